@@ -100,4 +100,13 @@ get_cwd__Dir();
 Vec *
 get_files_rec__Dir(const char *path);
 
+/**
+ *
+ * @brief Gets the name of all entries (files and folders) of the folder (not
+ * recursively, without `.` and `..`).
+ * @return Vec<String*>*?
+ */
+Vec *
+get_entries__Dir(const char *path);
+
 #endif // LILY_BASE_DIR_H
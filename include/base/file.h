@@ -91,6 +91,14 @@ get_absolute_dir__File(const char *path);
 Usize
 get_size__File(const char *path);
 
+/**
+ *
+ * @brief Get the last modification time of the file (in seconds).
+ * @return Return -1 if the status of the file cannot be read.
+ */
+Int64
+get_mtime__File(const char *path);
+
 /**
  *
  * @brief Read file content.
@@ -36,7 +36,10 @@
 #undef HASH_JENKINS
 
 #define HASH_SIP
-// #undef HASH_SIP
+#undef HASH_SIP
+
+#define HASH_WY
+// #undef HASH_WY
 
 #ifdef HASH_FNV1A
 #include <base/hash/fnv.h>
@@ -46,6 +49,8 @@
 #include <base/hash/jenkins.h>
 #elif defined(HASH_SIP)
 #include <base/hash/sip.h>
+#elif defined(HASH_WY)
+#include <base/hash/wy.h>
 #else
 #error "cannot generate an hash"
 #endif
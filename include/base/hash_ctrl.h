@@ -0,0 +1,233 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_BASE_HASH_CTRL_H
+#define LILY_BASE_HASH_CTRL_H
+
+#include <base/macros.h>
+#include <base/new.h>
+#include <base/types.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#define HASH_CTRL_USE_SSE2
+#endif
+
+// Control bytes shared by the open-addressing tables (HashMap,
+// OrderedHashMap).
+//
+// Each slot of a table has one control byte: a full slot stores the 7 low bits
+// of its hash (H2), while empty and deleted slots are negative. The slots are
+// probed by groups of HASH_CTRL_GROUP_WIDTH control bytes, which are compared
+// with H2 in a single SIMD operation when it's available.
+//
+// NOTE: The capacity of a table is always a power of two and never less than
+// HASH_CTRL_GROUP_WIDTH. The first HASH_CTRL_GROUP_WIDTH control bytes are
+// mirrored after the last one, so a group can be loaded from any slot.
+#define HASH_CTRL_EMPTY ((Int8)-128)
+#define HASH_CTRL_DELETED ((Int8)-2)
+#define HASH_CTRL_IS_FULL(ctrl) ((ctrl) >= 0)
+
+#define HASH_CTRL_GROUP_WIDTH 16
+#define HASH_CTRL_MIN_CAPACITY HASH_CTRL_GROUP_WIDTH
+
+// Maximum number of full slots in a table of capacity c (load factor of 7/8).
+#define HASH_CTRL_MAX_LOAD(c) ((c) - (c) / 8)
+
+// Set of the slots of a group (one bit per slot) matching a condition.
+typedef Uint32 HashCtrlMask;
+
+/**
+ *
+ * @brief Get the H1 part of the hash (used to pick the first group to probe).
+ */
+inline Usize
+h1__HashCtrl(Usize hash)
+{
+    return hash >> 7;
+}
+
+/**
+ *
+ * @brief Get the H2 part of the hash (stored in the control byte).
+ */
+inline Int8
+h2__HashCtrl(Usize hash)
+{
+    return hash & 0x7F;
+}
+
+/**
+ *
+ * @brief Match the slots of the group whose control byte is equal to h2.
+ */
+inline HashCtrlMask
+match__HashCtrl(const Int8 *group, Int8 h2)
+{
+#ifdef HASH_CTRL_USE_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+#else
+    HashCtrlMask mask = 0;
+
+    for (Usize i = 0; i < HASH_CTRL_GROUP_WIDTH; ++i) {
+        mask |= (HashCtrlMask)(group[i] == h2) << i;
+    }
+
+    return mask;
+#endif
+}
+
+/**
+ *
+ * @brief Match the empty slots of the group.
+ */
+inline HashCtrlMask
+match_empty__HashCtrl(const Int8 *group)
+{
+    return match__HashCtrl(group, HASH_CTRL_EMPTY);
+}
+
+/**
+ *
+ * @brief Match the empty or deleted slots of the group.
+ */
+inline HashCtrlMask
+match_empty_or_deleted__HashCtrl(const Int8 *group)
+{
+#ifdef HASH_CTRL_USE_SSE2
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else
+    HashCtrlMask mask = 0;
+
+    for (Usize i = 0; i < HASH_CTRL_GROUP_WIDTH; ++i) {
+        mask |= (HashCtrlMask)(group[i] < 0) << i;
+    }
+
+    return mask;
+#endif
+}
+
+/**
+ *
+ * @brief Match the full slots of the group.
+ */
+inline HashCtrlMask
+match_full__HashCtrl(const Int8 *group)
+{
+    return ~match_empty_or_deleted__HashCtrl(group) &
+           ((1u << HASH_CTRL_GROUP_WIDTH) - 1);
+}
+
+/**
+ *
+ * @brief Pop the lowest slot of the mask.
+ * @return The position of the slot in the group.
+ */
+inline Usize
+next__HashCtrlMask(HashCtrlMask *self)
+{
+    Usize pos = __builtin_ctz(*self);
+
+    *self &= *self - 1;
+
+    return pos;
+}
+
+/**
+ *
+ * @brief Set the control byte of the slot at index (and its mirror).
+ */
+inline void
+set__HashCtrl(Int8 *ctrls, Usize capacity, Usize index, Int8 ctrl)
+{
+    ctrls[index] = ctrl;
+
+    if (index < HASH_CTRL_GROUP_WIDTH) {
+        ctrls[capacity + index] = ctrl;
+    }
+}
+
+typedef struct HashCtrlProbe
+{
+    Usize pos;
+    Usize stride;
+    Usize mask;
+} HashCtrlProbe;
+
+/**
+ *
+ * @brief Construct HashCtrlProbe type (triangular probing over the groups).
+ */
+inline CONSTRUCTOR(HashCtrlProbe, HashCtrlProbe, Usize hash, Usize capacity)
+{
+    return (HashCtrlProbe){ .pos = h1__HashCtrl(hash) & (capacity - 1),
+                            .stride = 0,
+                            .mask = capacity - 1 };
+}
+
+/**
+ *
+ * @brief Move to the next group.
+ */
+inline void
+next__HashCtrlProbe(HashCtrlProbe *self)
+{
+    self->stride += HASH_CTRL_GROUP_WIDTH;
+    self->pos = (self->pos + self->stride) & self->mask;
+}
+
+/**
+ *
+ * @brief Allocate the control bytes of a table, all slots are empty.
+ */
+Int8 *
+new__HashCtrl(Usize capacity);
+
+/**
+ *
+ * @brief Find the first empty or deleted slot on the probe sequence of hash.
+ * @note The table must have at least one empty slot.
+ */
+Usize
+find_insert_slot__HashCtrl(const Int8 *ctrls, Usize capacity, Usize hash);
+
+/**
+ *
+ * @brief Mark the full slot at index as empty or deleted.
+ * @return Return true if the slot is marked as empty (i.e. no probe sequence
+ * can have passed through it), otherwise return false.
+ */
+bool
+erase__HashCtrl(Int8 *ctrls, Usize capacity, Usize index);
+
+/**
+ *
+ * @brief Get the capacity to use to rehash a full table.
+ */
+Usize
+grow__HashCtrl(Usize len, Usize capacity);
+
+#endif // LILY_BASE_HASH_CTRL_H
@@ -26,6 +26,7 @@
 #define LILY_BASE_HASH_MAP_H
 
 #include <base/hash_choice.h>
+#include <base/hash_ctrl.h>
 #include <base/macros.h>
 #include <base/new.h>
 #include <base/platform.h>
@@ -39,20 +40,15 @@
 #define HASH_MAP_SIZE INT32_MAX
 #endif
 
-#define DEFAULT_HASH_MAP_CAPACITY 8
+#define DEFAULT_HASH_MAP_CAPACITY HASH_CTRL_MIN_CAPACITY
 
-#define FREE_HASHMAP_VALUES(self, type)                    \
-    if (self->buckets) {                                   \
-        for (Usize i = 0; i < self->capacity; ++i) {       \
-            if (self->buckets[i]) {                        \
-                HashMapBucket *current = self->buckets[i]; \
-                while (current->next) {                    \
-                    FREE(type, current->pair.value);       \
-                    current = current->next;               \
-                }                                          \
-                FREE(type, current->pair.value);           \
-            }                                              \
-        }                                                  \
+#define FREE_HASHMAP_VALUES(self, type)                \
+    if (self->ctrls) {                                 \
+        for (Usize i = 0; i < self->capacity; ++i) {   \
+            if (HASH_CTRL_IS_FULL(self->ctrls[i])) {   \
+                FREE(type, self->slots[i].pair.value); \
+            }                                          \
+        }                                              \
     }
 
 #ifdef ENV_DEBUG
@@ -108,29 +104,22 @@ inline CONSTRUCTOR(HashMapPair, HashMapPair, char *key, void *value)
     return (HashMapPair){ .key = key, .value = value };
 }
 
-typedef struct HashMapBucket
+typedef struct HashMapSlot
 {
+    Usize hash;
     HashMapPair pair;
-    struct HashMapBucket *next; // HashMapBucket*?
-} HashMapBucket;
-
-/**
- *
- * @brief Construct HashMapBucket type.
- */
-CONSTRUCTOR(HashMapBucket *, HashMapBucket, HashMapPair pair);
-
-/**
- *
- * @brief Free HashMapBucket type.
- */
-DESTRUCTOR(HashMapBucket, HashMapBucket *self);
+} HashMapSlot;
 
+// Open-addressing table: the slots are probed by groups of control bytes (see
+// <base/hash_ctrl.h>), and the hash of each key is stored in its slot, so it's
+// never recomputed on rehash and most of the key comparisons are skipped.
 typedef struct HashMap
 {
-    HashMapBucket **buckets; // HashMapBucket**?
+    Int8 *ctrls;        // Int8*?
+    HashMapSlot *slots; // HashMapSlot*?
     Usize len;
     Usize capacity;
+    Usize growth_left;
 } HashMap;
 
 /**
@@ -170,6 +159,8 @@ hash__HashMap(HashMap *self, char *key)
     return hash_jenkins(key);
 #elif defined(HASH_SIP)
     return hash_sip(key, strlen(key), SIP_K0, SIP_K1);
+#elif defined(HASH_WY)
+    return hash_wy(key, strlen(key), WY_SEED);
 #else
 #error "cannot generate an hash"
 #endif
@@ -182,7 +173,7 @@ hash__HashMap(HashMap *self, char *key)
 inline Usize
 index__HashMap(HashMap *self, char *key)
 {
-    return hash__HashMap(self, key) % self->capacity;
+    return h1__HashCtrl(hash__HashMap(self, key)) & (self->capacity - 1);
 }
 
 /**
@@ -233,7 +224,6 @@ inline CONSTRUCTOR(HashMapIterPair, HashMapIterPair, char *key, void *value)
 typedef struct HashMapIter
 {
     HashMap *hash_map;
-    HashMapBucket *current;
     Usize count;
 } HashMapIter;
 
@@ -243,7 +233,7 @@ typedef struct HashMapIter
  */
 inline CONSTRUCTOR(HashMapIter, HashMapIter, HashMap *hash_map)
 {
-    return (HashMapIter){ .hash_map = hash_map, .current = NULL, .count = 0 };
+    return (HashMapIter){ .hash_map = hash_map, .count = 0 };
 }
 
 /**
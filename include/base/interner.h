@@ -0,0 +1,132 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_BASE_INTERNER_H
+#define LILY_BASE_INTERNER_H
+
+#include <base/memory/arena_chain.h>
+#include <base/new.h>
+#include <base/types.h>
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+// The interner never returns 0, so it can be used as "no symbol".
+#define SYMBOL_NONE 0
+
+#define INTERNER_ARENA_CAPACITY 65536
+#define INTERNER_DEFAULT_CAPACITY 1024
+#define INTERNER_CHUNK_LEN 4096
+#define INTERNER_CHUNKS_LEN 4096 // max: 16M symbols
+
+// Identifier of an interned string: two symbols are equal if and only if the
+// strings are equal.
+typedef Uint32 Symbol;
+
+// Open-addressing table of the symbols. Each slot holds the high half of the
+// hash of the string and its symbol, or 0 if the slot is empty. A full table
+// is replaced by a bigger one, but it's kept until the interner is freed, so
+// a reader can still probe it.
+typedef struct InternerTable
+{
+    _Atomic(Uint64) *slots;
+    Usize capacity;
+    struct InternerTable *previous; // struct InternerTable*?
+} InternerTable;
+
+// NOTE: Only `intern__Interner` takes the mutex (when the string is new):
+// `lookup__Interner` and `get__Interner` never lock, so the threads of the
+// analysis can look up names at the same time.
+typedef struct Interner
+{
+    _Atomic(InternerTable *) table;
+    // The string of each symbol, by chunks that are never moved.
+    _Atomic(const char **) chunks[INTERNER_CHUNKS_LEN]; // const char**?
+    Usize len;
+    MemoryArenaChain arenas;
+    pthread_mutex_t mutex;
+} Interner;
+
+/**
+ *
+ * @brief Construct Interner type.
+ */
+CONSTRUCTOR(Interner *, Interner);
+
+/**
+ *
+ * @brief Get the symbol of the string, the string is copied into the arenas
+ * of the interner the first time it's interned.
+ * @note This function is thread-safe.
+ */
+Symbol
+intern__Interner(Interner *self, const char *s);
+
+/**
+ *
+ * @brief Get the symbol of the string without interning it.
+ * @return If the string has never been interned, return SYMBOL_NONE.
+ * @note This function is thread-safe and lock-free.
+ */
+Symbol
+lookup__Interner(Interner *self, const char *s);
+
+/**
+ *
+ * @brief Get the string of the symbol.
+ * @note This function is thread-safe and lock-free.
+ */
+const char *
+get__Interner(Interner *self, Symbol symbol);
+
+/**
+ *
+ * @brief Free Interner type.
+ */
+DESTRUCTOR(Interner, Interner *self);
+
+/**
+ *
+ * @brief Intern the string in the global interner.
+ * @note The global interner lives until the end of the program.
+ */
+Symbol
+intern__Symbol(const char *s);
+
+/**
+ *
+ * @brief Look up the string in the global interner.
+ * @return If the string has never been interned, return SYMBOL_NONE.
+ */
+Symbol
+lookup__Symbol(const char *s);
+
+/**
+ *
+ * @brief Get the string of the symbol from the global interner.
+ */
+const char *
+to_str__Symbol(Symbol self);
+
+#endif // LILY_BASE_INTERNER_H
@@ -0,0 +1,111 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_BASE_JOB_RUNNER_H
+#define LILY_BASE_JOB_RUNNER_H
+
+#include <base/macros.h>
+#include <base/new.h>
+#include <base/string.h>
+#include <base/types.h>
+#include <base/vec.h>
+
+// Run external processes (e.g. C compiler invocations) in parallel, without
+// going through a shell.
+//
+// Each job belongs to a stage: the jobs of a stage only start when all jobs of
+// the previous stages are done (e.g. the libraries are compiled before the
+// binaries).
+
+typedef struct Job
+{
+    Vec *args; // Vec<char*>*
+    Usize stage;
+    String *err;     // String* (stderr of the process)
+    int exit_status; // -1 if the process didn't exit normally
+    int kill_signal; // -1 if the process wasn't killed by a signal
+} Job;
+
+/**
+ *
+ * @brief Construct Job type.
+ * @param args Vec<char*>* (the first argument is the program, which is searched
+ * in PATH)
+ */
+CONSTRUCTOR(Job *, Job, Vec *args, Usize stage);
+
+/**
+ *
+ * @brief Check if the job has failed (not run, non-zero exit status or killed
+ * by a signal).
+ */
+inline bool
+has_failed__Job(const Job *self)
+{
+    return self->exit_status != 0 || self->kill_signal != -1;
+}
+
+/**
+ *
+ * @brief Free Job type.
+ */
+DESTRUCTOR(Job, Job *self);
+
+typedef struct JobRunner
+{
+    Vec *jobs; // Vec<Job*>*
+    Usize max_running;
+} JobRunner;
+
+/**
+ *
+ * @brief Construct JobRunner type.
+ * @param max_running The maximum number of processes running at the same time
+ * (0 means the number of online cores).
+ */
+CONSTRUCTOR(JobRunner, JobRunner, Usize max_running);
+
+/**
+ *
+ * @brief Add a job to the runner.
+ * @note The jobs must be added by ascending stage.
+ */
+void
+add__JobRunner(JobRunner *self, Job *job);
+
+/**
+ *
+ * @brief Run all jobs, then collect their exit status and stderr.
+ * @return Return the number of failed jobs.
+ */
+Usize
+run__JobRunner(JobRunner *self);
+
+/**
+ *
+ * @brief Free JobRunner type.
+ */
+DESTRUCTOR(JobRunner, const JobRunner *self);
+
+#endif // LILY_BASE_JOB_RUNNER_H
@@ -59,6 +59,14 @@ inline CONSTRUCTOR(MemoryArena, MemoryArena, Usize capacity)
     };
 }
 
+/**
+ *
+ * @brief Check if the Arena has enough space left to reserve a region of
+ * `size` bytes aligned on `align`.
+ */
+bool
+has_space__MemoryArena(const MemoryArena *self, Usize size, Usize align);
+
 /**
  *
  * @brief Reserve region of the Arena.
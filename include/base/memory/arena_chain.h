@@ -0,0 +1,77 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef LILY_BASE_MEMORY_ARENA_CHAIN_H
+#define LILY_BASE_MEMORY_ARENA_CHAIN_H
+
+#include <base/memory/arena.h>
+#include <base/new.h>
+#include <base/vec.h>
+
+#define MEMORY_ARENA_CHAIN_ALLOC(T, self, n) \
+    alloc__MemoryArenaChain(self, sizeof(T) * n, alignof(T))
+
+// The chain of arenas is an arena allocator which never runs out of memory:
+// when the last arena is full, a new arena is appended to the chain. All the
+// regions are freed at once when the chain is freed.
+typedef struct MemoryArenaChain
+{
+    Vec *arenas; // Vec<MemoryArena*>*
+    Usize arena_capacity;
+} MemoryArenaChain;
+
+/**
+ *
+ * @brief Construct MemoryArenaChain type.
+ * @param arena_capacity The capacity of each arena of the chain (a region
+ * bigger than this capacity gets its own arena).
+ */
+inline CONSTRUCTOR(MemoryArenaChain, MemoryArenaChain, Usize arena_capacity)
+{
+    return (MemoryArenaChain){ .arenas = NEW(Vec),
+                               .arena_capacity = arena_capacity };
+}
+
+/**
+ *
+ * @brief Reserve region of the chain of arenas.
+ */
+void *
+alloc__MemoryArenaChain(MemoryArenaChain *self, Usize size, Usize align);
+
+/**
+ *
+ * @brief Get the total size of the regions reserved by the chain of arenas.
+ */
+Usize
+get_total_size__MemoryArenaChain(const MemoryArenaChain *self);
+
+/**
+ *
+ * @brief Free MemoryArenaChain type (free all the arenas of the chain).
+ */
+DESTRUCTOR(MemoryArenaChain, const MemoryArenaChain *self);
+
+#endif // LILY_BASE_MEMORY_ARENA_CHAIN_H
@@ -29,12 +29,15 @@
 
 #include <stdbool.h>
 
+// Header of a block allocated by the global allocator (the memory of the user
+// starts right after the header).
 typedef struct MemoryBlock
 {
-    Usize size;
+    Usize size; // size of the block (without the header)
     Usize align;
-    struct MemoryBlock *next; // struct MemoryBlock*?
-    struct MemoryBlock *prev; // struct MemoryBlock*?
+    struct MemoryBlock *next; // struct MemoryBlock*? (next free block)
+    void *owner; // MemoryGlobalCache*? (NULL if the block is not in a size
+                 // class)
 } MemoryBlock;
 
 /**
@@ -46,6 +49,6 @@ CONSTRUCTOR(MemoryBlock *,
             MemoryApi *api,
             Usize size,
             Usize align,
-            MemoryBlock *prev);
+            void *owner);
 
 #endif // LILY_BASE_MEMORY_BLOCK_H
@@ -36,10 +36,22 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+// The small blocks are grouped by size class (64, 128, ..., 8192 bytes,
+// header included). Each thread has its own free list per size class, filled
+// by spans of MEMORY_GLOBAL_SPAN_SIZE bytes, so an allocation or a free of the
+// owner thread never takes a lock. A block freed by another thread is pushed
+// on a lock-free queue of the owner thread, which collects it when its free
+// list is empty. The bigger blocks are directly allocated by the memory API.
+#define MEMORY_GLOBAL_MIN_BLOCK_SIZE 64
+#define MEMORY_GLOBAL_SIZE_CLASS_LEN 8
+#define MEMORY_GLOBAL_SPAN_SIZE 65536
+#define MEMORY_GLOBAL_BLOCK_ALIGN 32
+
 #define MEMORY_GLOBAL_ALLOC(T, n) \
-    alloc__MemoryGlobal(sizeof(T) * n, alignof(T) * ALIGNMENT_COEFF)
+    alloc__MemoryGlobal(sizeof(T) * (n), alignof(T) * ALIGNMENT_COEFF)
 
-#define MEMORY_GLOBAL_RESIZE(T, mem, n) resize__MemoryGlobal(mem, sizeof(T) * n)
+#define MEMORY_GLOBAL_RESIZE(T, mem, n) \
+    resize__MemoryGlobal(mem, sizeof(T) * (n))
 
 #define MEMORY_GLOBAL_FREE(mem) free__MemoryGlobal(mem)
 
@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_BASE_MEMSCAN_H
+#define LILY_BASE_MEMSCAN_H
+
+#include <base/types.h>
+
+// Bulk scanning of byte runs (whitespaces, identifiers, ...), used by the
+// scanners to skip or copy a whole run instead of advancing one character at a
+// time.
+//
+// The bytes are compared by blocks of 32 (AVX2) or 16 (SSE2) when it's
+// available at compile time, the rest of the bytes (or all bytes without SIMD)
+// are compared one by one.
+
+/**
+ *
+ * @brief Get the length of the run of whitespaces (` `, `\t`, `\n`, `\v`, `\f`,
+ * `\r`) at the start of `s`.
+ * @param with_new_line If it's false, `\n` ends the run.
+ */
+Usize
+span_space__MemScan(const char *s, Usize len, bool with_new_line);
+
+/**
+ *
+ * @brief Get the length of the run of identifier characters ([a-zA-Z0-9_]) at
+ * the start of `s`.
+ * @param with_dollar If it's true, `$` is also an identifier character.
+ */
+Usize
+span_ident__MemScan(const char *s, Usize len, bool with_dollar);
+
+/**
+ *
+ * @brief Find the first occurrence of `c1` or `c2`.
+ * @return Return the index of the occurrence, or `len` if there is no
+ * occurrence.
+ */
+Usize
+find_any__MemScan(const char *s, Usize len, char c1, char c2);
+
+/**
+ *
+ * @brief Count the occurrences of `c`.
+ */
+Usize
+count__MemScan(const char *s, Usize len, char c);
+
+#endif // LILY_BASE_MEMSCAN_H
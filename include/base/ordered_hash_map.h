@@ -26,6 +26,7 @@
 #define LILY_BASE_ORDERED_HASH_MAP_H
 
 #include <base/hash_choice.h>
+#include <base/hash_ctrl.h>
 #include <base/macros.h>
 #include <base/new.h>
 #include <base/platform.h>
@@ -40,20 +41,11 @@
 #define HASH_MAP_SIZE INT32_MAX
 #endif
 
-#define DEFAULT_ORDERED_HASH_MAP_CAPACITY 8
-
-#define FREE_ORD_HASHMAP_VALUES(self, type)                       \
-    if (self->buckets) {                                          \
-        for (Usize i = 0; i < self->capacity; ++i) {              \
-            if (self->buckets[i]) {                               \
-                OrderedHashMapBucket *current = self->buckets[i]; \
-                while (current->next) {                           \
-                    FREE(type, current->pair.value);              \
-                    current = current->next;                      \
-                }                                                 \
-                FREE(type, current->pair.value);                  \
-            }                                                     \
-        }                                                         \
+#define DEFAULT_ORDERED_HASH_MAP_CAPACITY HASH_CTRL_MIN_CAPACITY
+
+#define FREE_ORD_HASHMAP_VALUES(self, type) \
+    for (Usize i = 0; i < self->len; ++i) { \
+        FREE(type, self->pairs[i].value);   \
     }
 
 #ifdef ENV_DEBUG
@@ -101,29 +93,15 @@ inline CONSTRUCTOR(OrderedHashMapPair,
     return (OrderedHashMapPair){ .key = key, .value = value, .id = id };
 }
 
-typedef struct OrderedHashMapBucket
-{
-    OrderedHashMapPair pair;
-    struct OrderedHashMapBucket *next; // OrederedHashMapBucket*?
-} OrderedHashMapBucket;
-
-/**
- *
- * @brief Construct OrderedHashMapBucket type.
- */
-CONSTRUCTOR(OrderedHashMapBucket *,
-            OrderedHashMapBucket,
-            OrderedHashMapPair pair);
-
-/**
- *
- * @brief Free OrderedHashMapBucket type.
- */
-DESTRUCTOR(OrderedHashMapBucket, OrderedHashMapBucket *self);
-
+// Open-addressing table (see <base/hash_ctrl.h>) whose slots store the id of
+// the pair. The pairs are stored contiguously in insertion order, so the id of
+// a pair is its index in `pairs`.
 typedef struct OrderedHashMap
 {
-    OrderedHashMapBucket **buckets; // OrderedHashMapBucket**?
+    Int8 *ctrls;               // Int8*?
+    Usize *ids;                // Usize*?
+    OrderedHashMapPair *pairs; // OrderedHashMapPair*?
+    Usize *hashes;             // Usize*?
     Usize len;
     Usize capacity;
 } OrderedHashMap;
@@ -188,6 +166,8 @@ hash__OrderedHashMap(OrderedHashMap *self, char *key)
     return hash_jenkins(key);
 #elif defined(HASH_SIP)
     return hash_sip(key, strlen(key), SIP_K0, SIP_K1);
+#elif defined(HASH_WY)
+    return hash_wy(key, strlen(key), WY_SEED);
 #else
 #error "cannot generate an hash"
 #endif
@@ -200,7 +180,8 @@ hash__OrderedHashMap(OrderedHashMap *self, char *key)
 inline Usize
 index__OrderedHashMap(OrderedHashMap *self, char *key)
 {
-    return hash__OrderedHashMap(self, key) % self->capacity;
+    return h1__HashCtrl(hash__OrderedHashMap(self, key)) &
+           (self->capacity - 1);
 }
 
 typedef struct OrderedHashMapInitPair
@@ -234,6 +215,17 @@ vinit__OrderedHashMap(Usize count, va_list arg);
 void *
 insert__OrderedHashMap(OrderedHashMap *self, char *key, void *value);
 
+/**
+ *
+ * @brief Remove a pair from a key (the ids of the next pairs are shifted, so
+ * the insertion order is kept).
+ * @note The cost is O(n): the next pairs are moved and the whole table is
+ * rebuilt, so don't use it on a hot path.
+ * @return void*?
+ */
+void *
+remove__OrderedHashMap(OrderedHashMap *self, char *key);
+
 /**
  *
  * @brief Get the last item from the OrderedHashMap.
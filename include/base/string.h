@@ -72,6 +72,18 @@ CONSTRUCTOR(String *, String);
 void
 append__String(String *self, const String *other);
 
+/**
+ *
+ * @brief Remove all characters of the String, without freeing its buffer
+ * (the String can be reused).
+ */
+inline void
+clear__String(String *self)
+{
+    self->len = 0;
+    self->buffer[0] = '\0';
+}
+
 /**
  *
  * @brief Clone String.
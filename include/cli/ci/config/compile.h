@@ -43,7 +43,9 @@ inline CONSTRUCTOR(CIConfigCompile,
                    enum CIStandard standard,
                    Vec *includes,
                    Vec *includes0,
-                   bool no_state_check)
+                   bool no_state_check,
+                   Usize jobs,
+                   bool json_diagnostics)
 {
     return NEW(CIcConfig,
                path,
@@ -52,7 +54,9 @@ inline CONSTRUCTOR(CIConfigCompile,
                standard,
                includes,
                includes0,
-               no_state_check);
+               no_state_check,
+               jobs,
+               json_diagnostics);
 }
 
 /**
@@ -34,6 +34,8 @@
     CliOption *include = NEW(CliOption, "--include");                         \
     CliOption *include0 = NEW(CliOption, "--include0");                       \
     CliOption *no_state_check = NEW(CliOption, "--no-state-check");           \
+    CliOption *jobs = NEW(CliOption, "--jobs");                               \
+    CliOption *json_diagnostics = NEW(CliOption, "--json-diagnostics");       \
                                                                               \
     mode->$help(mode, "Specify transpilation mode (DEBUG | RELEASE)")         \
       ->$value(mode, NEW(CliValue, CLI_VALUE_KIND_SINGLE, "MODE", true));     \
@@ -57,13 +59,21 @@
         "Add directory to the begin of the list of include search paths")     \
       ->$value(include0, NEW(CliValue, CLI_VALUE_KIND_SINGLE, "DIR", true));  \
     no_state_check->$help(no_state_check, "Disable the state checker");       \
+    jobs->$short_name(jobs, "-j")                                             \
+      ->$help(jobs,                                                           \
+              "Set the number of files transpiled and compiled in parallel")  \
+      ->$value(jobs, NEW(CliValue, CLI_VALUE_KIND_SINGLE, "N", true));        \
+    json_diagnostics->$help(json_diagnostics,                                 \
+                            "Emit the diagnostics as JSON lines");            \
                                                                               \
     self->$option(self, mode)                                                 \
       ->$option(self, file)                                                   \
       ->$option(self, standard)                                               \
       ->$option(self, include)                                                \
       ->$option(self, include0)                                               \
-      ->$option(self, no_state_check);
+      ->$option(self, no_state_check)                                         \
+      ->$option(self, jobs)                                                   \
+      ->$option(self, json_diagnostics);
 
 Cli
 build__CliCIc(Vec *args);
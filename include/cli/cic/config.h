@@ -50,6 +50,8 @@ typedef struct CIcConfig
     // Store values passed via the `--include0` option
     Vec *includes0; // Vec<char* (&)>*
     bool no_state_check;
+    Usize jobs; // 0 means the number of online cores
+    bool json_diagnostics;
 } CIcConfig;
 
 /**
@@ -64,7 +66,9 @@ inline CONSTRUCTOR(CIcConfig,
                    enum CIStandard standard,
                    Vec *includes,
                    Vec *includes0,
-                   bool no_state_check)
+                   bool no_state_check,
+                   Usize jobs,
+                   bool json_diagnostics)
 {
     return (CIcConfig){ .path = path,
                         .mode = mode,
@@ -72,7 +76,9 @@ inline CONSTRUCTOR(CIcConfig,
                         .standard = standard,
                         .includes = includes,
                         .includes0 = includes0,
-                        .no_state_check = no_state_check };
+                        .no_state_check = no_state_check,
+                        .jobs = jobs,
+                        .json_diagnostics = json_diagnostics };
 }
 
 /**
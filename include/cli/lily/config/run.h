@@ -35,6 +35,7 @@ typedef struct LilyConfigRun
     Vec *args; // Vec<char*>* (&)
     Usize max_stack;
     Usize max_heap;
+    Usize jobs; // 0 means the number of online cores
 } LilyConfigRun;
 
 /**
@@ -47,13 +48,15 @@ inline CONSTRUCTOR(LilyConfigRun,
                    bool verbose,
                    Vec *args,
                    Usize max_stack,
-                   Usize max_heap)
+                   Usize max_heap,
+                   Usize jobs)
 {
     return (LilyConfigRun){ .filename = filename,
                             .verbose = verbose,
                             .args = args,
                             .max_stack = max_stack,
-                            .max_heap = max_heap };
+                            .max_heap = max_heap,
+                            .jobs = jobs };
 }
 
 #endif // LILY_CLI_LILY_CONFIG_RUN_H
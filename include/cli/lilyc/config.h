@@ -26,6 +26,7 @@
 #define LILY_CLI_LILYC_CONFIG_H
 
 #include <base/macros.h>
+#include <base/types.h>
 
 typedef struct LilycConfig
 {
@@ -62,6 +63,9 @@ typedef struct LilycConfig
     bool oz; // Include -OSize
     bool verbose;
     bool run;
+    Usize jobs; // 0 means the number of online cores
+    bool cache_stats;
+    bool skip_teardown;
 } LilycConfig;
 
 /**
@@ -102,7 +106,10 @@ inline CONSTRUCTOR(LilycConfig,
                    bool o3,
                    bool oz,
                    bool verbose,
-                   bool run)
+                   bool run,
+                   Usize jobs,
+                   bool cache_stats,
+                   bool skip_teardown)
 {
     return (LilycConfig){ .filename = filename,
                           .target = target,
@@ -136,7 +143,10 @@ inline CONSTRUCTOR(LilycConfig,
                           .o3 = o3,
                           .oz = oz,
                           .verbose = verbose,
-                          .run = run };
+                          .run = run,
+                          .jobs = jobs,
+                          .cache_stats = cache_stats,
+                          .skip_teardown = skip_teardown };
 }
 
 /**
@@ -64,6 +64,9 @@
     CliOption *output = NEW(CliOption, "--output");                            \
     CliOption *verbose = NEW(CliOption, "--verbose");                          \
     CliOption *run = NEW(CliOption, "--run");                                  \
+    CliOption *jobs = NEW(CliOption, "--jobs");                                \
+    CliOption *cache_stats = NEW(CliOption, "--cache-stats");                  \
+    CliOption *skip_teardown = NEW(CliOption, "--skip-teardown");              \
                                                                                \
     build->$help(build, "Build a package (exe, lib, ...)")                     \
       ->$short_name(build, "-b");                                              \
@@ -109,6 +112,14 @@
                NEW(CliValue, CLI_VALUE_KIND_SINGLE, "FILENAME", true));        \
     verbose->$help(verbose, "Enable log step of the compiler");                \
     run->$short_name(run, "-r")->$help(run, "Run the compiled file");          \
+    jobs->$short_name(jobs, "-j")                                              \
+      ->$help(jobs, "Set the number of packages compiled in parallel")         \
+      ->$value(jobs, NEW(CliValue, CLI_VALUE_KIND_SINGLE, "N", true));         \
+    cache_stats->$help(cache_stats,                                            \
+                       "Report the hits and misses of the object cache");      \
+    skip_teardown->$help(                                                      \
+      skip_teardown,                                                           \
+      "Exit without freeing the compiled package (faster one-shot builds)");   \
                                                                                \
     self->$option(self, build)                                                 \
       ->$option(self, dump_scanner)                                            \
@@ -144,7 +155,10 @@
       ->$option(self, Oz)                                                      \
       ->$option(self, output)                                                  \
       ->$option(self, verbose)                                                 \
-      ->$option(self, run);
+      ->$option(self, run)                                                     \
+      ->$option(self, jobs)                                                    \
+      ->$option(self, cache_stats)                                             \
+      ->$option(self, skip_teardown);
 
 Cli
 build__CliLilyc(Vec *args);
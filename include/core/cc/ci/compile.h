@@ -31,8 +31,11 @@
  *
  * @brief Compile binaries and libraries.
  * @param result const CIResult* (&)
+ * @param jobs The maximum number of compilers running at the same time (0
+ * means the number of online cores).
+ * @return Return the number of failed compilations.
  */
-void
-exec__CICompile(const CIResult *result);
+Usize
+exec__CICompile(const CIResult *result, Usize jobs);
 
 #endif // LILY_CORE_CC_CI_COMPILE_H
@@ -25,6 +25,7 @@
 #ifndef LILY_CORE_CC_CI_GENERATOR_H
 #define LILY_CORE_CC_CI_GENERATOR_H
 
+#include <base/hash_map.h>
 #include <base/vec_bit.h>
 
 #include <core/cc/ci/result.h>
@@ -81,22 +82,104 @@ inline CONSTRUCTOR(CIGeneratorContent, CIGeneratorContent)
  */
 DESTRUCTOR(CIGeneratorContent, const CIGeneratorContent *self);
 
+// Declaration generated (hoisted) before the instantiation, which must also be
+// generated when the cached content is reused in another file.
+typedef struct CIGeneratorGenCacheDependency
+{
+    CIDecl *(*search)(const CIResultFile *, const String *);
+    String *name;
+} CIGeneratorGenCacheDependency;
+
+/**
+ *
+ * @brief Construct CIGeneratorGenCacheDependency type.
+ */
+CONSTRUCTOR(CIGeneratorGenCacheDependency *,
+            CIGeneratorGenCacheDependency,
+            CIDecl *(*search)(const CIResultFile *, const String *),
+            const String *name);
+
+/**
+ *
+ * @brief Free CIGeneratorGenCacheDependency type.
+ */
+DESTRUCTOR(CIGeneratorGenCacheDependency, CIGeneratorGenCacheDependency *self);
+
+// Generated content of an instantiation (struct, union, typedef or function
+// gen) of a generic declaration.
+typedef struct CIGeneratorGenCacheEntry
+{
+    // NOTE: The name of the generic declaration comes from the tokens of its
+    // file, which are shared by all the files that include it, so it's used to
+    // identify the generic declaration across the files.
+    const Rc *origin; // const Rc<String*>* (&)
+    String *name;
+    String *content;   // String*?
+    Vec *dependencies; // Vec<CIGeneratorGenCacheDependency*>*
+    bool is_cacheable;
+} CIGeneratorGenCacheEntry;
+
+/**
+ *
+ * @brief Construct CIGeneratorGenCacheEntry type.
+ */
+CONSTRUCTOR(CIGeneratorGenCacheEntry *,
+            CIGeneratorGenCacheEntry,
+            const Rc *origin,
+            const String *name);
+
+/**
+ *
+ * @brief Free CIGeneratorGenCacheEntry type.
+ */
+DESTRUCTOR(CIGeneratorGenCacheEntry, CIGeneratorGenCacheEntry *self);
+
+// This cache is shared by all the generated files, so an instantiation used by
+// several files is only generated once.
+typedef struct CIGeneratorGenCache
+{
+    HashMap *entries; // HashMap<CIGeneratorGenCacheEntry*>*
+} CIGeneratorGenCache;
+
+/**
+ *
+ * @brief Construct CIGeneratorGenCache type.
+ */
+inline CONSTRUCTOR(CIGeneratorGenCache, CIGeneratorGenCache)
+{
+    return (CIGeneratorGenCache){ .entries = NEW(HashMap) };
+}
+
+/**
+ *
+ * @brief Free CIGeneratorGenCache type.
+ */
+DESTRUCTOR(CIGeneratorGenCache, const CIGeneratorGenCache *self);
+
 typedef struct CIGenerator
 {
     const CIResultFile *file; // const CIResultFile* (&)
     CIGeneratorContent content;
     VecBit *generated_decls;
+    CIGeneratorGenCache *gen_cache; // CIGeneratorGenCache* (&)
+    // Entry of the instantiation being generated.
+    CIGeneratorGenCacheEntry *gen_cache_entry; // CIGeneratorGenCacheEntry*?
 } CIGenerator;
 
 /**
  *
  * @brief Construct CIGenerator type.
  */
-inline CONSTRUCTOR(CIGenerator, CIGenerator, const CIResultFile *file)
+inline CONSTRUCTOR(CIGenerator,
+                   CIGenerator,
+                   const CIResultFile *file,
+                   CIGeneratorGenCache *gen_cache)
 {
     return (CIGenerator){ .file = file,
                           .content = NEW(CIGeneratorContent),
-                          .generated_decls = NEW(VecBit) };
+                          .generated_decls = NEW(VecBit),
+                          .gen_cache = gen_cache,
+                          .gen_cache_entry = NULL };
 }
 
 /**
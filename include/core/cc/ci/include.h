@@ -61,6 +61,18 @@ insert_include_dir__CIInclude(String *include_dir, Usize index);
 const Vec *
 get_include_dirs__CIInclude();
 
+/**
+ *
+ * @brief Resolve the full path of the included file, by looking for it in the
+ * include directories, then in the directory of the including file. The result
+ * of the resolution (even if the file is not found) is cached.
+ * @param include_path const String* (&)
+ * @param including_dir const String* (&)
+ * @return const String*? (&)
+ */
+const String *
+resolve__CIInclude(const String *include_path, const String *including_dir);
+
 /**
  *
  * @brief Free `include_dirs` vector.
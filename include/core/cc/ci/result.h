@@ -739,6 +739,22 @@ include_content__CIResultFile(const CIResultFile *self, CIResultFile *other);
 bool
 is_same_filename__CIResultFile(const CIResultFile *self, const char *filename);
 
+/**
+ *
+ * @brief Get the output directory (e.g. `out.ci`), where the results, the
+ * manifest and the caches are written.
+ */
+const char *
+get_output_dir__CIResult();
+
+/**
+ *
+ * @brief Get the path of `name` in the output directory.
+ * @return char*
+ */
+char *
+get_output_path__CIResult(const char *name);
+
 enum CIDirResultPurpose
 {
     CI_DIR_RESULT_PURPOSE_BIN,
@@ -825,6 +841,10 @@ typedef struct CIResult
     OrderedHashMap *sources;       // OrderedHashMap<CIResultFile* (&)>*
     OrderedHashMap *bins;          // OrderedHashMap<CIResultBin*>*
     OrderedHashMap *libs;          // OrderedHashMap<CIResultLib*>*
+    // Only the entities of the shard are passed through (see
+    // `run_in_parallel__CIResult`).
+    Usize shard_index;
+    Usize shard_count;
 } CIResult;
 
 /**
@@ -844,6 +864,8 @@ inline CONSTRUCTOR(CIResult,
         .sources = NEW(OrderedHashMap),
         .bins = NEW(OrderedHashMap),
         .libs = NEW(OrderedHashMap),
+        .shard_index = 0,
+        .shard_count = 1,
     };
 }
 
@@ -964,6 +986,21 @@ pass_through_result__CIResult(const CIResult *self,
                                           void *other_args),
                               void *other_args);
 
+/**
+ *
+ * @brief Run `run` in `jobs` worker processes (forked). Each worker only
+ * passes through its shard of the bins and libraries, so the workers don't
+ * share any state.
+ * @param jobs If `jobs` is 0, the number of online cores is used.
+ * @note The changes made by the workers to the result are not visible by the
+ * caller, only the files written by the workers are.
+ */
+void
+run_in_parallel__CIResult(CIResult *self,
+                          void (*run)(CIResult *self, void *other_args),
+                          void *other_args,
+                          Usize jobs);
+
 /**
  *
  * @brief Free CIResult type.
@@ -84,6 +84,19 @@ is_standard_predefined_macro__CIScanner(const String *name);
 enum CITokenKind
 get_keyword__CIScanner(const String *id);
 
+// keywords, attributes, builtin macros, standard predefined macros and
+// preprocessors
+#define CI_SCANNER_N_KEYWORDS_HASH 5
+
+/**
+ *
+ * @brief Get the perfect hash tables of keywords, attributes, builtin macros,
+ * standard predefined macros and preprocessors (in this order).
+ */
+void
+get_keywords_hashes__CIScanner(
+  const SearchPerfectHash *hashes[CI_SCANNER_N_KEYWORDS_HASH]);
+
 /**
  *
  * @brief Run the scanner.
@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_CORE_CC_CI_TOKEN_CACHE_H
+#define LILY_CORE_CC_CI_TOKEN_CACHE_H
+
+#include <core/cc/ci/project_config.h>
+#include <core/cc/ci/token.h>
+#include <core/shared/file.h>
+
+// The tokens of a scanned header are written in a flat binary file (without
+// pointer), so they can be loaded by the next invocation of the compiler
+// instead of scanning the header again.
+//
+// Layout:
+//
+// magic | version | CI_TOKEN_KIND_MAX | standard | compiler kind | path |
+// mtime | content length | content hash | payload hash | payload (tokens)
+
+/**
+ *
+ * @brief Load the tokens of the file from the cache.
+ * @param file const File* (&)
+ * @param config const CIProjectConfig* (&)
+ * @param tokens CITokens* (&)
+ * @return Return true if the cache is valid (the standard, the compiler, the
+ * path, the last modification time and the content of the file match),
+ * otherwise return false.
+ */
+bool
+load__CITokenCache(const File *file,
+                   const CIProjectConfig *config,
+                   CITokens *tokens);
+
+/**
+ *
+ * @brief Write the tokens of the file in the cache.
+ * @param file const File* (&)
+ * @param config const CIProjectConfig* (&)
+ * @param tokens const CITokens* (&)
+ * @note The tokens are not cached, if they depend on the time of the
+ * compilation (e.g. __DATE__), or if the last modification time of the file
+ * cannot be read.
+ */
+void
+save__CITokenCache(const File *file,
+                   const CIProjectConfig *config,
+                   const CITokens *tokens);
+
+#endif // LILY_CORE_CC_CI_TOKEN_CACHE_H
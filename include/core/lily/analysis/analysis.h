@@ -28,6 +28,7 @@
 #include <base/vec.h>
 
 #include <core/lily/analysis/checked.h>
+#include <core/lily/analysis/checked/history.h>
 #include <core/lily/parser/parser.h>
 
 typedef struct LilyPackage LilyPackage;
@@ -41,6 +42,19 @@ typedef struct LilyAnalysis
     LilyAstDecl *current;
     const LilyParser *parser;
     Usize position;
+    // NOTE: The following fields are the state of the declaration being
+    // checked. They are stored in the analysis (rather than in globals), so
+    // that the check of the declarations doesn't depend on the thread running
+    // it.
+    LilyCheckedHistory *history;      // LilyCheckedHistory*?
+    LilyCheckedDeclAlias *alias_decl; // LilyCheckedDeclAlias*? (&)
+    bool in_try;
+    // Operators matching the binary expression being checked, reused between
+    // the binary expressions.
+    Vec *binary_operators; // Vec<LilyCheckedOperator* (&)>*
+    // true during the step 2, where only the signatures of the functions are
+    // checked.
+    bool signatures_only;
     bool use_switch;
 } LilyAnalysis;
 
@@ -66,6 +80,11 @@ inline CONSTRUCTOR(LilyAnalysis,
                            .current = NULL,
                            .parser = parser,
                            .position = 0,
+                           .history = NULL,
+                           .alias_decl = NULL,
+                           .in_try = false,
+                           .binary_operators = NEW(Vec),
+                           .signatures_only = false,
                            .use_switch = use_switch };
 }
 
@@ -26,6 +26,7 @@
 #define LILY_CORE_LILY_ANALYSIS_CHECKED_DATA_TYPE_H
 
 #include <base/hash_map.h>
+#include <base/interner.h>
 #include <base/macros.h>
 #include <base/new.h>
 #include <base/ordered_hash_map.h>
@@ -249,7 +250,8 @@ typedef struct LilyCheckedDataTypeCustom
     LilyCheckedAccessScope scope;
     String *name;        // String* (&)
     String *global_name; // String* (&)
-    Vec *generics;       // Vec<LilyCheckedDataType*>*?
+    Symbol global_name_symbol;
+    Vec *generics; // Vec<LilyCheckedDataType*>*?
     enum LilyCheckedDataTypeCustomKind kind;
     bool is_recursive;
 } LilyCheckedDataTypeCustom;
@@ -268,10 +270,15 @@ inline CONSTRUCTOR(LilyCheckedDataTypeCustom,
                    enum LilyCheckedDataTypeCustomKind kind,
                    bool is_recursive)
 {
+    Symbol global_name_symbol =
+      global_name ? intern__Symbol(global_name->buffer) : SYMBOL_NONE;
+
     return (LilyCheckedDataTypeCustom){ .scope_id = scope_id,
                                         .scope = scope,
                                         .name = name,
                                         .global_name = global_name,
+                                        .global_name_symbol =
+                                          global_name_symbol,
                                         .generics = generics,
                                         .kind = kind,
                                         .is_recursive = is_recursive };
@@ -794,6 +801,37 @@ bool
 eq_return_data_type__LilyCheckedDataType(LilyCheckedDataType *self,
                                          LilyCheckedDataType *other);
 
+/**
+ *
+ * @brief Compute a structural hash of the data type, consistent with
+ * eq__LilyCheckedDataType.
+ * @return Return 0 if the data type contains a data type that can match
+ * anything (unknown, generic, compiler defined, ...), otherwise return a
+ * non-zero hash.
+ */
+Uint64
+hash__LilyCheckedDataType(const LilyCheckedDataType *self);
+
+/**
+ *
+ * @brief Compute the structural hash of the sequence of data types.
+ * @param self Vec<LilyCheckedDataType*>*
+ * @return Return 0 if at least one data type have no hash.
+ */
+Uint64
+hash_vec__LilyCheckedDataType(const Vec *self);
+
+/**
+ *
+ * @brief Return false if the data types with these hashes cannot be equal.
+ * @note Two hashes can only be compared when both are non-zero.
+ */
+inline bool
+may_eq_hash__LilyCheckedDataType(Uint64 self, Uint64 other)
+{
+    return !self || !other || self == other;
+}
+
 /**
  *
  * @brief Get the return data type according with the given condition.
@@ -136,6 +136,7 @@ typedef struct LilyCheckedDeclFun
     bool is_main;
     bool is_recursive;
     bool is_checked;
+    bool signature_is_checked;
     bool has_return;
     bool default_return_dt_is_set;
 } LilyCheckedDeclFun;
@@ -179,6 +180,7 @@ inline CONSTRUCTOR(LilyCheckedDeclFun,
                                  .is_main = false,
                                  .is_recursive = false,
                                  .is_checked = false,
+                                 .signature_is_checked = false,
                                  .has_return = false,
                                  .default_return_dt_is_set =
                                    default_return_data_type ? true : false };
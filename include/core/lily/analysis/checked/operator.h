@@ -38,6 +38,7 @@ typedef struct LilyCheckedOperator
     String *name;   // String* (&)
                     // [params, return_data_type]
     Vec *signature; // Vec<LilyCheckedDataType* (&)>* (&)
+    Uint64 signature_hash;
     bool is_default;
     Usize ref_count;
 } LilyCheckedOperator;
@@ -25,11 +25,36 @@
 #ifndef LILY_CORE_LILY_ANALYSIS_CHECKED_OPERATOR_REGISTER_H
 #define LILY_CORE_LILY_ANALYSIS_CHECKED_OPERATOR_REGISTER_H
 
+#include <base/hash_map.h>
+
 #include <core/lily/analysis/checked/operator.h>
 
+typedef struct LilyCheckedOperatorCollection
+{
+    Usize signature_len;
+    Vec *operators; // Vec<LilyCheckedOperator* (&)>*
+} LilyCheckedOperatorCollection;
+
+/**
+ *
+ * @brief Construct LilyCheckedOperatorCollection type.
+ */
+CONSTRUCTOR(LilyCheckedOperatorCollection *,
+            LilyCheckedOperatorCollection,
+            Usize signature_len);
+
+/**
+ *
+ * @brief Free LilyCheckedOperatorCollection type.
+ */
+DESTRUCTOR(LilyCheckedOperatorCollection, LilyCheckedOperatorCollection *self);
+
 typedef struct LilyCheckedOperatorRegister
 {
     Vec *operators; // Vec<LilyCheckedOperator*>*
+    // The operators are indexed by name, then by signature length, so a lookup
+    // only goes through the operators that can match.
+    HashMap *index; // HashMap<Vec<LilyCheckedOperatorCollection*>*>*
 } LilyCheckedOperatorRegister;
 
 /**
@@ -38,9 +63,18 @@ typedef struct LilyCheckedOperatorRegister
  */
 inline CONSTRUCTOR(LilyCheckedOperatorRegister, LilyCheckedOperatorRegister)
 {
-    return (LilyCheckedOperatorRegister){ .operators = NEW(Vec) };
+    return (LilyCheckedOperatorRegister){ .operators = NEW(Vec),
+                                          .index = NEW(HashMap) };
 }
 
+/**
+ *
+ * @brief Push operator to the register without looking for duplicate.
+ */
+void
+push_operator__LilyCheckedOperatorRegister(LilyCheckedOperatorRegister *self,
+                                           LilyCheckedOperator *operator);
+
 /**
  *
  * @brief Add operator to the register.
@@ -60,6 +94,18 @@ search_operator__LilyCheckedOperatorRegister(
   char *name,
   Vec *signature);
 
+/**
+ *
+ * @brief Get the collection of operators with the given name and signature
+ * length.
+ * @return Vec<LilyCheckedOperator* (&)>*? (&)
+ */
+const Vec *
+get_operators__LilyCheckedOperatorRegister(
+  const LilyCheckedOperatorRegister *self,
+  char *name,
+  Usize signature_len);
+
 /**
  *
  * @brief Collect all operators with the given name.
@@ -97,11 +143,17 @@ generate_conditional_compiler_choice_according_operator_collection__LilyCheckedO
 /**
  *
  * @brief Typecheck binary operator.
+ * @param operators Vec<LilyCheckedOperator* (&)>*? (&) (e.g. the collection
+ * returned by `get_operators__LilyCheckedOperatorRegister`), it's not
+ * modified.
+ * @param matches Vec<LilyCheckedOperator* (&)>* (&) receives the operators
+ * which match (it's cleared first, so it can be reused between calls).
  * @param defined_data_type LilyCheckedDataType* (&)?
  */
 void
 typecheck_binary__LilyCheckedOperatorRegister(
-  Vec *operators,
+  const Vec *operators,
+  Vec *matches,
   const Location *expr_location,
   LilyCheckedDataType *left,
   LilyCheckedDataType *right,
@@ -26,6 +26,7 @@
 #define LILY_CORE_LILY_ANALYSIS_CHECKED_SCOPE_CONTAINER_H
 
 #include <base/alloc.h>
+#include <base/interner.h>
 #include <base/string.h>
 #include <base/vec.h>
 
@@ -439,6 +440,7 @@ inline DESTRUCTOR(LilyCheckedScopeContainerTrait,
 typedef struct LilyCheckedScopeContainerFun
 {
     String *name; // String* (&)
+    Symbol symbol;
     // overload of function
     Vec *ids; // Vec<Usize*>*
 } LilyCheckedScopeContainerFun;
@@ -41,6 +41,7 @@ typedef struct LilyCheckedSignatureFun
     // NOTE: the return data type must be drop.
     Vec *types; // Vec<LilyCheckedDataType* (&)...LilyCheckedDataType*>*
     HashMap *generic_params; // HashMap<LilyCheckedDataType*>*?
+    Uint64 hash; // Structural hash of the types (0 if not computable)
 } LilyCheckedSignatureFun;
 
 /**
@@ -69,7 +70,7 @@ add_signature__LilyCheckedSignatureFun(String *global_name,
 
 /**
  *
- * @brief Reload global name.
+ * @brief Reload global name (and the hash of the types).
  */
 void
 reload_global_name__LilyCheckedSignatureFun(LilyCheckedSignatureFun *self);
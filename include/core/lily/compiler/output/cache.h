@@ -25,21 +25,28 @@
 #ifndef LILY_CORE_LILY_COMPILER_OUTPUT_CACHE_H
 #define LILY_CORE_LILY_COMPILER_OUTPUT_CACHE_H
 
+#include <base/hash_map.h>
 #include <base/macros.h>
 #include <base/platform.h>
+#include <base/types.h>
+#include <base/vec.h>
 
 #ifdef LILY_WINDOWS_OS
 #define DIR_CACHE_NAME "out.lily\\"
 #define DIR_CACHE_BIN DIR_CACHE_NAME "bin\\"
 #define DIR_CACHE_LIB DIR_CACHE_NAME "lib\\"
 #define DIR_CACHE_OBJ DIR_CACHE_NAME "obj\\"
+#define DIR_CACHE_MANIFEST DIR_CACHE_NAME "manifest"
 #else
 #define DIR_CACHE_NAME "out.lily/"
 #define DIR_CACHE_BIN DIR_CACHE_NAME "bin/"
 #define DIR_CACHE_LIB DIR_CACHE_NAME "lib/"
 #define DIR_CACHE_OBJ DIR_CACHE_NAME "obj/"
+#define DIR_CACHE_MANIFEST DIR_CACHE_NAME "manifest"
 #endif
 
+typedef struct LilyPackage LilyPackage;
+
 /**
  *
  * @brief Create cache.
@@ -53,4 +60,75 @@
 void
 create_cache__LilyCompilerOutputCache();
 
+typedef struct LilyCompilerOutputCacheEntry
+{
+    char *global_name;
+    Usize key;
+    char *obj_path;
+} LilyCompilerOutputCacheEntry;
+
+/**
+ *
+ * @brief Construct LilyCompilerOutputCacheEntry type.
+ */
+CONSTRUCTOR(LilyCompilerOutputCacheEntry *,
+            LilyCompilerOutputCacheEntry,
+            char *global_name,
+            Usize key,
+            char *obj_path);
+
+/**
+ *
+ * @brief Free LilyCompilerOutputCacheEntry type.
+ */
+DESTRUCTOR(LilyCompilerOutputCacheEntry, LilyCompilerOutputCacheEntry *self);
+
+// NOTE: The manifest (out.lily/manifest) contains one line per package:
+// <global_name> <key> <obj_path>
+//
+// The key of a package combines the content of its file, the keys of its
+// package dependencies, the version of the compiler, the target and the
+// optimization flags. When the key of a package is the same as in the
+// manifest and the object file still exists, the object file is reused.
+typedef struct LilyCompilerOutputCache
+{
+    HashMap *entries; // HashMap<LilyCompilerOutputCacheEntry*>*
+    Usize hits;
+    Usize misses;
+} LilyCompilerOutputCache;
+
+/**
+ *
+ * @brief Construct LilyCompilerOutputCache type (load the manifest if it
+ * exists).
+ */
+CONSTRUCTOR(LilyCompilerOutputCache, LilyCompilerOutputCache);
+
+/**
+ *
+ * @brief Compute the key of all packages of the dependency trees and check if
+ * their object file can be reused (set `compiler.cache_hit` and
+ * `compiler.output_path` on a hit).
+ * @param trees Vec<LilyPackageDependencyTree*>* (&)
+ * @return true if all packages hit the cache.
+ */
+bool
+check__LilyCompilerOutputCache(LilyCompilerOutputCache *self,
+                               const Vec *trees);
+
+/**
+ *
+ * @brief Update the entries of all packages of the dependency trees and write
+ * the manifest.
+ * @param trees Vec<LilyPackageDependencyTree*>* (&)
+ */
+void
+save__LilyCompilerOutputCache(LilyCompilerOutputCache *self, const Vec *trees);
+
+/**
+ *
+ * @brief Free LilyCompilerOutputCache type.
+ */
+DESTRUCTOR(LilyCompilerOutputCache, const LilyCompilerOutputCache *self);
+
 #endif // LILY_CORE_LILY_COMPILER_OUTPUT_CACHE_H
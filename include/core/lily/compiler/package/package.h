@@ -131,6 +131,8 @@ typedef struct LilyCompilerAdapter
     LilyIr ir;
     enum LilyLinkerKind linker;
     LilyLibrary *lib; // LilyLibrary*? (&)
+    Usize cache_key;  // 0 if the key of the package is not computed yet
+    bool cache_hit;   // true if the object file is reused from the cache
 } LilyCompilerAdapter;
 
 /**
@@ -146,6 +148,8 @@ inline CONSTRUCTOR(LilyCompilerAdapter,
         .output_exe_path = NULL,
         .config = config,
         .lib = NULL,
+        .cache_key = 0,
+        .cache_hit = false,
     };
 }
 
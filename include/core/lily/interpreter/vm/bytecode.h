@@ -0,0 +1,192 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef LILY_CORE_LILY_INTERPRETER_VM_BYTECODE_H
+#define LILY_CORE_LILY_INTERPRETER_VM_BYTECODE_H
+
+#include <base/macros.h>
+#include <base/types.h>
+#include <base/vec.h>
+
+#include <core/lily/interpreter/vm/value.h>
+#include <core/lily/mir/mir.h>
+
+// If this bit is set on an operand (RK), the operand is an index in the
+// constants of the function, otherwise it's an index in the registers.
+#define LILY_INTERPRETER_VM_BYTECODE_RK_CONST 0x8000
+
+// Max number of registers or constants per function.
+#define LILY_INTERPRETER_VM_BYTECODE_MAX_RK 0x8000
+
+// Max number of instructions per function.
+#define LILY_INTERPRETER_VM_BYTECODE_MAX_INSTS 0xFFFF
+
+// R(x): register x
+// RK(x): register x or constant x (see LILY_INTERPRETER_VM_BYTECODE_RK_CONST)
+// The typed opcodes (*_F64: Float, *_I32: Int32, *_I64: Int64) expect that
+// both operands have the given kind, so they don't dispatch on the kind of the
+// values.
+enum LilyInterpreterVMBytecodeOpcode : Uint8
+{
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_ADD,      // R(x) = RK(y) + RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_ADD_F64,  // R(x) = RK(y) + RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_ADD_I32,  // R(x) = RK(y) + RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_ADD_I64,  // R(x) = RK(y) + RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_BITAND,   // R(x) = RK(y) & RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_BITNOT,   // R(x) = ~RK(y)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_BITOR,    // R(x) = RK(y) | RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_CALL,     // R(x) = fun[y](R(z)...)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_DIV,      // R(x) = RK(y) / RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_DIV_F64,  // R(x) = RK(y) / RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_DIV_I32,  // R(x) = RK(y) / RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_DIV_I64,  // R(x) = RK(y) / RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_EQ,       // R(x) = RK(y) == RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_EQ_F64,   // R(x) = RK(y) == RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_EQ_I32,   // R(x) = RK(y) == RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_EQ_I64,   // R(x) = RK(y) == RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_GE,       // R(x) = RK(y) >= RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_GE_F64,   // R(x) = RK(y) >= RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_GE_I32,   // R(x) = RK(y) >= RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_GE_I64,   // R(x) = RK(y) >= RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_GT,       // R(x) = RK(y) > RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_GT_F64,   // R(x) = RK(y) > RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_GT_I32,   // R(x) = RK(y) > RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_GT_I64,   // R(x) = RK(y) > RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_JMP,      // pc = y
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_JMPCOND,  // pc = RK(x) ? y : z
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_LE,       // R(x) = RK(y) <= RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_LE_F64,   // R(x) = RK(y) <= RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_LE_I32,   // R(x) = RK(y) <= RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_LE_I64,   // R(x) = RK(y) <= RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_LT,       // R(x) = RK(y) < RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_LT_F64,   // R(x) = RK(y) < RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_LT_I32,   // R(x) = RK(y) < RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_LT_I64,   // R(x) = RK(y) < RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_MOVE,     // R(x) = RK(y)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_MUL,      // R(x) = RK(y) * RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_MUL_F64,  // R(x) = RK(y) * RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_MUL_I32,  // R(x) = RK(y) * RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_MUL_I64,  // R(x) = RK(y) * RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_NE,       // R(x) = RK(y) != RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_NE_F64,   // R(x) = RK(y) != RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_NE_I32,   // R(x) = RK(y) != RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_NE_I64,   // R(x) = RK(y) != RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_NEG,      // R(x) = -RK(y)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_NOT,      // R(x) = !RK(y)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_REM,      // R(x) = RK(y) % RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_REM_F64,  // R(x) = RK(y) % RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_REM_I32,  // R(x) = RK(y) % RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_REM_I64,  // R(x) = RK(y) % RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_RET,      // return RK(y)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_SHL,      // R(x) = RK(y) << RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_SHR,      // R(x) = RK(y) >> RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_SUB,      // R(x) = RK(y) - RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_SUB_F64,  // R(x) = RK(y) - RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_SUB_I32,  // R(x) = RK(y) - RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_SUB_I64,  // R(x) = RK(y) - RK(z)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_SYS_CALL, // R(x) = sys[y](R(z)...)
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_UNREACHABLE,
+    LILY_INTERPRETER_VM_BYTECODE_OPCODE_XOR,      // R(x) = RK(y) ^ RK(z)
+};
+
+enum LilyInterpreterVMBytecodeSysCall : Uint8
+{
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_READ,
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_WRITE,
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_OPEN,
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_CLOSE,
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_MODE,
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_INO,
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_DEV,
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_NLINK,
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_UID,
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_GID,
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_SIZE,
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_ATIME,
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_MTIME,
+    LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_CTIME,
+};
+
+/**
+ *
+ * @brief Get the opcode specialized for the kind of the operands.
+ * @return Return the given opcode, if it has no specialized opcode for this
+ * kind.
+ */
+enum LilyInterpreterVMBytecodeOpcode
+get_typed_opcode__LilyInterpreterVMBytecodeOpcode(
+  enum LilyInterpreterVMBytecodeOpcode opcode,
+  enum LilyInterpreterValueKind kind);
+
+typedef struct LilyInterpreterVMBytecodeInst
+{
+    enum LilyInterpreterVMBytecodeOpcode opcode;
+    Uint16 x;
+    Uint16 y;
+    Uint16 z;
+} LilyInterpreterVMBytecodeInst;
+
+typedef struct LilyInterpreterVMBytecodeFun
+{
+    const char *name; // const char* (&)
+    LilyInterpreterVMBytecodeInst *insts;
+    Usize insts_len;
+    LilyInterpreterValue *consts;
+    Usize consts_len;
+    Usize params_len;
+    Usize regs_len; // params + slots + temporary registers
+} LilyInterpreterVMBytecodeFun;
+
+/**
+ *
+ * @brief Free LilyInterpreterVMBytecodeFun type.
+ */
+DESTRUCTOR(LilyInterpreterVMBytecodeFun, LilyInterpreterVMBytecodeFun *self);
+
+typedef struct LilyInterpreterVMBytecodeModule
+{
+    Vec *funs; // Vec<LilyInterpreterVMBytecodeFun*>*
+    LilyInterpreterVMBytecodeFun *entry_point; // (&)
+} LilyInterpreterVMBytecodeModule;
+
+/**
+ *
+ * @brief Lower all the functions of the MIR module to bytecode.
+ * @return Return NULL if the module uses an instruction or a value that cannot
+ * be lowered. In that case, the VM runs the MIR instructions directly.
+ * @note The slots of the module must be resolved before (see
+ * `resolve__LilyInterpreterVMSlot`).
+ */
+LilyInterpreterVMBytecodeModule *
+lower__LilyInterpreterVMBytecodeModule(const LilyMirModule *module);
+
+/**
+ *
+ * @brief Free LilyInterpreterVMBytecodeModule type.
+ */
+DESTRUCTOR(LilyInterpreterVMBytecodeModule,
+           LilyInterpreterVMBytecodeModule *self);
+
+#endif // LILY_CORE_LILY_INTERPRETER_VM_BYTECODE_H
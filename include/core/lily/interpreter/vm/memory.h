@@ -30,13 +30,36 @@
 
 #include <builtin/alloc.h>
 
-#include <core/lily/interpreter/vm/value.h>
+#include <stddef.h>
+
+// The heap of the VM: the small objects (<=
+// LILY_INTERPRETER_MEMORY_MAX_SMALL_SIZE) are taken from slabs split into
+// blocks of the same size class (16, 32, 64, ..., 512 bytes), the large objects
+// are allocated one by one. The capacity is a hard limit on the bytes in use
+// (rounded to the size class), beyond it the VM crashes with an out of memory
+// error.
+#define LILY_INTERPRETER_MEMORY_MIN_BLOCK_SIZE 16
+#define LILY_INTERPRETER_MEMORY_MAX_SMALL_SIZE 512
+#define LILY_INTERPRETER_MEMORY_SIZE_CLASS_LEN 6
+// Number of blocks in a slab.
+#define LILY_INTERPRETER_MEMORY_SLAB_BLOCKS_LEN 64
+
+typedef struct LilyInterpreterMemoryBlock LilyInterpreterMemoryBlock;
+typedef struct LilyInterpreterMemorySlab LilyInterpreterMemorySlab;
+typedef struct LilyInterpreterMemoryLarge LilyInterpreterMemoryLarge;
 
 typedef struct LilyInterpreterMemory
 {
     Usize capacity;   // custom capacity or max capacity in bytes of the device
     Usize total_size; // total size allocated in bytes
     Usize total_size_free; // total size free in bytes
+    Usize peak_size;       // peak of the size in use in bytes
+    Usize alloc_count;
+    Usize free_count;
+    LilyInterpreterMemoryBlock
+      *free_blocks[LILY_INTERPRETER_MEMORY_SIZE_CLASS_LEN];
+    LilyInterpreterMemorySlab *slabs;   // LilyInterpreterMemorySlab*?
+    LilyInterpreterMemoryLarge *larges; // LilyInterpreterMemoryLarge*?
 } LilyInterpreterMemory;
 
 /**
@@ -52,7 +75,9 @@ inline VARIANT_CONSTRUCTOR(LilyInterpreterMemory,
                                                   ? __max_capacity__$Alloc()
                                                   : capacity,
                                     .total_size = 0,
-                                    .total_size_free = 0 };
+                                    .total_size_free = 0,
+                                    .slabs = NULL,
+                                    .larges = NULL };
 }
 
 /**
@@ -65,31 +90,83 @@ inline CONSTRUCTOR(LilyInterpreterMemory, LilyInterpreterMemory)
         .capacity = __max_capacity__$Alloc(),
         .total_size = 0,
         .total_size_free = 0,
+        .slabs = NULL,
+        .larges = NULL,
     };
 }
 
+/**
+ *
+ * @brief Get the size in use in bytes.
+ */
+inline Usize
+get_size__LilyInterpreterMemory(const LilyInterpreterMemory *self)
+{
+    return self->total_size - self->total_size_free;
+}
+
+/**
+ *
+ * @brief Set the memory used by the heap values of the current thread.
+ * @param self LilyInterpreterMemory*? (&)
+ * @return Return the previous memory.
+ */
+LilyInterpreterMemory *
+set_current__LilyInterpreterMemory(LilyInterpreterMemory *self);
+
+/**
+ *
+ * @brief Get the memory used by the heap values of the current thread.
+ * @return LilyInterpreterMemory*? (&)
+ */
+LilyInterpreterMemory *
+get_current__LilyInterpreterMemory();
+
 /**
  *
  * @brief Alloc memory from VM memory controller.
+ * @param self LilyInterpreterMemory*? (&)
+ * @note If self is NULL, the memory is allocated with `lily_malloc`.
+ * @note Crash with an out of memory error, if the capacity is exceeded.
  */
-LilyInterpreterValue
+void *
 alloc__LilyInterpreterMemory(LilyInterpreterMemory *self, Usize size);
 
 /**
  *
  * @brief Resize memory allocated from VM memory controller.
+ * @param self LilyInterpreterMemory*? (&)
+ * @param size The size passed to alloc (or to the last resize).
  */
-LilyInterpreterValue
+void *
 resize__LilyInterpreterMemory(LilyInterpreterMemory *self,
-                              LilyInterpreterValue *value,
+                              void *mem,
+                              Usize size,
                               Usize new_size);
 
 /**
  *
  * @brief Free memory allocated from VM memory controller.
+ * @param self LilyInterpreterMemory*? (&)
+ * @param size The size passed to alloc (or to the last resize).
  */
 void
 free__LilyInterpreterMemory(LilyInterpreterMemory *self,
-                            LilyInterpreterValue *value);
+                            void *mem,
+                            Usize size);
+
+/**
+ *
+ * @brief Print the statistics of the VM memory controller.
+ */
+void
+print_stats__LilyInterpreterMemory(const LilyInterpreterMemory *self);
+
+/**
+ *
+ * @brief Free LilyInterpreterMemory type (all the slabs and all the large
+ * objects are released).
+ */
+DESTRUCTOR(LilyInterpreterMemory, LilyInterpreterMemory *self);
 
 #endif // LILY_CORE_LILY_INTERPRETER_MEMORY_H
@@ -29,6 +29,9 @@
 
 #define RUNTIME_ERROR_COMMON(msg) \
     emit_runtime_error_common__LilyInterpreterRuntimeError(msg)
+#define RUNTIME_ERROR_OUT_OF_MEMORY(size, capacity)                \
+    emit_runtime_error_out_of_memory__LilyInterpreterRuntimeError( \
+      size, capacity)
 #define RUNTIME_ERROR_RAISE_EXCEPTION(raise_name, filename, line, column) \
     emit_runtime_error_raise_exception__LilyInterpreterRuntimeError(      \
       raise_name, filename, line, column)
@@ -42,6 +45,7 @@
 enum LilyInterpreterRuntimeError
 {
     LILY_INTERPRETER_RUNTIME_ERROR_COMMON,
+    LILY_INTERPRETER_RUNTIME_ERROR_OUT_OF_MEMORY,
     LILY_INTERPRETER_RUNTIME_ERROR_RAISE_EXCEPTION,
     LILY_INTERPRETER_RUNTIME_ERROR_STACK_EMPTY,
     LILY_INTERPRETER_RUNTIME_ERROR_STACK_OVERFLOW,
@@ -55,6 +59,16 @@ enum LilyInterpreterRuntimeError
 void
 emit_runtime_error_common__LilyInterpreterRuntimeError(const char *msg);
 
+/**
+ *
+ * @brief Emit runtime out of memory error.
+ * @param size The size of the failed allocation in bytes.
+ * @param capacity The capacity of the heap in bytes.
+ */
+void
+emit_runtime_error_out_of_memory__LilyInterpreterRuntimeError(Usize size,
+                                                              Usize capacity);
+
 /**
  *
  * @brief Emit runtime raise exception error.
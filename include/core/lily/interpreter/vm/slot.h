@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef LILY_CORE_LILY_INTERPRETER_VM_SLOT_H
+#define LILY_CORE_LILY_INTERPRETER_VM_SLOT_H
+
+#include <base/hash_map.h>
+#include <base/macros.h>
+#include <base/types.h>
+
+#include <core/lily/mir/mir.h>
+
+typedef struct LilyInterpreterVMSlot
+{
+    HashMap *regs; // HashMap<Usize (slot + 1)>*
+    HashMap *vars; // HashMap<Usize (slot + 1)>*
+    Usize len;
+} LilyInterpreterVMSlot;
+
+/**
+ *
+ * @brief Construct LilyInterpreterVMSlot type.
+ */
+CONSTRUCTOR(LilyInterpreterVMSlot, LilyInterpreterVMSlot);
+
+/**
+ *
+ * @brief Get the slot of the reg, or allocate a new slot if the reg has not
+ * yet been resolved.
+ */
+Usize
+get_reg__LilyInterpreterVMSlot(LilyInterpreterVMSlot *self, const char *name);
+
+/**
+ *
+ * @brief Get the slot of the var, or allocate a new slot if the var has not
+ * yet been resolved.
+ */
+Usize
+get_var__LilyInterpreterVMSlot(LilyInterpreterVMSlot *self, const char *name);
+
+/**
+ *
+ * @brief Resolve the slot of every reg and var of the module. Each function
+ * gets a dense index per reg and var name, so that the VM can access them with
+ * an index in a flat array, instead of hashing their name.
+ * @note This function must be called once before running the module.
+ */
+void
+resolve__LilyInterpreterVMSlot(const LilyMirModule *module);
+
+/**
+ *
+ * @brief Free LilyInterpreterVMSlot type.
+ */
+DESTRUCTOR(LilyInterpreterVMSlot, const LilyInterpreterVMSlot *self);
+
+#endif // LILY_CORE_LILY_INTERPRETER_VM_SLOT_H
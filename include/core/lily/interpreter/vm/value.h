@@ -52,7 +52,7 @@ typedef struct LilyInterpreterValue LilyInterpreterValue;
 // LilyInterpreterValueStruct, LilyInterpreterValueStr, when we have pseudo
 // generic support to the base library.
 
-enum LilyInterpreterValueKind
+enum LilyInterpreterValueKind : Uint8
 {
     LILY_INTERPRETER_VALUE_KIND_FALSE = 0,
     LILY_INTERPRETER_VALUE_KIND_TRUE = 1,
@@ -83,10 +83,13 @@ enum LilyInterpreterValueKind
     LILY_INTERPRETER_VALUE_KIND_UNIT,
 };
 
+// NOTE: The value is 16 bytes wide: the kind and the ref count share the
+// first word, the immediates and the pointers to the heap values (which
+// have their own ref count) are stored in the second one.
 struct LilyInterpreterValue
 {
     enum LilyInterpreterValueKind kind;
-    Usize ref_count;
+    Uint32 ref_count;
     union
     {
         struct LilyInterpreterValueBytes *bytes;
@@ -432,12 +435,17 @@ inline CONSTRUCTOR(LilyInterpreterValue,
  *
  * @brief Pass to ref a pointer of `LilyInterpreterValue` and increment
  * the `ref_count`.
+ * @note The `ref_count` saturates at UINT32_MAX, in that case the value is
+ * never freed.
  * @return LilyInterpreterValue*
  */
 inline LilyInterpreterValue *
 ref__LilyInterpreterValue(LilyInterpreterValue *self)
 {
-    ++self->ref_count;
+    if (self->ref_count < UINT32_MAX) {
+        ++self->ref_count;
+    }
+
     return self;
 }
 
@@ -464,11 +472,112 @@ minimal_free__LilyInterpreterValue(LilyInterpreterValue *self);
  */
 DESTRUCTOR(LilyInterpreterValue, LilyInterpreterValue *self);
 
-struct LilyInterpreterValueDynamicArray
+// The heap values which can contain other values (arrays, list, result and
+// struct) can be part of a cycle, so they are reclaimed by a cycle collector
+// (trial deletion). When the ref count of such a value is decremented without
+// reaching zero, the value is buffered as a possible root of a garbage cycle.
+// The buffered roots are scanned when there are too many of them or after a
+// number of allocations.
+enum LilyInterpreterValueColor : Uint8
+{
+    LILY_INTERPRETER_VALUE_COLOR_BLACK,   // in use
+    LILY_INTERPRETER_VALUE_COLOR_GRAY,    // possible member of a cycle
+    LILY_INTERPRETER_VALUE_COLOR_WHITE,   // member of a garbage cycle
+    LILY_INTERPRETER_VALUE_COLOR_PURPLE,  // possible root of a cycle
+    LILY_INTERPRETER_VALUE_COLOR_GARBAGE, // member of a cycle being freed
+};
+
+#define LILY_INTERPRETER_VALUE_OBJECT_NOT_BUFFERED SIZE_MAX
+// Max number of buffered roots before a collection.
+#define LILY_INTERPRETER_VALUE_COLLECTOR_MAX_ROOTS 1024
+// Number of allocated objects before a collection (if there are roots).
+#define LILY_INTERPRETER_VALUE_COLLECTOR_ALLOC_THRESHOLD 8192
+
+// NOTE: It's the first field of the heap values which can be part of a cycle.
+typedef struct LilyInterpreterValueObject
 {
     Usize ref_count;
-    LilyInterpreterValue *buffer;
+    Usize gc_ref_count; // ref count used during the trial deletion
+    Usize root_index;   // index in the roots or
+                        // LILY_INTERPRETER_VALUE_OBJECT_NOT_BUFFERED
+    enum LilyInterpreterValueKind kind;
+    enum LilyInterpreterValueColor color;
+} LilyInterpreterValueObject;
+
+/**
+ *
+ * @brief Construct LilyInterpreterValueObject type.
+ */
+inline CONSTRUCTOR(LilyInterpreterValueObject,
+                   LilyInterpreterValueObject,
+                   enum LilyInterpreterValueKind kind)
+{
+    return (LilyInterpreterValueObject){
+        .ref_count = 0,
+        .gc_ref_count = 0,
+        .root_index = LILY_INTERPRETER_VALUE_OBJECT_NOT_BUFFERED,
+        .kind = kind,
+        .color = LILY_INTERPRETER_VALUE_COLOR_BLACK
+    };
+}
+
+/**
+ *
+ * @brief Increment the `ref_count` of the object.
+ */
+inline void
+ref__LilyInterpreterValueObject(LilyInterpreterValueObject *self)
+{
+    ++self->ref_count;
+    self->color = LILY_INTERPRETER_VALUE_COLOR_BLACK;
+}
+
+typedef struct LilyInterpreterValueCollectorStats
+{
+    Usize collections;
+    Usize cycles;        // number of roots of garbage cycles
+    Usize objects_freed; // number of objects freed by the collector
+    Uint64 total_pause;  // in nanoseconds
+    Uint64 max_pause;    // in nanoseconds
+} LilyInterpreterValueCollectorStats;
+
+/**
+ *
+ * @brief Free the garbage cycles reachable from the buffered roots (of the
+ * current thread).
+ */
+void
+collect_cycles__LilyInterpreterValue();
+
+/**
+ *
+ * @brief Get the statistics of the cycle collector (of the current thread).
+ */
+const LilyInterpreterValueCollectorStats *
+get_collector_stats__LilyInterpreterValue();
+
+/**
+ *
+ * @brief Print the statistics of the cycle collector (of the current thread).
+ */
+void
+print_collector_stats__LilyInterpreterValue();
+
+/**
+ *
+ * @brief Free the buffered roots and reset the statistics of the cycle
+ * collector (of the current thread).
+ * @note The buffered objects are not freed.
+ */
+void
+free_collector__LilyInterpreterValue();
+
+struct LilyInterpreterValueDynamicArray
+{
+    LilyInterpreterValueObject object;
+    LilyInterpreterValue *buffer; // LilyInterpreterValue*?
     Usize len;
+    Usize capacity;
 };
 
 /**
@@ -478,6 +587,15 @@ struct LilyInterpreterValueDynamicArray
 CONSTRUCTOR(LilyInterpreterValueDynamicArray *,
             LilyInterpreterValueDynamicArray);
 
+/**
+ *
+ * @brief Push a value to the dynamic array.
+ * @note The buffer is grown in the memory of the running VM.
+ */
+void
+push__LilyInterpreterValueDynamicArray(LilyInterpreterValueDynamicArray *self,
+                                       LilyInterpreterValue value);
+
 /**
  *
  * @brief Get element at n from the dynamic array.
@@ -500,7 +618,7 @@ get__LilyInterpreterValueDynamicArray(
 inline LilyInterpreterValueDynamicArray *
 ref__LilyInterpreterValueDynamicArray(LilyInterpreterValueDynamicArray *self)
 {
-    ++self->ref_count;
+    ref__LilyInterpreterValueObject(&self->object);
     return self;
 }
 
@@ -513,7 +631,7 @@ DESTRUCTOR(LilyInterpreterValueDynamicArray,
 
 struct LilyInterpreterValueMultiPointersArray
 {
-    Usize ref_count;
+    LilyInterpreterValueObject object;
     LilyInterpreterValue *buffer;
     Usize len;
 };
@@ -548,7 +666,7 @@ inline LilyInterpreterValueMultiPointersArray *
 ref__LilyInterpreterValueMultiPointersArray(
   LilyInterpreterValueMultiPointersArray *self)
 {
-    ++self->ref_count;
+    ref__LilyInterpreterValueObject(&self->object);
     return self;
 }
 
@@ -561,7 +679,7 @@ DESTRUCTOR(LilyInterpreterValueMultiPointersArray,
 
 struct LilyInterpreterValueSizedArray
 {
-    Usize ref_count;
+    LilyInterpreterValueObject object;
     LilyInterpreterValue *buffer;
     Usize len;
 };
@@ -569,10 +687,11 @@ struct LilyInterpreterValueSizedArray
 /**
  *
  * @brief Construct LilyInterpreterValueSizedArray type.
+ * @note The values are copied in the memory of the running VM.
  */
 CONSTRUCTOR(LilyInterpreterValueSizedArray *,
             LilyInterpreterValueSizedArray,
-            LilyInterpreterValue *buffer,
+            const LilyInterpreterValue *values,
             Usize len);
 
 /**
@@ -596,7 +715,7 @@ get__LilyInterpreterValueSizedArray(const LilyInterpreterValueSizedArray *self,
 inline LilyInterpreterValueSizedArray *
 ref__LilyInterpreterValueSizedArray(LilyInterpreterValueSizedArray *self)
 {
-    ++self->ref_count;
+    ref__LilyInterpreterValueObject(&self->object);
     return self;
 }
 
@@ -610,17 +729,18 @@ DESTRUCTOR(LilyInterpreterValueSizedArray,
 struct LilyInterpreterValueBytes
 {
     Usize ref_count;
-    Uint8 *buffer;
+    Uint8 *buffer; // Uint8*?
     Usize len;
 };
 
 /**
  *
  * @brief Construct LilyInterpreterValueBytes type.
+ * @note The bytes are copied in the memory of the running VM.
  */
 CONSTRUCTOR(LilyInterpreterValueBytes *,
             LilyInterpreterValueBytes,
-            Uint8 *buffer,
+            const Uint8 *buffer,
             Usize len);
 
 /**
@@ -676,7 +796,7 @@ DESTRUCTOR(LilyInterpreterValueListNode, LilyInterpreterValueListNode *self);
 
 struct LilyInterpreterValueList
 {
-    Usize ref_count;
+    LilyInterpreterValueObject object;
     LilyInterpreterValueListNode *head;
     LilyInterpreterValueListNode *tail;
 };
@@ -700,7 +820,7 @@ CONSTRUCTOR(LilyInterpreterValueList *,
 inline LilyInterpreterValueList *
 ref__LilyInterpreterValueList(LilyInterpreterValueList *self)
 {
-    ++self->ref_count;
+    ref__LilyInterpreterValueObject(&self->object);
     return self;
 }
 
@@ -718,8 +838,8 @@ enum LilyInterpreterValueResultKind
 
 typedef struct LilyInterpreterValueResult
 {
+    LilyInterpreterValueObject object;
     enum LilyInterpreterValueResultKind kind;
-    Usize ref_count;
     union
     {
         LilyInterpreterValue ok;
@@ -757,7 +877,7 @@ VARIANT_CONSTRUCTOR(LilyInterpreterValueResult *,
 inline LilyInterpreterValueResult *
 ref__LilyInterpreterValueResult(LilyInterpreterValueResult *self)
 {
-    ++self->ref_count;
+    ref__LilyInterpreterValueObject(&self->object);
     return self;
 }
 
@@ -777,10 +897,12 @@ typedef struct LilyInterpreterValueStr
 /**
  *
  * @brief Construct LilyInterpreterValueStr type.
+ * @note The string is copied (with a null character) in the memory of the
+ * running VM.
  */
 CONSTRUCTOR(LilyInterpreterValueStr *,
             LilyInterpreterValueStr,
-            char *s,
+            const char *s,
             Usize len);
 
 /**
@@ -815,9 +937,9 @@ DESTRUCTOR(LilyInterpreterValueStr, LilyInterpreterValueStr *self);
 
 typedef struct LilyInterpreterValueStruct
 {
-    Usize ref_count;
-    LilyInterpreterValue values[MAX_RECORD_FIELDS];
+    LilyInterpreterValueObject object;
     Usize len;
+    LilyInterpreterValue values[]; // LilyInterpreterValue [len]
 } LilyInterpreterValueStruct;
 
 /**
@@ -846,7 +968,7 @@ get__LilyInterpreterValueStruct(LilyInterpreterValueStruct *self, Usize n);
 inline LilyInterpreterValueStruct *
 ref__LilyInterpreterValueStruct(LilyInterpreterValueStruct *self)
 {
-    ++self->ref_count;
+    ref__LilyInterpreterValueObject(&self->object);
     return self;
 }
 
@@ -32,6 +32,7 @@
 
 #include <builtin/alloc.h>
 
+#include <core/lily/interpreter/vm/bytecode.h>
 #include <core/lily/interpreter/vm/memory.h>
 #include <core/lily/interpreter/vm/value.h>
 #include <core/lily/mir/mir.h>
@@ -94,9 +95,8 @@ inline DESTRUCTOR(LilyInterpreterVMStackFrameReturn,
 
 typedef struct LilyInterpreterVMStackBlockFrame
 {
-    Vec *names;         // Vec<char* (&)>*
-    HashMap *variables; // HashMap<char* (&), LilyInterpreterValue* (&)>*
-    HashMap *regs;      // HashMap<char* (&), LilyInterpreterValue* (&)>*
+    Vec *names;                   // Vec<char* (&)>*
+    LilyInterpreterValue **slots; // LilyInterpreterValue*? (&) [slots_len]
     Usize begin; // index of the begin of the stack frame on the stack buffer
     Usize end;   // index of the end of the stack frame on the stack buffer, 0
                  // mean no next block stack frame
@@ -114,7 +114,8 @@ CONSTRUCTOR(LilyInterpreterVMStackBlockFrame *,
             char *name,
             Usize begin,
             Usize end,
-            Usize limit_id);
+            Usize limit_id,
+            Usize slots_len);
 
 /**
  *
@@ -127,42 +128,24 @@ add_name__LilyInterpreterVMStackBlockFrame(
 
 /**
  *
- * @brief Add reg.
+ * @brief Add reg or variable to its slot.
  */
 void
-add_reg__LilyInterpreterVMStackBlockFrame(
+add_slot__LilyInterpreterVMStackBlockFrame(
   const LilyInterpreterVMStackBlockFrame *self,
-  char *name,
+  Usize slot,
   LilyInterpreterValue *value);
 
 /**
  *
- * @brief Add variable.
- */
-void
-add_variable__LilyInterpreterVMStackBlockFrame(
-  const LilyInterpreterVMStackBlockFrame *self,
-  char *name,
-  LilyInterpreterValue *value);
-
-/**
- *
- * @brief Search reg and return the associated value.
- */
-LilyInterpreterValue *
-search_reg__LilyInterpreterVMStackBlockFrame(
-  const LilyInterpreterVMStackBlockFrame *self,
-  char *name);
-
-/**
- *
- * @brief Search variable (in the block frame) and return the associated value.
+ * @brief Search reg or variable (in the block frame) by its slot and return
+ * the associated value.
  * @note This function cannot find global variables, only local ones.
  */
 LilyInterpreterValue *
-search_variable__LilyInterpreterVMStackBlockFrame(
+search_slot__LilyInterpreterVMStackBlockFrame(
   const LilyInterpreterVMStackBlockFrame *self,
-  char *name);
+  Usize slot);
 
 /**
  *
@@ -174,8 +157,6 @@ DESTRUCTOR(LilyInterpreterVMStackBlockFrame,
 typedef struct LilyInterpreterVMStackFrame
 {
     const char *name; // const char* (&)
-    LilyInterpreterValue
-      *params[MAX_FUN_PARAMS]; // LilyInterpreterValue* (&) [MAX_FUN_PARAMS]
     Usize params_len;
     LilyInterpreterVMStackFrameReturn return_;
     Usize begin; // index of the begin of the stack frame on the stack buffer
@@ -183,13 +164,18 @@ typedef struct LilyInterpreterVMStackFrame
                  // mean no next stack frame
     Usize current_block_frame_limit_id;
     Usize block_frames_len;
+    Usize block_frames_capacity;
     LilyInterpreterVMStackBlockFrame **block_frames;
+    Usize slots_len; // number of slots of each block frame
     struct LilyInterpreterVMStackFrame *next; // LilyInterpreterVMStackFrame*?
+    Usize params_capacity;
+    LilyInterpreterValue *params[]; // LilyInterpreterValue* (&) [params_len]
 } LilyInterpreterVMStackFrame;
 
 /**
  *
  * @brief Construct LilyInterpreterVMStackFrame type.
+ * @note The frame is taken from the pool of the freed frames, if any.
  */
 CONSTRUCTOR(LilyInterpreterVMStackFrame *,
             LilyInterpreterVMStackFrame,
@@ -198,7 +184,8 @@ CONSTRUCTOR(LilyInterpreterVMStackFrame *,
             Usize params_len,
             Usize begin,
             Usize current_block_frame_limit_id,
-            Usize block_frames_len);
+            Usize block_frames_len,
+            Usize slots_len);
 
 /**
  *
@@ -212,7 +199,8 @@ attach_stack_frame__LilyInterpreterVMStackFrame(
   Usize params_len,
   Usize begin,
   Usize current_block_frame_limit_id,
-  Usize block_frames_len);
+  Usize block_frames_len,
+  Usize slots_len);
 
 /**
  *
@@ -226,10 +214,18 @@ add_block_frame__LilyInterpreterVMStackFrame(LilyInterpreterVMStackFrame *self,
 
 /**
  *
- * @brief Free LilyInterpreterVMStackFrame type.
+ * @brief Free LilyInterpreterVMStackFrame type (the frame is put back in the
+ * pool).
  */
 DESTRUCTOR(LilyInterpreterVMStackFrame, LilyInterpreterVMStackFrame **self);
 
+/**
+ *
+ * @brief Free the frames kept in the pool of the current thread.
+ */
+void
+free_frame_pool__LilyInterpreterVMStackFrame();
+
 typedef struct LilyInterpreterVMStack
 {
     // The bottom of the stack (before the first call frame) is used to store
@@ -237,7 +233,7 @@ typedef struct LilyInterpreterVMStack
     LilyInterpreterValue *buffer;
     LilyInterpreterVMStackFrame *current_frame; // LilyInterpreterVMStackFrame*?
     Usize len;
-    Usize max_capacity;
+    Usize max_capacity; // max number of values
 } LilyInterpreterVMStack;
 
 /**
@@ -328,6 +324,8 @@ typedef struct LilyInterpreterVM
     const LilyMirModule *module;           // const LilyMirModule* (&)
     const LilyMirInstruction *entry_point; // const LilyMirInstruction* (&)
                                            // main function
+    // LilyInterpreterVMBytecodeModule*? (NULL if the module can't be lowered)
+    LilyInterpreterVMBytecodeModule *bytecode;
     LilyInterpreterVMResources resources;
     // TODO: Maybe add VM config type
     bool check_overflow; // also check underflow
@@ -151,6 +151,8 @@ typedef struct LilyMirInstructionVal
     enum LilyMirInstructionValKind kind;
     LilyMirDt *dt;
     Usize ref_count;
+    Usize slot; // index of the reg or the var in the function frame (only
+                // used by reg and var value), resolved by the interpreter
     union
     {
         Vec *array;         // Vec<LilyMirInstructionVal*>*
@@ -674,6 +676,8 @@ typedef struct LilyMirInstructionBlock
     LilyMirBlockLimit *limit;
     Vec *insts; // Vec<LilyMirInstruction*>*
     Usize id;
+    LilyMirInstruction *inst; // LilyMirInstruction*? (&) block instruction of
+                              // the function, linked by the VM
 } LilyMirInstructionBlock;
 
 /**
@@ -687,7 +691,7 @@ inline CONSTRUCTOR(LilyMirInstructionBlock,
                    Usize id)
 {
     return (LilyMirInstructionBlock){
-        .name = name, .limit = limit, .insts = NEW(Vec), .id = id
+        .name = name, .limit = limit, .insts = NEW(Vec), .id = id, .inst = NULL
     };
 }
 
@@ -714,6 +718,8 @@ typedef struct LilyMirInstructionCall
     LilyMirDt *return_dt;
     const char *name; // const char* (&)
     Vec *params;      // Vec<LilyMirInstructionVal*>*
+    LilyMirInstruction *fun; // LilyMirInstruction*? (&) function called,
+                             // linked by the VM (NULL for a prototype)
 } LilyMirInstructionCall;
 
 /**
@@ -728,7 +734,8 @@ inline CONSTRUCTOR(LilyMirInstructionCall,
 {
     return (LilyMirInstructionCall){ .return_dt = return_dt,
                                      .name = name,
-                                     .params = params };
+                                     .params = params,
+                                     .fun = NULL };
 }
 
 /**
@@ -944,6 +951,8 @@ typedef struct LilyMirInstructionFun
     LilyMirScope *root_scope; // LilyMirScope* (&)
     LilyMirScope *scope;
     Usize block_count;
+    Usize slots_len; // number of regs and vars slots needed by the function
+                     // frame, resolved by the interpreter
 } LilyMirInstructionFun;
 
 /**
@@ -1188,6 +1197,8 @@ typedef struct LilyMirInstructionReg
 {
     const char *name;
     LilyMirInstruction *inst;
+    Usize slot; // index of the reg in the function frame, resolved by the
+                // interpreter
 } LilyMirInstructionReg;
 
 /**
@@ -1199,7 +1210,7 @@ inline CONSTRUCTOR(LilyMirInstructionReg,
                    const char *name,
                    LilyMirInstruction *inst)
 {
-    return (LilyMirInstructionReg){ .name = name, .inst = inst };
+    return (LilyMirInstructionReg){ .name = name, .inst = inst, .slot = 0 };
 }
 
 /**
@@ -1224,6 +1235,8 @@ typedef struct LilyMirInstructionVar
 {
     char *name;
     LilyMirInstruction *inst;
+    Usize slot; // index of the var in the function frame, resolved by the
+                // interpreter
 } LilyMirInstructionVar;
 
 /**
@@ -1235,7 +1248,7 @@ inline CONSTRUCTOR(LilyMirInstructionVar,
                    char *name,
                    LilyMirInstruction *inst)
 {
-    return (LilyMirInstructionVar){ .name = name, .inst = inst };
+    return (LilyMirInstructionVar){ .name = name, .inst = inst, .slot = 0 };
 }
 
 /**
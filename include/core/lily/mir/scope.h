@@ -25,6 +25,7 @@
 #ifndef LILY_CORE_LILY_MIR_SCOPE_H
 #define LILY_CORE_LILY_MIR_SCOPE_H
 
+#include <base/interner.h>
 #include <base/vec.h>
 
 #include <core/lily/analysis/checked/data_type.h>
@@ -54,7 +55,8 @@ inline DESTRUCTOR(LilyMirScopeParam, LilyMirScopeParam *self)
 
 typedef struct LilyMirScopeVar
 {
-    String *name;                   // String* (&)
+    String *name; // String* (&)
+    Symbol symbol;
     LilyCheckedDataType *data_type; // LilyCheckedDataType* (&)
 } LilyMirScopeVar;
 
@@ -65,6 +65,8 @@ typedef struct LilyPackageCompilerConfig
     bool o3;
     bool oz;
     bool verbose;
+    Usize jobs; // 0 means the number of online cores
+    bool cache_stats;
 } LilyPackageCompilerConfig;
 
 /**
@@ -94,7 +96,9 @@ CONSTRUCTOR(LilyPackageCompilerConfig,
             bool o2,
             bool o3,
             bool oz,
-            bool verbose);
+            bool verbose,
+            Usize jobs,
+            bool cache_stats);
 
 /**
  *
@@ -124,7 +128,9 @@ default__LilyPackageCompilerConfig()
                                         .o2 = false,
                                         .o3 = false,
                                         .oz = false,
-                                        .verbose = false };
+                                        .verbose = false,
+                                        .jobs = 0,
+                                        .cache_stats = false };
 }
 
 /**
@@ -155,7 +161,9 @@ from_CompileConfig__LilyPackageCompilerConfig(const LilycConfig *lilyc_config)
                lilyc_config->o2,
                lilyc_config->o3,
                lilyc_config->oz,
-               lilyc_config->verbose);
+               lilyc_config->verbose,
+               lilyc_config->jobs,
+               lilyc_config->cache_stats);
 }
 
 #endif // LILY_CORE_LILY_PACKAGE_COMPILER_CONFIG_H
@@ -36,6 +36,7 @@ typedef struct LilyPackageInterpreterConfig
     bool verbose;
     Usize max_heap;
     Usize max_stack;
+    Usize jobs; // 0 means the number of online cores
 } LilyPackageInterpreterConfig;
 
 /**
@@ -47,12 +48,14 @@ inline CONSTRUCTOR(LilyPackageInterpreterConfig,
                    Vec *args,
                    bool verbose,
                    Usize max_heap,
-                   Usize max_stack)
+                   Usize max_stack,
+                   Usize jobs)
 {
     return (LilyPackageInterpreterConfig){ .args = args,
                                            .verbose = verbose,
                                            .max_heap = max_heap,
-                                           .max_stack = max_stack };
+                                           .max_stack = max_stack,
+                                           .jobs = jobs };
 }
 
 /**
@@ -62,9 +65,11 @@ inline CONSTRUCTOR(LilyPackageInterpreterConfig,
 inline LilyPackageInterpreterConfig
 default__LilyPackageInterpreterConfig()
 {
-    return (LilyPackageInterpreterConfig){
-        .args = NULL, .verbose = false, .max_heap = 0, .max_stack = 0
-    };
+    return (LilyPackageInterpreterConfig){ .args = NULL,
+                                           .verbose = false,
+                                           .max_heap = 0,
+                                           .max_stack = 0,
+                                           .jobs = 0 };
 }
 
 /**
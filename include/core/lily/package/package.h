@@ -77,11 +77,12 @@
     In a normal case where we wanted to add an operator to the register, we'd \
     use `add_operator__LilyCheckedOperatorRegister`, but in this case it's    \
     guaranteed that no operator repeats itself, so to increase loading speed  \
-    we'll add it directly to the vector without checking. */                  \
+    we'll push it directly to the register without checking. */               \
     for (Usize i = 0; i < DEFAULT_OPERATORS_COUNT; ++i) {                     \
-        push__Vec(root_package->operator_register.operators,                  \
-                  ref__LilyCheckedOperator(                                   \
-                    root_package->program->resources.default_operators[i]));  \
+        push_operator__LilyCheckedOperatorRegister(                           \
+          &root_package->operator_register,                                   \
+          ref__LilyCheckedOperator(                                           \
+            root_package->program->resources.default_operators[i]));          \
     }
 
 enum LilyPackageStatus
@@ -0,0 +1,119 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LILY_CORE_LILY_PACKAGE_SCHEDULER_H
+#define LILY_CORE_LILY_PACKAGE_SCHEDULER_H
+
+#include <base/hash_map.h>
+#include <base/macros.h>
+#include <base/types.h>
+#include <base/vec.h>
+
+#include <core/lily/package/dependency_tree.h>
+
+#include <pthread.h>
+
+// NOTE: The scheduler runs the packages of the dependency trees on a fixed
+// number of workers. A package is ready when its parent in the tree and all
+// its dependencies are done. Each worker owns a queue of ready packages: it
+// pushes the packages unlocked by its own work at the back, pops at the back
+// and steals at the front of the queues of the other workers when its own
+// queue is empty. Idle workers wait on a condition variable.
+
+typedef struct LilyPackageScheduler LilyPackageScheduler;
+
+typedef struct LilyPackageSchedulerTask
+{
+    LilyPackageDependencyTree *tree; // LilyPackageDependencyTree* (&)
+    Vec *successors;                 // Vec<LilyPackageSchedulerTask* (&)>*
+    Usize pending;                   // number of predecessors not done yet
+} LilyPackageSchedulerTask;
+
+/**
+ *
+ * @brief Construct LilyPackageSchedulerTask type.
+ */
+CONSTRUCTOR(LilyPackageSchedulerTask *,
+            LilyPackageSchedulerTask,
+            LilyPackageDependencyTree *tree);
+
+/**
+ *
+ * @brief Free LilyPackageSchedulerTask type.
+ */
+DESTRUCTOR(LilyPackageSchedulerTask, LilyPackageSchedulerTask *self);
+
+typedef struct LilyPackageSchedulerWorker
+{
+    LilyPackageScheduler *scheduler; // LilyPackageScheduler* (&)
+    Vec *ready;                      // Vec<LilyPackageSchedulerTask* (&)>*
+    pthread_mutex_t ready_mutex;
+    pthread_t thread;
+    Usize id;
+} LilyPackageSchedulerWorker;
+
+typedef struct LilyPackageScheduler
+{
+    Vec *tasks; // Vec<LilyPackageSchedulerTask*>*
+    // NOTE: The packages are identified by their name in the dependency trees
+    // (see `is_added__LilyPackageDependencyTree`).
+    HashMap *tasks_by_name; // HashMap<LilyPackageSchedulerTask* (&)>*
+    LilyPackageSchedulerWorker *workers;
+    Usize workers_len;
+    void (*run)(LilyPackageDependencyTree *tree);
+    // The following fields are protected by `mutex`.
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    Usize ready_len;     // number of ready tasks not yet claimed by a worker
+    Usize remaining_len; // number of tasks not done yet
+} LilyPackageScheduler;
+
+/**
+ *
+ * @brief Construct LilyPackageScheduler type.
+ * @param trees Vec<LilyPackageDependencyTree*>* (&)
+ * @param jobs Number of workers (if 0, the number of online cores is used).
+ * @param run Function called on each package of the dependency trees.
+ */
+CONSTRUCTOR(LilyPackageScheduler *,
+            LilyPackageScheduler,
+            const Vec *trees,
+            Usize jobs,
+            void (*run)(LilyPackageDependencyTree *tree));
+
+/**
+ *
+ * @brief Run all the packages of the scheduler and wait until they are all
+ * done.
+ */
+void
+run__LilyPackageScheduler(LilyPackageScheduler *self);
+
+/**
+ *
+ * @brief Free LilyPackageScheduler type.
+ */
+DESTRUCTOR(LilyPackageScheduler, LilyPackageScheduler *self);
+
+#endif // LILY_CORE_LILY_PACKAGE_SCHEDULER_H
@@ -26,6 +26,7 @@
 #define LILY_CORE_LILY_SCANNER_H
 
 #include <base/format.h>
+#include <base/memory/arena_chain.h>
 #include <base/new.h>
 #include <base/vec.h>
 
@@ -33,10 +34,15 @@
 #include <core/shared/diagnostic.h>
 #include <core/shared/scanner.h>
 
+#define LILY_SCANNER_TOKEN_ARENA_CAPACITY 65536
+
 typedef struct LilyScanner
 {
     Vec *tokens; // Vec<LilyToken*>*
     Scanner base;
+    // The tokens of the file are allocated in this arena, so they are released
+    // all at once with the scanner.
+    MemoryArenaChain token_arena;
 } LilyScanner;
 
 /**
@@ -45,10 +51,28 @@ typedef struct LilyScanner
  */
 inline CONSTRUCTOR(LilyScanner, LilyScanner, Source source, Usize *count_error)
 {
-    return (LilyScanner){ .tokens = NEW(Vec),
-                          .base = NEW(Scanner, source, count_error) };
+    return (LilyScanner){
+        .tokens = NEW(Vec),
+        .base = NEW(Scanner, source, count_error),
+        .token_arena =
+          NEW(MemoryArenaChain, LILY_SCANNER_TOKEN_ARENA_CAPACITY),
+    };
 }
 
+/**
+ *
+ * @brief Get the perfect hash table of keywords.
+ */
+const SearchPerfectHash *
+get_keywords_hash__LilyScanner();
+
+/**
+ *
+ * @brief Get the perfect hash table of at keywords (e.g. @builtin).
+ */
+const SearchPerfectHash *
+get_at_keywords_hash__LilyScanner();
+
 /**
  *
  * @brief Run the scanner.
@@ -25,7 +25,9 @@
 #ifndef LILY_CORE_LILY_SCANNER_TOKEN_H
 #define LILY_CORE_LILY_SCANNER_TOKEN_H
 
+#include <base/interner.h>
 #include <base/macros.h>
+#include <base/memory/arena_chain.h>
 #include <base/string.h>
 #include <base/types.h>
 #include <base/vec.h>
@@ -259,6 +261,10 @@ typedef struct LilyToken
 {
     enum LilyTokenKind kind;
     Location location;
+    Symbol symbol; // Symbol of the identifier (SYMBOL_NONE if it's not an
+                   // identifier token)
+    bool is_in_arena; // true if the token is allocated in the arena of a
+                      // scanner (see `set_arena__LilyToken`)
     union
     {
 #ifdef ENV_DEBUG
@@ -642,6 +648,18 @@ void
 IMPL_FOR_DEBUG(debug, LilyToken, const LilyToken *self);
 #endif
 
+/**
+ *
+ * @brief Set the arena in which the tokens constructed by the current thread
+ * are allocated.
+ * @param arena MemoryArenaChain*? (&)
+ * @return Return the previous arena of the current thread.
+ * @note The memory of a token allocated in an arena is released by the arena,
+ * so the arena must outlive the token.
+ */
+MemoryArenaChain *
+set_arena__LilyToken(MemoryArenaChain *arena);
+
 /**
  *
  * @brief Clone LilyToken.
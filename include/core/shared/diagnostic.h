@@ -44,6 +44,12 @@
 
 #include <stdlib.h>
 
+enum DiagnosticFormat
+{
+    DIAGNOSTIC_FORMAT_HUMAN,
+    DIAGNOSTIC_FORMAT_JSON
+};
+
 enum DiagnosticLevelKind
 {
     DIAGNOSTIC_LEVEL_KIND_CC_ERROR,
@@ -236,10 +242,12 @@ inline VARIANT_CONSTRUCTOR(DiagnosticLevel,
                               .lily_warning = lily_warning };
 }
 
+// NOTE: The lines of the detail are only read in the file when the diagnostic
+// is emitted.
 typedef struct DiagnosticDetail
 {
-    Vec *lines;  // Vec<char*>*
-    String *msg; // String*?
+    const File *file; // const File* (&)
+    String *msg;      // String*?
     const Location *location;
 } DiagnosticDetail;
 
@@ -249,12 +257,12 @@ typedef struct DiagnosticDetail
  */
 inline CONSTRUCTOR(DiagnosticDetail,
                    DiagnosticDetail,
-                   Vec *lines,
+                   const File *file,
                    String *msg,
                    const Location *location)
 {
     return (
-      DiagnosticDetail){ .lines = lines, .msg = msg, .location = location };
+      DiagnosticDetail){ .file = file, .msg = msg, .location = location };
 }
 
 typedef struct DiagnosticLevelUtil
@@ -696,4 +704,14 @@ emit_note__Diagnostic(Diagnostic self);
 void
 emit__Diagnostic(Diagnostic self, Usize *count_error);
 
+/**
+ *
+ * @brief Set the format of the emitted diagnostics (by default
+ * DIAGNOSTIC_FORMAT_HUMAN).
+ * @note With DIAGNOSTIC_FORMAT_JSON, each diagnostic is emitted on one line as
+ * a JSON object (JSON lines).
+ */
+void
+set_format__Diagnostic(enum DiagnosticFormat format);
+
 #endif // LILY_CORE_SHARED_DIAGNOSTIC_H
@@ -38,26 +38,46 @@ typedef struct File
     char *name;
     char *content;
     Usize len; // length of the content
+    // Position of the first character of each line.
+    Usize *line_starts; // Usize*?
+    Usize line_starts_len;
 } File;
 
 /**
  *
  * @brief Construct File type.
+ * @note The position of the start of each line is computed once, so the lines
+ * can be found without scanning the content again.
  */
-inline CONSTRUCTOR(File, File, char *name, char *content)
-{
-    return (File){ .name = name,
-                   .content = content,
-                   .len = get_size__File(name) + 1 };
-}
+CONSTRUCTOR(File, File, char *name, char *content);
+
+/**
+ *
+ * @brief Get the line (starting at 1) containing the position (binary search).
+ */
+Usize
+get_line__File(const File *self, Usize position);
+
+/**
+ *
+ * @brief Get the position of the first character of the line (starting at
+ * 1).
+ */
+Usize
+get_line_start__File(const File *self, Usize line);
+
+/**
+ *
+ * @brief Get the position of the end of the line (starting at 1), the newline
+ * character is not included.
+ */
+Usize
+get_line_end__File(const File *self, Usize line);
 
 /**
  *
  * @brief Free File type.
  */
-inline DESTRUCTOR(File, const File *self)
-{
-    lily_free(self->content);
-}
+DESTRUCTOR(File, const File *self);
 
 #endif // LILY_CORE_SHARED_FILE_H
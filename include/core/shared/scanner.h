@@ -118,6 +118,41 @@ skip_space_except_new_line__Scanner(Scanner *self);
 void
 jump__Scanner(Scanner *self, Usize n);
 
+/**
+ *
+ * @brief Skip all characters until the next new line (the new line is not
+ * skipped).
+ */
+void
+skip_line__Scanner(Scanner *self);
+
+/**
+ *
+ * @brief Skip all characters of the comment block until its end (a `*`
+ * followed by a `/`), or until the end of the file if the comment block is not
+ * closed.
+ */
+void
+skip_comment_block__Scanner(Scanner *self);
+
+/**
+ *
+ * @brief Append the run of identifier characters ([a-zA-Z0-9_]) starting at
+ * the current character to `res`, and move after it.
+ * @param with_dollar If it's true, `$` is also an identifier character.
+ */
+void
+scan_ident_chars__Scanner(Scanner *self, String *res, bool with_dollar);
+
+/**
+ *
+ * @brief Append the run of string literal characters (until the next `"`, `\`
+ * or the end of the file) starting at the current character to `res`, and move
+ * after it.
+ */
+void
+scan_string_chars__Scanner(Scanner *self, String *res);
+
 /**
  *
  * @brief Assign to line and column to start_line and start_column Location's
@@ -151,17 +186,14 @@ peek_char__Scanner(const Scanner *self, const Usize n);
 /**
  *
  * @brief Generic function for obtaining a keyword from any scanner.
- * @param keywords Expect an array sorted in ascending order.
+ * @param keywords Perfect hash table built over the keywords of the scanner.
  * @return If the return value is -1, this means that the function has not found
  * a keyword, or that this is an identifier.
  */
 inline Int32
-get_keyword__Scanner(const String *id,
-                     const SizedStr keywords[],
-                     const Int32 keyword_ids[],
-                     const Usize keywords_len)
+get_keyword__Scanner(const String *id, const SearchPerfectHash *keywords)
 {
-    return get_id__Search(id, keywords, keyword_ids, keywords_len);
+    return get_id__SearchPerfectHash(keywords, id);
 }
 
 #endif // LILY_CORE_SHARED_SCANNER_H
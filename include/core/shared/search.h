@@ -25,10 +25,23 @@
 #ifndef LILY_CORE_SHARED_SEARCH_H
 #define LILY_CORE_SHARED_SEARCH_H
 
+#include <base/macros.h>
+#include <base/new.h>
 #include <base/sized_str.h>
 #include <base/string.h>
 #include <base/types.h>
 
+// NOTE: The index of the slot is stored on 8 bits, so a table cannot hold more
+// than 255 ids.
+#define SEARCH_PERFECT_HASH_MAX_CAPACITY 256
+
+// NOTE: The displacement of a bucket is stored on 8 bits, and each bucket
+// holds about four ids on average.
+#define SEARCH_PERFECT_HASH_MAX_BUCKETS 64
+
+// Maximum number of seeds tried for each capacity before doubling it.
+#define SEARCH_PERFECT_HASH_MAX_SEED_TRIES 64
+
 /**
  *
  * @brief Generic function to search id from available ids.
@@ -42,4 +55,44 @@ get_id__Search(const String *id,
                const Int32 ids[],
                const Usize ids_s_len);
 
+/**
+ *
+ * @brief Collision-free hash table built over a fixed set of ids (e.g.
+ * keywords), so that a lookup costs one hash, one slot load and one memcmp.
+ * The whole id is hashed, then the ids are split into buckets and each bucket
+ * gets a displacement that moves all its ids to free slots (hash and displace).
+ */
+typedef struct SearchPerfectHash
+{
+    const SizedStr *ids_s;
+    const Int32 *ids;
+    Usize ids_s_len;
+    Uint64 seed;
+    Uint32 capacity_mask;
+    Uint32 buckets_mask;
+    bool is_perfect; // false if no seed was found (fallback to get_id__Search)
+    Uint8 displacements[SEARCH_PERFECT_HASH_MAX_BUCKETS];
+    Uint8 slots[SEARCH_PERFECT_HASH_MAX_CAPACITY]; // index + 1, 0 = empty
+} SearchPerfectHash;
+
+/**
+ *
+ * @brief Construct SearchPerfectHash type.
+ * @param ids_s The same array that is passed to get_id__Search.
+ */
+CONSTRUCTOR(SearchPerfectHash,
+            SearchPerfectHash,
+            const SizedStr ids_s[],
+            const Int32 ids[],
+            const Usize ids_s_len);
+
+/**
+ *
+ * @brief Search id from the perfect hash table.
+ * @return If the return value is -1, this means that the function has not found
+ * the id.
+ */
+Int32
+get_id__SearchPerfectHash(const SearchPerfectHash *self, const String *id);
+
 #endif // LILY_CORE_SHARED_SEARCH_H
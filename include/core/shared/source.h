@@ -52,6 +52,14 @@ inline CONSTRUCTOR(Source, Source, Cursor cursor, const File *file)
 void
 next_char__Source(Source *self);
 
+/**
+ *
+ * @brief Move next n characters at once. The line and the column are computed
+ * from the new lines of the skipped characters.
+ */
+void
+advance__Source(Source *self, Usize n);
+
 /**
  *
  * @brief Move back one character.
@@ -0,0 +1,88 @@
+#!/usr/bin/env bash
+
+# ./scripts/bench_interpreter.sh <baseline lily> <lily> [runs]
+#
+# Brief: This script compares the run time of the interpreter (`lily run`) of
+# two `lily` executables (e.g. built before and after a change in the VM), on
+# the programs of `./benchmarks/interpreter`. For each program, the best time
+# of all runs is kept. The peak resident memory of each program is also
+# measured, when GNU time is available (`/usr/bin/time`). The results are also
+# written in `bench_output.txt`.
+
+set -e
+set -o pipefail
+
+BENCH_DIR=./benchmarks/interpreter
+OUTPUT=./bench_output.txt
+RUNS=${3:-5}
+
+if [ $# -lt 2 ]
+then
+	echo "Usage: ./scripts/bench_interpreter.sh <baseline lily> <lily> [runs]"
+	exit 1
+fi
+
+BASELINE=$1
+CANDIDATE=$2
+
+# Same as `./scripts/exe.sh`.
+export LD_LIBRARY_PATH="$LD_LIBRARY_PATH:build:build/Debug"
+
+# Peak resident memory is only measured with GNU time (the `time` keyword of
+# bash doesn't report it).
+if [ -x /usr/bin/time ] && /usr/bin/time -f %M true > /dev/null 2>&1
+then
+	GNU_TIME=/usr/bin/time
+	RSS_FILE=$(mktemp)
+	trap "rm -f $RSS_FILE" EXIT
+fi
+
+# $1: lily executable
+# $2: program
+function best_time {
+	local best=""
+
+	for ((i = 0; i < $RUNS; ++i))
+	do
+		local start=$(date +%s%N)
+
+		$1 run $2 > /dev/null
+
+		local end=$(date +%s%N)
+		local elapsed=$((($end - $start) / 1000000))
+
+		if [ -z "$best" ] || [ $elapsed -lt $best ]
+		then
+			best=$elapsed
+		fi
+	done
+
+	echo $best
+}
+
+# $1: lily executable
+# $2: program
+function max_rss {
+	if [ -z "$GNU_TIME" ]
+	then
+		echo "n/a"
+		return
+	fi
+
+	$GNU_TIME -f %M -o $RSS_FILE $1 run $2 > /dev/null
+
+	cat $RSS_FILE
+}
+
+printf "%-30s %14s %14s %9s %15s %15s\n" "program" "baseline (ms)" "lily (ms)" "speedup" "baseline (KiB)" "lily (KiB)" | tee $OUTPUT
+
+for program in $BENCH_DIR/*.lily
+do
+	baseline_time=$(best_time $BASELINE $program)
+	candidate_time=$(best_time $CANDIDATE $program)
+	speedup=$(awk "BEGIN { printf \"%.2fx\", $baseline_time / ($candidate_time ? $candidate_time : 1) }")
+	baseline_rss=$(max_rss $BASELINE $program)
+	candidate_rss=$(max_rss $CANDIDATE $program)
+
+	printf "%-30s %14s %14s %9s %15s %15s\n" $(basename $program) $baseline_time $candidate_time $speedup $baseline_rss $candidate_rss | tee -a $OUTPUT
+done
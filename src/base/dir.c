@@ -200,6 +200,34 @@ get_files_rec__Dir(const char *path)
 
     return NULL;
 }
+
+Vec *
+get_entries__Dir(const char *path)
+{
+    char current_path[PATH_MAX];
+
+    sprintf(current_path, "%s\\%s", path, "*");
+
+    WIN32_FIND_DATA find_file_data;
+    HANDLE h_find_file = FindFirstFile(current_path, &find_file_data);
+
+    if (h_find_file != INVALID_HANDLE_VALUE) {
+        Vec *res = NEW(Vec); // Vec<String*>*
+
+        do {
+            if (strcmp(find_file_data.cFileName, ".") != 0 &&
+                strcmp(find_file_data.cFileName, "..") != 0) {
+                push__Vec(res, from__String(find_file_data.cFileName));
+            }
+        } while (FindNextFile(h_find_file, &find_file_data) != 0);
+
+        FindClose(h_find_file);
+
+        return res;
+    }
+
+    return NULL;
+}
 #else
 Vec *
 get_files_rec__Dir(const char *path)
@@ -242,4 +270,27 @@ get_files_rec__Dir(const char *path)
 
     return res;
 }
+
+Vec *
+get_entries__Dir(const char *path)
+{
+    DIR *dir = opendir(path);
+
+    if (!dir) {
+        return NULL;
+    }
+
+    struct dirent *dp;
+    Vec *res = NEW(Vec);
+
+    while ((dp = readdir(dir))) {
+        if (strcmp(dp->d_name, ".") != 0 && strcmp(dp->d_name, "..") != 0) {
+            push__Vec(res, from__String(dp->d_name));
+        }
+    }
+
+    closedir(dir);
+
+    return res;
+}
 #endif
@@ -199,6 +199,18 @@ get_size__File(const char *path)
     return st.st_size;
 }
 
+Int64
+get_mtime__File(const char *path)
+{
+    struct __stat__ st;
+
+    if (__stat__(path, &st)) {
+        return -1;
+    }
+
+    return st.st_mtime;
+}
+
 #ifdef LILY_WINDOWS_OS
 char *
 read_file__File(const char *path)
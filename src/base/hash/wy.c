@@ -0,0 +1,164 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/hash/wy.h>
+
+#include <string.h>
+
+#define WY_P0 0xa0761d6478bd642fULL
+#define WY_P1 0xe7037ed1a0b428dbULL
+#define WY_P2 0x8ebc6af09c88c6e3ULL
+#define WY_P3 0x589965cc75374cc3ULL
+
+/**
+ *
+ * @brief Multiply a and b, then fold the high 64 bits of the 128-bit product
+ * into the low 64 bits.
+ */
+static inline Uint64
+mum__WyHash(Uint64 a, Uint64 b);
+
+/**
+ *
+ * @brief Read 8 bytes (unaligned).
+ */
+static inline Uint64
+read8__WyHash(const Uint8 *p);
+
+/**
+ *
+ * @brief Read 4 bytes (unaligned).
+ */
+static inline Uint64
+read4__WyHash(const Uint8 *p);
+
+/**
+ *
+ * @brief Read 1 to 3 bytes.
+ */
+static inline Uint64
+read3__WyHash(const Uint8 *p, Usize k);
+
+Uint64
+mum__WyHash(Uint64 a, Uint64 b)
+{
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = (__uint128_t)a * b;
+
+    return (Uint64)r ^ (Uint64)(r >> 64);
+#else
+    Uint64 ha = a >> 32, hb = b >> 32, la = (Uint32)a, lb = (Uint32)b;
+    Uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    Uint64 t = rl + (rm0 << 32);
+    Uint64 c = t < rl;
+    Uint64 lo = t + (rm1 << 32);
+
+    c += lo < t;
+
+    return lo ^ (rh + (rm0 >> 32) + (rm1 >> 32) + c);
+#endif
+}
+
+Uint64
+read8__WyHash(const Uint8 *p)
+{
+    Uint64 v;
+
+    memcpy(&v, p, 8);
+
+    return v;
+}
+
+Uint64
+read4__WyHash(const Uint8 *p)
+{
+    Uint32 v;
+
+    memcpy(&v, p, 4);
+
+    return v;
+}
+
+Uint64
+read3__WyHash(const Uint8 *p, Usize k)
+{
+    return (((Uint64)p[0]) << 16) | (((Uint64)p[k >> 1]) << 8) | p[k - 1];
+}
+
+Uint64
+hash_wy(const void *key, Usize key_len, Uint64 seed)
+{
+    const Uint8 *p = key;
+    Uint64 a = 0;
+    Uint64 b_ = 0;
+
+    seed ^= mum__WyHash(seed ^ WY_P0, WY_P1);
+
+    if (key_len <= 16) {
+        if (key_len >= 4) {
+            Usize shift = (key_len >> 3) << 2;
+
+            a = (read4__WyHash(p) << 32) | read4__WyHash(p + shift);
+            b_ = (read4__WyHash(p + key_len - 4) << 32) |
+                 read4__WyHash(p + key_len - 4 - shift);
+        } else if (key_len > 0) {
+            a = read3__WyHash(p, key_len);
+        }
+    } else {
+        Usize i = key_len;
+
+        if (i > 48) {
+            Uint64 see1 = seed;
+            Uint64 see2 = seed;
+
+            do {
+                seed = mum__WyHash(read8__WyHash(p) ^ WY_P1,
+                                   read8__WyHash(p + 8) ^ seed);
+                see1 = mum__WyHash(read8__WyHash(p + 16) ^ WY_P2,
+                                   read8__WyHash(p + 24) ^ see1);
+                see2 = mum__WyHash(read8__WyHash(p + 32) ^ WY_P3,
+                                   read8__WyHash(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+
+            seed ^= see1 ^ see2;
+        }
+
+        while (i > 16) {
+            seed = mum__WyHash(read8__WyHash(p) ^ WY_P1,
+                               read8__WyHash(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        a = read8__WyHash(p + i - 16);
+        b_ = read8__WyHash(p + i - 8);
+    }
+
+    a ^= WY_P1;
+    b_ ^= seed;
+
+    return mum__WyHash(WY_P1 ^ key_len, mum__WyHash(a, b_));
+}
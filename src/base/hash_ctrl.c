@@ -0,0 +1,94 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/hash_ctrl.h>
+
+#include <string.h>
+
+Int8 *
+new__HashCtrl(Usize capacity)
+{
+    Int8 *ctrls = lily_malloc(capacity + HASH_CTRL_GROUP_WIDTH);
+
+    memset(ctrls, HASH_CTRL_EMPTY, capacity + HASH_CTRL_GROUP_WIDTH);
+
+    return ctrls;
+}
+
+Usize
+find_insert_slot__HashCtrl(const Int8 *ctrls, Usize capacity, Usize hash)
+{
+    HashCtrlProbe probe = NEW(HashCtrlProbe, hash, capacity);
+
+    for (;;) {
+        HashCtrlMask mask =
+          match_empty_or_deleted__HashCtrl(ctrls + probe.pos);
+
+        if (mask) {
+            return (probe.pos + next__HashCtrlMask(&mask)) & probe.mask;
+        }
+
+        next__HashCtrlProbe(&probe);
+    }
+}
+
+bool
+erase__HashCtrl(Int8 *ctrls, Usize capacity, Usize index)
+{
+    Usize index_before = (index - HASH_CTRL_GROUP_WIDTH) & (capacity - 1);
+    HashCtrlMask empty_after = match_empty__HashCtrl(ctrls + index);
+    HashCtrlMask empty_before = match_empty__HashCtrl(ctrls + index_before);
+
+    // If the run of non-empty slots around index is shorter than a group, no
+    // probe sequence has ever seen a full group here, so the slot can become
+    // empty again.
+    bool was_never_full =
+      empty_after && empty_before &&
+      (Usize)__builtin_ctz(empty_after) +
+          (Usize)__builtin_clz(empty_before << (32 - HASH_CTRL_GROUP_WIDTH)) <
+        HASH_CTRL_GROUP_WIDTH;
+
+    set__HashCtrl(ctrls,
+                  capacity,
+                  index,
+                  was_never_full ? HASH_CTRL_EMPTY : HASH_CTRL_DELETED);
+
+    return was_never_full;
+}
+
+Usize
+grow__HashCtrl(Usize len, Usize capacity)
+{
+    if (capacity == 0) {
+        return HASH_CTRL_MIN_CAPACITY;
+    }
+
+    // Most of the slots are tombstones: rehash in place.
+    if (len * 2 < HASH_CTRL_MAX_LOAD(capacity)) {
+        return capacity;
+    }
+
+    return capacity * 2;
+}
@@ -27,147 +27,137 @@
 
 #include <stdlib.h>
 
-static const HashMapBucket *
-get_bucket__HashMapBucket(const HashMapBucket *self, char *key);
+/**
+ *
+ * @brief Find the slot of the key.
+ * @return HashMapSlot*? (&)
+ */
+static HashMapSlot *
+find_slot__HashMap(const HashMap *self, char *key, Usize hash);
 
-static void *
-push_bucket__HashMap(HashMap *self, Usize index, HashMapBucket *new);
+/**
+ *
+ * @brief Rehash all the pairs into a table of the given capacity.
+ */
+static void
+resize__HashMap(HashMap *self, Usize capacity);
 
-CONSTRUCTOR(HashMapBucket *, HashMapBucket, HashMapPair pair)
+CONSTRUCTOR(HashMap *, HashMap)
 {
-    HashMapBucket *self = lily_malloc(sizeof(HashMapBucket));
+    HashMap *self = lily_malloc(sizeof(HashMap));
 
-    self->pair = pair;
-    self->next = NULL;
+    self->ctrls = NULL;
+    self->slots = NULL;
+    self->len = 0;
+    self->capacity = 0;
+    self->growth_left = 0;
 
     return self;
 }
 
-DESTRUCTOR(HashMapBucket, HashMapBucket *self)
+HashMapSlot *
+find_slot__HashMap(const HashMap *self, char *key, Usize hash)
 {
-    if (self->next) {
-        FREE(HashMapBucket, self->next);
-    }
+    HashCtrlProbe probe = NEW(HashCtrlProbe, hash, self->capacity);
+    Int8 h2 = h2__HashCtrl(hash);
 
-    lily_free(self);
-}
+    for (;;) {
+        const Int8 *group = self->ctrls + probe.pos;
+        HashCtrlMask mask = match__HashCtrl(group, h2);
 
-CONSTRUCTOR(HashMap *, HashMap)
-{
-    HashMap *self = lily_malloc(sizeof(HashMap));
+        while (mask) {
+            HashMapSlot *slot =
+              &self->slots[(probe.pos + next__HashCtrlMask(&mask)) &
+                           probe.mask];
 
-    self->buckets = NULL;
-    self->len = 0;
-    self->capacity = DEFAULT_HASH_MAP_CAPACITY;
+            if (slot->hash == hash && !strcmp(slot->pair.key, key)) {
+                return slot;
+            }
+        }
 
-    return self;
-}
+        if (match_empty__HashCtrl(group)) {
+            return NULL;
+        }
 
-const HashMapBucket *
-get_bucket__HashMapBucket(const HashMapBucket *self, char *key)
-{
-    if (!strcmp(self->pair.key, key)) {
-        return self;
+        next__HashCtrlProbe(&probe);
     }
-
-    return self->next ? get_bucket__HashMapBucket(self->next, key) : NULL;
 }
 
 void *
 get__HashMap(HashMap *self, char *key)
 {
-    if (!self->buckets)
+    if (!self->ctrls) {
         return NULL;
-
-    Usize index = index__HashMap(self, key);
-    HashMapBucket *bucket = self->buckets[index];
-
-    if (bucket) {
-        const HashMapBucket *res = get_bucket__HashMapBucket(bucket, key);
-
-        return res ? res->pair.value : NULL;
     }
 
-    return NULL;
+    HashMapSlot *slot = find_slot__HashMap(self, key, hash__HashMap(self, key));
+
+    return slot ? slot->pair.value : NULL;
 }
 
-void *
-push_bucket__HashMap(HashMap *self, Usize index, HashMapBucket *new)
+void
+resize__HashMap(HashMap *self, Usize capacity)
 {
-    void *is_exist = get__HashMap(self, new->pair.key);
-
-    if (is_exist) {
-        FREE(HashMapBucket, new);
-
-        return is_exist;
-    }
-
-    if (self->buckets[index]) {
-        HashMapBucket *current = self->buckets[index];
-
-        while (current->next) {
-            current = current->next;
+    Int8 *old_ctrls = self->ctrls;
+    HashMapSlot *old_slots = self->slots;
+    Usize old_capacity = self->capacity;
+
+    self->ctrls = new__HashCtrl(capacity);
+    self->slots = lily_malloc(sizeof(HashMapSlot) * capacity);
+    self->capacity = capacity;
+    self->growth_left = HASH_CTRL_MAX_LOAD(capacity) - self->len;
+
+    // Re-hash all inserted K-V (with their stored hash)
+    for (Usize i = 0; i < old_capacity; ++i) {
+        if (HASH_CTRL_IS_FULL(old_ctrls[i])) {
+            Usize index = find_insert_slot__HashCtrl(
+              self->ctrls, capacity, old_slots[i].hash);
+
+            set__HashCtrl(self->ctrls,
+                          capacity,
+                          index,
+                          h2__HashCtrl(old_slots[i].hash));
+            self->slots[index] = old_slots[i];
         }
-
-        current->next = new;
-
-        return NULL;
     }
 
-    self->buckets[index] = new;
-
-    return NULL;
+    if (old_ctrls) {
+        lily_free(old_ctrls);
+        lily_free(old_slots);
+    }
 }
 
 void *
 insert__HashMap(HashMap *self, char *key, void *value)
 {
-    Usize index = index__HashMap(self, key);
+    Usize hash = hash__HashMap(self, key);
 
-    if (!self->buckets) {
-        self->buckets = lily_calloc(DEFAULT_HASH_MAP_CAPACITY, PTR_SIZE);
-
-        self->buckets[index] = NEW(HashMapBucket, NEW(HashMapPair, key, value));
-        ++self->len;
+    if (!self->ctrls) {
+        resize__HashMap(self, DEFAULT_HASH_MAP_CAPACITY);
+    } else {
+        HashMapSlot *is_exist = find_slot__HashMap(self, key, hash);
 
-        return NULL;
+        if (is_exist) {
+            return is_exist->pair.value;
+        }
     }
 
-    if (self->len + 1 > self->capacity) {
-        self->capacity *= 2;
-
-        HashMapBucket **new_buckets = lily_calloc(self->capacity, PTR_SIZE);
-        HashMapBucket **old_buckets = self->buckets;
-
-        self->buckets = new_buckets;
+    Usize index = find_insert_slot__HashCtrl(self->ctrls, self->capacity, hash);
 
-        // Re-hash all inserted K-V
-        for (Usize i = 0; i < self->len; ++i) {
-            HashMapBucket *current = old_buckets[i];
+    if (self->growth_left == 0 && self->ctrls[index] == HASH_CTRL_EMPTY) {
+        resize__HashMap(self, grow__HashCtrl(self->len, self->capacity));
 
-            while (current != NULL) {
-                HashMapBucket *next = current->next;
-                Usize new_index = index__HashMap(self, current->pair.key);
-
-                current->next = new_buckets[new_index];
-                new_buckets[new_index] = current;
-                current = next;
-            }
-        }
-
-        lily_free(old_buckets);
-
-        // Realod index
-        index = index__HashMap(self, key);
+        // Reload index
+        index = find_insert_slot__HashCtrl(self->ctrls, self->capacity, hash);
     }
 
-    void *is_exist = push_bucket__HashMap(
-      self, index, NEW(HashMapBucket, NEW(HashMapPair, key, value)));
-
-    if (is_exist) {
-        return is_exist;
+    if (self->ctrls[index] == HASH_CTRL_EMPTY) {
+        --self->growth_left;
     }
 
+    set__HashCtrl(self->ctrls, self->capacity, index, h2__HashCtrl(hash));
+    self->slots[index] =
+      (HashMapSlot){ .hash = hash, .pair = NEW(HashMapPair, key, value) };
     ++self->len;
 
     return NULL;
@@ -176,36 +166,18 @@ insert__HashMap(HashMap *self, char *key, void *value)
 void *
 remove__HashMap(HashMap *self, char *key)
 {
-    if (!self->buckets) {
+    if (!self->ctrls) {
         return NULL;
     }
 
-    Usize index = index__HashMap(self, key);
-    HashMapBucket *current = self->buckets[index];
-    HashMapBucket *match = NULL;
-    HashMapBucket *prev = NULL;
-
-    while (current) {
-        if (!strcmp(current->pair.key, key)) {
-            match = current;
-            break;
-        }
-
-        prev = current;
-        current = current->next;
-    }
+    HashMapSlot *match =
+      find_slot__HashMap(self, key, hash__HashMap(self, key));
 
     if (match) {
         void *res = match->pair.value;
 
-        if (prev) {
-            prev->next = match->next;
-
-            lily_free(match);
-        } else {
-            self->buckets[index] = match->next;
-
-            lily_free(match);
+        if (erase__HashCtrl(self->ctrls, self->capacity, match - self->slots)) {
+            ++self->growth_left;
         }
 
         --self->len;
@@ -218,14 +190,9 @@ remove__HashMap(HashMap *self, char *key)
 
 DESTRUCTOR(HashMap, HashMap *self)
 {
-    if (self->buckets) {
-        for (Usize i = 0; i < self->capacity; ++i) {
-            if (self->buckets[i]) {
-                FREE(HashMapBucket, self->buckets[i]);
-            }
-        }
-
-        lily_free(self->buckets);
+    if (self->ctrls) {
+        lily_free(self->ctrls);
+        lily_free(self->slots);
     }
 
     lily_free(self);
@@ -242,22 +209,32 @@ next__HashMapIter(HashMapIter *self)
 HashMapIterPair
 next_pair__HashMapIter(HashMapIter *self)
 {
-    if (!self->hash_map->buckets) {
+    HashMap *hash_map = self->hash_map;
+
+    if (!hash_map->ctrls) {
         return HASH_MAP_ITER_PAIR_NULL();
     }
 
-    for (; !self->current && self->count < self->hash_map->capacity;
-         self->current = self->hash_map->buckets[self->count++])
-        ;
+    // Skip the empty or deleted slots a group at a time.
+    while (self->count < hash_map->capacity) {
+        HashCtrlMask mask = match_full__HashCtrl(hash_map->ctrls + self->count);
 
-    if (self->current) {
-        HashMapIterPair pair = NEW(
-          HashMapIterPair, self->current->pair.key, self->current->pair.value);
+        if (!mask) {
+            self->count += HASH_CTRL_GROUP_WIDTH;
+            continue;
+        }
 
-        self->current = self->current->next;
+        self->count += next__HashCtrlMask(&mask);
 
-        return pair;
-    } else {
-        return HASH_MAP_ITER_PAIR_NULL();
+        // The mask may match a mirrored control byte.
+        if (self->count >= hash_map->capacity) {
+            break;
+        }
+
+        HashMapPair *pair = &hash_map->slots[self->count++].pair;
+
+        return NEW(HashMapIterPair, pair->key, pair->value);
     }
+
+    return HASH_MAP_ITER_PAIR_NULL();
 }
@@ -0,0 +1,344 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/assert.h>
+#include <base/hash/wy.h>
+#include <base/interner.h>
+
+#include <string.h>
+
+static Interner *global_interner = NULL;
+static pthread_once_t global_interner_once = PTHREAD_ONCE_INIT;
+
+/**
+ *
+ * @brief Construct InternerTable type.
+ */
+static CONSTRUCTOR(InternerTable *,
+                   InternerTable,
+                   Usize capacity,
+                   InternerTable *previous);
+
+/**
+ *
+ * @brief Free InternerTable type (and all its previous tables).
+ */
+static DESTRUCTOR(InternerTable, InternerTable *self);
+
+/**
+ *
+ * @brief Hash the string.
+ */
+static inline Uint64
+hash__Interner(const char *s);
+
+/**
+ *
+ * @brief Search the string in the table.
+ * @return If the string is not found, return SYMBOL_NONE.
+ */
+static Symbol
+find__Interner(const Interner *self,
+               const InternerTable *table,
+               const char *s,
+               Uint64 hash);
+
+/**
+ *
+ * @brief Write the symbol in an empty slot of the table.
+ */
+static void
+set__InternerTable(InternerTable *self, Uint64 hash, Symbol symbol);
+
+/**
+ *
+ * @brief Replace the table by a table twice as big.
+ * @note The mutex of the interner must be locked.
+ */
+static InternerTable *
+grow__Interner(Interner *self, InternerTable *table);
+
+/**
+ *
+ * @brief Copy the string into the arenas of the interner.
+ */
+static char *
+copy_string__Interner(Interner *self, const char *s, Usize len);
+
+/**
+ *
+ * @brief Initialize the global interner (called once).
+ */
+static void
+init_global__Interner();
+
+CONSTRUCTOR(InternerTable *,
+            InternerTable,
+            Usize capacity,
+            InternerTable *previous)
+{
+    InternerTable *self = lily_malloc(sizeof(InternerTable));
+
+    self->slots = lily_calloc(capacity, sizeof(_Atomic(Uint64)));
+    self->capacity = capacity;
+    self->previous = previous;
+
+    return self;
+}
+
+DESTRUCTOR(InternerTable, InternerTable *self)
+{
+    while (self) {
+        InternerTable *previous = self->previous;
+
+        lily_free(self->slots);
+        lily_free(self);
+
+        self = previous;
+    }
+}
+
+CONSTRUCTOR(Interner *, Interner)
+{
+    Interner *self = lily_malloc(sizeof(Interner));
+
+    atomic_init(&self->table,
+                NEW(InternerTable, INTERNER_DEFAULT_CAPACITY, NULL));
+
+    for (Usize i = 0; i < INTERNER_CHUNKS_LEN; ++i) {
+        atomic_init(&self->chunks[i], NULL);
+    }
+
+    self->len = 0;
+    self->arenas = NEW(MemoryArenaChain, INTERNER_ARENA_CAPACITY);
+
+    pthread_mutex_init(&self->mutex, NULL);
+
+    return self;
+}
+
+Uint64
+hash__Interner(const char *s)
+{
+    return hash_wy(s, strlen(s), WY_SEED);
+}
+
+Symbol
+find__Interner(const Interner *self,
+               const InternerTable *table,
+               const char *s,
+               Uint64 hash)
+{
+    Usize mask = table->capacity - 1;
+
+    for (Usize i = hash & mask;; i = (i + 1) & mask) {
+        Uint64 slot =
+          atomic_load_explicit(&table->slots[i], memory_order_acquire);
+
+        if (!slot) {
+            return SYMBOL_NONE;
+        } else if (slot >> 32 == hash >> 32) {
+            Symbol symbol = (Symbol)slot;
+
+            if (!strcmp(get__Interner((Interner *)self, symbol), s)) {
+                return symbol;
+            }
+        }
+    }
+}
+
+void
+set__InternerTable(InternerTable *self, Uint64 hash, Symbol symbol)
+{
+    Usize mask = self->capacity - 1;
+    Usize i = hash & mask;
+
+    while (atomic_load_explicit(&self->slots[i], memory_order_relaxed)) {
+        i = (i + 1) & mask;
+    }
+
+    // NOTE: The release store publishes the string of the symbol to the
+    // readers.
+    atomic_store_explicit(&self->slots[i],
+                          (hash >> 32 << 32) | symbol,
+                          memory_order_release);
+}
+
+InternerTable *
+grow__Interner(Interner *self, InternerTable *table)
+{
+    InternerTable *new_table =
+      NEW(InternerTable, table->capacity * 2, table);
+
+    for (Usize i = 0; i < table->capacity; ++i) {
+        Uint64 slot =
+          atomic_load_explicit(&table->slots[i], memory_order_relaxed);
+
+        if (slot) {
+            Symbol symbol = (Symbol)slot;
+
+            set__InternerTable(new_table,
+                               hash__Interner(get__Interner(self, symbol)),
+                               symbol);
+        }
+    }
+
+    atomic_store_explicit(&self->table, new_table, memory_order_release);
+
+    return new_table;
+}
+
+char *
+copy_string__Interner(Interner *self, const char *s, Usize len)
+{
+    char *res = alloc__MemoryArenaChain(&self->arenas, len + 1, 1);
+
+    memcpy(res, s, len + 1);
+
+    return res;
+}
+
+Symbol
+intern__Interner(Interner *self, const char *s)
+{
+    Uint64 hash = hash__Interner(s);
+    Symbol symbol = lookup__Interner(self, s);
+
+    if (symbol != SYMBOL_NONE) {
+        return symbol;
+    }
+
+    pthread_mutex_lock(&self->mutex);
+
+    InternerTable *table =
+      atomic_load_explicit(&self->table, memory_order_relaxed);
+
+    // The string may have been interned by another thread since the lookup.
+    symbol = find__Interner(self, table, s, hash);
+
+    if (symbol == SYMBOL_NONE) {
+        ASSERT(self->len < INTERNER_CHUNK_LEN * INTERNER_CHUNKS_LEN);
+
+        Usize index = self->len++;
+        const char **chunk = atomic_load_explicit(
+          &self->chunks[index / INTERNER_CHUNK_LEN], memory_order_relaxed);
+
+        if (!chunk) {
+            chunk = lily_malloc(sizeof(const char *) * INTERNER_CHUNK_LEN);
+
+            atomic_store_explicit(&self->chunks[index / INTERNER_CHUNK_LEN],
+                                  chunk,
+                                  memory_order_release);
+        }
+
+        chunk[index % INTERNER_CHUNK_LEN] =
+          copy_string__Interner(self, s, strlen(s));
+        symbol = self->len;
+
+        // Keep the load factor under 3/4.
+        if (self->len * 4 > table->capacity * 3) {
+            table = grow__Interner(self, table);
+        }
+
+        set__InternerTable(table, hash, symbol);
+    }
+
+    pthread_mutex_unlock(&self->mutex);
+
+    return symbol;
+}
+
+Symbol
+lookup__Interner(Interner *self, const char *s)
+{
+    return find__Interner(
+      self,
+      atomic_load_explicit(&self->table, memory_order_acquire),
+      s,
+      hash__Interner(s));
+}
+
+const char *
+get__Interner(Interner *self, Symbol symbol)
+{
+    ASSERT(symbol != SYMBOL_NONE);
+
+    Usize index = symbol - 1;
+    const char **chunk = atomic_load_explicit(
+      &self->chunks[index / INTERNER_CHUNK_LEN], memory_order_acquire);
+
+    ASSERT(chunk);
+
+    return chunk[index % INTERNER_CHUNK_LEN];
+}
+
+DESTRUCTOR(Interner, Interner *self)
+{
+    FREE(InternerTable,
+         atomic_load_explicit(&self->table, memory_order_relaxed));
+
+    for (Usize i = 0;
+         i < INTERNER_CHUNKS_LEN &&
+         atomic_load_explicit(&self->chunks[i], memory_order_relaxed);
+         ++i) {
+        lily_free(
+          atomic_load_explicit(&self->chunks[i], memory_order_relaxed));
+    }
+
+    FREE(MemoryArenaChain, &self->arenas);
+
+    pthread_mutex_destroy(&self->mutex);
+    lily_free(self);
+}
+
+void
+init_global__Interner()
+{
+    global_interner = NEW(Interner);
+}
+
+Symbol
+intern__Symbol(const char *s)
+{
+    pthread_once(&global_interner_once, &init_global__Interner);
+
+    return intern__Interner(global_interner, s);
+}
+
+Symbol
+lookup__Symbol(const char *s)
+{
+    pthread_once(&global_interner_once, &init_global__Interner);
+
+    return lookup__Interner(global_interner, s);
+}
+
+const char *
+to_str__Symbol(Symbol self)
+{
+    pthread_once(&global_interner_once, &init_global__Interner);
+
+    return get__Interner(global_interner, self);
+}
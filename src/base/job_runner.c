@@ -0,0 +1,274 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/assert.h>
+#include <base/cpu.h>
+#include <base/fork.h>
+#include <base/job_runner.h>
+#include <base/pipe.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define JOB_RUNNER_READ_BUFFER_SIZE 4096
+
+extern char **environ;
+
+// Represents a job which is running.
+typedef struct JobRunnerSlot
+{
+    Job *job; // Job* (&)
+    Fork pid;
+    int err_fd; // read end of the stderr pipe of the process
+} JobRunnerSlot;
+
+/**
+ *
+ * @brief Spawn the process of the job, with its stderr redirected to a pipe.
+ * @return Return false if the process cannot be spawned (the job is marked as
+ * failed).
+ */
+static bool
+spawn__JobRunner(Job *job, JobRunnerSlot *slot);
+
+/**
+ *
+ * @brief Read the available bytes of the stderr of the process.
+ * @return Return false when the end of the pipe is reached.
+ */
+static bool
+read_err__JobRunner(JobRunnerSlot *slot);
+
+/**
+ *
+ * @brief Wait the end of the process and close the stderr pipe.
+ */
+static void
+finish__JobRunner(JobRunnerSlot *slot);
+
+CONSTRUCTOR(Job *, Job, Vec *args, Usize stage)
+{
+    ASSERT(args->len > 0);
+
+    Job *self = lily_malloc(sizeof(Job));
+
+    self->args = args;
+    self->stage = stage;
+    self->err = NEW(String);
+    self->exit_status = -1;
+    self->kill_signal = -1;
+
+    return self;
+}
+
+DESTRUCTOR(Job, Job *self)
+{
+    for (Usize i = 0; i < self->args->len; ++i) {
+        lily_free(get__Vec(self->args, i));
+    }
+
+    FREE(Vec, self->args);
+    FREE(String, self->err);
+    lily_free(self);
+}
+
+CONSTRUCTOR(JobRunner, JobRunner, Usize max_running)
+{
+    return (JobRunner){ .jobs = NEW(Vec),
+                        .max_running = max_running > 0
+                                         ? max_running
+                                         : get_cores_len__Cpu() };
+}
+
+void
+add__JobRunner(JobRunner *self, Job *job)
+{
+    ASSERT(self->jobs->len == 0 ||
+           CAST(Job *, last__Vec(self->jobs))->stage <= job->stage);
+
+    push__Vec(self->jobs, job);
+}
+
+bool
+spawn__JobRunner(Job *job, JobRunnerSlot *slot)
+{
+    Pipefd err_pipe;
+
+    create__Pipe(err_pipe);
+
+    // NOTE: The pipes must not be inherited by the other processes spawned by
+    // the runner, otherwise the end of the pipe is never reached.
+    fcntl(err_pipe[PIPE_READ_FD], F_SETFD, FD_CLOEXEC);
+    fcntl(err_pipe[PIPE_WRITE_FD], F_SETFD, FD_CLOEXEC);
+
+    posix_spawn_file_actions_t actions;
+
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(
+      &actions, err_pipe[PIPE_WRITE_FD], STDERR_FILENO);
+
+    // NOTE: The `argv` passed to `posix_spawnp` must end with NULL.
+    push__Vec(job->args, NULL);
+
+    int res = posix_spawnp(&slot->pid,
+                           get__Vec(job->args, 0),
+                           &actions,
+                           NULL,
+                           (char *const *)job->args->buffer,
+                           environ);
+
+    pop__Vec(job->args);
+    posix_spawn_file_actions_destroy(&actions);
+    close_write__Pipe(err_pipe);
+
+    if (res != 0) {
+        close_read__Pipe(err_pipe);
+
+        job->exit_status = 127;
+
+        push_str__String(job->err, "cannot spawn `");
+        push_str__String(job->err, get__Vec(job->args, 0));
+        push_str__String(job->err, "`: ");
+        push_str__String(job->err, strerror(res));
+        push__String(job->err, '\n');
+
+        return false;
+    }
+
+    slot->job = job;
+    slot->err_fd = err_pipe[PIPE_READ_FD];
+
+    return true;
+}
+
+bool
+read_err__JobRunner(JobRunnerSlot *slot)
+{
+    char buffer[JOB_RUNNER_READ_BUFFER_SIZE];
+    ssize_t n = read(slot->err_fd, buffer, JOB_RUNNER_READ_BUFFER_SIZE);
+
+    if (n > 0) {
+        push_str_with_len__String(slot->job->err, buffer, n);
+
+        return true;
+    }
+
+    return n == -1 && errno == EINTR;
+}
+
+void
+finish__JobRunner(JobRunnerSlot *slot)
+{
+    close(slot->err_fd);
+
+    wait__Fork(slot->pid,
+               &slot->job->exit_status,
+               &slot->job->kill_signal,
+               NULL,
+               false);
+}
+
+Usize
+run__JobRunner(JobRunner *self)
+{
+    Usize failed = 0;
+    Usize next = 0;
+    Usize running_len = 0;
+    JobRunnerSlot *running = lily_malloc(sizeof(JobRunnerSlot) *
+                                         (self->max_running + 1));
+    struct pollfd *fds =
+      lily_malloc(sizeof(struct pollfd) * (self->max_running + 1));
+
+    while (next < self->jobs->len || running_len > 0) {
+        // 1. Spawn the jobs of the current stage. A job of the next stage is
+        // only spawned when all jobs of the current stage are finished.
+        while (next < self->jobs->len && running_len < self->max_running) {
+            Job *job = get__Vec(self->jobs, next);
+
+            if (running_len > 0 && running[0].job->stage != job->stage) {
+                break;
+            }
+
+            ++next;
+
+            if (spawn__JobRunner(job, &running[running_len])) {
+                ++running_len;
+            } else {
+                ++failed;
+            }
+        }
+
+        if (running_len == 0) {
+            continue;
+        }
+
+        // 2. Wait for output (or the end) of the running processes.
+        for (Usize i = 0; i < running_len; ++i) {
+            fds[i] = (struct pollfd){ .fd = running[i].err_fd,
+                                      .events = POLLIN,
+                                      .revents = 0 };
+        }
+
+        if (poll(fds, running_len, -1) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            UNREACHABLE("something wrong with poll");
+        }
+
+        // 3. Collect the finished processes.
+        for (Usize i = running_len; i-- > 0;) {
+            if (!fds[i].revents || read_err__JobRunner(&running[i])) {
+                continue;
+            }
+
+            finish__JobRunner(&running[i]);
+
+            if (has_failed__Job(running[i].job)) {
+                ++failed;
+            }
+
+            running[i] = running[--running_len];
+        }
+    }
+
+    lily_free(running);
+    lily_free(fds);
+
+    return failed;
+}
+
+DESTRUCTOR(JobRunner, const JobRunner *self)
+{
+    FREE_BUFFER_ITEMS(self->jobs->buffer, self->jobs->len, Job);
+    FREE(Vec, self->jobs);
+}
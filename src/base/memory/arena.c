@@ -32,17 +32,26 @@
 #include <stdlib.h>
 #include <string.h>
 
+bool
+has_space__MemoryArena(const MemoryArena *self, Usize size, Usize align)
+{
+    Uptr mem = ALIGN(self->arena + self->total_size, align);
+
+    return mem - (Uptr)self->arena + size <= self->capacity;
+}
+
 void *
 alloc__MemoryArena(MemoryArena *self, Usize size, Usize align)
 {
     ASSERT(!self->is_destroy);
 
-    if (self->total_size + size < self->capacity) {
-        void *mem = (void *)ALIGN(self->arena + self->total_size, align);
+    if (has_space__MemoryArena(self, size, align)) {
+        Uptr mem = ALIGN(self->arena + self->total_size, align);
 
-        self->total_size += size;
+        // NOTE: The padding added to align the region is also counted.
+        self->total_size = mem - (Uptr)self->arena + size;
 
-        return mem;
+        return (void *)mem;
     } else {
         perror("Lily(Fail): too mutch allocated memory or out of memory");
         exit(1);
@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <base/alloc.h>
+#include <base/memory/arena_chain.h>
+
+void *
+alloc__MemoryArenaChain(MemoryArenaChain *self, Usize size, Usize align)
+{
+    MemoryArena *arena = self->arenas->len > 0 ? last__Vec(self->arenas) : NULL;
+
+    if (!arena || !has_space__MemoryArena(arena, size, align)) {
+        arena = lily_malloc(sizeof(MemoryArena));
+        *arena = NEW(MemoryArena,
+                     size + align > self->arena_capacity
+                       ? size + align
+                       : self->arena_capacity);
+
+        push__Vec(self->arenas, arena);
+    }
+
+    return alloc__MemoryArena(arena, size, align);
+}
+
+Usize
+get_total_size__MemoryArenaChain(const MemoryArenaChain *self)
+{
+    Usize total_size = 0;
+
+    for (Usize i = 0; i < self->arenas->len; ++i) {
+        const MemoryArena *arena = get__Vec(self->arenas, i);
+
+        total_size += arena->total_size;
+    }
+
+    return total_size;
+}
+
+DESTRUCTOR(MemoryArenaChain, const MemoryArenaChain *self)
+{
+    for (Usize i = 0; i < self->arenas->len; ++i) {
+        MemoryArena *arena = get__Vec(self->arenas, i);
+
+        destroy__MemoryArena(arena);
+        lily_free(arena);
+    }
+
+    FREE(Vec, self->arenas);
+}
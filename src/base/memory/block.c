@@ -35,7 +35,7 @@ CONSTRUCTOR(MemoryBlock *,
             MemoryApi *api,
             Usize size,
             Usize align,
-            MemoryBlock *prev)
+            void *owner)
 {
     MemoryBlock *self =
       api->alloc(sizeof(MemoryBlock) + size, DEFAULT_ALIGNMENT);
@@ -43,7 +43,7 @@ CONSTRUCTOR(MemoryBlock *,
     self->size = size;
     self->align = align;
     self->next = NULL;
-    self->prev = prev;
+    self->owner = owner;
 
     return self;
 }
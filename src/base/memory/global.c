@@ -29,8 +29,10 @@
 #include <base/units.h>
 
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifdef USE_C_MEMORY_API
 #if defined(LILY_APPLE_OS)
@@ -40,88 +42,294 @@
 #endif
 #endif
 
+// Allocation cache of a thread.
+typedef struct MemoryGlobalCache
+{
+    MemoryBlock *free_lists[MEMORY_GLOBAL_SIZE_CLASS_LEN]; // MemoryBlock*?
+    // Blocks of this cache freed by the other threads.
+    _Atomic(MemoryBlock *) remote_frees; // _Atomic(MemoryBlock*)?
+    // true if the thread of the cache is finished, so the cache can be
+    // adopted by a new thread.
+    atomic_bool is_orphan;
+    struct MemoryGlobalCache *next; // struct MemoryGlobalCache*?
+    Usize total_size;
+    Usize total_block;
+    Usize total_size_free;
+    Usize total_block_free;
+    Usize total_remote_free;
+    Usize total_span;
+} MemoryGlobalCache;
+
+/**
+ *
+ * @brief Get the cache of the current thread (the cache is created or adopted
+ * on the first call).
+ */
+static MemoryGlobalCache *
+get_cache__MemoryGlobal();
+
+/**
+ *
+ * @brief Mark the cache of a finished thread as orphan.
+ */
+static void
+orphan__MemoryGlobalCache(void *self);
+
+/**
+ *
+ * @brief Initialize the key used to know when a thread is finished.
+ */
+static void
+init_cache_key__MemoryGlobal();
+
+#ifndef USE_C_MEMORY_API
+/**
+ *
+ * @brief Get the size class of the block.
+ * @return Return MEMORY_GLOBAL_SIZE_CLASS_LEN if the block is too big (or
+ * too aligned) to be in a size class.
+ */
+static inline Usize
+get_size_class__MemoryGlobal(Usize size, Usize align);
+
+/**
+ *
+ * @brief Push the block on the free list of its size class.
+ */
+static inline void
+push_free__MemoryGlobalCache(MemoryGlobalCache *self, MemoryBlock *block);
+
+/**
+ *
+ * @brief Move the blocks freed by the other threads in the free lists.
+ */
+static void
+collect_remote_frees__MemoryGlobalCache(MemoryGlobalCache *self);
+
+/**
+ *
+ * @brief Fill the free list of the size class with a new span.
+ */
+static void
+refill__MemoryGlobalCache(MemoryGlobalCache *self, Usize size_class);
+
+#ifdef ENV_SAFE
+/**
+ *
+ * @brief Count the bytes taken from the memory API, and fail if the capacity
+ * is exceeded.
+ */
+static void
+reserve__MemoryGlobal(Usize alloc_size);
+#endif
+#endif
+
 [[maybe_unused]] static MemoryApi api = { .align = __align__,
                                           .alloc = __alloc__,
                                           .resize = __resize__,
                                           .free = __free__ };
-static Usize total_size = 0;
-static Usize total_block = 0;
-static Usize total_block_free = 0;
-static Usize total_size_free = 0;
-[[maybe_unused]] static MemoryBlock *top = NULL;
-[[maybe_unused]] static MemoryBlock *last = NULL;
-[[maybe_unused]] static Usize capacity = 0;
-[[maybe_unused]] static pthread_mutex_t global_mutex =
-  PTHREAD_MUTEX_INITIALIZER;
+static MemoryGlobalCache *caches = NULL; // MemoryGlobalCache*?
+static pthread_mutex_t caches_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t cache_key;
+static pthread_once_t cache_key_once = PTHREAD_ONCE_INIT;
+static threadlocal MemoryGlobalCache *cache = NULL;
+#if defined(ENV_SAFE) && !defined(USE_C_MEMORY_API)
+static atomic_size_t capacity = 0;
+// Bytes taken from the memory API (spans and big blocks).
+static atomic_size_t total_api_size = 0;
+#endif
 
-void *
-alloc__MemoryGlobal(Usize size, Usize align)
+MemoryGlobalCache *
+get_cache__MemoryGlobal()
 {
-#ifdef USE_C_MEMORY_API
-    void *mem = malloc(size);
+    if (cache) {
+        return cache;
+    }
 
-    if (mem) {
-        ++total_block;
-        total_size += size;
+    pthread_once(&cache_key_once, &init_cache_key__MemoryGlobal);
+    pthread_mutex_lock(&caches_mutex);
+
+    // Adopt the cache of a finished thread, so the free blocks of this cache
+    // are reused.
+    for (MemoryGlobalCache *current = caches; current;
+         current = current->next) {
+        if (atomic_load(&current->is_orphan)) {
+            atomic_store(&current->is_orphan, false);
+            cache = current;
+
+            break;
+        }
     }
 
-    return mem;
-#else
-    pthread_mutex_lock(&global_mutex);
+    if (!cache) {
+        cache = api.alloc(sizeof(MemoryGlobalCache), DEFAULT_ALIGNMENT);
 
-#ifdef ENV_SAFE
-    if (capacity == 0) {
-        capacity = __max_capacity__$Alloc();
+        ASSERT(cache);
+
+        memset(cache, 0, sizeof(MemoryGlobalCache));
+        cache->next = caches;
+        caches = cache;
     }
-#endif
 
-    Usize alloc_size = sizeof(MemoryBlock) + size;
+    pthread_mutex_unlock(&caches_mutex);
+    pthread_setspecific(cache_key, cache);
+
+    return cache;
+}
+
+void
+orphan__MemoryGlobalCache(void *self)
+{
+    // NOTE: If the thread allocates again (e.g. in another destructor), a
+    // cache is adopted again.
+    cache = NULL;
+
+    atomic_store(&((MemoryGlobalCache *)self)->is_orphan, true);
+}
+
+void
+init_cache_key__MemoryGlobal()
+{
+    pthread_key_create(&cache_key, &orphan__MemoryGlobalCache);
+}
+
+#ifndef USE_C_MEMORY_API
+Usize
+get_size_class__MemoryGlobal(Usize size, Usize align)
+{
+    if (align > MEMORY_GLOBAL_BLOCK_ALIGN) {
+        return MEMORY_GLOBAL_SIZE_CLASS_LEN;
+    }
+
+    Usize block_size = sizeof(MemoryBlock) + size;
+    Usize size_class = 0;
+
+    for (Usize class_size = MEMORY_GLOBAL_MIN_BLOCK_SIZE;
+         size_class < MEMORY_GLOBAL_SIZE_CLASS_LEN && class_size < block_size;
+         class_size <<= 1) {
+        ++size_class;
+    }
+
+    return size_class;
+}
 
 #ifdef ENV_SAFE
-    if (total_size + alloc_size > capacity) {
+void
+reserve__MemoryGlobal(Usize alloc_size)
+{
+    if (atomic_load_explicit(&capacity, memory_order_relaxed) == 0) {
+        atomic_store_explicit(
+          &capacity, __max_capacity__$Alloc(), memory_order_relaxed);
+    }
+
+    Usize total_size = atomic_fetch_add_explicit(
+      &total_api_size, alloc_size, memory_order_relaxed);
+
+    if (total_size + alloc_size >
+        atomic_load_explicit(&capacity, memory_order_relaxed)) {
         perror("Lily(Fail): too much memory allocation allocated");
         exit(1);
     }
+}
+#endif
+
+void
+push_free__MemoryGlobalCache(MemoryGlobalCache *self, MemoryBlock *block)
+{
+    Usize size_class = get_size_class__MemoryGlobal(block->size, 0);
+
+    block->next = self->free_lists[size_class];
+    self->free_lists[size_class] = block;
+}
+
+void
+collect_remote_frees__MemoryGlobalCache(MemoryGlobalCache *self)
+{
+    MemoryBlock *block = atomic_exchange_explicit(
+      &self->remote_frees, NULL, memory_order_acquire);
+
+    while (block) {
+        MemoryBlock *next = block->next;
+
+        push_free__MemoryGlobalCache(self, block);
+        block = next;
+    }
+}
+
+void
+refill__MemoryGlobalCache(MemoryGlobalCache *self, Usize size_class)
+{
+    Usize block_size = MEMORY_GLOBAL_MIN_BLOCK_SIZE << size_class;
+#ifdef ENV_SAFE
+    reserve__MemoryGlobal(MEMORY_GLOBAL_SPAN_SIZE);
 #endif
 
-    void *mem = api.alloc(alloc_size, align);
+    char *span = api.alloc(MEMORY_GLOBAL_SPAN_SIZE, DEFAULT_ALIGNMENT);
+
+    ASSERT(span);
 
-    total_size += size;
-    ++total_block;
+    for (Usize offset = 0; offset + block_size <= MEMORY_GLOBAL_SPAN_SIZE;
+         offset += block_size) {
+        MemoryBlock *block = (MemoryBlock *)(span + offset);
 
-    if (!top) {
-        top = (MemoryBlock *)mem;
-        last = top;
-        top->prev = NULL;
+        block->size = block_size - sizeof(MemoryBlock);
+        block->align = MEMORY_GLOBAL_BLOCK_ALIGN;
+        block->owner = self;
+        block->next = self->free_lists[size_class];
+        self->free_lists[size_class] = block;
+    }
+
+    ++self->total_span;
+}
+#endif
+
+void *
+alloc__MemoryGlobal(Usize size, Usize align)
+{
+    MemoryGlobalCache *self = get_cache__MemoryGlobal();
+
+#ifdef USE_C_MEMORY_API
+    void *mem = malloc(size);
+
+    if (mem) {
+        ++self->total_block;
+        self->total_size += size;
+    }
+
+    return mem;
+#else
+    Usize size_class = get_size_class__MemoryGlobal(size, align);
+    MemoryBlock *block = NULL;
+
+    if (size_class == MEMORY_GLOBAL_SIZE_CLASS_LEN) {
+#ifdef ENV_SAFE
+        reserve__MemoryGlobal(sizeof(MemoryBlock) + size);
+#endif
+
+        block = api.alloc(sizeof(MemoryBlock) + size, align);
+
+        block->size = size;
+        block->align = align;
+        block->owner = NULL;
     } else {
-        // Split the block if it's large enough
-        Usize remaining_size = last->size - alloc_size;
-
-        if (remaining_size >= sizeof(MemoryBlock)) {
-            MemoryBlock *new_block = (MemoryBlock *)((char *)last + alloc_size);
-
-            new_block->size = remaining_size - sizeof(MemoryBlock);
-            new_block->align = last->align;
-            new_block->next = last->next;
-            new_block->prev = last;
-
-            last->size = size;
-            last->align = align;
-            last->next = new_block;
-        } else {
-            last->next = (MemoryBlock *)mem;
-            last->next->prev = last;
-            last = last->next;
+        if (!self->free_lists[size_class]) {
+            collect_remote_frees__MemoryGlobalCache(self);
+        }
+
+        if (!self->free_lists[size_class]) {
+            refill__MemoryGlobalCache(self, size_class);
         }
+
+        block = self->free_lists[size_class];
+        self->free_lists[size_class] = block->next;
     }
 
-    last->size = size;
-    last->align = align;
-    last->next = NULL;
+    block->next = NULL;
 
-    pthread_mutex_unlock(&global_mutex);
+    self->total_size += block->size;
+    ++self->total_block;
 
-    return (void *)((char *)mem + sizeof(MemoryBlock));
+    return (void *)((char *)block + sizeof(MemoryBlock));
 #endif
 }
 
@@ -138,83 +346,40 @@ resize__MemoryGlobal(void *mem, Usize new_size)
     void *new_mem = realloc(mem, new_size);
 
     if (new_mem) {
-        total_size += new_size;
-        total_size_free += old_size;
+        MemoryGlobalCache *self = get_cache__MemoryGlobal();
 
-        ++total_block;
-        ++total_block_free;
+        self->total_size += new_size;
+        self->total_size_free += old_size;
+
+        ++self->total_block;
+        ++self->total_block_free;
     }
 
     return new_mem;
 #else
     if (!mem) {
         return NULL;
-    }
+    } else if (new_size == 0) {
+        // If new_size is 0, treat resize as a deallocation.
+        free__MemoryGlobal(mem);
 
-#ifdef ENV_SAFE
-    if (capacity == 0) {
-        capacity = __max_capacity__$Alloc();
+        return NULL;
     }
-#endif
-
-    pthread_mutex_lock(&global_mutex);
 
     MemoryBlock *block = (MemoryBlock *)((char *)mem - sizeof(MemoryBlock));
-    Usize old_size = block->size;
-    Usize align = block->align;
-    void *resized_mem = mem;
 
-#ifdef ENV_SAFE
-    {
-        Usize alloc_size =
-          new_size < old_size ? old_size - new_size : new_size - old_size;
-
-        if (total_size + alloc_size > capacity) {
-            perror("Lily(Fail): too much memory allocation allocated");
-            exit(1);
-        }
+    // The block is big enough (the size of a block in a size class is the
+    // size of its class).
+    if (new_size <= block->size) {
+        return mem;
     }
-#endif
 
-    if (new_size == 0) {
-        // If new_size is 0, treat resize as a deallocation.
-        // Remove the block from the linked list.
-        if (block == top) {
-            top = block->next;
-        } else {
-            MemoryBlock *prev = block->prev;
-            prev->next = block->next;
-        }
+    void *new_mem = alloc__MemoryGlobal(new_size, block->align);
 
-        if (block->next) {
-            block->next->prev = block->prev;
-        }
+    memcpy(new_mem, mem, block->size);
+    free__MemoryGlobal(mem);
 
-        // Free memory
-        api.free(&mem, old_size, align);
-
-        resized_mem = NULL;
-    } else if (new_size != old_size) {
-        MemoryBlock *resized_block = api.resize(block,
-                                                old_size + sizeof(MemoryBlock),
-                                                new_size + sizeof(MemoryBlock),
-                                                align);
-
-        if (resized_block) {
-            // FIXME: leak here. You should probably use api.alloc instead of
-            // api.resize. Plus you'd probably have to add a new block to the
-            // linked list and remove the old one and free it.
-            resized_block->size = new_size;
-            resized_mem = (void *)((char *)resized_block + sizeof(MemoryBlock));
-            ++total_block;
-            total_size +=
-              new_size < old_size ? old_size - new_size : new_size - old_size;
-        }
-    }
-
-    pthread_mutex_unlock(&global_mutex);
-
-    return resized_mem;
+    return new_mem;
 #endif
 }
 
@@ -230,56 +395,81 @@ free__MemoryGlobal(void *mem)
 
     free(mem);
 
-    ++total_block_free;
-    total_size_free += mem_size;
+    MemoryGlobalCache *self = get_cache__MemoryGlobal();
+
+    ++self->total_block_free;
+    self->total_size_free += mem_size;
 #else
     if (!mem) {
         return;
     }
 
-    pthread_mutex_lock(&global_mutex);
-
-    MemoryBlock *block = (MemoryBlock *)((void *)mem - sizeof(MemoryBlock));
-
-    if (block->size == 0 || block->next != NULL) {
-        ++total_block_free;
+    MemoryGlobalCache *self = get_cache__MemoryGlobal();
+    MemoryBlock *block = (MemoryBlock *)((char *)mem - sizeof(MemoryBlock));
+    MemoryGlobalCache *owner = block->owner;
 
-        pthread_mutex_unlock(&global_mutex);
+    self->total_size_free += block->size;
+    ++self->total_block_free;
 
-        return;
-    }
+    if (!owner) {
+#ifdef ENV_SAFE
+        atomic_fetch_sub_explicit(&total_api_size,
+                                  sizeof(MemoryBlock) + block->size,
+                                  memory_order_relaxed);
+#endif
 
-    if (block == top) {
-        top = block->next;
+        api.free(
+          (void **)&block, sizeof(MemoryBlock) + block->size, block->align);
+    } else if (owner == self) {
+        push_free__MemoryGlobalCache(self, block);
     } else {
-        MemoryBlock *prev = block->prev;
-
-        prev->next = block->next;
+        MemoryBlock *head =
+          atomic_load_explicit(&owner->remote_frees, memory_order_relaxed);
+
+        do {
+            block->next = head;
+        } while (!atomic_compare_exchange_weak_explicit(&owner->remote_frees,
+                                                        &head,
+                                                        block,
+                                                        memory_order_release,
+                                                        memory_order_relaxed));
+
+        ++self->total_remote_free;
     }
-
-    if (block->next) {
-        block->next->prev = block->prev;
-    }
-
-    // Free the memory
-    Usize size = block->size;
-    Usize align = block->align;
-
-    api.free((void **)&block, sizeof(MemoryBlock) + size, align);
-
-    total_size_free += size;
-    ++total_block_free;
-
-    pthread_mutex_unlock(&global_mutex);
 #endif
 }
 
 void
 print_stat__MemoryGlobal()
 {
+    Usize total_size = 0;
+    Usize total_block = 0;
+    Usize total_size_free = 0;
+    Usize total_block_free = 0;
+    Usize total_remote_free = 0;
+    Usize total_span = 0;
+    Usize total_cache = 0;
+
+    pthread_mutex_lock(&caches_mutex);
+
+    for (MemoryGlobalCache *current = caches; current;
+         current = current->next) {
+        total_size += current->total_size;
+        total_block += current->total_block;
+        total_size_free += current->total_size_free;
+        total_block_free += current->total_block_free;
+        total_remote_free += current->total_remote_free;
+        total_span += current->total_span;
+        ++total_cache;
+    }
+
+    pthread_mutex_unlock(&caches_mutex);
+
     Float32 mib_total_size = total_size / MiB;
     Float32 mib_total_size_free = total_size_free / MiB;
+    Float32 mib_total_span = total_span * MEMORY_GLOBAL_SPAN_SIZE / MiB;
 #ifdef ENV_SAFE
+    Usize capacity = __max_capacity__$Alloc();
     Float32 mib_capacity = capacity / MiB;
 #endif
 
@@ -291,6 +481,9 @@ print_stat__MemoryGlobal()
     PRINTLN("total size free: {d} b => {f} MiB",
             total_size_free,
             mib_total_size_free);
+    PRINTLN("total remote free: {d}", total_remote_free);
+    PRINTLN("total span: {d} => {f} MiB", total_span, mib_total_span);
+    PRINTLN("total thread cache: {d}", total_cache);
 #ifdef ENV_SAFE
     PRINTLN("capacity: {d} b => {f} MiB", capacity, mib_capacity);
 #endif
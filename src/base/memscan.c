@@ -0,0 +1,241 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/memscan.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MEMSCAN_USE_SIMD
+#define MEMSCAN_WIDTH 32
+
+typedef __m256i MemScanVec;
+
+#define LOAD(p) _mm256_loadu_si256((const __m256i *)(p))
+#define SET1(c) _mm256_set1_epi8((char)(c))
+#define EQ(a, b_) _mm256_cmpeq_epi8(a, b_)
+#define GT(a, b_) _mm256_cmpgt_epi8(a, b_)
+#define ADD(a, b_) _mm256_add_epi8(a, b_)
+#define OR(a, b_) _mm256_or_si256(a, b_)
+#define ANDNOT(a, b_) _mm256_andnot_si256(a, b_)
+#define MASK(v) (Uint32) _mm256_movemask_epi8(v)
+#define FULL_MASK 0xFFFFFFFF
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define MEMSCAN_USE_SIMD
+#define MEMSCAN_WIDTH 16
+
+typedef __m128i MemScanVec;
+
+#define LOAD(p) _mm_loadu_si128((const __m128i *)(p))
+#define SET1(c) _mm_set1_epi8((char)(c))
+#define EQ(a, b_) _mm_cmpeq_epi8(a, b_)
+#define GT(a, b_) _mm_cmpgt_epi8(a, b_)
+#define ADD(a, b_) _mm_add_epi8(a, b_)
+#define OR(a, b_) _mm_or_si128(a, b_)
+#define ANDNOT(a, b_) _mm_andnot_si128(a, b_)
+#define MASK(v) (Uint32) _mm_movemask_epi8(v)
+#define FULL_MASK 0xFFFF
+#endif
+
+/**
+ *
+ * @brief Check if `c` is a whitespace.
+ */
+static inline bool
+is_space__MemScan(char c, bool with_new_line);
+
+/**
+ *
+ * @brief Check if `c` is an identifier character.
+ */
+static inline bool
+is_ident__MemScan(char c, bool with_dollar);
+
+#ifdef MEMSCAN_USE_SIMD
+/**
+ *
+ * @brief Get a vector where the bytes of `v` in [lo, hi] are set to 0xFF.
+ */
+static inline MemScanVec
+in_range__MemScan(MemScanVec v, char lo, char hi);
+
+/**
+ *
+ * @brief Get the mask of the whitespaces of the block.
+ */
+static inline Uint32
+space_mask__MemScan(const char *s, bool with_new_line);
+
+/**
+ *
+ * @brief Get the mask of the identifier characters of the block.
+ */
+static inline Uint32
+ident_mask__MemScan(const char *s, bool with_dollar);
+#endif
+
+bool
+is_space__MemScan(char c, bool with_new_line)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r' && (with_new_line || c != '\n'));
+}
+
+bool
+is_ident__MemScan(char c, bool with_dollar)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c == '_' || (with_dollar && c == '$');
+}
+
+#ifdef MEMSCAN_USE_SIMD
+MemScanVec
+in_range__MemScan(MemScanVec v, char lo, char hi)
+{
+    // Move [lo, hi] to the bottom of the signed range, so that a single signed
+    // comparison is enough.
+    MemScanVec shifted = ADD(v, SET1((Uint8)(0x80 - (Uint8)lo)));
+
+    return GT(SET1((Uint8)(0x80 + (Uint8)(hi - lo) + 1)), shifted);
+}
+
+Uint32
+space_mask__MemScan(const char *s, bool with_new_line)
+{
+    MemScanVec v = LOAD(s);
+    MemScanVec res = OR(EQ(v, SET1(' ')), in_range__MemScan(v, '\t', '\r'));
+
+    if (!with_new_line) {
+        res = ANDNOT(EQ(v, SET1('\n')), res);
+    }
+
+    return MASK(res);
+}
+
+Uint32
+ident_mask__MemScan(const char *s, bool with_dollar)
+{
+    MemScanVec v = LOAD(s);
+    // NOTE: `c | 0x20` maps [A-Z] to [a-z], and doesn't map any other
+    // character to [a-z].
+    MemScanVec res = OR(in_range__MemScan(OR(v, SET1(0x20)), 'a', 'z'),
+                        OR(in_range__MemScan(v, '0', '9'), EQ(v, SET1('_'))));
+
+    if (with_dollar) {
+        res = OR(res, EQ(v, SET1('$')));
+    }
+
+    return MASK(res);
+}
+#endif
+
+Usize
+span_space__MemScan(const char *s, Usize len, bool with_new_line)
+{
+    Usize i = 0;
+
+#ifdef MEMSCAN_USE_SIMD
+    for (; i + MEMSCAN_WIDTH <= len; i += MEMSCAN_WIDTH) {
+        Uint32 mask = ~space_mask__MemScan(s + i, with_new_line) & FULL_MASK;
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#endif
+
+    while (i < len && is_space__MemScan(s[i], with_new_line)) {
+        ++i;
+    }
+
+    return i;
+}
+
+Usize
+span_ident__MemScan(const char *s, Usize len, bool with_dollar)
+{
+    Usize i = 0;
+
+#ifdef MEMSCAN_USE_SIMD
+    for (; i + MEMSCAN_WIDTH <= len; i += MEMSCAN_WIDTH) {
+        Uint32 mask = ~ident_mask__MemScan(s + i, with_dollar) & FULL_MASK;
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#endif
+
+    while (i < len && is_ident__MemScan(s[i], with_dollar)) {
+        ++i;
+    }
+
+    return i;
+}
+
+Usize
+find_any__MemScan(const char *s, Usize len, char c1, char c2)
+{
+    Usize i = 0;
+
+#ifdef MEMSCAN_USE_SIMD
+    MemScanVec v1 = SET1(c1);
+    MemScanVec v2 = SET1(c2);
+
+    for (; i + MEMSCAN_WIDTH <= len; i += MEMSCAN_WIDTH) {
+        MemScanVec v = LOAD(s + i);
+        Uint32 mask = MASK(OR(EQ(v, v1), EQ(v, v2)));
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#endif
+
+    while (i < len && s[i] != c1 && s[i] != c2) {
+        ++i;
+    }
+
+    return i;
+}
+
+Usize
+count__MemScan(const char *s, Usize len, char c)
+{
+    Usize i = 0;
+    Usize count = 0;
+
+#ifdef MEMSCAN_USE_SIMD
+    MemScanVec vc = SET1(c);
+
+    for (; i + MEMSCAN_WIDTH <= len; i += MEMSCAN_WIDTH) {
+        count += __builtin_popcount(MASK(EQ(LOAD(s + i), vc)));
+    }
+#endif
+
+    for (; i < len; ++i) {
+        count += s[i] == c;
+    }
+
+    return count;
+}
@@ -29,93 +29,85 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-static const OrderedHashMapBucket *
-get_bucket__OrderedHashMapBucket(const OrderedHashMapBucket *self, char *key);
+/**
+ *
+ * @brief Find the id of the key.
+ * @return Usize*? (&)
+ */
+static const Usize *
+find_id__OrderedHashMap(const OrderedHashMap *self, char *key, Usize hash);
 
-static void *
-push_bucket__OrderedHashMap(OrderedHashMap *self,
-                            Usize index,
-                            OrderedHashMapBucket *new);
+/**
+ *
+ * @brief Rehash all the ids into a table of the given capacity.
+ */
+static void
+resize__OrderedHashMap(OrderedHashMap *self, Usize capacity);
 
-CONSTRUCTOR(OrderedHashMapBucket *,
-            OrderedHashMapBucket,
-            OrderedHashMapPair pair)
+CONSTRUCTOR(OrderedHashMap *, OrderedHashMap)
 {
-    OrderedHashMapBucket *self = lily_malloc(sizeof(OrderedHashMapBucket));
+    OrderedHashMap *self = lily_malloc(sizeof(OrderedHashMap));
 
-    self->pair = pair;
-    self->next = NULL;
+    self->ctrls = NULL;
+    self->ids = NULL;
+    self->pairs = NULL;
+    self->hashes = NULL;
+    self->len = 0;
+    self->capacity = 0;
 
     return self;
 }
 
-DESTRUCTOR(OrderedHashMapBucket, OrderedHashMapBucket *self)
+const Usize *
+find_id__OrderedHashMap(const OrderedHashMap *self, char *key, Usize hash)
 {
-    if (self->next) {
-        FREE(OrderedHashMapBucket, self->next);
-    }
+    HashCtrlProbe probe = NEW(HashCtrlProbe, hash, self->capacity);
+    Int8 h2 = h2__HashCtrl(hash);
 
-    lily_free(self);
-}
+    for (;;) {
+        const Int8 *group = self->ctrls + probe.pos;
+        HashCtrlMask mask = match__HashCtrl(group, h2);
 
-CONSTRUCTOR(OrderedHashMap *, OrderedHashMap)
-{
-    OrderedHashMap *self = lily_malloc(sizeof(OrderedHashMap));
+        while (mask) {
+            const Usize *id =
+              &self->ids[(probe.pos + next__HashCtrlMask(&mask)) & probe.mask];
 
-    self->buckets = NULL;
-    self->len = 0;
-    self->capacity = DEFAULT_ORDERED_HASH_MAP_CAPACITY;
+            if (self->hashes[*id] == hash &&
+                !strcmp(self->pairs[*id].key, key)) {
+                return id;
+            }
+        }
 
-    return self;
-}
+        if (match_empty__HashCtrl(group)) {
+            return NULL;
+        }
 
-const OrderedHashMapBucket *
-get_bucket__OrderedHashMapBucket(const OrderedHashMapBucket *self, char *key)
-{
-    if (!strcmp(self->pair.key, key)) {
-        return self;
+        next__HashCtrlProbe(&probe);
     }
-
-    return self->next ? get_bucket__OrderedHashMapBucket(self->next, key)
-                      : NULL;
 }
 
 void *
 get__OrderedHashMap(OrderedHashMap *self, char *key)
 {
-    if (!self->buckets)
+    if (!self->ctrls)
         return NULL;
 
-    Usize index = index__OrderedHashMap(self, key);
-    OrderedHashMapBucket *bucket = self->buckets[index];
-
-    if (bucket) {
-        const OrderedHashMapBucket *res =
-          get_bucket__OrderedHashMapBucket(bucket, key);
+    const Usize *id =
+      find_id__OrderedHashMap(self, key, hash__OrderedHashMap(self, key));
 
-        return res ? res->pair.value : NULL;
-    }
-
-    return NULL;
+    return id ? self->pairs[*id].value : NULL;
 }
 
 const Usize *
 get_id__OrderedHashMap(OrderedHashMap *self, char *key)
 {
-    if (!self->buckets)
+    if (!self->ctrls)
         return NULL;
 
-    Usize index = index__OrderedHashMap(self, key);
-    OrderedHashMapBucket *bucket = self->buckets[index];
-
-    if (bucket) {
-        const OrderedHashMapBucket *res =
-          get_bucket__OrderedHashMapBucket(bucket, key);
+    const Usize *id =
+      find_id__OrderedHashMap(self, key, hash__OrderedHashMap(self, key));
 
-        return res ? &res->pair.id : NULL;
-    }
-
-    return NULL;
+    return id ? &self->pairs[*id].id : NULL;
 }
 
 void *
@@ -133,58 +125,35 @@ get_from_id__OrderedHashMap(OrderedHashMap *self, Usize id)
 OrderedHashMapPair *
 get_pair_from_id__OrderedHashMap(OrderedHashMap *self, Usize id)
 {
-    if (id > self->capacity || !self->buckets)
-        return NULL;
-
-    for (Usize i = 0; i < self->capacity; ++i) {
-        OrderedHashMapBucket *current_bucket = self->buckets[i];
-
-        if (current_bucket) {
-            while (current_bucket->next) {
-                if (current_bucket->pair.id == id) {
-                    return &current_bucket->pair;
-                }
-
-                current_bucket = current_bucket->next;
-            }
-
-            if (current_bucket->pair.id == id) {
-                return &current_bucket->pair;
-            }
-        }
-    }
-
-    return NULL;
+    return id < self->len ? &self->pairs[id] : NULL;
 }
 
-void *
-push_bucket__OrderedHashMap(OrderedHashMap *self,
-                            Usize index,
-                            OrderedHashMapBucket *new)
+void
+resize__OrderedHashMap(OrderedHashMap *self, Usize capacity)
 {
-    void *is_exist = get__OrderedHashMap(self, new->pair.key);
-
-    if (is_exist) {
-        FREE(OrderedHashMapBucket, new);
+    Usize max_len = HASH_CTRL_MAX_LOAD(capacity);
 
-        return is_exist;
+    if (self->ctrls) {
+        lily_free(self->ctrls);
+        lily_free(self->ids);
     }
 
-    if (self->buckets[index]) {
-        OrderedHashMapBucket *current = self->buckets[index];
-
-        while (current->next) {
-            current = current->next;
-        }
-
-        current->next = new;
-
-        return NULL;
+    self->ctrls = new__HashCtrl(capacity);
+    self->ids = lily_malloc(sizeof(Usize) * capacity);
+    self->pairs =
+      lily_realloc(self->pairs, sizeof(OrderedHashMapPair) * max_len);
+    self->hashes = lily_realloc(self->hashes, sizeof(Usize) * max_len);
+    self->capacity = capacity;
+
+    // Re-hash all inserted ids (with their stored hash)
+    for (Usize i = 0; i < self->len; ++i) {
+        Usize index =
+          find_insert_slot__HashCtrl(self->ctrls, capacity, self->hashes[i]);
+
+        set__HashCtrl(
+          self->ctrls, capacity, index, h2__HashCtrl(self->hashes[i]));
+        self->ids[index] = i;
     }
-
-    self->buckets[index] = new;
-
-    return NULL;
 }
 
 OrderedHashMap *
@@ -221,61 +190,61 @@ vinit__OrderedHashMap(Usize count, va_list arg)
 void *
 insert__OrderedHashMap(OrderedHashMap *self, char *key, void *value)
 {
-    Usize index = index__OrderedHashMap(self, key);
-
-    if (!self->buckets) {
-        self->buckets =
-          lily_calloc(DEFAULT_ORDERED_HASH_MAP_CAPACITY, PTR_SIZE);
-        self->buckets[index] =
-          NEW(OrderedHashMapBucket,
-              NEW(OrderedHashMapPair, key, value, self->len++));
+    Usize hash = hash__OrderedHashMap(self, key);
 
-        return NULL;
-    }
+    if (!self->ctrls) {
+        resize__OrderedHashMap(self, DEFAULT_ORDERED_HASH_MAP_CAPACITY);
+    } else {
+        const Usize *is_exist = find_id__OrderedHashMap(self, key, hash);
 
-    if (self->len + 1 > self->capacity) {
-        self->capacity *= 2;
+        if (is_exist) {
+            return self->pairs[*is_exist].value;
+        }
 
-        OrderedHashMapBucket **new_buckets =
-          lily_calloc(self->capacity, PTR_SIZE);
-        OrderedHashMapBucket **old_buckets = self->buckets;
+        if (self->len == HASH_CTRL_MAX_LOAD(self->capacity)) {
+            resize__OrderedHashMap(self, self->capacity * 2);
+        }
+    }
 
-        self->buckets = new_buckets;
+    Usize index = find_insert_slot__HashCtrl(self->ctrls, self->capacity, hash);
 
-        // Re-hash all inserted K-V
-        for (Usize i = 0; i < self->len; ++i) {
-            OrderedHashMapBucket *current = old_buckets[i];
+    set__HashCtrl(self->ctrls, self->capacity, index, h2__HashCtrl(hash));
+    self->ids[index] = self->len;
+    self->pairs[self->len] = NEW(OrderedHashMapPair, key, value, self->len);
+    self->hashes[self->len] = hash;
+    ++self->len;
 
-            while (current != NULL) {
-                OrderedHashMapBucket *next = current->next;
-                Usize new_index =
-                  index__OrderedHashMap(self, current->pair.key);
+    return NULL;
+}
 
-                current->next = new_buckets[new_index];
-                new_buckets[new_index] = current;
-                current = next;
-            }
-        }
+void *
+remove__OrderedHashMap(OrderedHashMap *self, char *key)
+{
+    if (!self->ctrls)
+        return NULL;
 
-        lily_free(old_buckets);
+    const Usize *id =
+      find_id__OrderedHashMap(self, key, hash__OrderedHashMap(self, key));
 
-        // Reload index
-        index = index__OrderedHashMap(self, key);
+    if (!id) {
+        return NULL;
     }
 
-    void *is_exist = push_bucket__OrderedHashMap(
-      self,
-      index,
-      NEW(OrderedHashMapBucket,
-          NEW(OrderedHashMapPair, key, value, self->len)));
+    Usize removed_id = *id;
+    void *value = self->pairs[removed_id].value;
 
-    if (is_exist) {
-        return is_exist;
+    for (Usize i = removed_id + 1; i < self->len; ++i) {
+        self->pairs[i - 1] = self->pairs[i];
+        self->pairs[i - 1].id = i - 1;
+        self->hashes[i - 1] = self->hashes[i];
     }
 
-    ++self->len;
+    --self->len;
 
-    return NULL;
+    // Rebuild the table, because all the next ids are shifted.
+    resize__OrderedHashMap(self, self->capacity);
+
+    return value;
 }
 
 void *
@@ -288,14 +257,11 @@ last__OrderedHashMap(OrderedHashMap *self)
 
 DESTRUCTOR(OrderedHashMap, OrderedHashMap *self)
 {
-    if (self->buckets) {
-        for (Usize i = 0; i < self->capacity; ++i) {
-            if (self->buckets[i]) {
-                FREE(OrderedHashMapBucket, self->buckets[i]);
-            }
-        }
-
-        lily_free(self->buckets);
+    if (self->ctrls) {
+        lily_free(self->ctrls);
+        lily_free(self->ids);
+        lily_free(self->pairs);
+        lily_free(self->hashes);
     }
 
     lily_free(self);
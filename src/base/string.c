@@ -277,17 +277,31 @@ push__String(String *self, char item)
 void
 push_str__String(String *self, char *s)
 {
-    for (Usize i = 0; s[i++];) {
-        push__String(self, s[i - 1]);
-    }
+    push_str_with_len__String(self, s, strlen(s));
 }
 
 void
 push_str_with_len__String(String *self, const char *s, Usize len)
 {
-    for (Usize i = 0; i < len; ++i) {
-        push__String(self, s[i]);
+    if (len == 0) {
+        return;
+    }
+
+    // Grow once for the whole str (+1 for the null terminator).
+    if (self->len + len + 1 > self->capacity) {
+        Usize new_capacity =
+          self->capacity ? self->capacity : STRING_DEFAULT_CAPACITY;
+
+        while (new_capacity < self->len + len + 1) {
+            new_capacity *= 2;
+        }
+
+        grow__String(self, new_capacity);
     }
+
+    memcpy(self->buffer + self->len, s, len);
+    self->len += len;
+    self->buffer[self->len] = '\0';
 }
 
 char
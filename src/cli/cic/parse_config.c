@@ -23,6 +23,7 @@
  */
 
 #include <base/assert.h>
+#include <base/atoi.h>
 #include <base/cli/result.h>
 
 #include <cli/cic/parse_config.h>
@@ -42,15 +43,18 @@
 #define V_OPTION 2
 #define VERSION_OPTION 3
 */
-#define MODE_OPTION 0           // (4 or 2)
-#define F_OPTION 1              // (5 or 3)
-#define FILE_OPTION 2           // (6 or 4)
-#define S_OPTION 3              // (7 or 5)
-#define STD_OPTION 4            // (8 or 6)
-#define I_OPTION 5              // (9 or 7)
-#define INCLUDE_OPTION 6        // (10 or 8)
-#define INCLUDE0_OPTION 7       // (11 or 9)
-#define NO_STATE_CHECK_OPTION 8 // (12 or 10)
+#define MODE_OPTION 0              // (4 or 2)
+#define F_OPTION 1                 // (5 or 3)
+#define FILE_OPTION 2              // (6 or 4)
+#define S_OPTION 3                 // (7 or 5)
+#define STD_OPTION 4               // (8 or 6)
+#define I_OPTION 5                 // (9 or 7)
+#define INCLUDE_OPTION 6           // (10 or 8)
+#define INCLUDE0_OPTION 7          // (11 or 9)
+#define NO_STATE_CHECK_OPTION 8    // (12 or 10)
+#define J_OPTION 9                 // (13 or 11)
+#define JOBS_OPTION 10             // (14 or 12)
+#define JSON_DIAGNOSTICS_OPTION 11 // (15 or 13)
 
 /// @brief Get offset, given the purpose.
 static int
@@ -87,6 +91,8 @@ run_base__CIcParseConfig(const Vec *results, enum CIcParseConfigPurpose purpose)
     Vec *includes = NEW(Vec);  // Vec<char* (&)>*
     Vec *includes0 = NEW(Vec); // Vec<char* (&)>*
     bool no_state_check = false;
+    const char *jobs = NULL;
+    bool json_diagnostics = false;
 
     VecIter iter = NEW(VecIter, results);
     CliResult *current = NULL;
@@ -176,6 +182,19 @@ run_base__CIcParseConfig(const Vec *results, enum CIcParseConfigPurpose purpose)
                     case NO_STATE_CHECK_OPTION:
                         no_state_check = true;
 
+                        break;
+                    case J_OPTION:
+                    case JOBS_OPTION:
+                        ASSERT(current->option->value);
+                        ASSERT(current->option->value->kind ==
+                               CLI_RESULT_VALUE_KIND_SINGLE);
+
+                        jobs = current->option->value->single;
+
+                        break;
+                    case JSON_DIAGNOSTICS_OPTION:
+                        json_diagnostics = true;
+
                         break;
                     default:
                         UNREACHABLE("unknown option");
@@ -203,6 +222,13 @@ run_base__CIcParseConfig(const Vec *results, enum CIcParseConfigPurpose purpose)
         standard = CI_STANDARD_99;
     }
 
+    Usize jobs_len = jobs ? atoi__Usize(jobs, 10) : 0;
+
+    if (jobs_len == 0 && jobs) {
+        EMIT_ERROR("you cannot set the number of jobs to 0");
+        exit(1);
+    }
+
     return NEW(CIcConfig,
                path,
                mode,
@@ -210,7 +236,9 @@ run_base__CIcParseConfig(const Vec *results, enum CIcParseConfigPurpose purpose)
                standard,
                includes,
                includes0,
-               no_state_check);
+               no_state_check,
+               jobs_len,
+               json_diagnostics);
 }
 
 CIcConfig
@@ -68,6 +68,8 @@
 #define RUN_ARGS_OPTION 4
 #define RUN_MAX_STACK_OPTION 5
 #define RUN_MAX_HEAP_OPTION 6
+#define RUN_J_OPTION 7
+#define RUN_JOBS_OPTION 8
 
 // NOTE: The following options, are builtin:
 /*
@@ -269,7 +271,7 @@ parse_run__LilyParseConfig(const Vec *results)
     bool verbose = false;
     char *filename = NULL;
     Vec *args = init__Vec(1, "<app>");
-    char *max_stack = NULL, *max_heap = NULL;
+    char *max_stack = NULL, *max_heap = NULL, *jobs = NULL;
     VecIter iter = NEW(VecIter, results);
     CliResult *current = NULL;
 
@@ -298,6 +300,10 @@ parse_run__LilyParseConfig(const Vec *results)
                     case RUN_MAX_HEAP_OPTION:
                         max_heap = current->option->value->single;
                         break;
+                    case RUN_J_OPTION:
+                    case RUN_JOBS_OPTION:
+                        jobs = current->option->value->single;
+                        break;
                     default:
                         UNREACHABLE("unknown option");
                 }
@@ -310,6 +316,7 @@ parse_run__LilyParseConfig(const Vec *results)
 
     Usize max_stack_capacity = max_stack ? atoi__Usize(max_stack, 10) : 0;
     Usize max_heap_capacity = max_heap ? atoi__Usize(max_heap, 10) : 0;
+    Usize jobs_len = jobs ? atoi__Usize(jobs, 10) : 0;
 
     // TODO: maybe set a minimum max stack capacity
     if ((max_stack_capacity == 0 && max_stack)) {
@@ -321,6 +328,10 @@ parse_run__LilyParseConfig(const Vec *results)
         EMIT_ERROR("you cannot set the heap capacity to 0");
     }
 
+    if (jobs_len == 0 && jobs) {
+        EMIT_ERROR("you cannot set the number of jobs to 0");
+    }
+
     return NEW_VARIANT(LilyConfig,
                        run,
                        NEW(LilyConfigRun,
@@ -328,7 +339,8 @@ parse_run__LilyParseConfig(const Vec *results)
                            verbose,
                            args,
                            max_stack_capacity,
-                           max_heap_capacity));
+                           max_heap_capacity,
+                           jobs_len));
 }
 
 LilyConfig
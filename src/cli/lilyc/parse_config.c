@@ -23,6 +23,7 @@
  */
 
 #include <base/assert.h>
+#include <base/atoi.h>
 #include <base/cli/result.h>
 
 #include <cli/emit.h>
@@ -77,6 +78,10 @@
 #define VERBOSE_OPTION 40
 #define R_OPTION 41
 #define RUN_OPTION 42
+#define J_OPTION 43
+#define JOBS_OPTION 44
+#define CACHE_STATS_OPTION 45
+#define SKIP_TEARDOWN_OPTION 46
 
 LilycConfig
 run__LilycParseConfig(const Vec *results)
@@ -95,8 +100,11 @@ run__LilycParseConfig(const Vec *results)
     bool o0 = false, o1 = false, o2 = false, o3 = false, oz = false;
     bool verbose = false;
     bool run = false;
+    bool cache_stats = false;
+    bool skip_teardown = false;
     const char *target = NULL;
     const char *output = NULL;
+    const char *jobs = NULL;
     VecIter iter = NEW(VecIter, results);
     CliResult *current = NULL;
 
@@ -220,6 +228,16 @@ run__LilycParseConfig(const Vec *results)
                     case RUN_OPTION:
                         run = true;
                         break;
+                    case J_OPTION:
+                    case JOBS_OPTION:
+                        jobs = current->option->value->single;
+                        break;
+                    case CACHE_STATS_OPTION:
+                        cache_stats = true;
+                        break;
+                    case SKIP_TEARDOWN_OPTION:
+                        skip_teardown = true;
+                        break;
                     default:
                         UNREACHABLE("unknown option");
                 }
@@ -238,6 +256,13 @@ run__LilycParseConfig(const Vec *results)
         exit(1);
     }
 
+    Usize jobs_len = jobs ? atoi__Usize(jobs, 10) : 0;
+
+    if (jobs_len == 0 && jobs) {
+        EMIT_ERROR("you cannot set the number of jobs to 0");
+        exit(1);
+    }
+
     return NEW(LilycConfig,
                filename,
                target,
@@ -271,5 +296,8 @@ run__LilycParseConfig(const Vec *results)
                o3,
                oz,
                verbose,
-               run);
+               run,
+               jobs_len,
+               cache_stats,
+               skip_teardown);
 }
@@ -36,10 +36,38 @@
 #include <core/cc/ci/state_checker.h>
 #include <core/cc/ci/typecheck.h>
 #include <core/cc/ci/visitor.h>
+#include <core/shared/diagnostic.h>
 
 #include <stdio.h>
 #include <stdlib.h>
 
+struct CIcPipeline
+{
+    CIVisitor *visitor;            // CIVisitor* (&)
+    CITypecheck *typecheck;        // CITypecheck* (&)
+    CIStateChecker *state_checker; // CIStateChecker* (&)
+};
+
+/**
+ *
+ * @brief Run the stages which are applied file by file (visitor, typecheck,
+ * state checker and generator).
+ * @param other_args void* (&) (struct CIcPipeline* (&))
+ */
+static void
+run_pipeline__CIc(CIResult *result, void *other_args);
+
+void
+run_pipeline__CIc(CIResult *result, void *other_args)
+{
+    struct CIcPipeline *pipeline = other_args;
+
+    run__CIVisitor(pipeline->visitor);
+    run__CITypecheck(pipeline->typecheck);
+    run__CIStateChecker(pipeline->state_checker);
+    run__CIGenerator(result);
+}
+
 void
 run__CIc(const CIcConfig *config,
          void (*handler)(const CIResult *result, void *other_args),
@@ -58,14 +86,24 @@ run__CIc(const CIcConfig *config,
     CITypecheck typecheck = NEW(CITypecheck, &result);
     CIStateChecker state_checker = NEW(CIStateChecker, &result);
 
+    if (config->json_diagnostics) {
+        set_format__Diagnostic(DIAGNOSTIC_FORMAT_JSON);
+    }
+
     set__CIBuiltin(&builtin);
     build__CIResult(&result);
-    run__CIVisitor(&visitor);
-    run__CITypecheck(&typecheck);
-    run__CIStateChecker(&state_checker);
-    run__CIGenerator(&result);
 
-    exec__CICompile(&result);
+    // NOTE: The files are built sequentially, because the headers (and their
+    // tokens) are shared by all the files. Then, the files are visited,
+    // checked and generated by several workers.
+    struct CIcPipeline pipeline = { .visitor = &visitor,
+                                    .typecheck = &typecheck,
+                                    .state_checker = &state_checker };
+
+    run_in_parallel__CIResult(
+      &result, &run_pipeline__CIc, &pipeline, config->jobs);
+
+    Usize failed = exec__CICompile(&result, config->jobs);
 
     if (handler) {
         handler(&result, other_args);
@@ -75,4 +113,8 @@ run__CIc(const CIcConfig *config,
     FREE(CIBuiltin, &builtin);
     FREE(CIProjectConfig, &project_config);
     FREE(CIStateChecker, &state_checker);
+
+    if (failed > 0) {
+        exit(EXIT_ERR);
+    }
 }
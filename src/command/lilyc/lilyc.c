@@ -89,7 +89,9 @@ run__Lilyc(const LilycConfig *config)
                                            &program);
 
 #if !defined(RUN_UNTIL_PREPARSER) && !defined(RUN_UNTIL_PRECOMPILER)
-        FREE(LilyLibrary, lib);
+        if (!config->skip_teardown) {
+            FREE(LilyLibrary, lib);
+        }
 #endif
     } else {
         LilyPackage *pkg =
@@ -112,7 +114,9 @@ run__Lilyc(const LilycConfig *config)
         }
 
 #if !defined(RUN_UNTIL_PREPARSER) && !defined(RUN_UNTIL_PRECOMPILER)
-        FREE(LilyPackage, pkg);
+        if (!config->skip_teardown) {
+            FREE(LilyPackage, pkg);
+        }
 #endif
     }
 
@@ -121,7 +125,14 @@ run__Lilyc(const LilycConfig *config)
     // NOTE: Do not move this `free` otherwise it could cause double free. In
     // short, always free the program pointer after the package
     // pointer or library pointer.
-    FREE(LilyProgram, &program);
+    //
+    // NOTE: With `--skip-teardown`, the package (or the library) and the
+    // program are not freed: the compiler exits right after the compilation,
+    // so the memory is released by the OS at once instead of walking all the
+    // trees of the package.
+    if (!config->skip_teardown) {
+        FREE(LilyProgram, &program);
+    }
 
 exit:
 #if defined(LILY_LINUX_OS) || defined(LILY_BSD_OS)
@@ -22,103 +22,377 @@
  * SOFTWARE.
  */
 
+#include <base/alloc.h>
+#include <base/atoi.h>
 #include <base/dir.h>
+#include <base/dir_separator.h>
+#include <base/file.h>
+#include <base/format.h>
+#include <base/hash/sip.h>
+#include <base/hash_map.h>
+#include <base/job_runner.h>
+#include <base/str.h>
 
 #include <core/cc/ci/compile.h>
 #include <core/cc/ci/result.h>
 
-static String *
-build_bin_compile_command__CICompile(const CIResultBin *bin,
-                                     const CIResultFile *file);
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-static String *
-build_lib_compile_command__CICompile(const CIResultLib *lib,
-                                     const CIResultFile *file);
+// The manifest is written in the output directory (see
+// get_output_path__CIResult).
+#define CI_COMPILE_MANIFEST "compile.manifest"
+
+#ifdef PLATFORM_64
+#define CI_COMPILE_K0 0x0123456789abcdefULL
+#define CI_COMPILE_K1 0xfedcba9876543210ULL
+#else
+#define CI_COMPILE_K0 0x01234567
+#define CI_COMPILE_K1 0x89abcdef
+#endif
+
+// The libraries are compiled before the binaries, because the binaries can
+// depend on them.
+#define CI_COMPILE_STAGE_LIB 0
+#define CI_COMPILE_STAGE_BIN 1
+
+typedef struct CICompileEntry
+{
+    char *output_path;
+    Usize key;
+} CICompileEntry;
+
+typedef struct CICompile
+{
+    JobRunner runner;
+    Vec *entries; // Vec<CICompileEntry*>*
+    // Entries loaded from the manifest (or updated after the compilation).
+    HashMap *manifest; // HashMap<CICompileEntry* (&)>*
+    // Entry of each job of the runner (same index).
+    Vec *job_entries; // Vec<CICompileEntry* (&)>*
+} CICompile;
+
+/**
+ *
+ * @brief Construct CICompileEntry type.
+ */
+static CONSTRUCTOR(CICompileEntry *,
+                   CICompileEntry,
+                   char *output_path,
+                   Usize key);
+
+/**
+ *
+ * @brief Free CICompileEntry type.
+ */
+static DESTRUCTOR(CICompileEntry, CICompileEntry *self);
+
+/**
+ *
+ * @brief Construct CICompile type.
+ */
+static CONSTRUCTOR(CICompile, CICompile, Usize jobs);
+
+/**
+ *
+ * @brief Load the entries of the manifest.
+ */
+static void
+load_manifest__CICompile(CICompile *self);
+
+/**
+ *
+ * @brief Write the entries of the manifest.
+ */
+static void
+write_manifest__CICompile(const CICompile *self);
+
+/**
+ *
+ * @brief Compute the key of the compilation, from the content of the generated
+ * C file and from the arguments passed to the compiler.
+ * @param args const Vec<char*>* (&)
+ * @return Return 0 if the generated C file doesn't exist.
+ */
+static Usize
+compute_key__CICompile(const char *gen_file, const Vec *args);
+
+/**
+ *
+ * @brief Build the arguments passed to the compiler.
+ * @return Vec<char*>*
+ */
+static Vec *
+build_args__CICompile(const CIResultFile *file,
+                      const char *gen_file,
+                      const char *output_path,
+                      bool is_lib);
+
+/**
+ *
+ * @brief Add the compilation of the generated C file to the runner, unless its
+ * output is up to date.
+ */
+static void
+add__CICompile(CICompile *self,
+               const CIResultFile *file,
+               enum CIDirResultPurpose purpose,
+               const char *name);
 
 /// @param file const CIResultFile* (&)
+/// @param other_args CICompile*
 static void
-handler__CICompile(void *entity,
-                   const CIResultFile *file,
-                   [[maybe_unused]] void *other_args);
+handler__CICompile(void *entity, const CIResultFile *file, void *other_args);
+
+/**
+ *
+ * @brief Free CICompile type.
+ */
+static DESTRUCTOR(CICompile, const CICompile *self);
 
 static const char *standard_options[] = {
-    [CI_STANDARD_NONE] = "",        [CI_STANDARD_KR] = "",
-    [CI_STANDARD_89] = " -std=c89", [CI_STANDARD_95] = " -std=c90",
-    [CI_STANDARD_99] = " -std=c99", [CI_STANDARD_11] = " -std=c11",
-    [CI_STANDARD_17] = " -std=c17", [CI_STANDARD_23] = " -std=c23"
+    [CI_STANDARD_NONE] = NULL,     [CI_STANDARD_KR] = NULL,
+    [CI_STANDARD_89] = "-std=c89", [CI_STANDARD_95] = "-std=c90",
+    [CI_STANDARD_99] = "-std=c99", [CI_STANDARD_11] = "-std=c11",
+    [CI_STANDARD_17] = "-std=c17", [CI_STANDARD_23] = "-std=c23"
 };
 
-String *
-build_bin_compile_command__CICompile(const CIResultBin *bin,
-                                     const CIResultFile *file)
+CONSTRUCTOR(CICompileEntry *, CICompileEntry, char *output_path, Usize key)
 {
-    String *bin_dir_result =
-      get_dir_result__CIResultFile(file, CI_DIR_RESULT_PURPOSE_BIN);
+    CICompileEntry *self = lily_malloc(sizeof(CICompileEntry));
 
-    create_recursive_dir__Dir(bin_dir_result->buffer,
-                              DIR_MODE_RWXU | DIR_MODE_RWXG | DIR_MODE_RWXO);
+    self->output_path = output_path;
+    self->key = key;
 
-    String *gen_c_dir_result =
-      get_dir_result__CIResultFile(file, CI_DIR_RESULT_PURPOSE_C_GEN);
-    String *gen_file = format__String(
-      "{Sr}/{S}", gen_c_dir_result, file->entity.filename_result);
-    String *command = format__String("{S} {Sr}{s} -o {Sr}/{s}",
-                                     file->config->compiler.command,
-                                     gen_file,
-                                     standard_options[file->config->standard],
-                                     bin_dir_result,
-                                     bin->name);
-
-    return command;
+    return self;
+}
+
+DESTRUCTOR(CICompileEntry, CICompileEntry *self)
+{
+    lily_free(self->output_path);
+    lily_free(self);
+}
+
+CONSTRUCTOR(CICompile, CICompile, Usize jobs)
+{
+    CICompile self = { .runner = NEW(JobRunner, jobs),
+                       .entries = NEW(Vec),
+                       .manifest = NEW(HashMap),
+                       .job_entries = NEW(Vec) };
+
+    load_manifest__CICompile(&self);
+
+    return self;
+}
+
+void
+load_manifest__CICompile(CICompile *self)
+{
+    char *path = get_output_path__CIResult(CI_COMPILE_MANIFEST);
+
+    if (!exists__File(path)) {
+        lily_free(path);
+
+        return;
+    }
+
+    char *content = read_file__File(path);
+    char *line = content;
+
+    lily_free(path);
+
+    while (*line) {
+        char *line_end = strchr(line, '\n');
+
+        if (line_end) {
+            *line_end = '\0';
+        }
+
+        char *key = strrchr(line, ' ');
+
+        // NOTE: A malformed line is ignored, so the file is recompiled.
+        if (key && key != line && key[1]) {
+            *key++ = '\0';
+
+            CICompileEntry *entry =
+              NEW(CICompileEntry, strdup(line), atoi__Usize(key, 10));
+
+            push__Vec(self->entries, entry);
+
+            // NOTE: If the output is duplicated in the manifest, the first
+            // entry is kept.
+            insert__HashMap(self->manifest, entry->output_path, entry);
+        }
+
+        if (!line_end) {
+            break;
+        }
+
+        line = line_end + 1;
+    }
+
+    lily_free(content);
+}
+
+void
+write_manifest__CICompile(const CICompile *self)
+{
+    String *content = NEW(String);
+    HashMapIter iter = NEW(HashMapIter, self->manifest);
+    CICompileEntry *current = NULL;
+
+    while ((current = next__HashMapIter(&iter))) {
+        char *line =
+          format("{s} {zu}\n", current->output_path, current->key);
+
+        PUSH_STR_AND_FREE(content, line);
+    }
+
+    char *path = get_output_path__CIResult(CI_COMPILE_MANIFEST);
+
+    write_file__File(path, content->buffer, content->len);
+
+    lily_free(path);
+    FREE(String, content);
+}
+
+Usize
+compute_key__CICompile(const char *gen_file, const Vec *args)
+{
+    if (!exists__File(gen_file)) {
+        return 0;
+    }
+
+    char *content = read_file__File(gen_file);
+    Usize key =
+      hash_sip(content, strlen(content), CI_COMPILE_K0, CI_COMPILE_K1);
+
+    lily_free(content);
+
+    for (Usize i = 0; i < args->len; ++i) {
+        const char *arg = get__Vec(args, i);
+        Usize pair[2] = {
+            key, hash_sip(arg, strlen(arg), CI_COMPILE_K0, CI_COMPILE_K1)
+        };
+
+        key = hash_sip(pair, sizeof(pair), CI_COMPILE_K0, CI_COMPILE_K1);
+    }
+
+    // NOTE: The key 0 is used to know that the key cannot be computed.
+    return key ? key : 1;
 }
 
-String *
-build_lib_compile_command__CICompile(const CIResultLib *lib,
-                                     const CIResultFile *file)
+Vec *
+build_args__CICompile(const CIResultFile *file,
+                      const char *gen_file,
+                      const char *output_path,
+                      bool is_lib)
 {
-    String *lib_dir_result =
-      get_dir_result__CIResultFile(file, CI_DIR_RESULT_PURPOSE_LIB);
+    ASSERT(file->config->compiler.command);
+
+    // NOTE: The command of the compiler can contain some arguments (e.g.
+    // `gcc -g`), but it's not interpreted by a shell.
+    Vec *args = split__Str(file->config->compiler.command->buffer, ' ');
+
+    for (Usize i = 0; i < args->len;) {
+        char *arg = get__Vec(args, i);
+
+        if (*arg) {
+            ++i;
+        } else {
+            lily_free(remove__Vec(args, i));
+        }
+    }
 
-    create_recursive_dir__Dir(lib_dir_result->buffer,
+    ASSERT(args->len > 0);
+
+    push__Vec(args, strdup(gen_file));
+
+    const char *standard_option = standard_options[file->config->standard];
+
+    if (standard_option) {
+        push__Vec(args, strdup(standard_option));
+    }
+
+    if (is_lib) {
+        push__Vec(args, strdup("-static"));
+    }
+
+    push__Vec(args, strdup("-o"));
+    push__Vec(args, strdup(output_path));
+
+    return args;
+}
+
+void
+add__CICompile(CICompile *self,
+               const CIResultFile *file,
+               enum CIDirResultPurpose purpose,
+               const char *name)
+{
+    String *output_dir_result = get_dir_result__CIResultFile(file, purpose);
+
+    create_recursive_dir__Dir(output_dir_result->buffer,
                               DIR_MODE_RWXU | DIR_MODE_RWXG | DIR_MODE_RWXO);
 
     String *gen_c_dir_result =
       get_dir_result__CIResultFile(file, CI_DIR_RESULT_PURPOSE_C_GEN);
     String *gen_file = format__String(
       "{Sr}/{S}", gen_c_dir_result, file->entity.filename_result);
-    String *command = format__String("{S} {Sr}{s} -static -o {Sr}/{s}",
-                                     file->config->compiler.command,
-                                     gen_file,
-                                     standard_options[file->config->standard],
-                                     lib_dir_result,
-                                     lib->name);
-
-    return command;
+    String *output_path =
+      format__String("{Sr}/{s}", output_dir_result, name);
+    bool is_lib = purpose == CI_DIR_RESULT_PURPOSE_LIB;
+    Vec *args = build_args__CICompile(
+      file, gen_file->buffer, output_path->buffer, is_lib);
+    Usize key = compute_key__CICompile(gen_file->buffer, args);
+    CICompileEntry *entry =
+      get__HashMap(self->manifest, output_path->buffer);
+
+    FREE(String, gen_file);
+
+    // NOTE: The compilation is skipped, if the generated C file and the
+    // arguments are the same as the last compilation.
+    if (key && entry && entry->key == key &&
+        exists__File(output_path->buffer)) {
+        for (Usize i = 0; i < args->len; ++i) {
+            lily_free(get__Vec(args, i));
+        }
+
+        FREE(Vec, args);
+        FREE(String, output_path);
+
+        return;
+    }
+
+    entry = NEW(CICompileEntry, strdup(output_path->buffer), key);
+
+    push__Vec(self->entries, entry);
+    push__Vec(self->job_entries, entry);
+    add__JobRunner(
+      &self->runner,
+      NEW(Job, args, is_lib ? CI_COMPILE_STAGE_LIB : CI_COMPILE_STAGE_BIN));
+
+    FREE(String, output_path);
 }
 
 void
-handler__CICompile(void *entity,
-                   const CIResultFile *file,
-                   [[maybe_unused]] void *other_args)
+handler__CICompile(void *entity, const CIResultFile *file, void *other_args)
 {
+    CICompile *self = other_args;
+
     switch (file->entity.kind) {
         case CI_RESULT_ENTITY_KIND_BIN: {
             const CIResultBin *bin = entity;
-            String *command = build_bin_compile_command__CICompile(bin, file);
 
-            system(command->buffer);
-
-            FREE(String, command);
+            add__CICompile(self, file, CI_DIR_RESULT_PURPOSE_BIN, bin->name);
 
             break;
         }
         case CI_RESULT_ENTITY_KIND_LIB: {
             const CIResultLib *lib = entity;
-            String *command = build_lib_compile_command__CICompile(lib, file);
-
-            system(command->buffer);
 
-            FREE(String, command);
+            add__CICompile(self, file, CI_DIR_RESULT_PURPOSE_LIB, lib->name);
 
             break;
         }
@@ -129,8 +403,60 @@ handler__CICompile(void *entity,
     }
 }
 
-void
-exec__CICompile(const CIResult *result)
+DESTRUCTOR(CICompile, const CICompile *self)
 {
-    pass_through_result__CIResult(result, &handler__CICompile, NULL);
+    FREE(JobRunner, &self->runner);
+    FREE_BUFFER_ITEMS(
+      self->entries->buffer, self->entries->len, CICompileEntry);
+    FREE(Vec, self->entries);
+    FREE(HashMap, self->manifest);
+    FREE(Vec, self->job_entries);
+}
+
+Usize
+exec__CICompile(const CIResult *result, Usize jobs)
+{
+    CICompile self = NEW(CICompile, jobs);
+    Usize failed = 0;
+
+    pass_through_result__CIResult(result, &handler__CICompile, &self);
+
+    if (self.runner.jobs->len > 0) {
+        failed = run__JobRunner(&self.runner);
+
+        bool manifest_is_updated = false;
+
+        for (Usize i = 0; i < self.runner.jobs->len; ++i) {
+            const Job *job = get__Vec(self.runner.jobs, i);
+            CICompileEntry *job_entry = get__Vec(self.job_entries, i);
+
+            if (job->err->len > 0) {
+                fputs(job->err->buffer, stderr);
+            }
+
+            if (has_failed__Job(job) || !job_entry->key) {
+                continue;
+            }
+
+            CICompileEntry *entry =
+              get__HashMap(self.manifest, job_entry->output_path);
+
+            if (entry) {
+                entry->key = job_entry->key;
+            } else {
+                insert__HashMap(
+                  self.manifest, job_entry->output_path, job_entry);
+            }
+
+            manifest_is_updated = true;
+        }
+
+        if (manifest_is_updated) {
+            write_manifest__CICompile(&self);
+        }
+    }
+
+    FREE(CICompile, &self);
+
+    return failed;
 }
@@ -438,6 +438,27 @@ static void
 generate_variable_decl__CIGenerator(CIGenerator *self,
                                     const CIDeclVariable *variable);
 
+/// @return const Rc<String*>* (&)
+static const Rc *
+get_gen_origin__CIGenerator(const CIDecl *decl);
+
+/// @return const CIGeneratorGenCacheEntry*? (&)
+static const CIGeneratorGenCacheEntry *
+get_gen_cache_entry__CIGenerator(const CIGenerator *self, const CIDecl *decl);
+
+/// @brief Generate the dependencies of the cached instantiation, then write its
+/// content.
+static void
+generate_gen_cache_entry__CIGenerator(CIGenerator *self,
+                                      const CIGeneratorGenCacheEntry *entry);
+
+/// @brief Add the entry to the cache with the content of the current session,
+/// or free it if it can't be cached.
+/// @param entry CIGeneratorGenCacheEntry*
+static void
+add_gen_cache_entry__CIGenerator(CIGenerator *self,
+                                 CIGeneratorGenCacheEntry *entry);
+
 static void
 generate_decl__CIGenerator(CIGenerator *self, const CIDecl *decl);
 
@@ -453,10 +474,11 @@ generate_global_decls_prototype__CIGenerator(CIGenerator *self);
 static void
 run_file__CIGenerator(CIGenerator *self);
 
+/// @param other_args CIGeneratorGenCache* (&)
 static void
 handler__CIGenerator([[maybe_unused]] void *entity,
                      const CIResultFile *file,
-                     [[maybe_unused]] void *other_args);
+                     void *other_args);
 
 CONSTRUCTOR(CIGeneratorContentSession *,
             CIGeneratorContentSession,
@@ -482,6 +504,64 @@ DESTRUCTOR(CIGeneratorContentSession, CIGeneratorContentSession *self)
     lily_free(self);
 }
 
+CONSTRUCTOR(CIGeneratorGenCacheDependency *,
+            CIGeneratorGenCacheDependency,
+            CIDecl *(*search)(const CIResultFile *, const String *),
+            const String *name)
+{
+    CIGeneratorGenCacheDependency *self =
+      lily_malloc(sizeof(CIGeneratorGenCacheDependency));
+
+    self->search = search;
+    self->name = clone__String((String *)name);
+
+    return self;
+}
+
+DESTRUCTOR(CIGeneratorGenCacheDependency, CIGeneratorGenCacheDependency *self)
+{
+    FREE(String, self->name);
+    lily_free(self);
+}
+
+CONSTRUCTOR(CIGeneratorGenCacheEntry *,
+            CIGeneratorGenCacheEntry,
+            const Rc *origin,
+            const String *name)
+{
+    CIGeneratorGenCacheEntry *self =
+      lily_malloc(sizeof(CIGeneratorGenCacheEntry));
+
+    self->origin = origin;
+    self->name = clone__String((String *)name);
+    self->content = NULL;
+    self->dependencies = NEW(Vec);
+    self->is_cacheable = true;
+
+    return self;
+}
+
+DESTRUCTOR(CIGeneratorGenCacheEntry, CIGeneratorGenCacheEntry *self)
+{
+    FREE(String, self->name);
+
+    if (self->content) {
+        FREE(String, self->content);
+    }
+
+    FREE_BUFFER_ITEMS(self->dependencies->buffer,
+                      self->dependencies->len,
+                      CIGeneratorGenCacheDependency);
+    FREE(Vec, self->dependencies);
+    lily_free(self);
+}
+
+DESTRUCTOR(CIGeneratorGenCache, const CIGeneratorGenCache *self)
+{
+    FREE_HASHMAP_VALUES(self->entries, CIGeneratorGenCacheEntry);
+    FREE(HashMap, self->entries);
+}
+
 void
 start_session__CIGeneratorContent(CIGeneratorContent *self,
                                   CIScope *current_scope)
@@ -847,6 +927,11 @@ search_decl_and_generate_base__CIGenerator(
 
         ASSERT(decl);
 
+        if (self->gen_cache_entry) {
+            push__Vec(self->gen_cache_entry->dependencies,
+                      NEW(CIGeneratorGenCacheDependency, search, name));
+        }
+
         generate_decl__CIGenerator(self, decl);
     }
 }
@@ -2229,6 +2314,13 @@ generate_function_body_item__CIGenerator(CIGenerator *self,
 {
     switch (item->kind) {
         case CI_DECL_FUNCTION_ITEM_KIND_DECL:
+            // NOTE: A global declaration (e.g. struct) declared in the body is
+            // not written in the content of the instantiation, so it can't be
+            // cached.
+            if (self->gen_cache_entry && !is_local__CIDecl(item->decl)) {
+                self->gen_cache_entry->is_cacheable = false;
+            }
+
             set_must_inherit__CIGenerator(self);
             generate_decl__CIGenerator(self, item->decl);
             unset_must_inherit__CIGenerator(self);
@@ -2527,10 +2619,77 @@ generate_variable_decl__CIGenerator(CIGenerator *self,
     }
 }
 
+const Rc *
+get_gen_origin__CIGenerator(const CIDecl *decl)
+{
+    switch (decl->kind) {
+        case CI_DECL_KIND_FUNCTION_GEN:
+            return decl->function_gen.function->name;
+        case CI_DECL_KIND_STRUCT_GEN:
+            return decl->struct_gen.struct_->name;
+        case CI_DECL_KIND_TYPEDEF_GEN:
+            return decl->typedef_gen.typedef_->name;
+        case CI_DECL_KIND_UNION_GEN:
+            return decl->union_gen.union_->name;
+        default:
+            UNREACHABLE("expected gen declaration");
+    }
+}
+
+const CIGeneratorGenCacheEntry *
+get_gen_cache_entry__CIGenerator(const CIGenerator *self, const CIDecl *decl)
+{
+    const CIGeneratorGenCacheEntry *entry =
+      get__HashMap(self->gen_cache->entries, get_name__CIDecl(decl)->buffer);
+
+    return entry && entry->origin == get_gen_origin__CIGenerator(decl) ? entry
+                                                                        : NULL;
+}
+
+void
+generate_gen_cache_entry__CIGenerator(CIGenerator *self,
+                                      const CIGeneratorGenCacheEntry *entry)
+{
+    for (Usize i = 0; i < entry->dependencies->len; ++i) {
+        const CIGeneratorGenCacheDependency *dependency =
+          get__Vec(entry->dependencies, i);
+        CIDecl *decl = dependency->search(self->file, dependency->name);
+
+        ASSERT(decl);
+
+        generate_decl__CIGenerator(self, decl);
+    }
+
+    write_str__CIGenerator(self, entry->content->buffer);
+}
+
+void
+add_gen_cache_entry__CIGenerator(CIGenerator *self,
+                                 CIGeneratorGenCacheEntry *entry)
+{
+    if (entry->is_cacheable &&
+        !get__HashMap(self->gen_cache->entries, entry->name->buffer)) {
+        entry->content = clone__String(self->content.last_session->buffer);
+
+        insert__HashMap(self->gen_cache->entries, entry->name->buffer, entry);
+    } else {
+        FREE(CIGeneratorGenCacheEntry, entry);
+    }
+}
+
 void
 generate_decl__CIGenerator(CIGenerator *self, const CIDecl *decl)
 {
     if (!has_generic__CIDecl(decl)) {
+        // NOTE: The content of an instantiation generated in a session which
+        // inherits the properties of its parent (e.g. the tabulation count)
+        // depends on its parent, so it's never cached.
+        bool is_inherited = self->content.last_session &&
+                            self->content.last_session->must_inherit;
+        CIGeneratorGenCacheEntry *parent_gen_cache_entry =
+          self->gen_cache_entry;
+        CIGeneratorGenCacheEntry *gen_cache_entry = NULL;
+
         start_session_with_default_scope__CIGenerator(self);
 
         Usize decl_id = get_decl_id_from_decl__CIGenerator(self, decl);
@@ -2545,6 +2704,23 @@ generate_decl__CIGenerator(CIGenerator *self, const CIDecl *decl)
             goto end_session;
         }
 
+        if (decl->kind & CI_DECL_KIND_GEN && !is_inherited) {
+            const CIGeneratorGenCacheEntry *cached_entry =
+              get_gen_cache_entry__CIGenerator(self, decl);
+
+            if (cached_entry) {
+                generate_gen_cache_entry__CIGenerator(self, cached_entry);
+
+                goto end_session;
+            }
+
+            gen_cache_entry =
+              NEW(CIGeneratorGenCacheEntry,
+                  get_gen_origin__CIGenerator(decl),
+                  get_name__CIDecl(decl));
+            self->gen_cache_entry = gen_cache_entry;
+        }
+
         switch (decl->kind) {
             case CI_DECL_KIND_ENUM:
                 generate_enum_decl__CIGenerator(self, &decl->enum_);
@@ -2604,6 +2780,12 @@ generate_decl__CIGenerator(CIGenerator *self, const CIDecl *decl)
         write_str__CIGenerator(self, ";\n");
 
     end_session:
+        if (gen_cache_entry) {
+            self->gen_cache_entry = parent_gen_cache_entry;
+
+            add_gen_cache_entry__CIGenerator(self, gen_cache_entry);
+        }
+
         end_session_by_decl__CIGenerator(self, decl);
     }
 }
@@ -2726,9 +2908,9 @@ run_file__CIGenerator(CIGenerator *self)
 void
 handler__CIGenerator([[maybe_unused]] void *entity,
                      const CIResultFile *file,
-                     [[maybe_unused]] void *other_args)
+                     void *other_args)
 {
-    CIGenerator generator = NEW(CIGenerator, file);
+    CIGenerator generator = NEW(CIGenerator, file, other_args);
 
     run_file__CIGenerator(&generator);
 
@@ -2738,7 +2920,11 @@ handler__CIGenerator([[maybe_unused]] void *entity,
 void
 run__CIGenerator(const CIResult *result)
 {
-    pass_through_result__CIResult(result, &handler__CIGenerator, NULL);
+    CIGeneratorGenCache gen_cache = NEW(CIGeneratorGenCache);
+
+    pass_through_result__CIResult(result, &handler__CIGenerator, &gen_cache);
+
+    FREE(CIGeneratorGenCache, &gen_cache);
 }
 
 DESTRUCTOR(CIGenerator, const CIGenerator *self)
@@ -22,41 +22,402 @@
  * SOFTWARE.
  */
 
+#include <base/alloc.h>
 #include <base/assert.h>
 #include <base/command.h>
+#include <base/dir.h>
+#include <base/dir_separator.h>
+#include <base/file.h>
 #include <base/format.h>
+#include <base/hash_map.h>
 #include <base/new.h>
 #include <base/path.h>
+#include <base/str.h>
 
 #include <core/cc/ci/include.h>
+#include <core/cc/ci/result.h>
 
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+// The probe cache is written in the output directory (see
+// get_output_path__CIResult).
+#define CI_INCLUDE_PROBE_CACHE "include_dirs.cache"
+
+#ifdef LILY_WINDOWS_OS
+#define CI_INCLUDE_PATH_SEPARATOR ';'
+#else
+#define CI_INCLUDE_PATH_SEPARATOR ':'
+#endif
+
+// The environment variables which change the default include directories of
+// the compiler.
+static const char *probe_env_vars[] = { "CPATH",
+                                        "C_INCLUDE_PATH",
+                                        "CPLUS_INCLUDE_PATH",
+                                        "OBJC_INCLUDE_PATH",
+                                        "SDKROOT",
+                                        "GCC_EXEC_PREFIX" };
+static const Usize probe_env_vars_len =
+  sizeof(probe_env_vars) / sizeof(*probe_env_vars);
+
+typedef struct CIIncludeResolved
+{
+    char *key;
+    String *path; // String*?
+} CIIncludeResolved;
+
+typedef struct CIIncludeDirEntries
+{
+    char *dir;
+    Vec *entries;   // Vec<String*>*? (the names are folded to lower case)
+    HashMap *names; // HashMap<String* (&)>*
+} CIIncludeDirEntries;
+
+/**
+ *
+ * @brief Construct CIIncludeResolved type.
+ * @param path String*?
+ */
+static CONSTRUCTOR(CIIncludeResolved *,
+                   CIIncludeResolved,
+                   char *key,
+                   String *path);
+
+/**
+ *
+ * @brief Free CIIncludeResolved type.
+ */
+static DESTRUCTOR(CIIncludeResolved, CIIncludeResolved *self);
+
+/**
+ *
+ * @brief Construct CIIncludeDirEntries type.
+ */
+static CONSTRUCTOR(CIIncludeDirEntries *, CIIncludeDirEntries, char *dir);
+
+/**
+ *
+ * @brief Free CIIncludeDirEntries type.
+ */
+static DESTRUCTOR(CIIncludeDirEntries, CIIncludeDirEntries *self);
+
+/**
+ *
+ * @brief Get the path of the executable of the compiler.
+ * @return char*?
+ */
+static char *
+get_compiler_path__CIInclude(const String *compiler_command);
+
+/**
+ *
+ * @brief Get the key of the probe of the compiler (path and last modification
+ * time of the compiler, compiler command, and environment variables read by
+ * the compiler).
+ * @return char*?
+ */
+static char *
+get_probe_key__CIInclude(const String *compiler_command);
+
+/**
+ *
+ * @brief Load the result of the probe from the cache.
+ * @return String*?
+ */
+static String *
+load_probe__CIInclude(const char *key);
+
+/**
+ *
+ * @brief Write the result of the probe in the cache.
+ */
+static void
+save_probe__CIInclude(const char *key, const String *probe);
+
+/**
+ *
+ * @brief Run the compiler to get its default include directories.
+ * @return String*
+ */
+static String *
+run_probe__CIInclude(const String *compiler_command);
+
+/**
+ *
+ * @brief Free all the resolved includes (e.g. when the include directories
+ * are changed).
+ */
+static void
+clear_resolved_includes__CIInclude();
+
+/**
+ *
+ * @brief Fold the name to lower case.
+ */
+static void
+fold_case__CIInclude(char *name);
+
+/**
+ *
+ * @brief Check if the folder may contain the entry (the content of the folder
+ * is read once).
+ * @note The names are compared regardless of the case, because the file
+ * system can be case-insensitive (e.g. Windows, macOS), so the entry must
+ * still be checked on the file system.
+ */
+static bool
+has_dir_entry__CIInclude(const char *dir, const char *name);
+
+/**
+ *
+ * @brief Get the full path of the included file, if it exists in the folder.
+ * @return String*?
+ */
+static String *
+find_include__CIInclude(const String *dir, const String *include_path);
 
 static Vec *include_dirs = NULL; // Vec<String*>*?
+// Result of the resolution of each included file, by including directory.
+static HashMap *resolved_includes = NULL; // HashMap<CIIncludeResolved*>*?
+// Entries of each folder where an included file has been looked for.
+static HashMap *dir_entries = NULL; // HashMap<CIIncludeDirEntries*>*?
+
+CONSTRUCTOR(CIIncludeResolved *, CIIncludeResolved, char *key, String *path)
+{
+    CIIncludeResolved *self = lily_malloc(sizeof(CIIncludeResolved));
+
+    self->key = key;
+    self->path = path;
+
+    return self;
+}
+
+DESTRUCTOR(CIIncludeResolved, CIIncludeResolved *self)
+{
+    lily_free(self->key);
+
+    if (self->path) {
+        FREE(String, self->path);
+    }
+
+    lily_free(self);
+}
+
+CONSTRUCTOR(CIIncludeDirEntries *, CIIncludeDirEntries, char *dir)
+{
+    CIIncludeDirEntries *self = lily_malloc(sizeof(CIIncludeDirEntries));
+
+    self->dir = dir;
+    self->entries = get_entries__Dir(dir);
+    self->names = NEW(HashMap);
+
+    if (self->entries) {
+        for (Usize i = 0; i < self->entries->len; ++i) {
+            String *entry = get__Vec(self->entries, i);
+
+            fold_case__CIInclude(entry->buffer);
+            insert__HashMap(self->names, entry->buffer, entry);
+        }
+    }
+
+    return self;
+}
+
+DESTRUCTOR(CIIncludeDirEntries, CIIncludeDirEntries *self)
+{
+    lily_free(self->dir);
+
+    if (self->entries) {
+        FREE_BUFFER_ITEMS(self->entries->buffer, self->entries->len, String);
+        FREE(Vec, self->entries);
+    }
+
+    FREE(HashMap, self->names);
+    lily_free(self);
+}
+
+char *
+get_compiler_path__CIInclude(const String *compiler_command)
+{
+    // NOTE: The command of the compiler can contain some arguments (e.g.
+    // `gcc -g`).
+    Vec *args = split__Str(compiler_command->buffer, ' '); // Vec<char*>*
+    char *compiler = args->len > 0 ? get__Vec(args, 0) : NULL;
+    char *res = NULL;
+
+    if (!compiler || !*compiler) {
+        goto exit;
+    }
+
+    if (strchr(compiler, DIR_SEPARATOR)) {
+        res = exists__File(compiler) ? strdup(compiler) : NULL;
+
+        goto exit;
+    }
+
+    const char *path_env = getenv("PATH");
+
+    if (!path_env) {
+        goto exit;
+    }
+
+    Vec *path_dirs = split__Str(path_env, CI_INCLUDE_PATH_SEPARATOR);
+
+    for (Usize i = 0; i < path_dirs->len; ++i) {
+        char *current =
+          format("{s}" DIR_SEPARATOR_S "{s}", get__Vec(path_dirs, i), compiler);
+
+        if (exists__File(current)) {
+            res = current;
+
+            break;
+        }
+
+        lily_free(current);
+    }
+
+    for (Usize i = 0; i < path_dirs->len; ++i) {
+        lily_free(get__Vec(path_dirs, i));
+    }
+
+    FREE(Vec, path_dirs);
+
+exit:
+    for (Usize i = 0; i < args->len; ++i) {
+        lily_free(get__Vec(args, i));
+    }
+
+    FREE(Vec, args);
+
+    return res;
+}
+
+char *
+get_probe_key__CIInclude(const String *compiler_command)
+{
+    char *compiler_path = get_compiler_path__CIInclude(compiler_command);
+
+    if (!compiler_path) {
+        return NULL;
+    }
+
+    String *key = format__String("{s} {zi} {S}",
+                                 compiler_path,
+                                 (Isize)get_mtime__File(compiler_path),
+                                 compiler_command);
+
+    for (Usize i = 0; i < probe_env_vars_len; ++i) {
+        const char *value = getenv(probe_env_vars[i]);
+
+        // NOTE: An unset variable is distinguished from an empty variable.
+        if (value) {
+            push_str__String(key, " ");
+            push_str__String(key, (char *)probe_env_vars[i]);
+            push_str__String(key, "=");
+            push_str__String(key, (char *)value);
+        }
+    }
+
+    char *res = strdup(key->buffer);
+
+    lily_free(compiler_path);
+    FREE(String, key);
+
+    return res;
+}
+
+String *
+load_probe__CIInclude(const char *key)
+{
+    char *path = get_output_path__CIResult(CI_INCLUDE_PROBE_CACHE);
+
+    if (!exists__File(path)) {
+        lily_free(path);
+
+        return NULL;
+    }
+
+    char *content = read_file__File(path);
+    char *key_end = strchr(content, '\n');
+    String *probe = NULL;
+
+    lily_free(path);
+
+    // NOTE: The first line of the cache is the key of the probe, the rest is
+    // the result of the probe.
+    if (key_end && (Usize)(key_end - content) == strlen(key) &&
+        !strncmp(content, key, key_end - content)) {
+        probe = from__String(key_end + 1);
+    }
+
+    lily_free(content);
+
+    return probe;
+}
 
 void
-init_include_dirs__CIInclude(const String *compiler_command,
-                             const char *base_path)
+save_probe__CIInclude(const char *key, const String *probe)
 {
-    ASSERT(compiler_command);
+    char *content = format("{s}\n{S}", key, probe);
+    char *path = get_output_path__CIResult(CI_INCLUDE_PROBE_CACHE);
+
+    create_recursive_dir__Dir(get_output_dir__CIResult(),
+                              DIR_MODE_RWXU | DIR_MODE_RWXG | DIR_MODE_RWXO);
+    write_file__File(path, content, strlen(content));
 
+    lily_free(path);
+    lily_free(content);
+}
+
+String *
+run_probe__CIInclude(const String *compiler_command)
+{
     char *command =
       format("echo | {S} -E -Wp,-v - 2>&1 | grep \"^ \" | sed 's/^ *//'",
              compiler_command);
     int command_exit_status;
-    String *include_dirs_s = save__Command(command, &command_exit_status);
+    String *probe = save__Command(command, &command_exit_status);
 
     if (command_exit_status != EXIT_OK) {
         FAILED("failed to fetch default include paths");
     }
 
+    lily_free(command);
+
+    return probe;
+}
+
+void
+init_include_dirs__CIInclude(const String *compiler_command,
+                             const char *base_path)
+{
+    ASSERT(compiler_command);
+
+    // NOTE: The probe runs a shell pipeline, so its result is cached until the
+    // compiler is changed.
+    char *probe_key = get_probe_key__CIInclude(compiler_command);
+    String *include_dirs_s =
+      probe_key ? load_probe__CIInclude(probe_key) : NULL;
+
+    if (!include_dirs_s) {
+        include_dirs_s = run_probe__CIInclude(compiler_command);
+
+        if (probe_key) {
+            save_probe__CIInclude(probe_key, include_dirs_s);
+        }
+    }
+
+    if (probe_key) {
+        lily_free(probe_key);
+    }
+
     Vec *split_include_dirs_s = split__String(include_dirs_s, '\n');
 
     include_dirs = init__Vec(1, from__String((char *)base_path));
 
-    lily_free(command);
-
     for (Usize i = 0; i < split_include_dirs_s->len; ++i) {
         push__Vec(include_dirs, get__Vec(split_include_dirs_s, i));
     }
@@ -71,6 +432,7 @@ add_include_dir__CIInclude(String *include_dir)
     ASSERT(include_dirs);
 
     push__Vec(include_dirs, include_dir);
+    clear_resolved_includes__CIInclude();
 }
 
 void
@@ -79,6 +441,7 @@ insert_include_dir__CIInclude(String *include_dir, Usize index)
     ASSERT(include_dirs);
 
     insert__Vec(include_dirs, include_dir, index);
+    clear_resolved_includes__CIInclude();
 }
 
 const Vec *
@@ -91,6 +454,120 @@ get_include_dirs__CIInclude()
     return include_dirs;
 }
 
+void
+clear_resolved_includes__CIInclude()
+{
+    if (resolved_includes) {
+        FREE_HASHMAP_VALUES(resolved_includes, CIIncludeResolved);
+        FREE(HashMap, resolved_includes);
+
+        resolved_includes = NULL;
+    }
+}
+
+void
+fold_case__CIInclude(char *name)
+{
+    for (; *name; ++name) {
+        *name = tolower((unsigned char)*name);
+    }
+}
+
+bool
+has_dir_entry__CIInclude(const char *dir, const char *name)
+{
+    if (!dir_entries) {
+        dir_entries = NEW(HashMap);
+    }
+
+    CIIncludeDirEntries *entries = get__HashMap(dir_entries, (char *)dir);
+
+    if (!entries) {
+        entries = NEW(CIIncludeDirEntries, strdup(dir));
+
+        insert__HashMap(dir_entries, entries->dir, entries);
+    }
+
+    char *folded_name = strdup(name);
+
+    fold_case__CIInclude(folded_name);
+
+    bool res = get__HashMap(entries->names, folded_name);
+
+    lily_free(folded_name);
+
+    return res;
+}
+
+String *
+find_include__CIInclude(const String *dir, const String *include_path)
+{
+    // dir + '/' + include_path
+    String *full_include_path = format__String("{S}/{S}", dir, include_path);
+    char *name = strrchr(full_include_path->buffer, '/');
+    // NOTE: The folder of the included file is the folder of the full path
+    // (e.g. <dir>/sys for <sys/types.h>).
+    String *include_dir = NEW(String);
+
+    if (name == full_include_path->buffer) {
+        push__String(include_dir, '/');
+    } else {
+        push_str_with_len__String(include_dir,
+                                  full_include_path->buffer,
+                                  name - full_include_path->buffer);
+    }
+
+    bool has_entry = has_dir_entry__CIInclude(include_dir->buffer, name + 1);
+
+    FREE(String, include_dir);
+
+    // NOTE: The content of the folder excludes most of the paths without any
+    // access to the file system, but the remaining paths are still checked
+    // (e.g. broken symbolic link, name with a different case).
+    if (has_entry && exists__File(full_include_path->buffer)) {
+        return full_include_path;
+    }
+
+    FREE(String, full_include_path);
+
+    return NULL;
+}
+
+const String *
+resolve__CIInclude(const String *include_path, const String *including_dir)
+{
+    ASSERT(include_dirs);
+
+    if (!resolved_includes) {
+        resolved_includes = NEW(HashMap);
+    }
+
+    char *key = format("{S}\n{S}", include_path, including_dir);
+    CIIncludeResolved *resolved = get__HashMap(resolved_includes, key);
+
+    if (resolved) {
+        lily_free(key);
+
+        return resolved->path;
+    }
+
+    String *path = NULL;
+
+    for (Usize i = 0; i < include_dirs->len && !path; ++i) {
+        path = find_include__CIInclude(get__Vec(include_dirs, i), include_path);
+    }
+
+    if (!path) {
+        path = find_include__CIInclude(including_dir, include_path);
+    }
+
+    resolved = NEW(CIIncludeResolved, key, path);
+
+    insert__HashMap(resolved_includes, resolved->key, resolved);
+
+    return path;
+}
+
 void
 destroy__CIInclude()
 {
@@ -98,4 +575,13 @@ destroy__CIInclude()
         FREE_BUFFER_ITEMS(include_dirs->buffer, include_dirs->len, String);
         FREE(Vec, include_dirs);
     }
+
+    clear_resolved_includes__CIInclude();
+
+    if (dir_entries) {
+        FREE_HASHMAP_VALUES(dir_entries, CIIncludeDirEntries);
+        FREE(HashMap, dir_entries);
+
+        dir_entries = NULL;
+    }
 }
@@ -155,11 +155,9 @@ static void
 resolve_preprocessor_error__CIResolver(CIResolver *self,
                                        CIToken *preprocessor_error_token);
 
-static bool
-load_include__CIResolver(CIResolver *self,
-                         CIToken *preprocessor_include_token,
-                         const String *current_dir,
-                         const String *include_path);
+/// @param full_include_path const String* (&)
+static void
+load_include__CIResolver(CIResolver *self, const String *full_include_path);
 
 static void
 resolve_preprocessor_include__CIResolver(CIResolver *self,
@@ -1060,65 +1058,34 @@ resolve_preprocessor_error__CIResolver(CIResolver *self,
       self->count_error);
 }
 
-bool
-load_include__CIResolver(CIResolver *self,
-                         CIToken *preprocessor_include_token,
-                         const String *current_dir,
-                         const String *include_path)
+void
+load_include__CIResolver(CIResolver *self, const String *full_include_path)
 {
-    // current_dir + '/' + include_path
-    char *full_include_path = format("{S}/{S}", current_dir, include_path);
-
-    if (exists__File(full_include_path)) {
-        CIResultFile *header =
-          add_and_run_header__CIResult(self->file->entity.result,
-                                       self->file,
-                                       full_include_path,
-                                       self->file->entity.result->config);
-
-        RESOLVE_TOKENS(&header->scanner.tokens, self->resolved_tokens, {}, {});
-
-        pop_if_eof__CIResolvedTokens(self->resolved_tokens);
-
-        lily_free(full_include_path);
-
-        return true;
-    }
+    CIResultFile *header =
+      add_and_run_header__CIResult(self->file->entity.result,
+                                   self->file,
+                                   full_include_path->buffer,
+                                   self->file->entity.result->config);
 
-    lily_free(full_include_path);
+    RESOLVE_TOKENS(&header->scanner.tokens, self->resolved_tokens, {}, {});
 
-    return false;
+    pop_if_eof__CIResolvedTokens(self->resolved_tokens);
 }
 
 void
 resolve_preprocessor_include__CIResolver(CIResolver *self,
                                          CIToken *preprocessor_include_token)
 {
-    const Vec *include_dirs = get_include_dirs__CIInclude();
-
-    for (Usize i = 0; i < include_dirs->len; ++i) {
-        const String *current_dir = get__Vec(include_dirs, i);
-
-        if (load_include__CIResolver(
-              self,
-              preprocessor_include_token,
-              current_dir,
-              preprocessor_include_token->preprocessor_include.value)) {
-            return;
-        }
-    }
-
     String *current_dir =
       get_dir__File(preprocessor_include_token->location.filename);
-    bool load_include_res = load_include__CIResolver(
-      self,
-      preprocessor_include_token,
-      current_dir,
-      preprocessor_include_token->preprocessor_include.value);
+    const String *full_include_path = resolve__CIInclude(
+      preprocessor_include_token->preprocessor_include.value, current_dir);
 
     FREE(String, current_dir);
 
-    if (load_include_res) {
+    if (full_include_path) {
+        load_include__CIResolver(self, full_include_path);
+
         return;
     }
 
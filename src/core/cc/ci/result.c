@@ -24,13 +24,17 @@
 
 #include <base/alloc.h>
 #include <base/assert.h>
+#include <base/cpu.h>
 #include <base/dir.h>
 #include <base/dir_separator.h>
+#include <base/fork.h>
+#include <base/format.h>
 #include <base/macros.h>
 
 #include <core/cc/ci/file.h>
 #include <core/cc/ci/resolver.h>
 #include <core/cc/ci/result.h>
+#include <core/cc/ci/token_cache.h>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -1305,12 +1309,25 @@ is_same_filename__CIResultFile(const CIResultFile *self, const char *filename)
     UNREACHABLE("unknown filename extension");
 }
 
+const char *
+get_output_dir__CIResult()
+{
+    // TODO: Add a possibly to the user to "create its custom output directory"
+    return "out.ci";
+}
+
+char *
+get_output_path__CIResult(const char *name)
+{
+    return format(
+      "{s}" DIR_SEPARATOR_S "{s}", get_output_dir__CIResult(), name);
+}
+
 String *
 get_dir_result__CIResultFile(const CIResultFile *self,
                              enum CIDirResultPurpose purpose)
 {
-    // TODO: Add a possibly to the user to "create its custom output directory"
-    const char *output_dir = "out.ci";
+    const char *output_dir = get_output_dir__CIResult();
 
     switch (purpose) {
         case CI_DIR_RESULT_PURPOSE_BIN:
@@ -1336,7 +1353,7 @@ get_dir_result__CIResultFile(const CIResultFile *self,
 DESTRUCTOR(CIResultFile, CIResultFile *self)
 {
     if (self->file_input.content) {
-        lily_free(self->file_input.content);
+        FREE(File, &self->file_input);
     }
 
     if (self->file_input.name) {
@@ -1580,7 +1597,18 @@ scan_file__CIResult(const CIResult *self,
           self->headers, result_file->file_input.name, result_file);
     }
 
-    run__CIScanner(&result_file->scanner, false);
+    // NOTE: The headers are often included by many files (and by many
+    // invocations of the compiler), so their tokens are cached on disk.
+    if (kind == CI_FILE_ID_KIND_SOURCE) {
+        run__CIScanner(&result_file->scanner, false);
+    } else if (!load__CITokenCache(&result_file->file_input,
+                                   self->config,
+                                   &result_file->scanner.tokens)) {
+        run__CIScanner(&result_file->scanner, false);
+        save__CITokenCache(&result_file->file_input,
+                           self->config,
+                           &result_file->scanner.tokens);
+    }
 
     return result_file;
 }
@@ -1724,14 +1752,87 @@ pass_through_result__CIResult(const CIResult *self,
     OrderedHashMapIter iter_bins = NEW(OrderedHashMapIter, self->bins);
     CIResultLib *current_lib = NULL;
     CIResultBin *current_bin = NULL;
+    Usize index = 0;
 
     while ((current_lib = next__OrderedHashMapIter(&iter_libs))) {
-        run(current_lib, current_lib->file, other_args);
+        if (index++ % self->shard_count == self->shard_index) {
+            run(current_lib, current_lib->file, other_args);
+        }
     }
 
     while ((current_bin = next__OrderedHashMapIter(&iter_bins))) {
-        run(current_bin, current_bin->file, other_args);
+        if (index++ % self->shard_count == self->shard_index) {
+            run(current_bin, current_bin->file, other_args);
+        }
+    }
+}
+
+void
+run_in_parallel__CIResult(CIResult *self,
+                          void (*run)(CIResult *self, void *other_args),
+                          void *other_args,
+                          Usize jobs)
+{
+    Usize entities_len = self->libs->len + self->bins->len;
+    Usize workers_len = jobs == 0 ? get_cores_len__Cpu() : jobs;
+
+    if (workers_len > entities_len) {
+        workers_len = entities_len;
+    }
+
+#ifdef LILY_UNIX_OS
+    if (workers_len <= 1) {
+        run(self, other_args);
+
+        return;
+    }
+
+    // NOTE: The buffered outputs must be flushed before forking, otherwise
+    // they are written again by each worker.
+    fflush(stdout);
+    fflush(stderr);
+
+    Fork *pids = lily_malloc(sizeof(Fork) * workers_len);
+
+    for (Usize i = 0; i < workers_len; ++i) {
+        Fork pid = run__Fork();
+
+        switch (pid) {
+            case -1:
+                UNREACHABLE("failed to fork process");
+            case 0:
+                self->shard_index = i;
+                self->shard_count = workers_len;
+
+                run(self, other_args);
+
+                exit(EXIT_OK);
+            default:
+                pids[i] = pid;
+        }
+    }
+
+    bool has_failed = false;
+
+    for (Usize i = 0; i < workers_len; ++i) {
+        // NOTE: A worker killed by a signal is considered as failed.
+        int exit_status = EXIT_ERR;
+
+        wait__Fork(pids[i], &exit_status, NULL, NULL, false);
+
+        if (exit_status != EXIT_OK) {
+            has_failed = true;
+        }
+    }
+
+    lily_free(pids);
+
+    if (has_failed) {
+        exit(EXIT_ERR);
     }
+#else
+    run(self, other_args);
+#endif
 }
 
 DESTRUCTOR(CIResult, const CIResult *self)
@@ -33,6 +33,7 @@
 #include <core/cc/ci/scanner.h>
 #include <core/shared/diagnostic.h>
 
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
@@ -169,6 +170,10 @@ push_token__CIScanner(CIScanner *self, CIScannerContext *ctx, CIToken *token);
 static void
 next_char_by_token__CIScanner(CIScanner *self, const CIToken *token);
 
+/// @brief Build the perfect hash tables of keywords (called once).
+static void
+init_keywords__CIScanner();
+
 /// @brief Get attribute from id.
 static enum CITokenKind
 get_attribute__CIScanner(const String *id);
@@ -969,6 +974,15 @@ static const enum CITokenKind ci_preprocessor_ids[CI_N_PREPROCESSOR] = {
     CI_TOKEN_KIND_PREPROCESSOR_UNDEF,   CI_TOKEN_KIND_PREPROCESSOR_WARNING,
 };
 
+// NOTE: These tables are built once from the sorted tables above (see
+// init_keywords__CIScanner).
+static SearchPerfectHash ci_keywords_hash;
+static SearchPerfectHash ci_attributes_hash;
+static SearchPerfectHash ci_builtin_macros_hash;
+static SearchPerfectHash ci_standard_predefined_macros_hash;
+static SearchPerfectHash ci_preprocessors_hash;
+static pthread_once_t ci_keywords_hash_once = PTHREAD_ONCE_INIT;
+
 #define IS_ZERO '0'
 
 #define IS_DIGIT_WITHOUT_ZERO \
@@ -1272,11 +1286,57 @@ next_char_by_token__CIScanner(CIScanner *self, const CIToken *token)
     }
 }
 
+void
+init_keywords__CIScanner()
+{
+    ci_keywords_hash = NEW(SearchPerfectHash,
+                           ci_keywords,
+                           (const Int32 *)ci_keyword_ids,
+                           CI_N_KEYWORD);
+    ci_attributes_hash = NEW(SearchPerfectHash,
+                             ci_attributes,
+                             (const Int32 *)ci_attribute_ids,
+                             CI_N_ATTRIBUTE);
+    ci_builtin_macros_hash = NEW(SearchPerfectHash,
+                                 ci_builtin_macros,
+                                 (const Int32 *)ci_builtin_macro_ids,
+                                 CI_N_BUILTIN_MACRO);
+    ci_standard_predefined_macros_hash =
+      NEW(SearchPerfectHash,
+          ci_standard_predefined_macros,
+          (const Int32 *)ci_standard_predefined_macro_ids,
+          CI_N_STANDARD_PREDEFINED_MACRO);
+    ci_preprocessors_hash = NEW(SearchPerfectHash,
+                                ci_preprocessors,
+                                (const Int32 *)ci_preprocessor_ids,
+                                CI_N_PREPROCESSOR);
+
+    ASSERT(ci_keywords_hash.is_perfect);
+    ASSERT(ci_attributes_hash.is_perfect);
+    ASSERT(ci_builtin_macros_hash.is_perfect);
+    ASSERT(ci_standard_predefined_macros_hash.is_perfect);
+    ASSERT(ci_preprocessors_hash.is_perfect);
+}
+
+void
+get_keywords_hashes__CIScanner(
+  const SearchPerfectHash *hashes[CI_SCANNER_N_KEYWORDS_HASH])
+{
+    pthread_once(&ci_keywords_hash_once, &init_keywords__CIScanner);
+
+    hashes[0] = &ci_keywords_hash;
+    hashes[1] = &ci_attributes_hash;
+    hashes[2] = &ci_builtin_macros_hash;
+    hashes[3] = &ci_standard_predefined_macros_hash;
+    hashes[4] = &ci_preprocessors_hash;
+}
+
 enum CITokenKind
 get_attribute__CIScanner(const String *id)
 {
-    Int32 res = get_keyword__Scanner(
-      id, ci_attributes, (const Int32 *)ci_attribute_ids, CI_N_ATTRIBUTE);
+    pthread_once(&ci_keywords_hash_once, &init_keywords__CIScanner);
+
+    Int32 res = get_keyword__Scanner(id, &ci_attributes_hash);
 
     if (res == -1) {
         return CI_TOKEN_KIND_IDENTIFIER;
@@ -1288,10 +1348,9 @@ get_attribute__CIScanner(const String *id)
 enum CITokenKind
 get_builtin_macro__CIScanner(const String *id)
 {
-    Int32 res = get_keyword__Scanner(id,
-                                     ci_builtin_macros,
-                                     (const Int32 *)ci_builtin_macro_ids,
-                                     CI_N_BUILTIN_MACRO);
+    pthread_once(&ci_keywords_hash_once, &init_keywords__CIScanner);
+
+    Int32 res = get_keyword__Scanner(id, &ci_builtin_macros_hash);
 
     if (res == -1) {
         return CI_TOKEN_KIND_IDENTIFIER;
@@ -1303,11 +1362,9 @@ get_builtin_macro__CIScanner(const String *id)
 enum CITokenKind
 get_standard_predefined_macro__CIScanner(const String *id)
 {
-    Int32 res =
-      get_keyword__Scanner(id,
-                           ci_standard_predefined_macros,
-                           (const Int32 *)ci_standard_predefined_macro_ids,
-                           CI_N_STANDARD_PREDEFINED_MACRO);
+    pthread_once(&ci_keywords_hash_once, &init_keywords__CIScanner);
+
+    Int32 res = get_keyword__Scanner(id, &ci_standard_predefined_macros_hash);
 
     if (res == -1) {
         return CI_TOKEN_KIND_IDENTIFIER;
@@ -1319,10 +1376,9 @@ get_standard_predefined_macro__CIScanner(const String *id)
 enum CITokenKind
 get_preprocessor__CIScanner(const String *id)
 {
-    Int32 res = get_keyword__Scanner(id,
-                                     ci_preprocessors,
-                                     (const Int32 *)ci_preprocessor_ids,
-                                     CI_N_PREPROCESSOR);
+    pthread_once(&ci_keywords_hash_once, &init_keywords__CIScanner);
+
+    Int32 res = get_keyword__Scanner(id, &ci_preprocessors_hash);
 
     if (res == -1) {
         return CI_TOKEN_KIND_IDENTIFIER;
@@ -1334,8 +1390,9 @@ get_preprocessor__CIScanner(const String *id)
 enum CITokenKind
 get_keyword__CIScanner(const String *id)
 {
-    Int32 res = get_keyword__Scanner(
-      id, ci_keywords, (const Int32 *)ci_keyword_ids, CI_N_KEYWORD);
+    pthread_once(&ci_keywords_hash_once, &init_keywords__CIScanner);
+
+    Int32 res = get_keyword__Scanner(id, &ci_keywords_hash);
 
     if (res == -1) {
         return CI_TOKEN_KIND_IDENTIFIER;
@@ -1739,9 +1796,7 @@ scan_attribute__CIScanner(CIScanner *self)
 void
 skip_comment_line__CIScanner(CIScanner *self)
 {
-    while (self->base.source.cursor.current != '\n') {
-        next_char__CIScanner(self);
-    }
+    skip_line__Scanner(&self->base);
 }
 
 void
@@ -1754,9 +1809,11 @@ skip_comment_block__CIScanner(CIScanner *self)
                     self->base.source.cursor.column - 2,
                     self->base.source.cursor.position - 2); // 2 = `/*`
 
-    // Check if the comment block is closed. While the current character is not
-    // a `*` and the next character is not a `/`, we continue to scan the
-    // comment block.
+    // Skip the body of the comment block at once, then check if the comment
+    // block is closed. While the current character is not a `*` and the next
+    // character is not a `/`, we continue to scan the comment block.
+    skip_comment_block__Scanner(&self->base);
+
     while (self->base.source.cursor.current != '*' ||
            peek_char__CIScanner(self, 1) != (char *)'/') {
         // Check if the comment block is not closed.
@@ -1935,7 +1992,7 @@ scan_identifier__CIScanner(CIScanner *self)
 {
     String *id = NEW(String);
 
-    scan_and_append_chars__CIScanner(self, id, &is_ident__CIScanner);
+    scan_ident_chars__Scanner(&self->base, id, true);
     previous_char__CIScanner(self);
 
     return id;
@@ -2057,6 +2114,15 @@ scan_string__CIScanner(CIScanner *self)
     // not a `"` or the next character is not a `"`, we continue to scan the
     // string literal.
     while (self->base.source.cursor.current != '\"') {
+        // Append the characters that don't need to be escaped at once.
+        if (self->base.source.cursor.current != '\\') {
+            scan_string_chars__Scanner(&self->base, res);
+
+            if (self->base.source.cursor.current == '\"') {
+                break;
+            }
+        }
+
         if (self->base.source.cursor.position >
             self->base.source.file->len - 2) {
             end__Location(&location_error,
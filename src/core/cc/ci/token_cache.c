@@ -0,0 +1,834 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/assert.h>
+#include <base/dir.h>
+#include <base/dir_separator.h>
+#include <base/file.h>
+#include <base/format.h>
+#include <base/hash/sip.h>
+#include <base/rc.h>
+
+#include <core/cc/ci/result.h>
+#include <core/cc/ci/token_cache.h>
+
+#include <string.h>
+
+// The token cache is written in the output directory (see
+// get_output_path__CIResult).
+#define CI_TOKEN_CACHE_DIR "token_cache"
+
+#define CI_TOKEN_CACHE_MAGIC "CITC"
+#define CI_TOKEN_CACHE_MAGIC_LEN 4
+
+// NOTE: Increment the version, when the layout of the payload is changed.
+#define CI_TOKEN_CACHE_VERSION 2
+
+#define CI_TOKEN_CACHE_HASH(buffer, len) \
+    hash_sip(buffer, len, SIP_K0, SIP_K1)
+
+typedef struct CITokenCacheWriter
+{
+    String *buffer;
+    bool is_cacheable;
+} CITokenCacheWriter;
+
+typedef struct CITokenCacheReader
+{
+    const char *buffer; // const char* (&)
+    Usize len;
+    Usize position;
+    const char *filename; // const char* (&)
+} CITokenCacheReader;
+
+/// @return char*
+static char *
+get_path__CITokenCache(const char *filename);
+
+static void
+write_bytes__CITokenCacheWriter(CITokenCacheWriter *self,
+                                const void *bytes,
+                                Usize len);
+
+static inline void
+write_usize__CITokenCacheWriter(CITokenCacheWriter *self, Usize value);
+
+static inline void
+write_uint8__CITokenCacheWriter(CITokenCacheWriter *self, Uint8 value);
+
+/// @param s const char*? (&)
+static void
+write_str__CITokenCacheWriter(CITokenCacheWriter *self,
+                              const char *s,
+                              Usize len);
+
+/// @param s const String*? (&)
+static inline void
+write_string__CITokenCacheWriter(CITokenCacheWriter *self, const String *s);
+
+static void
+write_location__CITokenCacheWriter(CITokenCacheWriter *self,
+                                   const Location *location);
+
+static void
+write_tokens__CITokenCacheWriter(CITokenCacheWriter *self,
+                                 const CITokens *tokens);
+
+static void
+write_define__CITokenCacheWriter(CITokenCacheWriter *self,
+                                 const CITokenPreprocessorDefine *define);
+
+static void
+write_token__CITokenCacheWriter(CITokenCacheWriter *self, const CIToken *token);
+
+/// @return const void* (&)
+static const void *
+read_bytes__CITokenCacheReader(CITokenCacheReader *self, Usize len);
+
+static Usize
+read_usize__CITokenCacheReader(CITokenCacheReader *self);
+
+static inline Uint8
+read_uint8__CITokenCacheReader(CITokenCacheReader *self);
+
+/// @return String*?
+static String *
+read_string__CITokenCacheReader(CITokenCacheReader *self);
+
+static Location
+read_location__CITokenCacheReader(CITokenCacheReader *self);
+
+static CITokens
+read_tokens__CITokenCacheReader(CITokenCacheReader *self);
+
+static CITokenPreprocessorDefine
+read_define__CITokenCacheReader(CITokenCacheReader *self);
+
+/// @return CIToken*
+static CIToken *
+read_token__CITokenCacheReader(CITokenCacheReader *self);
+
+char *
+get_path__CITokenCache(const char *filename)
+{
+    return format("{s}" DIR_SEPARATOR_S CI_TOKEN_CACHE_DIR DIR_SEPARATOR_S
+                  "{zu}.tok",
+                  get_output_dir__CIResult(),
+                  CI_TOKEN_CACHE_HASH(filename, strlen(filename)));
+}
+
+void
+write_bytes__CITokenCacheWriter(CITokenCacheWriter *self,
+                                const void *bytes,
+                                Usize len)
+{
+    push_str_with_len__String(self->buffer, bytes, len);
+}
+
+void
+write_usize__CITokenCacheWriter(CITokenCacheWriter *self, Usize value)
+{
+    write_bytes__CITokenCacheWriter(self, &value, sizeof(Usize));
+}
+
+void
+write_uint8__CITokenCacheWriter(CITokenCacheWriter *self, Uint8 value)
+{
+    write_bytes__CITokenCacheWriter(self, &value, sizeof(Uint8));
+}
+
+void
+write_str__CITokenCacheWriter(CITokenCacheWriter *self,
+                              const char *s,
+                              Usize len)
+{
+    // NOTE: The NULL string is written with the length `-1`.
+    if (!s) {
+        write_usize__CITokenCacheWriter(self, (Usize)-1);
+
+        return;
+    }
+
+    write_usize__CITokenCacheWriter(self, len);
+    write_bytes__CITokenCacheWriter(self, s, len);
+}
+
+void
+write_string__CITokenCacheWriter(CITokenCacheWriter *self, const String *s)
+{
+    write_str__CITokenCacheWriter(
+      self, s ? s->buffer : NULL, s ? s->len : 0);
+}
+
+void
+write_location__CITokenCacheWriter(CITokenCacheWriter *self,
+                                   const Location *location)
+{
+    // NOTE: The filename is not written, because all the tokens have the
+    // filename of the cached file.
+    write_usize__CITokenCacheWriter(self, location->start_line);
+    write_usize__CITokenCacheWriter(self, location->end_line);
+    write_usize__CITokenCacheWriter(self, location->start_column);
+    write_usize__CITokenCacheWriter(self, location->end_column);
+    write_usize__CITokenCacheWriter(self, location->start_position);
+    write_usize__CITokenCacheWriter(self, location->end_position);
+}
+
+void
+write_tokens__CITokenCacheWriter(CITokenCacheWriter *self,
+                                 const CITokens *tokens)
+{
+    Usize count = 0;
+
+    for (const CIToken *current = tokens->first; current;
+         current = current->next) {
+        ++count;
+
+        if (current == tokens->last) {
+            break;
+        }
+    }
+
+    write_usize__CITokenCacheWriter(self, count);
+
+    // NOTE: The last token of the content of a conditional preprocessor (e.g.
+    // #if) is linked to the next token of the parent, so the iteration stops
+    // at the last token of `tokens`.
+    for (const CIToken *current = tokens->first; count > 0;
+         current = current->next, --count) {
+        write_token__CITokenCacheWriter(self, current);
+    }
+}
+
+void
+write_define__CITokenCacheWriter(CITokenCacheWriter *self,
+                                 const CITokenPreprocessorDefine *define)
+{
+    write_string__CITokenCacheWriter(self, define->name);
+    write_uint8__CITokenCacheWriter(self, define->params != NULL);
+
+    if (define->params) {
+        write_usize__CITokenCacheWriter(self, define->params->len);
+
+        for (Usize i = 0; i < define->params->len; ++i) {
+            const CITokenPreprocessorDefineParam *param =
+              get__Vec(define->params, i);
+
+            write_string__CITokenCacheWriter(self, param->name);
+            write_uint8__CITokenCacheWriter(self, param->is_variadic);
+            write_uint8__CITokenCacheWriter(self, param->is_used);
+        }
+    }
+
+    write_tokens__CITokenCacheWriter(self, &define->tokens);
+    write_uint8__CITokenCacheWriter(self, define->is_variadic);
+}
+
+void
+write_token__CITokenCacheWriter(CITokenCacheWriter *self, const CIToken *token)
+{
+    write_usize__CITokenCacheWriter(self, token->kind);
+    write_location__CITokenCacheWriter(self, &token->location);
+
+    switch (token->kind) {
+        case CI_TOKEN_KIND_ATTRIBUTE_DEPRECATED:
+            write_string__CITokenCacheWriter(self,
+                                             token->attribute_deprecated);
+
+            break;
+        case CI_TOKEN_KIND_ATTRIBUTE_NODISCARD:
+            write_string__CITokenCacheWriter(self, token->attribute_nodiscard);
+
+            break;
+        case CI_TOKEN_KIND_BUILTIN_MACRO___HAS_FEATURE:
+            write_usize__CITokenCacheWriter(self, token->has_feature);
+
+            break;
+        case CI_TOKEN_KIND_COMMENT_DOC:
+            write_string__CITokenCacheWriter(self, token->comment_doc);
+
+            break;
+        case CI_TOKEN_KIND_EOT:
+            write_usize__CITokenCacheWriter(self, token->eot.ctx);
+
+            break;
+        case CI_TOKEN_KIND_GNU_ATTRIBUTE:
+            write_tokens__CITokenCacheWriter(self,
+                                             &token->gnu_attribute.content);
+
+            break;
+        case CI_TOKEN_KIND_IDENTIFIER:
+            write_string__CITokenCacheWriter(
+              self, GET_PTR_RC(String, token->identifier));
+
+            break;
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_INT:
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_OCTAL:
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_HEX:
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_BIN:
+            // NOTE: literal_constant_octal, literal_constant_hex and
+            // literal_constant_bin have the same type as literal_constant_int.
+            write_usize__CITokenCacheWriter(self,
+                                            token->literal_constant_int.suffix);
+            write_string__CITokenCacheWriter(self,
+                                             token->literal_constant_int.value);
+
+            break;
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_FLOAT:
+            write_usize__CITokenCacheWriter(
+              self, token->literal_constant_float.suffix);
+            write_string__CITokenCacheWriter(
+              self, token->literal_constant_float.value);
+
+            break;
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_CHARACTER:
+            write_uint8__CITokenCacheWriter(self,
+                                            token->literal_constant_character);
+
+            break;
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_STRING:
+            write_string__CITokenCacheWriter(
+              self, GET_PTR_RC(String, token->literal_constant_string));
+
+            break;
+        case CI_TOKEN_KIND_MACRO_DEFINED:
+            write_string__CITokenCacheWriter(self, token->macro_defined);
+
+            break;
+        case CI_TOKEN_KIND_MACRO_PARAM:
+            write_usize__CITokenCacheWriter(self, token->macro_param.id);
+
+            break;
+        case CI_TOKEN_KIND_PREPROCESSOR_DEFINE:
+            write_define__CITokenCacheWriter(self,
+                                             &token->preprocessor_define);
+
+            break;
+        case CI_TOKEN_KIND_PREPROCESSOR_ELIF:
+        case CI_TOKEN_KIND_PREPROCESSOR_IF:
+            // NOTE: preprocessor_elif has the same type as preprocessor_if.
+            write_tokens__CITokenCacheWriter(self,
+                                             &token->preprocessor_if.cond);
+            write_tokens__CITokenCacheWriter(self,
+                                             &token->preprocessor_if.content);
+
+            break;
+        case CI_TOKEN_KIND_PREPROCESSOR_ELIFDEF:
+        case CI_TOKEN_KIND_PREPROCESSOR_ELIFNDEF:
+        case CI_TOKEN_KIND_PREPROCESSOR_IFDEF:
+        case CI_TOKEN_KIND_PREPROCESSOR_IFNDEF:
+            // NOTE: preprocessor_elifdef, preprocessor_elifndef and
+            // preprocessor_ifndef have the same type as preprocessor_ifdef.
+            write_string__CITokenCacheWriter(
+              self, token->preprocessor_ifdef.identifier);
+            write_tokens__CITokenCacheWriter(
+              self, &token->preprocessor_ifdef.content);
+
+            break;
+        case CI_TOKEN_KIND_PREPROCESSOR_ELSE:
+            write_tokens__CITokenCacheWriter(
+              self, &token->preprocessor_else.content);
+
+            break;
+        case CI_TOKEN_KIND_PREPROCESSOR_EMBED:
+            write_string__CITokenCacheWriter(self,
+                                             token->preprocessor_embed.value);
+            write_tokens__CITokenCacheWriter(
+              self, &token->preprocessor_embed.content);
+
+            break;
+        case CI_TOKEN_KIND_PREPROCESSOR_ERROR:
+            write_string__CITokenCacheWriter(self, token->preprocessor_error);
+
+            break;
+        case CI_TOKEN_KIND_PREPROCESSOR_INCLUDE:
+            write_string__CITokenCacheWriter(
+              self, token->preprocessor_include.value);
+
+            break;
+        case CI_TOKEN_KIND_PREPROCESSOR_LINE:
+            write_usize__CITokenCacheWriter(self,
+                                            token->preprocessor_line.line);
+            write_string__CITokenCacheWriter(
+              self, token->preprocessor_line.filename);
+
+            break;
+        case CI_TOKEN_KIND_PREPROCESSOR_UNDEF:
+            write_string__CITokenCacheWriter(self, token->preprocessor_undef);
+
+            break;
+        case CI_TOKEN_KIND_PREPROCESSOR_WARNING:
+            write_string__CITokenCacheWriter(self,
+                                             token->preprocessor_warning);
+
+            break;
+        case CI_TOKEN_KIND_STANDARD_PREDEFINED_MACRO___DATE__:
+        case CI_TOKEN_KIND_STANDARD_PREDEFINED_MACRO___TIME__:
+            // NOTE: The value of these macros is computed at scanning time.
+            self->is_cacheable = false;
+
+            break;
+        default:
+            break;
+    }
+}
+
+const void *
+read_bytes__CITokenCacheReader(CITokenCacheReader *self, Usize len)
+{
+    // NOTE: The payload is already checked with its hash.
+    ASSERT(len <= self->len - self->position);
+
+    const void *bytes = self->buffer + self->position;
+
+    self->position += len;
+
+    return bytes;
+}
+
+Usize
+read_usize__CITokenCacheReader(CITokenCacheReader *self)
+{
+    Usize value;
+
+    memcpy(&value,
+           read_bytes__CITokenCacheReader(self, sizeof(Usize)),
+           sizeof(Usize));
+
+    return value;
+}
+
+Uint8
+read_uint8__CITokenCacheReader(CITokenCacheReader *self)
+{
+    return *(const Uint8 *)read_bytes__CITokenCacheReader(self, sizeof(Uint8));
+}
+
+String *
+read_string__CITokenCacheReader(CITokenCacheReader *self)
+{
+    Usize len = read_usize__CITokenCacheReader(self);
+
+    if (len == (Usize)-1) {
+        return NULL;
+    }
+
+    String *s = NEW(String);
+
+    push_str_with_len__String(
+      s, read_bytes__CITokenCacheReader(self, len), len);
+
+    return s;
+}
+
+Location
+read_location__CITokenCacheReader(CITokenCacheReader *self)
+{
+    Location location = { .filename = self->filename };
+
+    location.start_line = read_usize__CITokenCacheReader(self);
+    location.end_line = read_usize__CITokenCacheReader(self);
+    location.start_column = read_usize__CITokenCacheReader(self);
+    location.end_column = read_usize__CITokenCacheReader(self);
+    location.start_position = read_usize__CITokenCacheReader(self);
+    location.end_position = read_usize__CITokenCacheReader(self);
+
+    return location;
+}
+
+CITokens
+read_tokens__CITokenCacheReader(CITokenCacheReader *self)
+{
+    CITokens tokens = NEW(CITokens);
+    Usize count = read_usize__CITokenCacheReader(self);
+
+    // NOTE: The tokens are added like the scanner does, so the last token of
+    // the content of a conditional preprocessor is linked again to the next
+    // token of the parent.
+    for (Usize i = 0; i < count; ++i) {
+        add__CITokens(&tokens, read_token__CITokenCacheReader(self));
+    }
+
+    return tokens;
+}
+
+CITokenPreprocessorDefine
+read_define__CITokenCacheReader(CITokenCacheReader *self)
+{
+    String *name = read_string__CITokenCacheReader(self);
+    Vec *params = NULL;
+
+    if (read_uint8__CITokenCacheReader(self)) {
+        Usize params_len = read_usize__CITokenCacheReader(self);
+
+        params = NEW(Vec);
+
+        for (Usize i = 0; i < params_len; ++i) {
+            String *param_name = read_string__CITokenCacheReader(self);
+            CITokenPreprocessorDefineParam *param =
+              read_uint8__CITokenCacheReader(self)
+                ? NEW_VARIANT(CITokenPreprocessorDefineParam, variadic)
+                : NEW_VARIANT(
+                    CITokenPreprocessorDefineParam, normal, param_name);
+
+            if (param->is_variadic && param_name) {
+                FREE(String, param_name);
+            }
+
+            param->is_used = read_uint8__CITokenCacheReader(self);
+
+            push__Vec(params, param);
+        }
+    }
+
+    CITokens tokens = read_tokens__CITokenCacheReader(self);
+    bool is_variadic = read_uint8__CITokenCacheReader(self);
+
+    return NEW(CITokenPreprocessorDefine, name, params, tokens, is_variadic);
+}
+
+CIToken *
+read_token__CITokenCacheReader(CITokenCacheReader *self)
+{
+    enum CITokenKind kind = read_usize__CITokenCacheReader(self);
+    Location location = read_location__CITokenCacheReader(self);
+
+    switch (kind) {
+        case CI_TOKEN_KIND_ATTRIBUTE_DEPRECATED:
+            return NEW_VARIANT(CIToken,
+                               attribute_deprecated,
+                               location,
+                               read_string__CITokenCacheReader(self));
+        case CI_TOKEN_KIND_ATTRIBUTE_NODISCARD:
+            return NEW_VARIANT(CIToken,
+                               attribute_nodiscard,
+                               location,
+                               read_string__CITokenCacheReader(self));
+        case CI_TOKEN_KIND_BUILTIN_MACRO___HAS_FEATURE:
+            return NEW_VARIANT(CIToken,
+                               builtin_macro_has_feature,
+                               location,
+                               read_usize__CITokenCacheReader(self));
+        case CI_TOKEN_KIND_COMMENT_DOC:
+            return NEW_VARIANT(CIToken,
+                               comment_doc,
+                               location,
+                               read_string__CITokenCacheReader(self));
+        case CI_TOKEN_KIND_EOT:
+            return NEW_VARIANT(
+              CIToken,
+              eot,
+              location,
+              NEW(CITokenEot, read_usize__CITokenCacheReader(self)));
+        case CI_TOKEN_KIND_GNU_ATTRIBUTE:
+            return NEW_VARIANT(
+              CIToken,
+              gnu_attribute,
+              location,
+              NEW(CITokenGNUAttribute, read_tokens__CITokenCacheReader(self)));
+        case CI_TOKEN_KIND_IDENTIFIER:
+            return NEW_VARIANT(
+              CIToken,
+              identifier,
+              location,
+              NEW(Rc, read_string__CITokenCacheReader(self)));
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_INT:
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_OCTAL:
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_HEX:
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_BIN: {
+            enum CITokenLiteralConstantIntSuffix suffix =
+              read_usize__CITokenCacheReader(self);
+            CIToken *token =
+              NEW_VARIANT(CIToken,
+                          literal_constant_int,
+                          location,
+                          NEW(CITokenLiteralConstantInt,
+                              suffix,
+                              read_string__CITokenCacheReader(self)));
+
+            token->kind = kind;
+
+            return token;
+        }
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_FLOAT: {
+            enum CITokenLiteralConstantFloatSuffix suffix =
+              read_usize__CITokenCacheReader(self);
+
+            return NEW_VARIANT(CIToken,
+                               literal_constant_float,
+                               location,
+                               NEW(CITokenLiteralConstantFloat,
+                                   suffix,
+                                   read_string__CITokenCacheReader(self)));
+        }
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_CHARACTER:
+            return NEW_VARIANT(CIToken,
+                               literal_constant_character,
+                               location,
+                               read_uint8__CITokenCacheReader(self));
+        case CI_TOKEN_KIND_LITERAL_CONSTANT_STRING:
+            return NEW_VARIANT(
+              CIToken,
+              literal_constant_string,
+              location,
+              NEW(Rc, read_string__CITokenCacheReader(self)));
+        case CI_TOKEN_KIND_MACRO_DEFINED:
+            return NEW_VARIANT(CIToken,
+                               macro_defined,
+                               location,
+                               read_string__CITokenCacheReader(self));
+        case CI_TOKEN_KIND_MACRO_PARAM:
+            return NEW_VARIANT(
+              CIToken,
+              macro_param,
+              location,
+              NEW(CITokenMacroParam, read_usize__CITokenCacheReader(self)));
+        case CI_TOKEN_KIND_MACRO_PARAM_VARIADIC:
+            return NEW_VARIANT(CIToken,
+                               macro_param_variadic,
+                               location,
+                               NEW(CITokenMacroParamVariadic));
+        case CI_TOKEN_KIND_PREPROCESSOR_DEFINE:
+            return NEW_VARIANT(CIToken,
+                               preprocessor_define,
+                               location,
+                               read_define__CITokenCacheReader(self));
+        case CI_TOKEN_KIND_PREPROCESSOR_ELIF:
+        case CI_TOKEN_KIND_PREPROCESSOR_IF: {
+            CITokens cond = read_tokens__CITokenCacheReader(self);
+            CITokens content = read_tokens__CITokenCacheReader(self);
+
+            return kind == CI_TOKEN_KIND_PREPROCESSOR_IF
+                     ? NEW_VARIANT(CIToken,
+                                   preprocessor_if,
+                                   location,
+                                   NEW(CITokenPreprocessorIf, cond, content))
+                     : NEW_VARIANT(CIToken,
+                                   preprocessor_elif,
+                                   location,
+                                   NEW(CITokenPreprocessorElif, cond, content));
+        }
+        case CI_TOKEN_KIND_PREPROCESSOR_ELIFDEF:
+        case CI_TOKEN_KIND_PREPROCESSOR_ELIFNDEF:
+        case CI_TOKEN_KIND_PREPROCESSOR_IFDEF:
+        case CI_TOKEN_KIND_PREPROCESSOR_IFNDEF: {
+            String *identifier = read_string__CITokenCacheReader(self);
+            CIToken *token = NEW_VARIANT(
+              CIToken,
+              preprocessor_ifdef,
+              location,
+              NEW(CITokenPreprocessorIfdef,
+                  identifier,
+                  read_tokens__CITokenCacheReader(self)));
+
+            token->kind = kind;
+
+            return token;
+        }
+        case CI_TOKEN_KIND_PREPROCESSOR_ELSE:
+            return NEW_VARIANT(
+              CIToken,
+              preprocessor_else,
+              location,
+              NEW(CITokenPreprocessorElse,
+                  read_tokens__CITokenCacheReader(self)));
+        case CI_TOKEN_KIND_PREPROCESSOR_EMBED: {
+            String *value = read_string__CITokenCacheReader(self);
+
+            return NEW_VARIANT(CIToken,
+                               preprocessor_embed,
+                               location,
+                               NEW(CITokenPreprocessorEmbed,
+                                   value,
+                                   read_tokens__CITokenCacheReader(self)));
+        }
+        case CI_TOKEN_KIND_PREPROCESSOR_ERROR:
+            return NEW_VARIANT(CIToken,
+                               preprocessor_error,
+                               location,
+                               read_string__CITokenCacheReader(self));
+        case CI_TOKEN_KIND_PREPROCESSOR_INCLUDE:
+            return NEW_VARIANT(
+              CIToken,
+              preprocessor_include,
+              location,
+              NEW(CITokenPreprocessorInclude,
+                  read_string__CITokenCacheReader(self)));
+        case CI_TOKEN_KIND_PREPROCESSOR_LINE: {
+            Usize line = read_usize__CITokenCacheReader(self);
+
+            return NEW_VARIANT(CIToken,
+                               preprocessor_line,
+                               location,
+                               NEW(CITokenPreprocessorLine,
+                                   line,
+                                   read_string__CITokenCacheReader(self)));
+        }
+        case CI_TOKEN_KIND_PREPROCESSOR_UNDEF:
+            return NEW_VARIANT(CIToken,
+                               preprocessor_undef,
+                               location,
+                               read_string__CITokenCacheReader(self));
+        case CI_TOKEN_KIND_PREPROCESSOR_WARNING:
+            return NEW_VARIANT(CIToken,
+                               preprocessor_warning,
+                               location,
+                               read_string__CITokenCacheReader(self));
+        default:
+            ASSERT(kind < CI_TOKEN_KIND_MAX);
+
+            return NEW(CIToken, kind, location);
+    }
+}
+
+bool
+load__CITokenCache(const File *file,
+                   const CIProjectConfig *config,
+                   CITokens *tokens)
+{
+    Int64 mtime = get_mtime__File(file->name);
+
+    if (mtime == -1) {
+        return false;
+    }
+
+    char *path = get_path__CITokenCache(file->name);
+
+    if (!exists__File(path)) {
+        lily_free(path);
+
+        return false;
+    }
+
+    CITokenCacheReader reader = { .buffer = read_file__File(path),
+                                  .len = get_size__File(path),
+                                  .position = 0,
+                                  .filename = file->name };
+    bool is_valid = false;
+
+    lily_free(path);
+
+    // NOTE: The header of the cache is checked step by step, so it's never
+    // read beyond the buffer.
+    if (reader.len < CI_TOKEN_CACHE_MAGIC_LEN + sizeof(Usize) * 5 ||
+        memcmp(reader.buffer, CI_TOKEN_CACHE_MAGIC, CI_TOKEN_CACHE_MAGIC_LEN)) {
+        goto exit;
+    }
+
+    reader.position = CI_TOKEN_CACHE_MAGIC_LEN;
+
+    Usize filename_len = strlen(file->name);
+
+    if (read_usize__CITokenCacheReader(&reader) != CI_TOKEN_CACHE_VERSION ||
+        read_usize__CITokenCacheReader(&reader) != CI_TOKEN_KIND_MAX ||
+        read_usize__CITokenCacheReader(&reader) != config->standard ||
+        read_usize__CITokenCacheReader(&reader) != config->compiler.kind ||
+        read_usize__CITokenCacheReader(&reader) != filename_len ||
+        reader.len - reader.position < filename_len + sizeof(Usize) * 4 ||
+        memcmp(reader.buffer + reader.position, file->name, filename_len)) {
+        goto exit;
+    }
+
+    reader.position += filename_len;
+
+    if ((Int64)read_usize__CITokenCacheReader(&reader) != mtime ||
+        read_usize__CITokenCacheReader(&reader) != file->len ||
+        read_usize__CITokenCacheReader(&reader) !=
+          CI_TOKEN_CACHE_HASH(file->content, file->len)) {
+        goto exit;
+    }
+
+    Usize payload_hash = read_usize__CITokenCacheReader(&reader);
+
+    if (payload_hash != CI_TOKEN_CACHE_HASH(reader.buffer + reader.position,
+                                            reader.len - reader.position)) {
+        goto exit;
+    }
+
+    *tokens = read_tokens__CITokenCacheReader(&reader);
+    is_valid = true;
+
+exit:
+    lily_free((char *)reader.buffer);
+
+    return is_valid;
+}
+
+void
+save__CITokenCache(const File *file,
+                   const CIProjectConfig *config,
+                   const CITokens *tokens)
+{
+    Int64 mtime = get_mtime__File(file->name);
+
+    if (mtime == -1) {
+        return;
+    }
+
+    CITokenCacheWriter payload = { .buffer = NEW(String),
+                                   .is_cacheable = true };
+
+    write_tokens__CITokenCacheWriter(&payload, tokens);
+
+    if (!payload.is_cacheable) {
+        FREE(String, payload.buffer);
+
+        return;
+    }
+
+    CITokenCacheWriter writer = { .buffer = NEW(String),
+                                  .is_cacheable = true };
+
+    write_bytes__CITokenCacheWriter(
+      &writer, CI_TOKEN_CACHE_MAGIC, CI_TOKEN_CACHE_MAGIC_LEN);
+    write_usize__CITokenCacheWriter(&writer, CI_TOKEN_CACHE_VERSION);
+    write_usize__CITokenCacheWriter(&writer, CI_TOKEN_KIND_MAX);
+    write_usize__CITokenCacheWriter(&writer, config->standard);
+    write_usize__CITokenCacheWriter(&writer, config->compiler.kind);
+    write_str__CITokenCacheWriter(&writer, file->name, strlen(file->name));
+    write_usize__CITokenCacheWriter(&writer, mtime);
+    write_usize__CITokenCacheWriter(&writer, file->len);
+    write_usize__CITokenCacheWriter(
+      &writer, CI_TOKEN_CACHE_HASH(file->content, file->len));
+    write_usize__CITokenCacheWriter(
+      &writer,
+      CI_TOKEN_CACHE_HASH(payload.buffer->buffer, payload.buffer->len));
+    write_bytes__CITokenCacheWriter(
+      &writer, payload.buffer->buffer, payload.buffer->len);
+
+    char *dir = get_output_path__CIResult(CI_TOKEN_CACHE_DIR);
+
+    create_recursive_dir__Dir(dir,
+                              DIR_MODE_RWXU | DIR_MODE_RWXG | DIR_MODE_RWXO);
+    lily_free(dir);
+
+    char *path = get_path__CITokenCache(file->name);
+
+    write_file__File(path, writer.buffer->buffer, writer.buffer->len);
+
+    lily_free(path);
+    FREE(String, payload.buffer);
+    FREE(String, writer.buffer);
+}
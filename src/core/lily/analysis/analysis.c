@@ -798,13 +798,13 @@ run_step0__LilyAnalysis(LilyAnalysis *self);
 static inline void
 run_step1__LilyAnalysis(LilyAnalysis *self);
 
-// Check all declarations.
+// Check all declarations, except the bodies of the functions.
 static inline void
 run_step2__LilyAnalysis(LilyAnalysis *self);
 
-static threadlocal LilyCheckedHistory *history = NULL;
-static threadlocal bool in_try = false;
-static threadlocal LilyCheckedDeclAlias *alias_decl = NULL;
+// Check the bodies of the functions.
+static inline void
+run_step3__LilyAnalysis(LilyAnalysis *self);
 
 #define CHECK_FUN_BODY(ast_body, scope, body, safety_mode, in_loop, n)             \
     {                                                                              \
@@ -2477,14 +2477,15 @@ check_data_type__LilyAnalysis(LilyAnalysis *self,
                               enum LilyCheckedSafetyMode safety_mode)
 {
     // Check if the generic params is required in alias declaration
-    if (alias_decl) {
+    if (self->alias_decl) {
         if (data_type->kind != LILY_AST_DATA_TYPE_KIND_CUSTOM) {
-            if (alias_decl->generic_params) {
+            if (self->alias_decl->generic_params) {
                 FAILED(
                   "the generic params of the alias is not expected in this "
                   "context");
             }
-        } else if (alias_decl->generic_params && !data_type->custom.generics) {
+        } else if (self->alias_decl->generic_params &&
+                   !data_type->custom.generics) {
             FAILED("the generic params of the alias is not expected in this "
                    "context");
         }
@@ -2655,16 +2656,16 @@ check_data_type__LilyAnalysis(LilyAnalysis *self,
                         case LILY_CHECKED_DECL_KIND_TYPE:
                             switch (custom_dt_response.decl->type.kind) {
                                 case LILY_CHECKED_DECL_TYPE_KIND_ALIAS: {
-                                    ASSERT(alias_decl);
+                                    ASSERT(self->alias_decl);
 
                                     LilyCheckedDeclAlias *local_alias_decl =
-                                      alias_decl;
-                                    alias_decl = NULL;
+                                      self->alias_decl;
+                                    self->alias_decl = NULL;
 
                                     check_alias__LilyAnalysis(
                                       self, custom_dt_response.decl);
 
-                                    alias_decl = local_alias_decl;
+                                    self->alias_decl = local_alias_decl;
 
                                     break;
                                 }
@@ -3602,17 +3603,16 @@ typecheck_binary_expr__LilyAnalysis(LilyAnalysis *self,
     char *binary_kind_string = to_string__LilyCheckedExprBinaryKind(kind);
     bool defined_data_type_is_null = defined_data_type ? 0 : 1;
 
-    Vec *operators = collect_all_operators__LilyCheckedOperatorRegister(
+    const Vec *operators = get_operators__LilyCheckedOperatorRegister(
       &self->package->operator_register, binary_kind_string, 3);
 
     typecheck_binary__LilyCheckedOperatorRegister(operators,
+                                                  self->binary_operators,
                                                   &expr->location,
                                                   left->data_type,
                                                   right->data_type,
                                                   &defined_data_type);
 
-    FREE(Vec, operators);
-
     return NEW_VARIANT(LilyCheckedExpr,
                        binary,
                        &expr->location,
@@ -5443,7 +5443,8 @@ check_fun_call_expr__LilyAnalysis(LilyAnalysis *self,
 
     if (!fun->fun.is_checked &&
         !contains_for_fun__LilyCheckedHistory(
-          history, get_original_signature__LilyCheckedDeclFun(&fun->fun))) {
+          self->history,
+          get_original_signature__LilyCheckedDeclFun(&fun->fun))) {
         // Add fun dependency to the current
         // function.
         // TODO: method
@@ -5454,12 +5455,12 @@ check_fun_call_expr__LilyAnalysis(LilyAnalysis *self,
             add_fun_dep__LilyCheckedDeclFun(&current_fun->decl->fun, fun);
         }
 
-        ASSERT(history);
+        ASSERT(self->history);
 
-        add__LilyCheckedHistory(history, fun);
+        add__LilyCheckedHistory(self->history, fun);
         check_fun__LilyAnalysis(self, fun);
 
-        FREE(LilyCheckedHistory, &history);
+        FREE(LilyCheckedHistory, &self->history);
     }
 
     if (fun->fun.is_main) {
@@ -5732,8 +5733,10 @@ check_fun_call_expr__LilyAnalysis(LilyAnalysis *self,
 
             if (current_fun) {
                 add_fun_dep__LilyCheckedDeclFun(&current_fun->decl->fun, fun);
-                collect_raises__LilyCheckedDeclFun(
-                  &current_fun->decl->fun, scope, fun->fun.raises, in_try);
+                collect_raises__LilyCheckedDeclFun(&current_fun->decl->fun,
+                                                   scope,
+                                                   fun->fun.raises,
+                                                   self->in_try);
             }
         }
 
@@ -10392,7 +10395,7 @@ check_raise_stmt__LilyAnalysis(LilyAnalysis *self,
                 ASSERT(fun);
 
                 add_raise__LilyCheckedDeclFun(
-                  &fun->decl->fun, scope, raise_expr->data_type, in_try);
+                  &fun->decl->fun, scope, raise_expr->data_type, self->in_try);
             }
 
             return NEW_VARIANT(
@@ -10590,7 +10593,7 @@ check_try_stmt__LilyAnalysis(LilyAnalysis *self,
           NEW_VARIANT(LilyCheckedParent, scope, scope, current_body),
           NEW_VARIANT(LilyCheckedScopeDecls, scope, try_body));
 
-    in_try = true;
+    self->in_try = true;
 
     CHECK_FUN_BODY(stmt->try.try_body,
                    scope_try,
@@ -10603,7 +10606,7 @@ check_try_stmt__LilyAnalysis(LilyAnalysis *self,
         FAILED("no raises are expected in this scope");
     }
 
-    in_try = false;
+    self->in_try = false;
 
     if (stmt->try.catch_body && scope_try->raises) {
         Vec *catch_body = NEW(Vec);
@@ -11178,6 +11181,7 @@ check_fun_signature__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *fun)
           NULL,
           NULL);
     }
+    fun->fun.signature_is_checked = true;
 }
 
 void
@@ -11201,8 +11205,10 @@ check_fun__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *fun)
         }
     }
 
-    // 2. Check fun signature
-    check_fun_signature__LilyAnalysis(self, fun);
+    // 2. Check fun signature (if not already checked in the step 2)
+    if (!fun->fun.signature_is_checked) {
+        check_fun_signature__LilyAnalysis(self, fun);
+    }
 
     // 3. Init scope of body.
     fun->fun.scope =
@@ -11348,7 +11354,7 @@ check_fun__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *fun)
     lock_data_types__LilyCheckedDeclFun(&fun->fun);
 
     // 10. Free history
-    FREE(LilyCheckedHistory, &history);
+    FREE(LilyCheckedHistory, &self->history);
 
     fun->fun.is_checked = true;
 }
@@ -11389,7 +11395,7 @@ check_constant__LilyAnalysis(LilyAnalysis *self,
           NULL);
     }
 
-    FREE(LilyCheckedHistory, &history);
+    FREE(LilyCheckedHistory, &self->history);
 
     constant->constant.is_checked = true;
 }
@@ -11434,7 +11440,7 @@ check_alias__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *alias)
         return;
     }
 
-    alias_decl = &alias->type.alias;
+    self->alias_decl = &alias->type.alias;
 
     // 1. Check generic params.
     if (alias->ast_decl->type.alias.generic_params) {
@@ -11452,9 +11458,9 @@ check_alias__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *alias)
                                     NULL,
                                     LILY_CHECKED_SAFETY_MODE_SAFE);
 
-    alias_decl = NULL;
+    self->alias_decl = NULL;
 
-    FREE(LilyCheckedHistory, &history);
+    FREE(LilyCheckedHistory, &self->history);
 
     alias->type.alias.is_checked = true;
 }
@@ -11600,7 +11606,7 @@ check_record__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *record)
         }
     }
 
-    FREE(LilyCheckedHistory, &history);
+    FREE(LilyCheckedHistory, &self->history);
 
     record->type.record.is_checked = true;
 }
@@ -11710,7 +11716,7 @@ check_enum__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *enum_)
         }
     }
 
-    FREE(LilyCheckedHistory, &history);
+    FREE(LilyCheckedHistory, &self->history);
 
     enum_->type.enum_.is_checked = true;
 }
@@ -11742,7 +11748,7 @@ check_error__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *error)
           self, error->error.data_type, error->error.global_name);
     }
 
-    FREE(LilyCheckedHistory, &history);
+    FREE(LilyCheckedHistory, &self->history);
 
     error->error.is_checked = true;
 }
@@ -11754,7 +11760,7 @@ check_module__LilyAnalysis(LilyAnalysis *self, LilyCheckedDecl *module)
     check_decls__LilyAnalysis(
       self, module->module.decls, module->module.scope, true);
 
-    FREE(LilyCheckedHistory, &history);
+    FREE(LilyCheckedHistory, &self->history);
 
     module->module.is_checked = true;
 }
@@ -11795,16 +11801,26 @@ check_decls__LilyAnalysis(LilyAnalysis *self,
         LilyCheckedDecl *decl = get__Vec(decls, i);
 
         if (in_module) {
-            ASSERT(history);
+            ASSERT(self->history);
         } else {
-            history = NEW(LilyCheckedHistory);
+            self->history = NEW(LilyCheckedHistory);
         }
 
-        add__LilyCheckedHistory(history, decl);
+        add__LilyCheckedHistory(self->history, decl);
 
         switch (decl->kind) {
             case LILY_CHECKED_DECL_KIND_FUN:
-                check_fun__LilyAnalysis(self, decl);
+                if (self->signatures_only) {
+                    if (!decl->fun.signature_is_checked) {
+                        check_fun_signature__LilyAnalysis(self, decl);
+
+                        // NOTE: The history is freed as at the end of
+                        // `check_fun__LilyAnalysis`.
+                        FREE(LilyCheckedHistory, &self->history);
+                    }
+                } else {
+                    check_fun__LilyAnalysis(self, decl);
+                }
 
                 break;
             case LILY_CHECKED_DECL_KIND_CONSTANT:
@@ -11866,7 +11882,7 @@ check_decls__LilyAnalysis(LilyAnalysis *self,
         }
 
         if (!in_module) {
-            FREE(LilyCheckedHistory, &history);
+            FREE(LilyCheckedHistory, &self->history);
         }
     }
 }
@@ -11884,6 +11900,20 @@ run_step1__LilyAnalysis(LilyAnalysis *self)
 
 void
 run_step2__LilyAnalysis(LilyAnalysis *self)
+{
+    // NOTE: All signatures are checked before any function body, so the body
+    // of a function only depends on the signatures of the functions it calls
+    // (except when the return data type of the callee is inferred).
+    self->signatures_only = true;
+
+    check_decls__LilyAnalysis(
+      self, self->module.decls, self->module.scope, false);
+
+    self->signatures_only = false;
+}
+
+void
+run_step3__LilyAnalysis(LilyAnalysis *self)
 {
     check_decls__LilyAnalysis(
       self, self->module.decls, self->module.scope, false);
@@ -11907,6 +11937,7 @@ run__LilyAnalysis(LilyAnalysis *self)
     run_step0__LilyAnalysis(self);
     run_step1__LilyAnalysis(self);
     run_step2__LilyAnalysis(self);
+    run_step3__LilyAnalysis(self);
 
     // TODO: add a support to only build a library.
     if (!self->package->main_is_found &&
@@ -11946,4 +11977,5 @@ DESTRUCTOR(LilyAnalysis, const LilyAnalysis *self)
 {
     FREE(String, self->module.name);
     FREE(LilyCheckedDeclModule, &self->module);
+    FREE(Vec, self->binary_operators);
 }
@@ -39,6 +39,16 @@
 #include <base/print.h>
 #endif
 
+// Combine the hash with the value.
+static inline Uint64
+combine_hash__LilyCheckedDataType(Uint64 hash, Uint64 value);
+
+// Combine the hash with the hash of the item, return 0 if the item has no
+// hash.
+static Uint64
+combine_item_hash__LilyCheckedDataType(Uint64 hash,
+                                       const LilyCheckedDataType *item);
+
 // Free LilyCheckedDataTypeLambda type.
 static DESTRUCTOR(LilyCheckedDataTypeLambda,
                   const LilyCheckedDataTypeLambda *self);
@@ -935,8 +945,8 @@ eq__LilyCheckedDataType(LilyCheckedDataType *self, LilyCheckedDataType *other)
                     }
 
                     // TODO: compare generics params of data type
-                    return !strcmp(self->custom.global_name->buffer,
-                                   other->custom.global_name->buffer) &&
+                    return self->custom.global_name_symbol ==
+                             other->custom.global_name_symbol &&
                            self->custom.kind == other->custom.kind;
                 default:
                     return false;
@@ -1203,6 +1213,141 @@ eq_return_data_type__LilyCheckedDataType(LilyCheckedDataType *self,
     }
 }
 
+static inline Uint64
+combine_hash__LilyCheckedDataType(Uint64 hash, Uint64 value)
+{
+    // FNV-1a step
+    return (hash ^ value) * 0x100000001b3ULL;
+}
+
+static Uint64
+combine_item_hash__LilyCheckedDataType(Uint64 hash,
+                                       const LilyCheckedDataType *item)
+{
+    Uint64 item_hash = hash__LilyCheckedDataType(item);
+
+    return item_hash ? combine_hash__LilyCheckedDataType(hash, item_hash) : 0;
+}
+
+Uint64
+hash__LilyCheckedDataType(const LilyCheckedDataType *self)
+{
+    Uint64 hash =
+      combine_hash__LilyCheckedDataType(0xcbf29ce484222325ULL, self->kind);
+
+    switch (self->kind) {
+        case LILY_CHECKED_DATA_TYPE_KIND_UNKNOWN:
+        case LILY_CHECKED_DATA_TYPE_KIND_COMPILER_CHOICE:
+        case LILY_CHECKED_DATA_TYPE_KIND_CONDITIONAL_COMPILER_CHOICE:
+        case LILY_CHECKED_DATA_TYPE_KIND_COMPILER_GENERIC:
+            return 0;
+        // Mut and optional are transparent for eq__LilyCheckedDataType.
+        case LILY_CHECKED_DATA_TYPE_KIND_MUT:
+            return hash__LilyCheckedDataType(self->mut);
+        case LILY_CHECKED_DATA_TYPE_KIND_OPTIONAL:
+            return hash__LilyCheckedDataType(self->optional);
+        case LILY_CHECKED_DATA_TYPE_KIND_ARRAY:
+            switch (self->array.kind) {
+                case LILY_CHECKED_DATA_TYPE_ARRAY_KIND_UNKNOWN:
+                    return 0;
+                case LILY_CHECKED_DATA_TYPE_ARRAY_KIND_SIZED:
+                    hash = combine_hash__LilyCheckedDataType(hash,
+                                                             self->array.sized);
+                    break;
+                default:
+                    break;
+            }
+
+            hash = combine_hash__LilyCheckedDataType(hash, self->array.kind);
+            hash = combine_item_hash__LilyCheckedDataType(
+              hash, self->array.data_type);
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_CUSTOM:
+            if (self->custom.kind ==
+                LILY_CHECKED_DATA_TYPE_CUSTOM_KIND_GENERIC) {
+                return 0;
+            }
+
+            hash = combine_hash__LilyCheckedDataType(
+              hash, self->custom.global_name_symbol);
+            hash = combine_hash__LilyCheckedDataType(hash, self->custom.kind);
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_RESULT:
+            // NOTE: The errors are only compared when the both results have
+            // errors, so only the ok data type is hashed.
+            hash =
+              combine_item_hash__LilyCheckedDataType(hash, self->result->ok);
+
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_LAMBDA: {
+            Uint64 params_hash =
+              hash_vec__LilyCheckedDataType(self->lambda.params);
+
+            if (!params_hash) {
+                return 0;
+            }
+
+            hash = combine_hash__LilyCheckedDataType(hash, params_hash);
+            hash = combine_item_hash__LilyCheckedDataType(
+              hash, self->lambda.return_type);
+
+            break;
+        }
+        case LILY_CHECKED_DATA_TYPE_KIND_TUPLE: {
+            Uint64 items_hash = hash_vec__LilyCheckedDataType(self->tuple);
+
+            if (!items_hash) {
+                return 0;
+            }
+
+            hash = combine_hash__LilyCheckedDataType(hash, items_hash);
+
+            break;
+        }
+        case LILY_CHECKED_DATA_TYPE_KIND_LIST:
+            hash = combine_item_hash__LilyCheckedDataType(hash, self->list);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR:
+            hash = combine_item_hash__LilyCheckedDataType(hash, self->ptr);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_PTR_MUT:
+            hash = combine_item_hash__LilyCheckedDataType(hash, self->ptr_mut);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_REF:
+            hash = combine_item_hash__LilyCheckedDataType(hash, self->ref);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_REF_MUT:
+            hash = combine_item_hash__LilyCheckedDataType(hash, self->ref_mut);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE:
+            hash = combine_item_hash__LilyCheckedDataType(hash, self->trace);
+            break;
+        case LILY_CHECKED_DATA_TYPE_KIND_TRACE_MUT:
+            hash =
+              combine_item_hash__LilyCheckedDataType(hash, self->trace_mut);
+            break;
+        default:
+            break;
+    }
+
+    return hash;
+}
+
+Uint64
+hash_vec__LilyCheckedDataType(const Vec *self)
+{
+    Uint64 hash =
+      combine_hash__LilyCheckedDataType(0xcbf29ce484222325ULL, self->len);
+
+    for (Usize i = 0; i < self->len && hash; ++i) {
+        hash = combine_item_hash__LilyCheckedDataType(hash, get__Vec(self, i));
+    }
+
+    return hash;
+}
+
 LilyCheckedDataType *
 get_return_data_type_of_conditional_compiler_choice(
   const LilyCheckedDataType *self,
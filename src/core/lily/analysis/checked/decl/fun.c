@@ -318,12 +318,18 @@ get_signature__LilyCheckedDeclFun(LilyCheckedDeclFun *self,
                                   String *global_name,
                                   Vec *fun_types)
 {
+    Uint64 fun_types_hash = hash_vec__LilyCheckedDataType(fun_types);
+
     for (Usize i = 0; i < self->signatures->len; ++i) {
         LilyCheckedSignatureFun *signature = get__Vec(self->signatures, i);
 
         if (strcmp(signature->global_name->buffer, global_name->buffer) &&
             fun_types->len == signature->types->len) {
             continue;
+        } else if (fun_types->len == signature->types->len &&
+                   !may_eq_hash__LilyCheckedDataType(fun_types_hash,
+                                                     signature->hash)) {
+            continue;
         }
 
         bool is_match = true;
@@ -36,6 +36,7 @@ CONSTRUCTOR(LilyCheckedOperator *,
 
     self->name = name;
     self->signature = signature;
+    self->signature_hash = hash_vec__LilyCheckedDataType(signature);
     self->is_default = is_default;
     self->ref_count = 0;
 
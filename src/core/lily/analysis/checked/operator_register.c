@@ -31,20 +31,94 @@
 #include <stdlib.h>
 #include <string.h>
 
+// Get the collection of operators with the given name and signature length.
+static LilyCheckedOperatorCollection *
+get_collection__LilyCheckedOperatorRegister(
+  const LilyCheckedOperatorRegister *self,
+  char *name,
+  Usize signature_len);
+
 static void
 binary_update_data_type_according_operator_collection__LilyCheckedOperatorRegister(
-  Vec *operators,
+  const Vec *operators,
   LilyCheckedDataType *data_type,
   Usize position);
 
 static void
 binary_update_return_data_type_according_operator_collection__LilyCheckedOperatorRegister(
-  Vec *operators,
+  const Vec *operators,
   const Location *expr_location,
   LilyCheckedDataType *left,
   LilyCheckedDataType *right,
   LilyCheckedDataType **return_data_type);
 
+CONSTRUCTOR(LilyCheckedOperatorCollection *,
+            LilyCheckedOperatorCollection,
+            Usize signature_len)
+{
+    LilyCheckedOperatorCollection *self =
+      lily_malloc(sizeof(LilyCheckedOperatorCollection));
+
+    self->signature_len = signature_len;
+    self->operators = NEW(Vec);
+
+    return self;
+}
+
+DESTRUCTOR(LilyCheckedOperatorCollection, LilyCheckedOperatorCollection *self)
+{
+    FREE(Vec, self->operators);
+    lily_free(self);
+}
+
+LilyCheckedOperatorCollection *
+get_collection__LilyCheckedOperatorRegister(
+  const LilyCheckedOperatorRegister *self,
+  char *name,
+  Usize signature_len)
+{
+    Vec *collections = get__HashMap(self->index, name);
+
+    if (collections) {
+        for (Usize i = 0; i < collections->len; ++i) {
+            LilyCheckedOperatorCollection *collection =
+              get__Vec(collections, i);
+
+            if (collection->signature_len == signature_len) {
+                return collection;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void
+push_operator__LilyCheckedOperatorRegister(LilyCheckedOperatorRegister *self,
+                                           LilyCheckedOperator *operator)
+{
+    push__Vec(self->operators, operator);
+
+    LilyCheckedOperatorCollection *collection =
+      get_collection__LilyCheckedOperatorRegister(
+        self, operator->name->buffer, operator->signature->len);
+
+    if (!collection) {
+        Vec *collections = get__HashMap(self->index, operator->name->buffer);
+
+        if (!collections) {
+            collections = NEW(Vec);
+            insert__HashMap(self->index, operator->name->buffer, collections);
+        }
+
+        collection =
+          NEW(LilyCheckedOperatorCollection, operator->signature->len);
+        push__Vec(collections, collection);
+    }
+
+    push__Vec(collection->operators, operator);
+}
+
 int
 add_operator__LilyCheckedOperatorRegister(LilyCheckedOperatorRegister *self,
                                           LilyCheckedOperator *operator)
@@ -58,7 +132,7 @@ add_operator__LilyCheckedOperatorRegister(LilyCheckedOperatorRegister *self,
         return 1;
     }
 
-    push__Vec(self->operators, operator);
+    push_operator__LilyCheckedOperatorRegister(self, operator);
 
     return 0;
 }
@@ -69,33 +143,53 @@ search_operator__LilyCheckedOperatorRegister(
   char *name,
   Vec *signature)
 {
-    for (Usize i = 0; i < self->operators->len; ++i) {
-        LilyCheckedOperator *operator= get__Vec(self->operators, i);
+    LilyCheckedOperatorCollection *collection =
+      get_collection__LilyCheckedOperatorRegister(self, name, signature->len);
 
-        if (!strcmp(name, operator->name->buffer)) {
-            if (signature->len != operator->signature->len) {
-                continue;
-            }
+    if (!collection) {
+        return NULL;
+    }
 
-            bool is_match = true;
+    Uint64 signature_hash = hash_vec__LilyCheckedDataType(signature);
 
-            for (Usize j = 0; j < operator->signature->len; ++j) {
-                if (!eq__LilyCheckedDataType(get__Vec(operator->signature, j),
-                                             get__Vec(signature, j))) {
-                    is_match = false;
-                    break;
-                }
-            }
+    for (Usize i = 0; i < collection->operators->len; ++i) {
+        LilyCheckedOperator *operator= get__Vec(collection->operators, i);
+
+        if (!may_eq_hash__LilyCheckedDataType(signature_hash,
+                                              operator->signature_hash)) {
+            continue;
+        }
+
+        bool is_match = true;
 
-            if (is_match) {
-                return operator;
+        for (Usize j = 0; j < operator->signature->len; ++j) {
+            if (!eq__LilyCheckedDataType(get__Vec(operator->signature, j),
+                                         get__Vec(signature, j))) {
+                is_match = false;
+                break;
             }
         }
+
+        if (is_match) {
+            return operator;
+        }
     }
 
     return NULL;
 }
 
+const Vec *
+get_operators__LilyCheckedOperatorRegister(
+  const LilyCheckedOperatorRegister *self,
+  char *name,
+  Usize signature_len)
+{
+    LilyCheckedOperatorCollection *collection =
+      get_collection__LilyCheckedOperatorRegister(self, name, signature_len);
+
+    return collection ? collection->operators : NULL;
+}
+
 Vec *
 collect_all_operators__LilyCheckedOperatorRegister(
   const LilyCheckedOperatorRegister *self,
@@ -103,14 +197,11 @@ collect_all_operators__LilyCheckedOperatorRegister(
   Usize signature_len)
 {
     Vec *operators = NEW(Vec); // Vec<LilyCheckedOperator* (&)>*
+    const Vec *collection_operators =
+      get_operators__LilyCheckedOperatorRegister(self, name, signature_len);
 
-    for (Usize i = 0; i < self->operators->len; ++i) {
-        LilyCheckedOperator *operator= get__Vec(self->operators, i);
-
-        if (!strcmp(name, operator->name->buffer) &&
-            signature_len == operator->signature->len) {
-            push__Vec(operators, operator);
-        }
+    if (collection_operators) {
+        append__Vec(operators, collection_operators);
     }
 
     return operators;
@@ -196,7 +287,6 @@ generate_conditional_compiler_choice_according_operator_collection__LilyCheckedO
             }                                                                  \
                                                                                \
             if (!is_match) {                                                   \
-                remove__Vec(operators, i);                                     \
                 continue;                                                      \
             }                                                                  \
                                                                                \
@@ -217,7 +307,6 @@ generate_conditional_compiler_choice_according_operator_collection__LilyCheckedO
             }                                                                  \
                                                                                \
             if (!is_match) {                                                   \
-                remove__Vec(operators, i);                                     \
                 continue;                                                      \
             }                                                                  \
                                                                                \
@@ -225,7 +314,6 @@ generate_conditional_compiler_choice_according_operator_collection__LilyCheckedO
         }                                                                      \
         default:                                                               \
             if (!eq__LilyCheckedDataType(dt_op, dt)) {                         \
-                remove__Vec(operators, i);                                     \
                 continue;                                                      \
             }                                                                  \
     }
@@ -248,7 +336,7 @@ generate_conditional_compiler_choice_according_operator_collection__LilyCheckedO
 
 void
 binary_update_data_type_according_operator_collection__LilyCheckedOperatorRegister(
-  Vec *operators,
+  const Vec *operators,
   LilyCheckedDataType *data_type,
   Usize position)
 {
@@ -268,7 +356,7 @@ binary_update_data_type_according_operator_collection__LilyCheckedOperatorRegist
 
 void
 binary_update_return_data_type_according_operator_collection__LilyCheckedOperatorRegister(
-  Vec *operators,
+  const Vec *operators,
   const Location *expr_location,
   LilyCheckedDataType *left,
   LilyCheckedDataType *right,
@@ -334,14 +422,18 @@ binary_update_return_data_type_according_operator_collection__LilyCheckedOperato
 
 void
 typecheck_binary__LilyCheckedOperatorRegister(
-  Vec *operators,
+  const Vec *operators,
+  Vec *matches,
   const Location *expr_location,
   LilyCheckedDataType *left,
   LilyCheckedDataType *right,
   LilyCheckedDataType **defined_data_type)
 {
-    // 1. Filter operators
-    for (Usize i = 0; i < operators->len;) {
+    // 1. Filter operators (the operators are not copied, only the operators
+    // which match are pushed to `matches`)
+    matches->len = 0;
+
+    for (Usize i = 0; operators && i < operators->len; ++i) {
         LilyCheckedOperator *operator= get__Vec(operators, i);
         LilyCheckedDataType *left_op_data_type =
           get__Vec(operator->signature, 0);
@@ -360,24 +452,35 @@ typecheck_binary__LilyCheckedOperatorRegister(
             FILTER_OPERATOR(return_op_data_type, (*defined_data_type));
         }
 
-        ++i;
+        push__Vec(matches, operator);
     }
 
-    if (operators->len == 0) {
+    if (matches->len == 0) {
         FAILED("no operator signature matched");
     }
 
     // 2. Update data type
     binary_update_data_type_according_operator_collection__LilyCheckedOperatorRegister(
-      operators, left, 0);
+      matches, left, 0);
     binary_update_data_type_according_operator_collection__LilyCheckedOperatorRegister(
-      operators, right, 1);
+      matches, right, 1);
     binary_update_return_data_type_according_operator_collection__LilyCheckedOperatorRegister(
-      operators, expr_location, left, right, defined_data_type);
+      matches, expr_location, left, right, defined_data_type);
 }
 
 DESTRUCTOR(LilyCheckedOperatorRegister, const LilyCheckedOperatorRegister *self)
 {
+    HashMapIter iter = NEW(HashMapIter, self->index);
+    Vec *collections = NULL;
+
+    while ((collections = next__HashMapIter(&iter))) {
+        FREE_BUFFER_ITEMS(collections->buffer,
+                          collections->len,
+                          LilyCheckedOperatorCollection);
+        FREE(Vec, collections);
+    }
+
+    FREE(HashMap, self->index);
     FREE_BUFFER_ITEMS(
       self->operators->buffer, self->operators->len, LilyCheckedOperator);
     FREE(Vec, self->operators);
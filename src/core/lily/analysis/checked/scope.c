@@ -103,15 +103,17 @@ search_trait_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
         }                                                  \
     }
 
-#define VEC_CHECK_IF_EXISTS(container, item, container_name)           \
-    if (container) {                                                   \
-        for (Usize i = 0; i < container->len; ++i) {                   \
-            if (!strcmp(CAST(container_name *, get__Vec(container, i)) \
-                          ->name->buffer,                              \
-                        item->name->buffer)) {                         \
-                return 1;                                              \
-            }                                                          \
-        }                                                              \
+#define VEC_CHECK_IF_EXISTS(container, item, container_name)              \
+    if (container) {                                                      \
+        Symbol symbol = lookup__Symbol(item->name->buffer);               \
+                                                                          \
+        for (Usize i = 0; symbol != SYMBOL_NONE && i < container->len;    \
+             ++i) {                                                       \
+            if (CAST(container_name *, get__Vec(container, i))->symbol == \
+                symbol) {                                                 \
+                return 1;                                                 \
+            }                                                             \
+        }                                                                 \
     }
 
 #define HASH_MAP_ADD_TO_SCOPE(container, item)            \
@@ -375,10 +377,14 @@ get_fun_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                                            const String *name)
 {
     if (self->funs) {
-        for (Usize i = 0; i < self->funs->len; ++i) {
+        // NOTE: All the function names are interned, so if the name has never
+        // been interned, no function is matching.
+        Symbol symbol = lookup__Symbol(name->buffer);
+
+        for (Usize i = 0; symbol != SYMBOL_NONE && i < self->funs->len; ++i) {
             LilyCheckedScopeContainerFun *fun = get__Vec(self->funs, i);
 
-            if (!strcmp(fun->name->buffer, name->buffer)) {
+            if (fun->symbol == symbol) {
                 return fun;
             }
         }
@@ -562,11 +568,14 @@ search_fun_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
 {
     if (self->funs) {
         switch (self->decls.kind) {
-            case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE:
-                for (Usize i = 0; i < self->funs->len; ++i) {
+            case LILY_CHECKED_SCOPE_DECLS_KIND_MODULE: {
+                Symbol symbol = lookup__Symbol(name->buffer);
+
+                for (Usize i = 0; symbol != SYMBOL_NONE && i < self->funs->len;
+                     ++i) {
                     LilyCheckedScopeContainerFun *fun = get__Vec(self->funs, i);
 
-                    if (!strcmp(fun->name->buffer, name->buffer)) {
+                    if (fun->symbol == symbol) {
                         Vec *f = NEW(Vec);
 
                         for (Usize j = 0; j < fun->ids->len; ++j) {
@@ -587,6 +596,7 @@ search_fun_in_current_scope__LilyCheckedScope(LilyCheckedScope *self,
                 }
 
                 return NEW(LilyCheckedScopeResponse);
+            }
             default:
                 return NEW(LilyCheckedScopeResponse);
         }
@@ -331,6 +331,7 @@ CONSTRUCTOR(LilyCheckedScopeContainerFun *,
       lily_malloc(sizeof(LilyCheckedScopeContainerFun));
 
     self->name = name;
+    self->symbol = intern__Symbol(name->buffer);
     self->ids = ids;
 
     return self;
@@ -46,6 +46,7 @@ CONSTRUCTOR(LilyCheckedSignatureFun *,
     self->ser_global_name = clone__String(global_name);
     self->types = types;
     self->generic_params = generic_params;
+    self->hash = hash_vec__LilyCheckedDataType(types);
 
     generate_global_fun_name_with_vec__LilyCheckedGlobalName(
       self->ser_global_name, self->types);
@@ -61,12 +62,20 @@ add_signature__LilyCheckedSignatureFun(String *global_name,
 {
     ASSERT(types->len != 0);
 
+    Uint64 types_hash = hash_vec__LilyCheckedDataType(types);
+
     for (Usize i = 0; i < signatures->len; ++i) {
-        Vec *pushed_types =
-          CAST(LilyCheckedSignatureFun *, get__Vec(signatures, i))->types;
+        LilyCheckedSignatureFun *signature = get__Vec(signatures, i);
+        Vec *pushed_types = signature->types;
 
         ASSERT(types->len == pushed_types->len);
 
+        // The both signatures only contain known data types and are
+        // structurally different.
+        if (!may_eq_hash__LilyCheckedDataType(types_hash, signature->hash)) {
+            continue;
+        }
+
         bool is_match = true;
 
         for (Usize j = 0; j < pushed_types->len; ++j) {
@@ -100,6 +109,7 @@ reload_global_name__LilyCheckedSignatureFun(LilyCheckedSignatureFun *self)
       reload_ser_global_name, self->types);
     FREE(String, self->ser_global_name);
     self->ser_global_name = reload_ser_global_name;
+    self->hash = hash_vec__LilyCheckedDataType(self->types);
 }
 
 bool
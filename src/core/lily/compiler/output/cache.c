@@ -22,9 +22,78 @@
  * SOFTWARE.
  */
 
+#include <base/alloc.h>
+#include <base/atoi.h>
 #include <base/dir.h>
+#include <base/file.h>
+#include <base/format.h>
+#include <base/hash/sip.h>
+#include <base/new.h>
+#include <base/str.h>
+#include <base/string.h>
+
+#include <cli/version.h>
 
 #include <core/lily/compiler/output/cache.h>
+#include <core/lily/package/package.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef PLATFORM_64
+#define CACHE_K0 0x0123456789abcdefULL
+#define CACHE_K1 0xfedcba9876543210ULL
+#else
+#define CACHE_K0 0x01234567
+#define CACHE_K1 0x89abcdef
+#endif
+
+/**
+ *
+ * @brief Combine the value with the key.
+ */
+static Usize
+combine_key__LilyCompilerOutputCache(Usize key, Usize value);
+
+/**
+ *
+ * @brief Get (compute if needed) the key of the package.
+ */
+static Usize
+get_key__LilyCompilerOutputCache(LilyPackage *package);
+
+/**
+ *
+ * @brief Load the entries of the manifest.
+ */
+static void
+load_manifest__LilyCompilerOutputCache(LilyCompilerOutputCache *self);
+
+/**
+ *
+ * @brief Check if the object file of the package in the tree (and in its
+ * children) can be reused.
+ * @return true if all packages hit the cache.
+ */
+static bool
+check_tree__LilyCompilerOutputCache(LilyCompilerOutputCache *self,
+                                    const LilyPackageDependencyTree *tree);
+
+/**
+ *
+ * @brief Update the entry of the package in the tree (and in its children).
+ */
+static void
+save_tree__LilyCompilerOutputCache(LilyCompilerOutputCache *self,
+                                   const LilyPackageDependencyTree *tree);
+
+/**
+ *
+ * @brief Write the entries in the manifest.
+ */
+static void
+write_manifest__LilyCompilerOutputCache(const LilyCompilerOutputCache *self);
 
 void
 create_cache__LilyCompilerOutputCache()
@@ -49,3 +118,249 @@ create_cache__LilyCompilerOutputCache()
                     DIR_MODE_RWXU | DIR_MODE_RWXG | DIR_MODE_RWXO);
     }
 }
+
+CONSTRUCTOR(LilyCompilerOutputCacheEntry *,
+            LilyCompilerOutputCacheEntry,
+            char *global_name,
+            Usize key,
+            char *obj_path)
+{
+    LilyCompilerOutputCacheEntry *self =
+      lily_malloc(sizeof(LilyCompilerOutputCacheEntry));
+
+    self->global_name = global_name;
+    self->key = key;
+    self->obj_path = obj_path;
+
+    return self;
+}
+
+DESTRUCTOR(LilyCompilerOutputCacheEntry, LilyCompilerOutputCacheEntry *self)
+{
+    lily_free(self->global_name);
+    lily_free(self->obj_path);
+    lily_free(self);
+}
+
+CONSTRUCTOR(LilyCompilerOutputCache, LilyCompilerOutputCache)
+{
+    LilyCompilerOutputCache self = { .entries = NEW(HashMap),
+                                     .hits = 0,
+                                     .misses = 0 };
+
+    load_manifest__LilyCompilerOutputCache(&self);
+
+    return self;
+}
+
+Usize
+combine_key__LilyCompilerOutputCache(Usize key, Usize value)
+{
+    Usize pair[2] = { key, value };
+
+    return hash_sip(pair, sizeof(pair), CACHE_K0, CACHE_K1);
+}
+
+Usize
+get_key__LilyCompilerOutputCache(LilyPackage *package)
+{
+    ASSERT(package->kind == LILY_PACKAGE_KIND_COMPILER);
+
+    // NOTE: The key 0 is used to know that the key is not computed yet.
+    if (package->compiler.cache_key) {
+        return package->compiler.cache_key;
+    }
+
+    const LilyPackageCompilerConfig *config = package->compiler.config;
+    Usize key =
+      hash_sip(package->file.content, package->file.len, CACHE_K0, CACHE_K1);
+
+    key = combine_key__LilyCompilerOutputCache(
+      key, hash_sip(VERSION, strlen(VERSION), CACHE_K0, CACHE_K1));
+    key = combine_key__LilyCompilerOutputCache(key, config->arch_target);
+    key = combine_key__LilyCompilerOutputCache(key, config->os_target);
+    key = combine_key__LilyCompilerOutputCache(
+      key,
+      config->o0 | config->o1 << 1 | config->o2 << 2 | config->o3 << 3 |
+        config->oz << 4);
+    key = combine_key__LilyCompilerOutputCache(key, package->compiler.ir.kind);
+
+    // NOTE: The analysis of the package depends on the declarations of its
+    // package dependencies, so the key of each package dependency is combined
+    // with the key of the package.
+    for (Usize i = 0; i < package->package_dependencies->len; ++i) {
+        key = combine_key__LilyCompilerOutputCache(
+          key,
+          get_key__LilyCompilerOutputCache(
+            get__Vec(package->package_dependencies, i)));
+    }
+
+    package->compiler.cache_key = key ? key : 1;
+
+    return package->compiler.cache_key;
+}
+
+void
+load_manifest__LilyCompilerOutputCache(LilyCompilerOutputCache *self)
+{
+    if (!exists__File(DIR_CACHE_MANIFEST)) {
+        return;
+    }
+
+    char *content = read_file__File(DIR_CACHE_MANIFEST);
+    char *line = content;
+
+    // NOTE: The lines are split in place, to keep the loading of the manifest
+    // linear in the size of the manifest.
+    while (*line) {
+        char *line_end = strchr(line, '\n');
+
+        if (line_end) {
+            *line_end = '\0';
+        }
+
+        char *key = strchr(line, ' ');
+        char *obj_path = key ? strchr(key + 1, ' ') : NULL;
+
+        // NOTE: A malformed line is ignored, so the package is rebuilt.
+        if (obj_path && obj_path != key + 1 && obj_path[1]) {
+            *key++ = '\0';
+            *obj_path++ = '\0';
+
+            LilyCompilerOutputCacheEntry *entry =
+              NEW(LilyCompilerOutputCacheEntry,
+                  strdup(line),
+                  atoi__Usize(key, 10),
+                  strdup(obj_path));
+
+            // NOTE: If the package is duplicated in the manifest, the first
+            // entry is kept.
+            if (insert__HashMap(self->entries, entry->global_name, entry)) {
+                FREE(LilyCompilerOutputCacheEntry, entry);
+            }
+        }
+
+        if (!line_end) {
+            break;
+        }
+
+        line = line_end + 1;
+    }
+
+    lily_free(content);
+}
+
+bool
+check_tree__LilyCompilerOutputCache(LilyCompilerOutputCache *self,
+                                    const LilyPackageDependencyTree *tree)
+{
+    LilyPackage *package = tree->package;
+    LilyCompilerOutputCacheEntry *entry =
+      get__HashMap(self->entries, package->global_name->buffer);
+
+    package->compiler.cache_hit =
+      entry && entry->key == get_key__LilyCompilerOutputCache(package) &&
+      exists__File(entry->obj_path);
+
+    if (package->compiler.cache_hit) {
+        ASSERT(!package->compiler.output_path);
+
+        package->compiler.output_path = strdup(entry->obj_path);
+        ++self->hits;
+    } else {
+        ++self->misses;
+    }
+
+    bool all_hit = package->compiler.cache_hit;
+
+    for (Usize i = 0; i < tree->children->len; ++i) {
+        all_hit = check_tree__LilyCompilerOutputCache(
+                    self, get__Vec(tree->children, i)) &&
+                  all_hit;
+    }
+
+    return all_hit;
+}
+
+bool
+check__LilyCompilerOutputCache(LilyCompilerOutputCache *self, const Vec *trees)
+{
+    bool all_hit = true;
+
+    for (Usize i = 0; i < trees->len; ++i) {
+        all_hit =
+          check_tree__LilyCompilerOutputCache(self, get__Vec(trees, i)) &&
+          all_hit;
+    }
+
+    return all_hit;
+}
+
+void
+save_tree__LilyCompilerOutputCache(LilyCompilerOutputCache *self,
+                                   const LilyPackageDependencyTree *tree)
+{
+    LilyPackage *package = tree->package;
+
+    // NOTE: The output path can be NULL if the compilation is stopped before
+    // the end.
+    if (package->compiler.output_path) {
+        LilyCompilerOutputCacheEntry *entry =
+          get__HashMap(self->entries, package->global_name->buffer);
+
+        if (entry) {
+            lily_free(entry->obj_path);
+
+            entry->key = get_key__LilyCompilerOutputCache(package);
+            entry->obj_path = strdup(package->compiler.output_path);
+        } else {
+            entry = NEW(LilyCompilerOutputCacheEntry,
+                        strdup(package->global_name->buffer),
+                        get_key__LilyCompilerOutputCache(package),
+                        strdup(package->compiler.output_path));
+
+            insert__HashMap(self->entries, entry->global_name, entry);
+        }
+    }
+
+    for (Usize i = 0; i < tree->children->len; ++i) {
+        save_tree__LilyCompilerOutputCache(self, get__Vec(tree->children, i));
+    }
+}
+
+void
+write_manifest__LilyCompilerOutputCache(const LilyCompilerOutputCache *self)
+{
+    String *content = NEW(String);
+    HashMapIter iter = NEW(HashMapIter, self->entries);
+    LilyCompilerOutputCacheEntry *current = NULL;
+
+    while ((current = next__HashMapIter(&iter))) {
+        char *line = format("{s} {zu} {s}\n",
+                            current->global_name,
+                            current->key,
+                            current->obj_path);
+
+        PUSH_STR_AND_FREE(content, line);
+    }
+
+    write_file__File(DIR_CACHE_MANIFEST, content->buffer, content->len);
+
+    FREE(String, content);
+}
+
+void
+save__LilyCompilerOutputCache(LilyCompilerOutputCache *self, const Vec *trees)
+{
+    for (Usize i = 0; i < trees->len; ++i) {
+        save_tree__LilyCompilerOutputCache(self, get__Vec(trees, i));
+    }
+
+    write_manifest__LilyCompilerOutputCache(self);
+}
+
+DESTRUCTOR(LilyCompilerOutputCache, const LilyCompilerOutputCache *self)
+{
+    FREE_HASHMAP_VALUES(self->entries, LilyCompilerOutputCacheEntry);
+    FREE(HashMap, self->entries);
+}
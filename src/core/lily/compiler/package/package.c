@@ -38,16 +38,13 @@
 #include <core/lily/mir/generator.h>
 #include <core/lily/package/default_path.h>
 #include <core/lily/package/package.h>
+#include <core/lily/package/scheduler.h>
 
 #include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-// TODO: add support for Windows.
-static threadlocal pthread_t *package_threads;
-static pthread_mutex_t package_thread_mutex;
-
 #define LOG_VERBOSE_SUCCESSFUL_COMPILATION(package)        \
     if (package->compiler.config->verbose) {               \
         printf("\x1b[32msuccessful compilation\x1b[0m\n"); \
@@ -56,10 +53,17 @@ static pthread_mutex_t package_thread_mutex;
 /**
  *
  * @brief Run parser, analysis, mir, ir and compile output object (...).
- * @param self LilyCompilerThreadWrapper*
+ * @note This function is called by the package scheduler.
  */
-static void *
-run_threads__LilyCompilerPackage(void *self);
+static void
+run_tree__LilyCompilerPackage(LilyPackageDependencyTree *tree);
+
+// NOTE: The parser, the analysis and the MIR of a package share the checked
+// declarations and data types of its dependencies (e.g. the analysis adds the
+// generic signatures to the declarations of a dependency, and the MIR reads
+// them), so they are run one package at a time. The IR and the object of a
+// package only depend on its MIR module, so they are run in parallel.
+static pthread_mutex_t package_thread_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 DESTRUCTOR(LilyCompilerAdapter, const LilyCompilerAdapter *self)
 {
@@ -139,27 +143,42 @@ build__LilyCompilerPackage(const LilyPackageCompilerConfig *config,
     // Create `out.lily` cache
     create_cache__LilyCompilerOutputCache();
 
-    LOG_VERBOSE(self, "creation of threads");
+    LOG_VERBOSE(self, "check cache");
+
+    LilyCompilerOutputCache cache = NEW(LilyCompilerOutputCache);
+    bool all_hit = false;
+
+    // NOTE: The cache is not used when an output of the compiler is dumped.
+    if (!self->compiler.config->dump_parser &&
+        !self->compiler.config->dump_analysis &&
+        !self->compiler.config->dump_mir && !self->compiler.config->dump_ir) {
+        all_hit = check__LilyCompilerOutputCache(
+          &cache, self->precompiler.dependency_trees);
+    }
+
+    // NOTE: If all packages hit the cache, there's nothing to parse, analyze
+    // or compile.
+    if (!all_hit) {
+        LOG_VERBOSE(self, "running package scheduler");
 
-    package_threads =
-      lily_malloc(sizeof(pthread_t) * self->precompiler.dependency_trees->len);
+        LilyPackageScheduler *scheduler =
+          NEW(LilyPackageScheduler,
+              self->precompiler.dependency_trees,
+              self->compiler.config->jobs,
+              &run_tree__LilyCompilerPackage);
 
-    ASSERT(!pthread_mutex_init(&package_thread_mutex, NULL));
+        run__LilyPackageScheduler(scheduler);
 
-    for (Usize i = 0; i < self->precompiler.dependency_trees->len; ++i) {
-        ASSERT(
-          !pthread_create(&package_threads[i],
-                          NULL,
-                          &run_threads__LilyCompilerPackage,
-                          get__Vec(self->precompiler.dependency_trees, i)));
+        FREE(LilyPackageScheduler, scheduler);
     }
 
-    for (Usize i = 0; i < self->precompiler.dependency_trees->len; ++i) {
-        pthread_join(package_threads[i], NULL);
+    save__LilyCompilerOutputCache(&cache, self->precompiler.dependency_trees);
+
+    if (self->compiler.config->cache_stats) {
+        printf("cache: %zu hit(s), %zu miss(es)\n", cache.hits, cache.misses);
     }
 
-    lily_free(package_threads);
-    pthread_mutex_destroy(&package_thread_mutex);
+    FREE(LilyCompilerOutputCache, &cache);
 
     return self;
 }
@@ -188,22 +207,11 @@ build_lib__LilyCompilerPackage(const LilycConfig *config,
       ->compiler.lib;
 }
 
-static void *
-run_threads__LilyCompilerPackage(void *self)
+void
+run_tree__LilyCompilerPackage(LilyPackageDependencyTree *tree)
 {
     pthread_mutex_lock(&package_thread_mutex);
 
-    LilyPackageDependencyTree *tree = self;
-
-    if (tree->dependencies) {
-        for (Usize i = 0; i < tree->dependencies->len; ++i) {
-            LilyPackageDependencyTree *dep = get__Vec(tree->dependencies, i);
-
-            while (!dep->is_done)
-                ;
-        }
-    }
-
     LOG_VERBOSE(tree->package, "running parser");
 
     run__LilyParser(&tree->package->parser, false);
@@ -212,10 +220,22 @@ run_threads__LilyCompilerPackage(void *self)
 
     run__LilyAnalysis(&tree->package->analysis);
 
+    // NOTE: The package is still parsed and analyzed, because the analysis of
+    // the packages that depend on it can miss the cache.
+    if (tree->package->compiler.cache_hit) {
+        pthread_mutex_unlock(&package_thread_mutex);
+
+        LOG_VERBOSE(tree->package, "running package done (cached object)");
+
+        return;
+    }
+
     LOG_VERBOSE(tree->package, "running mir");
 
     run__LilyMir(tree->package);
 
+    pthread_mutex_unlock(&package_thread_mutex);
+
     LOG_VERBOSE(tree->package, "running ir");
 
     run__LilyIr(tree->package);
@@ -225,39 +245,6 @@ run_threads__LilyCompilerPackage(void *self)
     compile__LilyCompilerOutputObj(tree, &compile__LilyCompilerIrLlvm);
 
     LOG_VERBOSE(tree->package, "running package done");
-
-    tree->is_done = true;
-
-    pthread_mutex_unlock(&package_thread_mutex);
-
-    // Run children of the tree
-    if (tree->children->len > 0) {
-        LOG_VERBOSE(tree->package, "running children package");
-
-        package_threads = lily_malloc(sizeof(pthread_t) * tree->children->len);
-        pthread_mutex_t children_thread_lock;
-
-        ASSERT(!pthread_mutex_init(&children_thread_lock, NULL));
-        pthread_mutex_lock(&children_thread_lock);
-
-        for (Usize i = 0; i < tree->children->len; ++i) {
-            ASSERT(!pthread_create(&package_threads[i],
-                                   NULL,
-                                   &run_threads__LilyCompilerPackage,
-                                   get__Vec(tree->children, i)));
-        }
-
-        for (Usize i = 0; i < tree->children->len; ++i) {
-            pthread_join(package_threads[i], NULL);
-        }
-
-        pthread_mutex_unlock(&children_thread_lock);
-
-        lily_free(package_threads);
-        pthread_mutex_destroy(&children_thread_lock);
-    }
-
-    return NULL;
 }
 
 LilyPackage *
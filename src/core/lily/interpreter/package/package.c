@@ -25,20 +25,22 @@
 #include <core/lily/interpreter/package/package.h>
 #include <core/lily/mir/generator.h>
 #include <core/lily/package/package.h>
+#include <core/lily/package/scheduler.h>
 
 #include <pthread.h>
 
-// TODO: add support for Windows.
-static threadlocal pthread_t *package_threads;
-static pthread_mutex_t package_thread_mutex;
-
 /**
  *
  * @brief Run parser, analysis, mir.
- * @param self LilyPackageDependencyTree*
+ * @note This function is called by the package scheduler.
  */
-static void *
-run_threads__LilyInterpreterPackage(void *self);
+static void
+run_tree__LilyInterpreterPackage(LilyPackageDependencyTree *tree);
+
+// NOTE: The parser, the analysis and the MIR of a package share the checked
+// declarations and data types of its dependencies, so they are run one package
+// at a time.
+static pthread_mutex_t package_thread_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 DESTRUCTOR(LilyInterpreterAdapter, const LilyInterpreterAdapter *self)
 {
@@ -94,27 +96,17 @@ build__LilyInterpreterPackage(const LilyPackageInterpreterConfig *config,
 
     run__LilyPrecompiler(&self->precompiler, self, false);
 
-    LOG_VERBOSE(self, "creation of threads");
+    LOG_VERBOSE(self, "running package scheduler");
 
-    package_threads =
-      lily_malloc(sizeof(pthread_t) * self->precompiler.dependency_trees->len);
+    LilyPackageScheduler *scheduler =
+      NEW(LilyPackageScheduler,
+          self->precompiler.dependency_trees,
+          config->jobs,
+          &run_tree__LilyInterpreterPackage);
 
-    ASSERT(!pthread_mutex_init(&package_thread_mutex, NULL));
+    run__LilyPackageScheduler(scheduler);
 
-    for (Usize i = 0; i < self->precompiler.dependency_trees->len; ++i) {
-        ASSERT(
-          !pthread_create(&package_threads[i],
-                          NULL,
-                          &run_threads__LilyInterpreterPackage,
-                          get__Vec(self->precompiler.dependency_trees, i)));
-    }
-
-    for (Usize i = 0; i < self->precompiler.dependency_trees->len; ++i) {
-        pthread_join(package_threads[i], NULL);
-    }
-
-    lily_free(package_threads);
-    pthread_mutex_destroy(&package_thread_mutex);
+    FREE(LilyPackageScheduler, scheduler);
 
     // TODO: set check overflow
     self->interpreter.vm = NEW(LilyInterpreterVM,
@@ -140,22 +132,11 @@ build_lib__LilyInterpreterPackage(const LilyConfig *config,
     return NULL;
 }
 
-static void *
-run_threads__LilyInterpreterPackage(void *self)
+void
+run_tree__LilyInterpreterPackage(LilyPackageDependencyTree *tree)
 {
     pthread_mutex_lock(&package_thread_mutex);
 
-    LilyPackageDependencyTree *tree = self;
-
-    if (tree->dependencies) {
-        for (Usize i = 0; i < tree->dependencies->len; ++i) {
-            LilyPackageDependencyTree *dep = get__Vec(tree->dependencies, i);
-
-            while (!dep->is_done)
-                ;
-        }
-    }
-
     LOG_VERBOSE(tree->package, "running parser");
 
     run__LilyParser(&tree->package->parser, false);
@@ -168,40 +149,9 @@ run_threads__LilyInterpreterPackage(void *self)
 
     run__LilyMir(tree->package);
 
-    LOG_VERBOSE(tree->package, "running package done");
-
-    tree->is_done = true;
-
     pthread_mutex_unlock(&package_thread_mutex);
 
-    // Run children of the tree
-    if (tree->children->len > 0) {
-        LOG_VERBOSE(tree->package, "running children package");
-
-        package_threads = lily_malloc(sizeof(pthread_t) * tree->children->len);
-        pthread_mutex_t children_thread_lock;
-
-        ASSERT(!pthread_mutex_init(&children_thread_lock, NULL));
-        pthread_mutex_lock(&children_thread_lock);
-
-        for (Usize i = 0; i < tree->children->len; ++i) {
-            ASSERT(!pthread_create(&package_threads[i],
-                                   NULL,
-                                   &run_threads__LilyInterpreterPackage,
-                                   get__Vec(tree->children, i)));
-        }
-
-        for (Usize i = 0; i < tree->children->len; ++i) {
-            pthread_join(package_threads[i], NULL);
-        }
-
-        pthread_mutex_unlock(&children_thread_lock);
-
-        lily_free(package_threads);
-        pthread_mutex_destroy(&children_thread_lock);
-    }
-
-    return NULL;
+    LOG_VERBOSE(tree->package, "running package done");
 }
 
 void
@@ -229,6 +179,11 @@ run__LilyInterpreterPackage(const LilyConfig *config,
 
     run__LilyInterpreterVM(&package->interpreter.vm);
 
+    if (interpreter_config.verbose) {
+        print_stats__LilyInterpreterMemory(&package->interpreter.vm.memory);
+        print_collector_stats__LilyInterpreterValue();
+    }
+
     // Clean up
 
     FREE(LilyPackage, package);
@@ -0,0 +1,888 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <base/alloc.h>
+#include <base/assert.h>
+#include <base/hash_map.h>
+#include <base/new.h>
+
+#include <core/lily/interpreter/vm/bytecode.h>
+
+#include <string.h>
+
+#define DEFAULT_BYTECODE_CAPACITY 16
+
+typedef struct LilyInterpreterVMBytecodeBuilder
+{
+    HashMap *fun_ids; // HashMap<Usize (id + 1)>* (&)
+    LilyInterpreterVMBytecodeInst *insts;
+    Usize insts_len;
+    Usize insts_capacity;
+    LilyInterpreterValue *consts;
+    Usize consts_len;
+    Usize consts_capacity;
+    Usize params_len;
+    Usize temps_base;
+    Usize temps_len; // number of temporary registers needed by the function
+    bool *declared_vars; // bool (&) [slots_len]
+} LilyInterpreterVMBytecodeBuilder;
+
+/**
+ *
+ * @brief Push a new instruction in the builder.
+ * @return Return false if the function has too many instructions.
+ */
+static bool
+push_inst__LilyInterpreterVMBytecodeBuilder(
+  LilyInterpreterVMBytecodeBuilder *self,
+  enum LilyInterpreterVMBytecodeOpcode opcode,
+  Usize x,
+  Usize y,
+  Usize z);
+
+/**
+ *
+ * @brief Push a new constant in the builder.
+ * @param rk Set the operand of the constant.
+ * @return Return false if the function has too many constants.
+ */
+static bool
+push_const__LilyInterpreterVMBytecodeBuilder(
+  LilyInterpreterVMBytecodeBuilder *self,
+  LilyInterpreterValue value,
+  Uint16 *rk);
+
+/**
+ *
+ * @brief Check if the register is valid.
+ */
+static inline bool
+is_valid_reg__LilyInterpreterVMBytecodeBuilder(Usize reg);
+
+/**
+ *
+ * @brief Lower MIR value to an operand (RK).
+ * @return Return false if the value cannot be lowered.
+ */
+static bool
+lower_val__LilyInterpreterVMBytecodeBuilder(
+  LilyInterpreterVMBytecodeBuilder *self,
+  const LilyMirInstructionVal *val,
+  Uint16 *rk);
+
+/**
+ *
+ * @brief Get the kind of the value produced by the VM for this data type.
+ * @return Return LILY_INTERPRETER_VALUE_KIND_UNDEF if the kind is not known
+ * statically.
+ */
+static enum LilyInterpreterValueKind
+get_value_kind__LilyInterpreterVMBytecode(const LilyMirDt *dt);
+
+/**
+ *
+ * @brief Lower the arguments of a call to the temporary registers.
+ */
+static bool
+lower_args__LilyInterpreterVMBytecodeBuilder(
+  LilyInterpreterVMBytecodeBuilder *self,
+  const Vec *params);
+
+/**
+ *
+ * @brief Lower MIR instruction which produces a value in R(dest).
+ */
+static bool
+lower_expr__LilyInterpreterVMBytecodeBuilder(
+  LilyInterpreterVMBytecodeBuilder *self,
+  const LilyMirInstruction *inst,
+  Usize dest);
+
+/**
+ *
+ * @brief Lower MIR instruction contained in a block.
+ */
+static bool
+lower_inst__LilyInterpreterVMBytecodeBuilder(
+  LilyInterpreterVMBytecodeBuilder *self,
+  const LilyMirInstruction *inst,
+  const LilyMirInstructionFun *fun);
+
+/**
+ *
+ * @brief Lower MIR function to bytecode.
+ * @return Return NULL if the function cannot be lowered.
+ */
+static LilyInterpreterVMBytecodeFun *
+lower_fun__LilyInterpreterVMBytecodeFun(const LilyMirInstructionFun *fun,
+                                        HashMap *fun_ids);
+
+/**
+ *
+ * @brief Get the id of the sys call.
+ * @return Return false if the sys call is unknown.
+ */
+static bool
+get_sys_call_id__LilyInterpreterVMBytecode(const char *name, Uint16 *id);
+
+static const char *sys_call_names[] = {
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_READ] = "__sys__$read",
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_WRITE] = "__sys__$write",
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_OPEN] = "__sys__$open",
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_CLOSE] = "__sys__$close",
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_MODE] = "__sys__$stat_mode",
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_INO] = "__sys__$stat_ino",
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_DEV] = "__sys__$stat_dev",
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_NLINK] = "__sys__$stat_nlink",
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_UID] = "__sys__$stat_uid",
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_GID] = "__sys__$stat_gid",
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_SIZE] = "__sys__$stat_size",
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_ATIME] = "__sys__$stat_atime",
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_MTIME] = "__sys__$stat_mtime",
+    [LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_CTIME] = "__sys__$stat_ctime",
+};
+
+#define TYPED_OPCODE(name)                                               \
+    case LILY_INTERPRETER_VM_BYTECODE_OPCODE_##name:                     \
+        switch (kind) {                                                  \
+            case LILY_INTERPRETER_VALUE_KIND_FLOAT:                      \
+                return LILY_INTERPRETER_VM_BYTECODE_OPCODE_##name##_F64; \
+            case LILY_INTERPRETER_VALUE_KIND_INT32:                      \
+                return LILY_INTERPRETER_VM_BYTECODE_OPCODE_##name##_I32; \
+            case LILY_INTERPRETER_VALUE_KIND_INT64:                      \
+                return LILY_INTERPRETER_VM_BYTECODE_OPCODE_##name##_I64; \
+            default:                                                     \
+                return opcode;                                           \
+        }
+
+enum LilyInterpreterVMBytecodeOpcode
+get_typed_opcode__LilyInterpreterVMBytecodeOpcode(
+  enum LilyInterpreterVMBytecodeOpcode opcode,
+  enum LilyInterpreterValueKind kind)
+{
+    switch (opcode) {
+        TYPED_OPCODE(ADD);
+        TYPED_OPCODE(DIV);
+        TYPED_OPCODE(EQ);
+        TYPED_OPCODE(GE);
+        TYPED_OPCODE(GT);
+        TYPED_OPCODE(LE);
+        TYPED_OPCODE(LT);
+        TYPED_OPCODE(MUL);
+        TYPED_OPCODE(NE);
+        TYPED_OPCODE(REM);
+        TYPED_OPCODE(SUB);
+        default:
+            return opcode;
+    }
+}
+
+bool
+push_inst__LilyInterpreterVMBytecodeBuilder(
+  LilyInterpreterVMBytecodeBuilder *self,
+  enum LilyInterpreterVMBytecodeOpcode opcode,
+  Usize x,
+  Usize y,
+  Usize z)
+{
+    if (self->insts_len >= LILY_INTERPRETER_VM_BYTECODE_MAX_INSTS) {
+        return false;
+    }
+
+    if (self->insts_len == self->insts_capacity) {
+        self->insts_capacity = self->insts_capacity
+                                 ? self->insts_capacity * 2
+                                 : DEFAULT_BYTECODE_CAPACITY;
+        self->insts =
+          lily_realloc(self->insts,
+                       sizeof(LilyInterpreterVMBytecodeInst) *
+                         self->insts_capacity);
+    }
+
+    self->insts[self->insts_len++] = (LilyInterpreterVMBytecodeInst){
+        .opcode = opcode, .x = x, .y = y, .z = z
+    };
+
+    return true;
+}
+
+bool
+push_const__LilyInterpreterVMBytecodeBuilder(
+  LilyInterpreterVMBytecodeBuilder *self,
+  LilyInterpreterValue value,
+  Uint16 *rk)
+{
+    if (self->consts_len >= LILY_INTERPRETER_VM_BYTECODE_MAX_RK) {
+        return false;
+    }
+
+    if (self->consts_len == self->consts_capacity) {
+        self->consts_capacity = self->consts_capacity
+                                  ? self->consts_capacity * 2
+                                  : DEFAULT_BYTECODE_CAPACITY;
+        self->consts = lily_realloc(
+          self->consts, sizeof(LilyInterpreterValue) * self->consts_capacity);
+    }
+
+    *rk = self->consts_len | LILY_INTERPRETER_VM_BYTECODE_RK_CONST;
+    self->consts[self->consts_len++] = value;
+
+    return true;
+}
+
+inline bool
+is_valid_reg__LilyInterpreterVMBytecodeBuilder(Usize reg)
+{
+    return reg < LILY_INTERPRETER_VM_BYTECODE_MAX_RK;
+}
+
+bool
+lower_val__LilyInterpreterVMBytecodeBuilder(
+  LilyInterpreterVMBytecodeBuilder *self,
+  const LilyMirInstructionVal *val,
+  Uint16 *rk)
+{
+    // NOTE: Only the values that don't need to be allocated on the heap are
+    // lowered, so the registers never need to be freed.
+    switch (val->kind) {
+        case LILY_MIR_INSTRUCTION_VAL_KIND_CSTR:
+            return push_const__LilyInterpreterVMBytecodeBuilder(
+              self,
+              NEW_VARIANT(LilyInterpreterValue, cstr, (char *)val->cstr),
+              rk);
+        case LILY_MIR_INSTRUCTION_VAL_KIND_FLOAT:
+            return push_const__LilyInterpreterVMBytecodeBuilder(
+              self, NEW_VARIANT(LilyInterpreterValue, float, val->float_), rk);
+        case LILY_MIR_INSTRUCTION_VAL_KIND_INT: {
+            LilyInterpreterValue value;
+
+            switch (val->dt->kind) {
+                case LILY_MIR_DT_KIND_I1:
+                    value = NEW(LilyInterpreterValue, val->int_);
+                    break;
+                case LILY_MIR_DT_KIND_I8:
+                    value =
+                      NEW_VARIANT(LilyInterpreterValue, int8, (Int8)val->int_);
+                    break;
+                case LILY_MIR_DT_KIND_I16:
+                    value = NEW_VARIANT(
+                      LilyInterpreterValue, int16, (Int16)val->int_);
+                    break;
+                case LILY_MIR_DT_KIND_I32:
+                    value = NEW_VARIANT(
+                      LilyInterpreterValue, int32, (Int32)val->int_);
+                    break;
+                case LILY_MIR_DT_KIND_I64:
+                    value = NEW_VARIANT(LilyInterpreterValue, int64, val->int_);
+                    break;
+                case LILY_MIR_DT_KIND_ISIZE:
+                    value = NEW_VARIANT(
+                      LilyInterpreterValue, isize, (Isize)val->int_);
+                    break;
+                default:
+                    return false;
+            }
+
+            return push_const__LilyInterpreterVMBytecodeBuilder(
+              self, value, rk);
+        }
+        case LILY_MIR_INSTRUCTION_VAL_KIND_NIL:
+            return push_const__LilyInterpreterVMBytecodeBuilder(
+              self,
+              NEW(LilyInterpreterValue, LILY_INTERPRETER_VALUE_KIND_NIL),
+              rk);
+        case LILY_MIR_INSTRUCTION_VAL_KIND_PARAM:
+            if (val->param >= self->params_len) {
+                return false;
+            }
+
+            *rk = val->param;
+
+            return true;
+        case LILY_MIR_INSTRUCTION_VAL_KIND_REG:
+        case LILY_MIR_INSTRUCTION_VAL_KIND_VAR:
+            *rk = self->params_len + val->slot;
+
+            return true;
+        case LILY_MIR_INSTRUCTION_VAL_KIND_UINT: {
+            LilyInterpreterValue value;
+
+            switch (val->dt->kind) {
+                case LILY_MIR_DT_KIND_U8:
+                    value = NEW_VARIANT(
+                      LilyInterpreterValue, uint8, (Uint8)val->uint);
+                    break;
+                case LILY_MIR_DT_KIND_U16:
+                    value = NEW_VARIANT(
+                      LilyInterpreterValue, uint16, (Uint16)val->uint);
+                    break;
+                case LILY_MIR_DT_KIND_U32:
+                    value = NEW_VARIANT(
+                      LilyInterpreterValue, uint32, (Uint32)val->uint);
+                    break;
+                case LILY_MIR_DT_KIND_U64:
+                    value = NEW_VARIANT(
+                      LilyInterpreterValue, uint64, (Uint64)val->uint);
+                    break;
+                case LILY_MIR_DT_KIND_USIZE:
+                    value = NEW_VARIANT(
+                      LilyInterpreterValue, usize, (Usize)val->uint);
+                    break;
+                default:
+                    return false;
+            }
+
+            return push_const__LilyInterpreterVMBytecodeBuilder(
+              self, value, rk);
+        }
+        case LILY_MIR_INSTRUCTION_VAL_KIND_UNDEF:
+            return push_const__LilyInterpreterVMBytecodeBuilder(
+              self,
+              NEW(LilyInterpreterValue, LILY_INTERPRETER_VALUE_KIND_UNDEF),
+              rk);
+        case LILY_MIR_INSTRUCTION_VAL_KIND_UNIT:
+            return push_const__LilyInterpreterVMBytecodeBuilder(
+              self,
+              NEW(LilyInterpreterValue, LILY_INTERPRETER_VALUE_KIND_UNIT),
+              rk);
+        default:
+            return false;
+    }
+}
+
+enum LilyInterpreterValueKind
+get_value_kind__LilyInterpreterVMBytecode(const LilyMirDt *dt)
+{
+    switch (dt ? dt->kind : LILY_MIR_DT_KIND_UNIT) {
+        case LILY_MIR_DT_KIND_F64:
+            return LILY_INTERPRETER_VALUE_KIND_FLOAT;
+        case LILY_MIR_DT_KIND_I32:
+            return LILY_INTERPRETER_VALUE_KIND_INT32;
+        case LILY_MIR_DT_KIND_I64:
+            return LILY_INTERPRETER_VALUE_KIND_INT64;
+        default:
+            return LILY_INTERPRETER_VALUE_KIND_UNDEF;
+    }
+}
+
+bool
+lower_args__LilyInterpreterVMBytecodeBuilder(
+  LilyInterpreterVMBytecodeBuilder *self,
+  const Vec *params)
+{
+    if (params->len > self->temps_len) {
+        self->temps_len = params->len;
+    }
+
+    for (Usize i = 0; i < params->len; ++i) {
+        Uint16 rk;
+
+        if (!lower_val__LilyInterpreterVMBytecodeBuilder(
+              self, get__Vec(params, i), &rk) ||
+            !push_inst__LilyInterpreterVMBytecodeBuilder(
+              self,
+              LILY_INTERPRETER_VM_BYTECODE_OPCODE_MOVE,
+              self->temps_base + i,
+              rk,
+              0)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool
+lower_expr__LilyInterpreterVMBytecodeBuilder(
+  LilyInterpreterVMBytecodeBuilder *self,
+  const LilyMirInstruction *inst,
+  Usize dest)
+{
+    enum LilyInterpreterVMBytecodeOpcode opcode;
+
+    switch (inst->kind) {
+        case LILY_MIR_INSTRUCTION_KIND_BITAND:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_BITAND;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_BITOR:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_BITOR;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_FADD:
+        case LILY_MIR_INSTRUCTION_KIND_IADD:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_ADD;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_FCMP_EQ:
+        case LILY_MIR_INSTRUCTION_KIND_ICMP_EQ:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_EQ;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_FCMP_NE:
+        case LILY_MIR_INSTRUCTION_KIND_ICMP_NE:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_NE;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_FCMP_LE:
+        case LILY_MIR_INSTRUCTION_KIND_ICMP_LE:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_LE;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_FCMP_LT:
+        case LILY_MIR_INSTRUCTION_KIND_ICMP_LT:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_LT;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_FCMP_GE:
+        case LILY_MIR_INSTRUCTION_KIND_ICMP_GE:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_GE;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_FCMP_GT:
+        case LILY_MIR_INSTRUCTION_KIND_ICMP_GT:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_GT;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_FDIV:
+        case LILY_MIR_INSTRUCTION_KIND_IDIV:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_DIV;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_FMUL:
+        case LILY_MIR_INSTRUCTION_KIND_IMUL:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_MUL;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_FREM:
+        case LILY_MIR_INSTRUCTION_KIND_IREM:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_REM;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_FSUB:
+        case LILY_MIR_INSTRUCTION_KIND_ISUB:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_SUB;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_SHL:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_SHL;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_SHR:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_SHR;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_XOR:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_XOR;
+            goto binary;
+        case LILY_MIR_INSTRUCTION_KIND_BITNOT:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_BITNOT;
+            goto unary;
+        case LILY_MIR_INSTRUCTION_KIND_FNEG:
+        case LILY_MIR_INSTRUCTION_KIND_INEG:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_NEG;
+            goto unary;
+        case LILY_MIR_INSTRUCTION_KIND_NOT:
+            opcode = LILY_INTERPRETER_VM_BYTECODE_OPCODE_NOT;
+            goto unary;
+        case LILY_MIR_INSTRUCTION_KIND_CALL: {
+            Uptr id =
+              (Uptr)get__HashMap(self->fun_ids, (char *)inst->call.name);
+
+            // NOTE: The function is unknown, when it's a prototype.
+            return id &&
+                   lower_args__LilyInterpreterVMBytecodeBuilder(
+                     self, inst->call.params) &&
+                   push_inst__LilyInterpreterVMBytecodeBuilder(
+                     self,
+                     LILY_INTERPRETER_VM_BYTECODE_OPCODE_CALL,
+                     dest,
+                     id - 1,
+                     self->temps_base);
+        }
+        case LILY_MIR_INSTRUCTION_KIND_LOAD: {
+            Uint16 rk;
+
+            return lower_val__LilyInterpreterVMBytecodeBuilder(
+                     self, inst->load.src.src, &rk) &&
+                   push_inst__LilyInterpreterVMBytecodeBuilder(
+                     self,
+                     LILY_INTERPRETER_VM_BYTECODE_OPCODE_MOVE,
+                     dest,
+                     rk,
+                     0);
+        }
+        case LILY_MIR_INSTRUCTION_KIND_SYS_CALL: {
+            Uint16 id;
+
+            return get_sys_call_id__LilyInterpreterVMBytecode(
+                     inst->sys_call.name, &id) &&
+                   lower_args__LilyInterpreterVMBytecodeBuilder(
+                     self, inst->sys_call.params) &&
+                   push_inst__LilyInterpreterVMBytecodeBuilder(
+                     self,
+                     LILY_INTERPRETER_VM_BYTECODE_OPCODE_SYS_CALL,
+                     dest,
+                     id,
+                     self->temps_base);
+        }
+        case LILY_MIR_INSTRUCTION_KIND_VAL: {
+            Uint16 rk;
+
+            return lower_val__LilyInterpreterVMBytecodeBuilder(
+                     self, inst->val, &rk) &&
+                   push_inst__LilyInterpreterVMBytecodeBuilder(
+                     self,
+                     LILY_INTERPRETER_VM_BYTECODE_OPCODE_MOVE,
+                     dest,
+                     rk,
+                     0);
+        }
+        default:
+            return false;
+    }
+
+binary: {
+    // NOTE: All these instructions have the same layout
+    // (LilyMirInstructionDestSrc).
+    Uint16 lhs, rhs;
+
+    // NOTE: If the kind of the operands is not known statically, the opcode is
+    // specialized at run time (see `run_bytecode__LilyInterpreterVM`).
+    opcode = get_typed_opcode__LilyInterpreterVMBytecodeOpcode(
+      opcode, get_value_kind__LilyInterpreterVMBytecode(inst->iadd.dest->dt));
+
+    return lower_val__LilyInterpreterVMBytecodeBuilder(
+             self, inst->iadd.dest, &lhs) &&
+           lower_val__LilyInterpreterVMBytecodeBuilder(
+             self, inst->iadd.src, &rhs) &&
+           push_inst__LilyInterpreterVMBytecodeBuilder(
+             self, opcode, dest, lhs, rhs);
+}
+
+unary: {
+    // NOTE: All these instructions have the same layout
+    // (LilyMirInstructionSrc).
+    Uint16 rk;
+
+    return lower_val__LilyInterpreterVMBytecodeBuilder(
+             self, inst->not.src, &rk) &&
+           push_inst__LilyInterpreterVMBytecodeBuilder(
+             self, opcode, dest, rk, 0);
+}
+}
+
+bool
+lower_inst__LilyInterpreterVMBytecodeBuilder(
+  LilyInterpreterVMBytecodeBuilder *self,
+  const LilyMirInstruction *inst,
+  const LilyMirInstructionFun *fun)
+{
+    switch (inst->kind) {
+        case LILY_MIR_INSTRUCTION_KIND_CALL:
+        case LILY_MIR_INSTRUCTION_KIND_SYS_CALL:
+            // NOTE: The result of the call is ignored, so it's written in the
+            // first temporary register.
+            if (self->temps_len == 0) {
+                self->temps_len = 1;
+            }
+
+            return lower_expr__LilyInterpreterVMBytecodeBuilder(
+              self, inst, self->temps_base);
+        case LILY_MIR_INSTRUCTION_KIND_JMP: {
+            // NOTE: The id of the block is replaced by the index of its first
+            // instruction, when all blocks are lowered.
+            const Usize *block_id =
+              get_id__OrderedHashMap(fun->insts, (char *)inst->jmp->name);
+
+            return block_id &&
+                   push_inst__LilyInterpreterVMBytecodeBuilder(
+                     self,
+                     LILY_INTERPRETER_VM_BYTECODE_OPCODE_JMP,
+                     0,
+                     *block_id,
+                     0);
+        }
+        case LILY_MIR_INSTRUCTION_KIND_JMPCOND: {
+            const Usize *then_block_id = get_id__OrderedHashMap(
+              fun->insts, (char *)inst->jmpcond.then_block->name);
+            const Usize *else_block_id = get_id__OrderedHashMap(
+              fun->insts, (char *)inst->jmpcond.else_block->name);
+            Uint16 cond;
+
+            return then_block_id && else_block_id &&
+                   lower_val__LilyInterpreterVMBytecodeBuilder(
+                     self, inst->jmpcond.cond, &cond) &&
+                   push_inst__LilyInterpreterVMBytecodeBuilder(
+                     self,
+                     LILY_INTERPRETER_VM_BYTECODE_OPCODE_JMPCOND,
+                     cond,
+                     *then_block_id,
+                     *else_block_id);
+        }
+        case LILY_MIR_INSTRUCTION_KIND_REG:
+            return lower_expr__LilyInterpreterVMBytecodeBuilder(
+              self, inst->reg.inst, self->params_len + inst->reg.slot);
+        case LILY_MIR_INSTRUCTION_KIND_RET: {
+            Uint16 rk;
+
+            if (inst->ret->kind == LILY_MIR_INSTRUCTION_KIND_VAL) {
+                if (!lower_val__LilyInterpreterVMBytecodeBuilder(
+                      self, inst->ret->val, &rk)) {
+                    return false;
+                }
+            } else {
+                if (self->temps_len == 0) {
+                    self->temps_len = 1;
+                }
+
+                if (!lower_expr__LilyInterpreterVMBytecodeBuilder(
+                      self, inst->ret, self->temps_base)) {
+                    return false;
+                }
+
+                rk = self->temps_base;
+            }
+
+            return push_inst__LilyInterpreterVMBytecodeBuilder(
+              self, LILY_INTERPRETER_VM_BYTECODE_OPCODE_RET, 0, rk, 0);
+        }
+        case LILY_MIR_INSTRUCTION_KIND_STORE: {
+            Uint16 rk;
+
+            return inst->store.dest->kind ==
+                     LILY_MIR_INSTRUCTION_VAL_KIND_VAR &&
+                   lower_val__LilyInterpreterVMBytecodeBuilder(
+                     self, inst->store.src, &rk) &&
+                   push_inst__LilyInterpreterVMBytecodeBuilder(
+                     self,
+                     LILY_INTERPRETER_VM_BYTECODE_OPCODE_MOVE,
+                     self->params_len + inst->store.dest->slot,
+                     rk,
+                     0);
+        }
+        case LILY_MIR_INSTRUCTION_KIND_UNREACHABLE:
+            return push_inst__LilyInterpreterVMBytecodeBuilder(
+              self, LILY_INTERPRETER_VM_BYTECODE_OPCODE_UNREACHABLE, 0, 0, 0);
+        case LILY_MIR_INSTRUCTION_KIND_VAL: {
+            Uint16 rk;
+
+            return lower_val__LilyInterpreterVMBytecodeBuilder(
+              self, inst->val, &rk);
+        }
+        case LILY_MIR_INSTRUCTION_KIND_VAR: {
+            Uint16 rk;
+
+            // NOTE: The same var declared twice (e.g. a shadowed var), would
+            // share its register with the other declaration.
+            if (inst->var.inst->kind != LILY_MIR_INSTRUCTION_KIND_ALLOC ||
+                self->declared_vars[inst->var.slot]) {
+                return false;
+            }
+
+            self->declared_vars[inst->var.slot] = true;
+
+            return push_const__LilyInterpreterVMBytecodeBuilder(
+                     self,
+                     NEW(LilyInterpreterValue,
+                         LILY_INTERPRETER_VALUE_KIND_UNDEF),
+                     &rk) &&
+                   push_inst__LilyInterpreterVMBytecodeBuilder(
+                     self,
+                     LILY_INTERPRETER_VM_BYTECODE_OPCODE_MOVE,
+                     self->params_len + inst->var.slot,
+                     rk,
+                     0);
+        }
+        default:
+            return false;
+    }
+}
+
+LilyInterpreterVMBytecodeFun *
+lower_fun__LilyInterpreterVMBytecodeFun(const LilyMirInstructionFun *fun,
+                                        HashMap *fun_ids)
+{
+    Usize params_len = fun->args->len;
+    LilyInterpreterVMBytecodeBuilder builder = {
+        .fun_ids = fun_ids,
+        .insts = NULL,
+        .insts_len = 0,
+        .insts_capacity = 0,
+        .consts = NULL,
+        .consts_len = 0,
+        .consts_capacity = 0,
+        .params_len = params_len,
+        .temps_base = params_len + fun->slots_len,
+        .temps_len = 0,
+        .declared_vars = lily_calloc(fun->slots_len + 1, sizeof(bool))
+    };
+    Usize *block_starts = lily_malloc(sizeof(Usize) * (fun->insts->len + 1));
+    OrderedHashMapIter iter = NEW(OrderedHashMapIter, fun->insts);
+    LilyMirInstruction *block_inst = NULL;
+    Usize block_id = 0;
+    bool is_lowered = fun->insts->len < LILY_INTERPRETER_VM_BYTECODE_MAX_INSTS;
+
+    while (is_lowered && (block_inst = next__OrderedHashMapIter(&iter))) {
+        ASSERT(block_inst->kind == LILY_MIR_INSTRUCTION_KIND_BLOCK);
+
+        block_starts[block_id++] = builder.insts_len;
+
+        for (Usize i = 0; is_lowered && i < block_inst->block.insts->len;
+             ++i) {
+            is_lowered = lower_inst__LilyInterpreterVMBytecodeBuilder(
+              &builder, get__Vec(block_inst->block.insts, i), fun);
+        }
+    }
+
+    Usize regs_len =
+      builder.temps_base + (builder.temps_len ? builder.temps_len : 1);
+
+    if (!is_lowered || !is_valid_reg__LilyInterpreterVMBytecodeBuilder(
+                         regs_len - 1)) {
+        lily_free(builder.insts);
+        lily_free(builder.consts);
+        lily_free(builder.declared_vars);
+        lily_free(block_starts);
+
+        return NULL;
+    }
+
+    // Replace the ids of the blocks by the index of their first instruction.
+    for (Usize i = 0; i < builder.insts_len; ++i) {
+        LilyInterpreterVMBytecodeInst *inst = &builder.insts[i];
+
+        switch (inst->opcode) {
+            case LILY_INTERPRETER_VM_BYTECODE_OPCODE_JMPCOND:
+                inst->z = block_starts[inst->z];
+                // fall through
+            case LILY_INTERPRETER_VM_BYTECODE_OPCODE_JMP:
+                inst->y = block_starts[inst->y];
+                break;
+            default:
+                break;
+        }
+    }
+
+    lily_free(builder.declared_vars);
+    lily_free(block_starts);
+
+    LilyInterpreterVMBytecodeFun *self =
+      lily_malloc(sizeof(LilyInterpreterVMBytecodeFun));
+
+    self->name = fun->name;
+    self->insts = builder.insts;
+    self->insts_len = builder.insts_len;
+    self->consts = builder.consts;
+    self->consts_len = builder.consts_len;
+    self->params_len = params_len;
+    self->regs_len = regs_len;
+
+    return self;
+}
+
+bool
+get_sys_call_id__LilyInterpreterVMBytecode(const char *name, Uint16 *id)
+{
+    for (Usize i = 0; i < sizeof(sys_call_names) / sizeof(*sys_call_names);
+         ++i) {
+        if (!strcmp(sys_call_names[i], name)) {
+            *id = i;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+DESTRUCTOR(LilyInterpreterVMBytecodeFun, LilyInterpreterVMBytecodeFun *self)
+{
+    lily_free(self->insts);
+    lily_free(self->consts);
+    lily_free(self);
+}
+
+LilyInterpreterVMBytecodeModule *
+lower__LilyInterpreterVMBytecodeModule(const LilyMirModule *module)
+{
+    HashMap *fun_ids = NEW(HashMap); // HashMap<Usize (id + 1)>*
+    Vec *funs = NEW(Vec);
+    LilyInterpreterVMBytecodeFun *entry_point = NULL;
+
+    {
+        OrderedHashMapIter iter = NEW(OrderedHashMapIter, module->insts);
+        LilyMirInstruction *inst = NULL;
+        Usize id = 0;
+
+        while ((inst = next__OrderedHashMapIter(&iter))) {
+            if (inst->kind == LILY_MIR_INSTRUCTION_KIND_FUN) {
+                insert__HashMap(
+                  fun_ids, (char *)inst->fun.name, (void *)(Uptr)(++id));
+            }
+        }
+    }
+
+    {
+        OrderedHashMapIter iter = NEW(OrderedHashMapIter, module->insts);
+        LilyMirInstruction *inst = NULL;
+
+        while ((inst = next__OrderedHashMapIter(&iter))) {
+            if (inst->kind != LILY_MIR_INSTRUCTION_KIND_FUN) {
+                continue;
+            }
+
+            LilyInterpreterVMBytecodeFun *fun =
+              lower_fun__LilyInterpreterVMBytecodeFun(&inst->fun, fun_ids);
+
+            if (!fun) {
+                FREE_BUFFER_ITEMS(
+                  funs->buffer, funs->len, LilyInterpreterVMBytecodeFun);
+                FREE(Vec, funs);
+                FREE(HashMap, fun_ids);
+
+                return NULL;
+            }
+
+            if (!strcmp(fun->name, "main")) {
+                entry_point = fun;
+            }
+
+            push__Vec(funs, fun);
+        }
+    }
+
+    FREE(HashMap, fun_ids);
+
+    if (!entry_point) {
+        FREE_BUFFER_ITEMS(
+          funs->buffer, funs->len, LilyInterpreterVMBytecodeFun);
+        FREE(Vec, funs);
+
+        return NULL;
+    }
+
+    LilyInterpreterVMBytecodeModule *self =
+      lily_malloc(sizeof(LilyInterpreterVMBytecodeModule));
+
+    self->funs = funs;
+    self->entry_point = entry_point;
+
+    return self;
+}
+
+DESTRUCTOR(LilyInterpreterVMBytecodeModule,
+           LilyInterpreterVMBytecodeModule *self)
+{
+    FREE_BUFFER_ITEMS(
+      self->funs->buffer, self->funs->len, LilyInterpreterVMBytecodeFun);
+    FREE(Vec, self->funs);
+    lily_free(self);
+}
@@ -23,30 +23,342 @@
  */
 
 #include <base/alloc.h>
+#include <base/assert.h>
+#include <base/print.h>
+#include <base/units.h>
 
 #include <core/lily/interpreter/vm/memory.h>
 #include <core/lily/interpreter/vm/runtime.h>
 
 #include <stddef.h>
+#include <string.h>
 
-LilyInterpreterValue
+struct LilyInterpreterMemoryBlock
+{
+    struct LilyInterpreterMemoryBlock *next;
+};
+
+struct LilyInterpreterMemorySlab
+{
+    struct LilyInterpreterMemorySlab *next;
+    alignas(max_align_t) char buffer[];
+};
+
+struct LilyInterpreterMemoryLarge
+{
+    struct LilyInterpreterMemoryLarge *prev;
+    struct LilyInterpreterMemoryLarge *next;
+    Usize size;
+    alignas(max_align_t) char buffer[];
+};
+
+static threadlocal LilyInterpreterMemory *current_memory = NULL;
+
+/**
+ *
+ * @brief Get the size class of the size.
+ */
+static inline Usize
+get_size_class__LilyInterpreterMemory(Usize size);
+
+/**
+ *
+ * @brief Get the size of the block of the size class.
+ */
+static inline Usize
+get_block_size__LilyInterpreterMemory(Usize size_class);
+
+/**
+ *
+ * @brief Crash if the size in use exceeds the capacity after allocating
+ * `size` bytes.
+ */
+static void
+check_capacity__LilyInterpreterMemory(LilyInterpreterMemory *self, Usize size);
+
+/**
+ *
+ * @brief Add a new slab split into blocks of the size class.
+ */
+static void
+add_slab__LilyInterpreterMemory(LilyInterpreterMemory *self,
+                                Usize size_class);
+
+/**
+ *
+ * @brief Alloc a large object.
+ */
+static void *
+alloc_large__LilyInterpreterMemory(LilyInterpreterMemory *self, Usize size);
+
+/**
+ *
+ * @brief Free a large object.
+ */
+static void
+free_large__LilyInterpreterMemory(LilyInterpreterMemory *self, void *mem);
+
+Usize
+get_size_class__LilyInterpreterMemory(Usize size)
+{
+    Usize size_class = 0;
+
+    for (Usize block_size = LILY_INTERPRETER_MEMORY_MIN_BLOCK_SIZE;
+         block_size < size;
+         block_size <<= 1) {
+        ++size_class;
+    }
+
+    return size_class;
+}
+
+Usize
+get_block_size__LilyInterpreterMemory(Usize size_class)
+{
+    return LILY_INTERPRETER_MEMORY_MIN_BLOCK_SIZE << size_class;
+}
+
+void
+check_capacity__LilyInterpreterMemory(LilyInterpreterMemory *self, Usize size)
+{
+    Usize size_in_use = get_size__LilyInterpreterMemory(self);
+
+    if (size > self->capacity || size_in_use > self->capacity - size) {
+        RUNTIME_ERROR_OUT_OF_MEMORY(size, self->capacity);
+    }
+
+    if (size_in_use + size > self->peak_size) {
+        self->peak_size = size_in_use + size;
+    }
+}
+
+void
+add_slab__LilyInterpreterMemory(LilyInterpreterMemory *self, Usize size_class)
+{
+    Usize block_size = get_block_size__LilyInterpreterMemory(size_class);
+    Usize slab_size = block_size * LILY_INTERPRETER_MEMORY_SLAB_BLOCKS_LEN;
+    LilyInterpreterMemorySlab *slab =
+      lily_malloc(sizeof(LilyInterpreterMemorySlab) + slab_size);
+
+    slab->next = self->slabs;
+    self->slabs = slab;
+
+    // Split the slab into blocks, in the order of the addresses.
+    for (Usize i = LILY_INTERPRETER_MEMORY_SLAB_BLOCKS_LEN; i > 0; --i) {
+        LilyInterpreterMemoryBlock *block =
+          (LilyInterpreterMemoryBlock *)(slab->buffer + (i - 1) * block_size);
+
+        block->next = self->free_blocks[size_class];
+        self->free_blocks[size_class] = block;
+    }
+
+    self->total_size += slab_size;
+    self->total_size_free += slab_size;
+}
+
+void *
+alloc_large__LilyInterpreterMemory(LilyInterpreterMemory *self, Usize size)
+{
+    LilyInterpreterMemoryLarge *large =
+      lily_malloc(sizeof(LilyInterpreterMemoryLarge) + size);
+
+    large->prev = NULL;
+    large->next = self->larges;
+    large->size = size;
+
+    if (self->larges) {
+        self->larges->prev = large;
+    }
+
+    self->larges = large;
+    self->total_size += size;
+
+    return large->buffer;
+}
+
+void
+free_large__LilyInterpreterMemory(LilyInterpreterMemory *self, void *mem)
+{
+    LilyInterpreterMemoryLarge *large =
+      (LilyInterpreterMemoryLarge *)((char *)mem -
+                                     offsetof(LilyInterpreterMemoryLarge,
+                                              buffer));
+
+    if (large->prev) {
+        large->prev->next = large->next;
+    } else {
+        self->larges = large->next;
+    }
+
+    if (large->next) {
+        large->next->prev = large->prev;
+    }
+
+    self->total_size -= large->size;
+
+    lily_free(large);
+}
+
+LilyInterpreterMemory *
+set_current__LilyInterpreterMemory(LilyInterpreterMemory *self)
+{
+    LilyInterpreterMemory *previous = current_memory;
+
+    current_memory = self;
+
+    return previous;
+}
+
+LilyInterpreterMemory *
+get_current__LilyInterpreterMemory()
+{
+    return current_memory;
+}
+
+void *
 alloc__LilyInterpreterMemory(LilyInterpreterMemory *self, Usize size)
 {
+    if (!self) {
+        return lily_malloc(size);
+    }
+
+    ++self->alloc_count;
+
+    if (size > LILY_INTERPRETER_MEMORY_MAX_SMALL_SIZE) {
+        check_capacity__LilyInterpreterMemory(self, size);
+
+        return alloc_large__LilyInterpreterMemory(self, size);
+    }
+
+    Usize size_class = get_size_class__LilyInterpreterMemory(size);
+    Usize block_size = get_block_size__LilyInterpreterMemory(size_class);
+
+    check_capacity__LilyInterpreterMemory(self, block_size);
+
+    if (!self->free_blocks[size_class]) {
+        add_slab__LilyInterpreterMemory(self, size_class);
+    }
+
+    LilyInterpreterMemoryBlock *block = self->free_blocks[size_class];
+
+    self->free_blocks[size_class] = block->next;
+    self->total_size_free -= block_size;
+
+    return block;
 }
 
-LilyInterpreterValue
+void *
 resize__LilyInterpreterMemory(LilyInterpreterMemory *self,
-                              LilyInterpreterValue *value,
+                              void *mem,
+                              Usize size,
                               Usize new_size)
 {
+    if (!self) {
+        return lily_realloc(mem, new_size);
+    }
+
+    // The block of the size class is already big enough.
+    if (size <= LILY_INTERPRETER_MEMORY_MAX_SMALL_SIZE &&
+        new_size <= LILY_INTERPRETER_MEMORY_MAX_SMALL_SIZE &&
+        get_size_class__LilyInterpreterMemory(size) ==
+          get_size_class__LilyInterpreterMemory(new_size)) {
+        return mem;
+    }
+
+    void *new_mem = alloc__LilyInterpreterMemory(self, new_size);
+
+    memcpy(new_mem, mem, size < new_size ? size : new_size);
+    free__LilyInterpreterMemory(self, mem, size);
+
+    return new_mem;
 }
 
 void
 free__LilyInterpreterMemory(LilyInterpreterMemory *self,
-                            LilyInterpreterValue *value)
+                            void *mem,
+                            Usize size)
 {
-    if (value) {
-    } else {
+    if (!mem) {
         RUNTIME_ERROR_UNREACHABLE("bad free, the object is NULL");
     }
+
+    if (!self) {
+        lily_free(mem);
+
+        return;
+    }
+
+    ++self->free_count;
+
+    if (size > LILY_INTERPRETER_MEMORY_MAX_SMALL_SIZE) {
+        return free_large__LilyInterpreterMemory(self, mem);
+    }
+
+    Usize size_class = get_size_class__LilyInterpreterMemory(size);
+    LilyInterpreterMemoryBlock *block = mem;
+
+    block->next = self->free_blocks[size_class];
+    self->free_blocks[size_class] = block;
+    self->total_size_free += get_block_size__LilyInterpreterMemory(size_class);
+}
+
+void
+print_stats__LilyInterpreterMemory(const LilyInterpreterMemory *self)
+{
+    Usize slabs_len = 0;
+    Usize larges_len = 0;
+
+    for (LilyInterpreterMemorySlab *current = self->slabs; current;
+         current = current->next) {
+        ++slabs_len;
+    }
+
+    for (LilyInterpreterMemoryLarge *current = self->larges; current;
+         current = current->next) {
+        ++larges_len;
+    }
+
+    PRINTLN("===================================");
+    PRINTLN("=============VM heap===============");
+    PRINTLN("total size: {zu} b => {f} MiB",
+            self->total_size,
+            (Float64)self->total_size / MiB);
+    PRINTLN("total size free: {zu} b => {f} MiB",
+            self->total_size_free,
+            (Float64)self->total_size_free / MiB);
+    PRINTLN("peak size: {zu} b => {f} MiB",
+            self->peak_size,
+            (Float64)self->peak_size / MiB);
+    PRINTLN("total alloc: {zu}", self->alloc_count);
+    PRINTLN("total free: {zu}", self->free_count);
+    PRINTLN("total slab: {zu}", slabs_len);
+    PRINTLN("total large object: {zu}", larges_len);
+    PRINTLN("capacity: {zu} b => {f} MiB",
+            self->capacity,
+            (Float64)self->capacity / MiB);
+    PRINTLN("===================================");
+}
+
+DESTRUCTOR(LilyInterpreterMemory, LilyInterpreterMemory *self)
+{
+    while (self->slabs) {
+        LilyInterpreterMemorySlab *next = self->slabs->next;
+
+        lily_free(self->slabs);
+        self->slabs = next;
+    }
+
+    while (self->larges) {
+        LilyInterpreterMemoryLarge *next = self->larges->next;
+
+        lily_free(self->larges);
+        self->larges = next;
+    }
+
+    for (Usize i = 0; i < LILY_INTERPRETER_MEMORY_SIZE_CLASS_LEN; ++i) {
+        self->free_blocks[i] = NULL;
+    }
+
+    self->total_size = 0;
+    self->total_size_free = 0;
 }
@@ -33,8 +33,9 @@
 #define PRINT_ERROR_HEADER(error_name) \
     PRINTLN("\x1b[31mcrash\x1b[0m({s}):", error_name);
 
-static const char *s_LilyInterpreterRuntimeError[5] = {
+static const char *s_LilyInterpreterRuntimeError[6] = {
     [LILY_INTERPRETER_RUNTIME_ERROR_COMMON] = "Common",
+    [LILY_INTERPRETER_RUNTIME_ERROR_OUT_OF_MEMORY] = "OutOfMemory",
     [LILY_INTERPRETER_RUNTIME_ERROR_RAISE_EXCEPTION] = "RaiseException",
     [LILY_INTERPRETER_RUNTIME_ERROR_STACK_EMPTY] = "StackEmpty",
     [LILY_INTERPRETER_RUNTIME_ERROR_STACK_OVERFLOW] = "StackOverflow",
@@ -50,6 +51,19 @@ emit_runtime_error_common__LilyInterpreterRuntimeError(const char *msg)
     exit(1);
 }
 
+void
+emit_runtime_error_out_of_memory__LilyInterpreterRuntimeError(Usize size,
+                                                              Usize capacity)
+{
+    PRINT_ERROR_HEADER(s_LilyInterpreterRuntimeError
+                         [LILY_INTERPRETER_RUNTIME_ERROR_OUT_OF_MEMORY]);
+    PRINTLN("cannot allocate {zu} bytes, the heap capacity is {zu} bytes",
+            size,
+            capacity);
+    PRINTLN("help: please increase the size of the heap (--max-heap)");
+    exit(1);
+}
+
 void
 emit_runtime_error_raise_exception__LilyInterpreterRuntimeError(
   const char *raise_name,
@@ -0,0 +1,296 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <base/assert.h>
+#include <base/new.h>
+
+#include <core/lily/interpreter/vm/slot.h>
+
+static Usize
+get__LilyInterpreterVMSlot(LilyInterpreterVMSlot *self,
+                           HashMap *slots,
+                           const char *name);
+
+static void
+resolve_vals__LilyInterpreterVMSlot(LilyInterpreterVMSlot *self, Vec *vals);
+
+static void
+resolve_val__LilyInterpreterVMSlot(LilyInterpreterVMSlot *self,
+                                   LilyMirInstructionVal *val);
+
+static void
+resolve_inst__LilyInterpreterVMSlot(LilyInterpreterVMSlot *self,
+                                    LilyMirInstruction *inst);
+
+static void
+resolve_fun__LilyInterpreterVMSlot(LilyMirInstructionFun *fun);
+
+CONSTRUCTOR(LilyInterpreterVMSlot, LilyInterpreterVMSlot)
+{
+    return (LilyInterpreterVMSlot){ .regs = NEW(HashMap),
+                                     .vars = NEW(HashMap),
+                                     .len = 0 };
+}
+
+Usize
+get__LilyInterpreterVMSlot(LilyInterpreterVMSlot *self,
+                           HashMap *slots,
+                           const char *name)
+{
+    // NOTE: The slot is stored with an offset of 1, because NULL means that
+    // the name is not yet resolved.
+    Uptr slot = (Uptr)get__HashMap(slots, (char *)name);
+
+    if (slot) {
+        return slot - 1;
+    }
+
+    insert__HashMap(slots, (char *)name, (void *)(Uptr)(self->len + 1));
+
+    return self->len++;
+}
+
+Usize
+get_reg__LilyInterpreterVMSlot(LilyInterpreterVMSlot *self, const char *name)
+{
+    return get__LilyInterpreterVMSlot(self, self->regs, name);
+}
+
+Usize
+get_var__LilyInterpreterVMSlot(LilyInterpreterVMSlot *self, const char *name)
+{
+    return get__LilyInterpreterVMSlot(self, self->vars, name);
+}
+
+void
+resolve_vals__LilyInterpreterVMSlot(LilyInterpreterVMSlot *self, Vec *vals)
+{
+    for (Usize i = 0; i < vals->len; ++i) {
+        resolve_val__LilyInterpreterVMSlot(self, get__Vec(vals, i));
+    }
+}
+
+void
+resolve_val__LilyInterpreterVMSlot(LilyInterpreterVMSlot *self,
+                                   LilyMirInstructionVal *val)
+{
+    if (!val) {
+        return;
+    }
+
+    switch (val->kind) {
+        case LILY_MIR_INSTRUCTION_VAL_KIND_ARRAY:
+            return resolve_vals__LilyInterpreterVMSlot(self, val->array);
+        case LILY_MIR_INSTRUCTION_VAL_KIND_EXCEPTION:
+            resolve_val__LilyInterpreterVMSlot(self, val->exception[0]);
+
+            return resolve_val__LilyInterpreterVMSlot(self, val->exception[1]);
+        case LILY_MIR_INSTRUCTION_VAL_KIND_LIST:
+            return resolve_vals__LilyInterpreterVMSlot(self, val->list);
+        case LILY_MIR_INSTRUCTION_VAL_KIND_REG:
+            val->slot = get_reg__LilyInterpreterVMSlot(self, val->reg);
+            break;
+        case LILY_MIR_INSTRUCTION_VAL_KIND_SLICE:
+            return resolve_vals__LilyInterpreterVMSlot(self, val->slice);
+        case LILY_MIR_INSTRUCTION_VAL_KIND_STRUCT:
+            return resolve_vals__LilyInterpreterVMSlot(self, val->struct_);
+        case LILY_MIR_INSTRUCTION_VAL_KIND_TRACE:
+            return resolve_val__LilyInterpreterVMSlot(self, val->trace);
+        case LILY_MIR_INSTRUCTION_VAL_KIND_TUPLE:
+            return resolve_vals__LilyInterpreterVMSlot(self, val->tuple);
+        case LILY_MIR_INSTRUCTION_VAL_KIND_VAR:
+            val->slot = get_var__LilyInterpreterVMSlot(self, val->var);
+            break;
+        default:
+            break;
+    }
+}
+
+void
+resolve_inst__LilyInterpreterVMSlot(LilyInterpreterVMSlot *self,
+                                    LilyMirInstruction *inst)
+{
+    if (!inst) {
+        return;
+    }
+
+    switch (inst->kind) {
+        case LILY_MIR_INSTRUCTION_KIND_BITCAST:
+        case LILY_MIR_INSTRUCTION_KIND_TRUNC:
+            // NOTE: bitcast and trunc have the same layout
+            // (LilyMirInstructionValDt).
+            return resolve_val__LilyInterpreterVMSlot(self, inst->bitcast.val);
+        case LILY_MIR_INSTRUCTION_KIND_BITAND:
+        case LILY_MIR_INSTRUCTION_KIND_BITOR:
+        case LILY_MIR_INSTRUCTION_KIND_EXP:
+        case LILY_MIR_INSTRUCTION_KIND_FADD:
+        case LILY_MIR_INSTRUCTION_KIND_FCMP_EQ:
+        case LILY_MIR_INSTRUCTION_KIND_FCMP_NE:
+        case LILY_MIR_INSTRUCTION_KIND_FCMP_LE:
+        case LILY_MIR_INSTRUCTION_KIND_FCMP_LT:
+        case LILY_MIR_INSTRUCTION_KIND_FCMP_GE:
+        case LILY_MIR_INSTRUCTION_KIND_FCMP_GT:
+        case LILY_MIR_INSTRUCTION_KIND_FDIV:
+        case LILY_MIR_INSTRUCTION_KIND_FMUL:
+        case LILY_MIR_INSTRUCTION_KIND_FREM:
+        case LILY_MIR_INSTRUCTION_KIND_FSUB:
+        case LILY_MIR_INSTRUCTION_KIND_IADD:
+        case LILY_MIR_INSTRUCTION_KIND_ICMP_EQ:
+        case LILY_MIR_INSTRUCTION_KIND_ICMP_NE:
+        case LILY_MIR_INSTRUCTION_KIND_ICMP_LE:
+        case LILY_MIR_INSTRUCTION_KIND_ICMP_LT:
+        case LILY_MIR_INSTRUCTION_KIND_ICMP_GE:
+        case LILY_MIR_INSTRUCTION_KIND_ICMP_GT:
+        case LILY_MIR_INSTRUCTION_KIND_IDIV:
+        case LILY_MIR_INSTRUCTION_KIND_IMUL:
+        case LILY_MIR_INSTRUCTION_KIND_IREM:
+        case LILY_MIR_INSTRUCTION_KIND_ISUB:
+        case LILY_MIR_INSTRUCTION_KIND_SHL:
+        case LILY_MIR_INSTRUCTION_KIND_SHR:
+        case LILY_MIR_INSTRUCTION_KIND_STORE:
+        case LILY_MIR_INSTRUCTION_KIND_XOR:
+            // NOTE: All these instructions have the same layout
+            // (LilyMirInstructionDestSrc).
+            resolve_val__LilyInterpreterVMSlot(self, inst->iadd.dest);
+
+            return resolve_val__LilyInterpreterVMSlot(self, inst->iadd.src);
+        case LILY_MIR_INSTRUCTION_KIND_BITNOT:
+        case LILY_MIR_INSTRUCTION_KIND_DROP:
+        case LILY_MIR_INSTRUCTION_KIND_FNEG:
+        case LILY_MIR_INSTRUCTION_KIND_GETARG:
+        case LILY_MIR_INSTRUCTION_KIND_GETLIST:
+        case LILY_MIR_INSTRUCTION_KIND_GETPTR:
+        case LILY_MIR_INSTRUCTION_KIND_GETSLICE:
+        case LILY_MIR_INSTRUCTION_KIND_INCTRACE:
+        case LILY_MIR_INSTRUCTION_KIND_INEG:
+        case LILY_MIR_INSTRUCTION_KIND_ISOK:
+        case LILY_MIR_INSTRUCTION_KIND_ISERR:
+        case LILY_MIR_INSTRUCTION_KIND_LEN:
+        case LILY_MIR_INSTRUCTION_KIND_MAKEREF:
+        case LILY_MIR_INSTRUCTION_KIND_MAKEOPT:
+        case LILY_MIR_INSTRUCTION_KIND_NOT:
+        case LILY_MIR_INSTRUCTION_KIND_REF_PTR:
+            // NOTE: All these instructions have the same layout
+            // (LilyMirInstructionSrc).
+            return resolve_val__LilyInterpreterVMSlot(self, inst->not.src);
+        case LILY_MIR_INSTRUCTION_KIND_BUILTIN_CALL:
+        case LILY_MIR_INSTRUCTION_KIND_CALL:
+        case LILY_MIR_INSTRUCTION_KIND_SYS_CALL:
+            // NOTE: All these instructions have the same layout
+            // (LilyMirInstructionCall).
+            return resolve_vals__LilyInterpreterVMSlot(self, inst->call.params);
+        case LILY_MIR_INSTRUCTION_KIND_GETARRAY:
+            resolve_val__LilyInterpreterVMSlot(self, inst->getarray.val);
+
+            return resolve_vals__LilyInterpreterVMSlot(self,
+                                                       inst->getarray.indexes);
+        case LILY_MIR_INSTRUCTION_KIND_GETFIELD:
+            resolve_val__LilyInterpreterVMSlot(self, inst->getfield.val);
+
+            return resolve_vals__LilyInterpreterVMSlot(self,
+                                                       inst->getfield.indexes);
+        case LILY_MIR_INSTRUCTION_KIND_JMPCOND:
+            return resolve_val__LilyInterpreterVMSlot(self,
+                                                      inst->jmpcond.cond);
+        case LILY_MIR_INSTRUCTION_KIND_LOAD:
+            return resolve_val__LilyInterpreterVMSlot(self,
+                                                      inst->load.src.src);
+        case LILY_MIR_INSTRUCTION_KIND_NON_NIL:
+            return resolve_inst__LilyInterpreterVMSlot(self, inst->non_nil);
+        case LILY_MIR_INSTRUCTION_KIND_REG:
+            inst->reg.slot =
+              get_reg__LilyInterpreterVMSlot(self, inst->reg.name);
+
+            return resolve_inst__LilyInterpreterVMSlot(self, inst->reg.inst);
+        case LILY_MIR_INSTRUCTION_KIND_RET:
+            return resolve_inst__LilyInterpreterVMSlot(self, inst->ret);
+        case LILY_MIR_INSTRUCTION_KIND_SWITCH:
+            resolve_val__LilyInterpreterVMSlot(self, inst->switch_.val);
+
+            for (Usize i = 0; i < inst->switch_.cases->len; ++i) {
+                LilyMirInstructionSwitchCase *case_ =
+                  get__Vec(inst->switch_.cases, i);
+
+                resolve_val__LilyInterpreterVMSlot(self, case_->val);
+            }
+
+            break;
+        case LILY_MIR_INSTRUCTION_KIND_TRY:
+        case LILY_MIR_INSTRUCTION_KIND_TRY_PTR:
+            resolve_val__LilyInterpreterVMSlot(self, inst->try.val);
+
+            return resolve_val__LilyInterpreterVMSlot(self,
+                                                      inst->try.catch_val);
+        case LILY_MIR_INSTRUCTION_KIND_VAL:
+            return resolve_val__LilyInterpreterVMSlot(self, inst->val);
+        case LILY_MIR_INSTRUCTION_KIND_VAR:
+            inst->var.slot =
+              get_var__LilyInterpreterVMSlot(self, inst->var.name);
+
+            return resolve_inst__LilyInterpreterVMSlot(self, inst->var.inst);
+        default:
+            break;
+    }
+}
+
+void
+resolve_fun__LilyInterpreterVMSlot(LilyMirInstructionFun *fun)
+{
+    LilyInterpreterVMSlot self = NEW(LilyInterpreterVMSlot);
+    OrderedHashMapIter iter = NEW(OrderedHashMapIter, fun->insts);
+    LilyMirInstruction *block_inst = NULL;
+
+    while ((block_inst = next__OrderedHashMapIter(&iter))) {
+        ASSERT(block_inst->kind == LILY_MIR_INSTRUCTION_KIND_BLOCK);
+
+        for (Usize i = 0; i < block_inst->block.insts->len; ++i) {
+            resolve_inst__LilyInterpreterVMSlot(
+              &self, get__Vec(block_inst->block.insts, i));
+        }
+    }
+
+    fun->slots_len = self.len;
+
+    FREE(LilyInterpreterVMSlot, &self);
+}
+
+void
+resolve__LilyInterpreterVMSlot(const LilyMirModule *module)
+{
+    OrderedHashMapIter iter = NEW(OrderedHashMapIter, module->insts);
+    LilyMirInstruction *inst = NULL;
+
+    while ((inst = next__OrderedHashMapIter(&iter))) {
+        if (inst->kind == LILY_MIR_INSTRUCTION_KIND_FUN) {
+            resolve_fun__LilyInterpreterVMSlot(&inst->fun);
+        }
+    }
+}
+
+DESTRUCTOR(LilyInterpreterVMSlot, const LilyInterpreterVMSlot *self)
+{
+    FREE(HashMap, self->regs);
+    FREE(HashMap, self->vars);
+}
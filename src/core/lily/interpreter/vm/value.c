@@ -22,15 +22,33 @@
  * SOFTWARE.
  */
 
+#define _GNU_SOURCE
+
 #include <base/alloc.h>
 #include <base/assert.h>
+#include <base/new.h>
+#include <base/print.h>
+#include <base/vec.h>
 
 #include <core/lily/interpreter/vm.h>
+#include <core/lily/interpreter/vm/memory.h>
 #include <core/lily/interpreter/vm/runtime.h>
 #include <core/lily/interpreter/vm/value.h>
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static_assert(sizeof(LilyInterpreterValue) == 16,
+              "LilyInterpreterValue is expected to be 16 bytes wide");
+
+// NOTE: The heap values are allocated in the memory of the running VM.
+#define VALUE_ALLOC(size) \
+    alloc__LilyInterpreterMemory(get_current__LilyInterpreterMemory(), size)
+#define VALUE_FREE(self, size)   \
+    free__LilyInterpreterMemory( \
+      get_current__LilyInterpreterMemory(), self, size)
 
 void
 store__LilyInterpreterValue(LilyInterpreterValue *self,
@@ -186,7 +204,9 @@ DESTRUCTOR(LilyInterpreterValue, LilyInterpreterValue *self)
     }
 
     if (self->ref_count > 0) {
-        --self->ref_count;
+        if (self->ref_count < UINT32_MAX) {
+            --self->ref_count;
+        }
 
         return;
     }
@@ -224,41 +244,712 @@ DESTRUCTOR(LilyInterpreterValue, LilyInterpreterValue *self)
     self->kind = LILY_INTERPRETER_VALUE_KIND_DESTROYED;
 }
 
+static threadlocal Vec *roots = NULL;   // Vec<LilyInterpreterValueObject*>*?
+static threadlocal Vec *garbage = NULL; // Vec<LilyInterpreterValueObject*>*?
+// NOTE: The objects are traversed with an explicit stack, so a deep structure
+// (e.g. a long list) cannot overflow the stack of the thread.
+static threadlocal Vec *work = NULL; // Vec<LilyInterpreterValueObject*>*?
+static threadlocal Usize allocs_since_collect = 0;
+static threadlocal LilyInterpreterValueCollectorStats collector_stats = { 0 };
+
+/**
+ *
+ * @brief Get the object of the value, if the value owns a heap value which
+ * can be part of a cycle.
+ * @return LilyInterpreterValueObject*? (&)
+ */
+static LilyInterpreterValueObject *
+get_object__LilyInterpreterValue(const LilyInterpreterValue *self);
+
+/**
+ *
+ * @brief Alloc an object (maybe collect the cycles before).
+ */
+static void *
+alloc__LilyInterpreterValueObject(Usize size);
+
+/**
+ *
+ * @brief Add the object to the roots.
+ */
+static void
+add_root__LilyInterpreterValueObject(LilyInterpreterValueObject *self);
+
+/**
+ *
+ * @brief Remove the object from the roots.
+ */
+static void
+remove_root__LilyInterpreterValueObject(LilyInterpreterValueObject *self);
+
+/**
+ *
+ * @brief Decrement the `ref_count` of the object (expected `ref_count` > 0),
+ * and buffer the object as a possible root of a cycle.
+ */
+static void
+release__LilyInterpreterValueObject(LilyInterpreterValueObject *self);
+
+/**
+ *
+ * @brief Call `visit` on each value contained in the object.
+ */
+static void
+visit_values__LilyInterpreterValueObject(
+  LilyInterpreterValueObject *self,
+  void (*visit)(LilyInterpreterValue *));
+
+/**
+ *
+ * @brief Free the memory of the object, without freeing the values contained
+ * in the object.
+ */
+static void
+free_shell__LilyInterpreterValueObject(LilyInterpreterValueObject *self);
+
+/**
+ *
+ * @brief Free the object (expected `ref_count` == 0).
+ */
+static void
+free__LilyInterpreterValueObject(LilyInterpreterValueObject *self);
+
+/**
+ *
+ * @brief Free the value contained in an object, unless the value is a member
+ * of a cycle being freed.
+ */
+static void
+free_child__LilyInterpreterValueObject(LilyInterpreterValue *value);
+
+/**
+ *
+ * @brief Mark the object as a possible member of a cycle, and push it to the
+ * work stack.
+ */
+static void
+push_gray__LilyInterpreterValueObject(LilyInterpreterValueObject *self);
+
+/**
+ *
+ * @brief Mark the object and the objects reachable from it as possible
+ * members of a cycle, and subtract the internal references from their
+ * `gc_ref_count`.
+ */
+static void
+mark_gray__LilyInterpreterValueObject(LilyInterpreterValueObject *self);
+
+static void
+mark_gray_child__LilyInterpreterValueObject(LilyInterpreterValue *value);
+
+/**
+ *
+ * @brief Mark the object as garbage if no external reference to it is found,
+ * otherwise mark it and the objects reachable from it as in use.
+ */
+static void
+scan__LilyInterpreterValueObject(LilyInterpreterValueObject *self);
+
+static void
+scan_child__LilyInterpreterValueObject(LilyInterpreterValue *value);
+
+static void
+scan_black__LilyInterpreterValueObject(LilyInterpreterValueObject *self);
+
+static void
+scan_black_child__LilyInterpreterValueObject(LilyInterpreterValue *value);
+
+/**
+ *
+ * @brief Move the object to the garbage, and push it to the work stack.
+ */
+static void
+push_garbage__LilyInterpreterValueObject(LilyInterpreterValueObject *self);
+
+/**
+ *
+ * @brief Move the object and the white objects reachable from it to the
+ * garbage.
+ */
+static void
+collect_white__LilyInterpreterValueObject(LilyInterpreterValueObject *self);
+
+static void
+collect_white_child__LilyInterpreterValueObject(LilyInterpreterValue *value);
+
+/**
+ *
+ * @brief Get the current time in nanoseconds.
+ */
+static Uint64
+get_time__LilyInterpreterValueCollector();
+
+LilyInterpreterValueObject *
+get_object__LilyInterpreterValue(const LilyInterpreterValue *self)
+{
+    // NOTE: A value with a ref count doesn't own its heap value (see the
+    // destructor of LilyInterpreterValue).
+    if (self->ref_count > 0) {
+        return NULL;
+    }
+
+    switch (self->kind) {
+        case LILY_INTERPRETER_VALUE_KIND_DYNAMIC_ARRAY:
+            return &self->dynamic_array->object;
+        case LILY_INTERPRETER_VALUE_KIND_LIST:
+            return &self->list->object;
+        case LILY_INTERPRETER_VALUE_KIND_MULTI_POINTERS_ARRAY:
+            return &self->multi_pointers_array->object;
+        case LILY_INTERPRETER_VALUE_KIND_RESULT:
+            return &self->result->object;
+        case LILY_INTERPRETER_VALUE_KIND_SIZED_ARRAY:
+            return &self->sized_array->object;
+        case LILY_INTERPRETER_VALUE_KIND_STRUCT:
+            return &self->struct_->object;
+        default:
+            return NULL;
+    }
+}
+
+void *
+alloc__LilyInterpreterValueObject(Usize size)
+{
+    if (roots && roots->len > 0) {
+        if (roots->len >= LILY_INTERPRETER_VALUE_COLLECTOR_MAX_ROOTS ||
+            ++allocs_since_collect >=
+              LILY_INTERPRETER_VALUE_COLLECTOR_ALLOC_THRESHOLD) {
+            collect_cycles__LilyInterpreterValue();
+        }
+    }
+
+    return VALUE_ALLOC(size);
+}
+
+void
+add_root__LilyInterpreterValueObject(LilyInterpreterValueObject *self)
+{
+    if (!roots) {
+        roots = NEW(Vec);
+    }
+
+    self->root_index = roots->len;
+    push__Vec(roots, self);
+}
+
+void
+remove_root__LilyInterpreterValueObject(LilyInterpreterValueObject *self)
+{
+    // Move the last root to the place of the removed root.
+    LilyInterpreterValueObject *last = pop__Vec(roots);
+
+    if (last != self) {
+        last->root_index = self->root_index;
+        replace__Vec(roots, self->root_index, last);
+    }
+
+    self->root_index = LILY_INTERPRETER_VALUE_OBJECT_NOT_BUFFERED;
+}
+
+void
+release__LilyInterpreterValueObject(LilyInterpreterValueObject *self)
+{
+    --self->ref_count;
+    self->color = LILY_INTERPRETER_VALUE_COLOR_PURPLE;
+
+    if (self->root_index == LILY_INTERPRETER_VALUE_OBJECT_NOT_BUFFERED) {
+        add_root__LilyInterpreterValueObject(self);
+    }
+}
+
+void
+visit_values__LilyInterpreterValueObject(
+  LilyInterpreterValueObject *self,
+  void (*visit)(LilyInterpreterValue *))
+{
+    switch (self->kind) {
+        case LILY_INTERPRETER_VALUE_KIND_DYNAMIC_ARRAY: {
+            LilyInterpreterValueDynamicArray *dynamic_array =
+              (LilyInterpreterValueDynamicArray *)self;
+
+            for (Usize i = 0; i < dynamic_array->len; ++i) {
+                visit(&dynamic_array->buffer[i]);
+            }
+
+            break;
+        }
+        case LILY_INTERPRETER_VALUE_KIND_LIST:
+            for (LilyInterpreterValueListNode *current =
+                   ((LilyInterpreterValueList *)self)->head;
+                 current;
+                 current = current->next) {
+                visit(&current->value);
+            }
+
+            break;
+        case LILY_INTERPRETER_VALUE_KIND_MULTI_POINTERS_ARRAY: {
+            LilyInterpreterValueMultiPointersArray *multi_pointers_array =
+              (LilyInterpreterValueMultiPointersArray *)self;
+
+            for (Usize i = 0; i < multi_pointers_array->len; ++i) {
+                visit(&multi_pointers_array->buffer[i]);
+            }
+
+            break;
+        }
+        case LILY_INTERPRETER_VALUE_KIND_RESULT: {
+            LilyInterpreterValueResult *result =
+              (LilyInterpreterValueResult *)self;
+
+            switch (result->kind) {
+                case LILY_INTERPRETER_VALUE_RESULT_KIND_OK:
+                    visit(&result->ok);
+                    break;
+                case LILY_INTERPRETER_VALUE_RESULT_KIND_ERR:
+                    visit(&result->err);
+                    break;
+                default:
+                    UNREACHABLE("unknown variant");
+            }
+
+            break;
+        }
+        case LILY_INTERPRETER_VALUE_KIND_SIZED_ARRAY: {
+            LilyInterpreterValueSizedArray *sized_array =
+              (LilyInterpreterValueSizedArray *)self;
+
+            for (Usize i = 0; i < sized_array->len; ++i) {
+                visit(&sized_array->buffer[i]);
+            }
+
+            break;
+        }
+        case LILY_INTERPRETER_VALUE_KIND_STRUCT: {
+            LilyInterpreterValueStruct *struct_ =
+              (LilyInterpreterValueStruct *)self;
+
+            for (Usize i = 0; i < struct_->len; ++i) {
+                visit(&struct_->values[i]);
+            }
+
+            break;
+        }
+        default:
+            UNREACHABLE("unknown variant");
+    }
+}
+
+void
+free_shell__LilyInterpreterValueObject(LilyInterpreterValueObject *self)
+{
+    switch (self->kind) {
+        case LILY_INTERPRETER_VALUE_KIND_DYNAMIC_ARRAY: {
+            LilyInterpreterValueDynamicArray *dynamic_array =
+              (LilyInterpreterValueDynamicArray *)self;
+
+            if (dynamic_array->buffer) {
+                VALUE_FREE(dynamic_array->buffer,
+                           sizeof(LilyInterpreterValue) *
+                             dynamic_array->capacity);
+            }
+
+            VALUE_FREE(self, sizeof(LilyInterpreterValueDynamicArray));
+
+            break;
+        }
+        case LILY_INTERPRETER_VALUE_KIND_LIST: {
+            LilyInterpreterValueListNode *current =
+              ((LilyInterpreterValueList *)self)->head;
+
+            while (current) {
+                LilyInterpreterValueListNode *next = current->next;
+
+                VALUE_FREE(current, sizeof(LilyInterpreterValueListNode));
+
+                current = next;
+            }
+
+            VALUE_FREE(self, sizeof(LilyInterpreterValueList));
+
+            break;
+        }
+        case LILY_INTERPRETER_VALUE_KIND_MULTI_POINTERS_ARRAY:
+            VALUE_FREE(self, sizeof(LilyInterpreterValueMultiPointersArray));
+            break;
+        case LILY_INTERPRETER_VALUE_KIND_RESULT:
+            VALUE_FREE(self, sizeof(LilyInterpreterValueResult));
+            break;
+        case LILY_INTERPRETER_VALUE_KIND_SIZED_ARRAY: {
+            LilyInterpreterValueSizedArray *sized_array =
+              (LilyInterpreterValueSizedArray *)self;
+
+            if (sized_array->buffer) {
+                VALUE_FREE(sized_array->buffer,
+                           sizeof(LilyInterpreterValue) * sized_array->len);
+            }
+
+            VALUE_FREE(self, sizeof(LilyInterpreterValueSizedArray));
+
+            break;
+        }
+        case LILY_INTERPRETER_VALUE_KIND_STRUCT:
+            VALUE_FREE(self,
+                       sizeof(LilyInterpreterValueStruct) +
+                         sizeof(LilyInterpreterValue) *
+                           ((LilyInterpreterValueStruct *)self)->len);
+            break;
+        default:
+            UNREACHABLE("unknown variant");
+    }
+}
+
+void
+free__LilyInterpreterValueObject(LilyInterpreterValueObject *self)
+{
+    if (self->root_index != LILY_INTERPRETER_VALUE_OBJECT_NOT_BUFFERED) {
+        remove_root__LilyInterpreterValueObject(self);
+    }
+
+    visit_values__LilyInterpreterValueObject(
+      self, &free_child__LilyInterpreterValueObject);
+    free_shell__LilyInterpreterValueObject(self);
+}
+
+void
+free_child__LilyInterpreterValueObject(LilyInterpreterValue *value)
+{
+    LilyInterpreterValueObject *child = get_object__LilyInterpreterValue(value);
+
+    if (!child || child->color != LILY_INTERPRETER_VALUE_COLOR_GARBAGE) {
+        FREE(LilyInterpreterValue, value);
+    }
+}
+
+void
+push_gray__LilyInterpreterValueObject(LilyInterpreterValueObject *self)
+{
+    self->color = LILY_INTERPRETER_VALUE_COLOR_GRAY;
+    // NOTE: A `ref_count` of 0 means that the object has one owner.
+    self->gc_ref_count = self->ref_count + 1;
+
+    push__Vec(work, self);
+}
+
+void
+mark_gray__LilyInterpreterValueObject(LilyInterpreterValueObject *self)
+{
+    if (self->color == LILY_INTERPRETER_VALUE_COLOR_GRAY) {
+        return;
+    }
+
+    push_gray__LilyInterpreterValueObject(self);
+
+    while (work->len > 0) {
+        visit_values__LilyInterpreterValueObject(
+          pop__Vec(work), &mark_gray_child__LilyInterpreterValueObject);
+    }
+}
+
+void
+mark_gray_child__LilyInterpreterValueObject(LilyInterpreterValue *value)
+{
+    LilyInterpreterValueObject *child = get_object__LilyInterpreterValue(value);
+
+    if (child) {
+        if (child->color != LILY_INTERPRETER_VALUE_COLOR_GRAY) {
+            push_gray__LilyInterpreterValueObject(child);
+        }
+
+        --child->gc_ref_count;
+    }
+}
+
+void
+scan__LilyInterpreterValueObject(LilyInterpreterValueObject *self)
+{
+    push__Vec(work, self);
+
+    while (work->len > 0) {
+        LilyInterpreterValueObject *current = pop__Vec(work);
+
+        // NOTE: The object can be pushed several times, or be marked as in
+        // use after it was pushed.
+        if (current->color != LILY_INTERPRETER_VALUE_COLOR_GRAY) {
+            continue;
+        }
+
+        if (current->gc_ref_count > 0) {
+            scan_black__LilyInterpreterValueObject(current);
+        } else {
+            current->color = LILY_INTERPRETER_VALUE_COLOR_WHITE;
+
+            visit_values__LilyInterpreterValueObject(
+              current, &scan_child__LilyInterpreterValueObject);
+        }
+    }
+}
+
+void
+scan_child__LilyInterpreterValueObject(LilyInterpreterValue *value)
+{
+    LilyInterpreterValueObject *child = get_object__LilyInterpreterValue(value);
+
+    if (child) {
+        push__Vec(work, child);
+    }
+}
+
+void
+scan_black__LilyInterpreterValueObject(LilyInterpreterValueObject *self)
+{
+    // NOTE: The objects still to be scanned are kept below `work_len` in the
+    // work stack.
+    Usize work_len = work->len;
+
+    self->color = LILY_INTERPRETER_VALUE_COLOR_BLACK;
+    push__Vec(work, self);
+
+    while (work->len > work_len) {
+        visit_values__LilyInterpreterValueObject(
+          pop__Vec(work), &scan_black_child__LilyInterpreterValueObject);
+    }
+}
+
+void
+scan_black_child__LilyInterpreterValueObject(LilyInterpreterValue *value)
+{
+    LilyInterpreterValueObject *child = get_object__LilyInterpreterValue(value);
+
+    if (child && child->color != LILY_INTERPRETER_VALUE_COLOR_BLACK) {
+        child->color = LILY_INTERPRETER_VALUE_COLOR_BLACK;
+        push__Vec(work, child);
+    }
+}
+
+void
+push_garbage__LilyInterpreterValueObject(LilyInterpreterValueObject *self)
+{
+    self->color = LILY_INTERPRETER_VALUE_COLOR_GARBAGE;
+
+    push__Vec(garbage, self);
+    push__Vec(work, self);
+}
+
+void
+collect_white__LilyInterpreterValueObject(LilyInterpreterValueObject *self)
+{
+    if (self->color != LILY_INTERPRETER_VALUE_COLOR_WHITE) {
+        return;
+    }
+
+    push_garbage__LilyInterpreterValueObject(self);
+
+    while (work->len > 0) {
+        visit_values__LilyInterpreterValueObject(
+          pop__Vec(work), &collect_white_child__LilyInterpreterValueObject);
+    }
+}
+
+void
+collect_white_child__LilyInterpreterValueObject(LilyInterpreterValue *value)
+{
+    LilyInterpreterValueObject *child = get_object__LilyInterpreterValue(value);
+
+    if (child && child->color == LILY_INTERPRETER_VALUE_COLOR_WHITE) {
+        push_garbage__LilyInterpreterValueObject(child);
+    }
+}
+
+Uint64
+get_time__LilyInterpreterValueCollector()
+{
+    struct timespec ts;
+
+    // NOTE: The pauses are measured with a monotonic clock, so they are not
+    // affected by a change of the system time.
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (Uint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void
+collect_cycles__LilyInterpreterValue()
+{
+    allocs_since_collect = 0;
+
+    if (!roots || roots->len == 0) {
+        return;
+    }
+
+    Uint64 start = get_time__LilyInterpreterValueCollector();
+    // NOTE: The roots are detached, because the values released while freeing
+    // the garbage can be buffered as new roots.
+    Vec *current_roots = roots;
+
+    roots = NEW(Vec);
+
+    if (!garbage) {
+        garbage = NEW(Vec);
+    }
+
+    if (!work) {
+        work = NEW(Vec);
+    }
+
+    // 1. Subtract the internal references (trial deletion).
+    for (Usize i = 0; i < current_roots->len; ++i) {
+        LilyInterpreterValueObject *root = get__Vec(current_roots, i);
+
+        root->root_index = LILY_INTERPRETER_VALUE_OBJECT_NOT_BUFFERED;
+
+        if (root->color == LILY_INTERPRETER_VALUE_COLOR_PURPLE) {
+            mark_gray__LilyInterpreterValueObject(root);
+        } else {
+            // The root has been referenced again since it was buffered.
+            replace__Vec(current_roots, i, NULL);
+        }
+    }
+
+    // 2. Restore the objects reachable from an external reference.
+    for (Usize i = 0; i < current_roots->len; ++i) {
+        LilyInterpreterValueObject *root = get__Vec(current_roots, i);
+
+        if (root) {
+            scan__LilyInterpreterValueObject(root);
+        }
+    }
+
+    // 3. Collect the remaining objects (the garbage cycles).
+    for (Usize i = 0; i < current_roots->len; ++i) {
+        LilyInterpreterValueObject *root = get__Vec(current_roots, i);
+
+        if (root && root->color == LILY_INTERPRETER_VALUE_COLOR_WHITE) {
+            ++collector_stats.cycles;
+            collect_white__LilyInterpreterValueObject(root);
+        }
+    }
+
+    FREE(Vec, current_roots);
+
+    // 4. Free the values referenced by the garbage (only the values outside of
+    // the garbage are released), then free the garbage.
+    for (Usize i = 0; i < garbage->len; ++i) {
+        visit_values__LilyInterpreterValueObject(
+          get__Vec(garbage, i), &free_child__LilyInterpreterValueObject);
+    }
+
+    for (Usize i = 0; i < garbage->len; ++i) {
+        free_shell__LilyInterpreterValueObject(get__Vec(garbage, i));
+    }
+
+    collector_stats.objects_freed += garbage->len;
+    garbage->len = 0;
+
+    Uint64 pause = get_time__LilyInterpreterValueCollector() - start;
+
+    ++collector_stats.collections;
+    collector_stats.total_pause += pause;
+
+    if (pause > collector_stats.max_pause) {
+        collector_stats.max_pause = pause;
+    }
+}
+
+const LilyInterpreterValueCollectorStats *
+get_collector_stats__LilyInterpreterValue()
+{
+    return &collector_stats;
+}
+
+void
+print_collector_stats__LilyInterpreterValue()
+{
+    PRINTLN("===================================");
+    PRINTLN("==========Cycle collector==========");
+    PRINTLN("total collection: {zu}", collector_stats.collections);
+    PRINTLN("total cycle: {zu}", collector_stats.cycles);
+    PRINTLN("total object freed: {zu}", collector_stats.objects_freed);
+    PRINTLN("total pause: {zu} ns", (Usize)collector_stats.total_pause);
+    PRINTLN("max pause: {zu} ns", (Usize)collector_stats.max_pause);
+    PRINTLN("===================================");
+}
+
+void
+free_collector__LilyInterpreterValue()
+{
+    if (roots) {
+        FREE(Vec, roots);
+        roots = NULL;
+    }
+
+    if (garbage) {
+        FREE(Vec, garbage);
+        garbage = NULL;
+    }
+
+    if (work) {
+        FREE(Vec, work);
+        work = NULL;
+    }
+
+    allocs_since_collect = 0;
+    collector_stats = (LilyInterpreterValueCollectorStats){ 0 };
+}
+
 CONSTRUCTOR(LilyInterpreterValueDynamicArray *,
             LilyInterpreterValueDynamicArray)
 {
-    LilyInterpreterValueDynamicArray *self =
-      lily_malloc(sizeof(LilyInterpreterValueDynamicArray));
+    LilyInterpreterValueDynamicArray *self = alloc__LilyInterpreterValueObject(
+      sizeof(LilyInterpreterValueDynamicArray));
 
-    self->ref_count = 0;
+    self->object = NEW(LilyInterpreterValueObject,
+                       LILY_INTERPRETER_VALUE_KIND_DYNAMIC_ARRAY);
     self->buffer = NULL;
     self->len = 0;
+    self->capacity = 0;
 
     return self;
 }
 
-DESTRUCTOR(LilyInterpreterValueDynamicArray,
-           LilyInterpreterValueDynamicArray *self)
+void
+push__LilyInterpreterValueDynamicArray(LilyInterpreterValueDynamicArray *self,
+                                       LilyInterpreterValue value)
 {
-    if (self->ref_count > 0) {
-        --self->ref_count;
-        return;
+    if (self->len == self->capacity) {
+        Usize new_capacity = self->capacity == 0 ? 4 : self->capacity * 2;
+
+        self->buffer =
+          self->buffer
+            ? resize__LilyInterpreterMemory(
+                get_current__LilyInterpreterMemory(),
+                self->buffer,
+                sizeof(LilyInterpreterValue) * self->capacity,
+                sizeof(LilyInterpreterValue) * new_capacity)
+            : VALUE_ALLOC(sizeof(LilyInterpreterValue) * new_capacity);
+        self->capacity = new_capacity;
     }
 
-    for (Usize i = 0; i < self->len; ++i) {
-        FREE(LilyInterpreterValue, &self->buffer[i]);
+    self->buffer[self->len++] = value;
+}
+
+DESTRUCTOR(LilyInterpreterValueDynamicArray,
+           LilyInterpreterValueDynamicArray *self)
+{
+    if (self->object.ref_count > 0) {
+        return release__LilyInterpreterValueObject(&self->object);
     }
 
-    lily_free(self);
+    free__LilyInterpreterValueObject(&self->object);
 }
 
 CONSTRUCTOR(LilyInterpreterValueMultiPointersArray *,
             LilyInterpreterValueMultiPointersArray)
 {
     LilyInterpreterValueMultiPointersArray *self =
-      lily_malloc(sizeof(LilyInterpreterValueMultiPointersArray));
+      alloc__LilyInterpreterValueObject(
+        sizeof(LilyInterpreterValueMultiPointersArray));
 
-    self->ref_count = 0;
+    self->object = NEW(LilyInterpreterValueObject,
+                       LILY_INTERPRETER_VALUE_KIND_MULTI_POINTERS_ARRAY);
     self->buffer = NULL;
     self->len = 0;
 
@@ -268,60 +959,59 @@ CONSTRUCTOR(LilyInterpreterValueMultiPointersArray *,
 DESTRUCTOR(LilyInterpreterValueMultiPointersArray,
            LilyInterpreterValueMultiPointersArray *self)
 {
-    if (self->ref_count > 0) {
-        --self->ref_count;
-        return;
-    }
-
-    for (Usize i = 0; i < self->len; ++i) {
-        FREE(LilyInterpreterValue, &self->buffer[i]);
+    if (self->object.ref_count > 0) {
+        return release__LilyInterpreterValueObject(&self->object);
     }
 
-    lily_free(self);
+    free__LilyInterpreterValueObject(&self->object);
 }
 
 CONSTRUCTOR(LilyInterpreterValueSizedArray *,
             LilyInterpreterValueSizedArray,
-            LilyInterpreterValue *buffer,
+            const LilyInterpreterValue *values,
             Usize len)
 {
-    LilyInterpreterValueSizedArray *self =
-      lily_malloc(sizeof(LilyInterpreterValueSizedArray));
+    LilyInterpreterValueSizedArray *self = alloc__LilyInterpreterValueObject(
+      sizeof(LilyInterpreterValueSizedArray));
 
-    self->ref_count = 0;
-    self->buffer = buffer;
+    self->object = NEW(LilyInterpreterValueObject,
+                       LILY_INTERPRETER_VALUE_KIND_SIZED_ARRAY);
+    self->buffer =
+      len > 0 ? VALUE_ALLOC(sizeof(LilyInterpreterValue) * len) : NULL;
     self->len = len;
 
+    if (len > 0) {
+        memcpy(self->buffer, values, sizeof(LilyInterpreterValue) * len);
+    }
+
     return self;
 }
 
 DESTRUCTOR(LilyInterpreterValueSizedArray, LilyInterpreterValueSizedArray *self)
 {
-    if (self->ref_count > 0) {
-        --self->ref_count;
-        return;
-    }
-
-    for (Usize i = 0; i < self->len; ++i) {
-        FREE(LilyInterpreterValue, &self->buffer[i]);
+    if (self->object.ref_count > 0) {
+        return release__LilyInterpreterValueObject(&self->object);
     }
 
-    lily_free(self->buffer);
-    lily_free(self);
+    free__LilyInterpreterValueObject(&self->object);
 }
 
 CONSTRUCTOR(LilyInterpreterValueBytes *,
             LilyInterpreterValueBytes,
-            Uint8 *buffer,
+            const Uint8 *buffer,
             Usize len)
 {
     LilyInterpreterValueBytes *self =
-      lily_malloc(sizeof(LilyInterpreterValueBytes));
+      VALUE_ALLOC(sizeof(LilyInterpreterValueBytes));
 
     self->ref_count = 0;
-    self->buffer = buffer;
+    self->buffer = len > 0 ? VALUE_ALLOC(len) : NULL;
     self->len = len;
 
+    if (len > 0) {
+        memcpy(self->buffer, buffer, len);
+    }
+
     return self;
 }
 
@@ -332,7 +1022,11 @@ DESTRUCTOR(LilyInterpreterValueBytes, LilyInterpreterValueBytes *self)
         return;
     }
 
-    lily_free(self);
+    if (self->buffer) {
+        VALUE_FREE(self->buffer, self->len);
+    }
+
+    VALUE_FREE(self, sizeof(LilyInterpreterValueBytes));
 }
 
 CONSTRUCTOR(LilyInterpreterValueListNode *,
@@ -341,7 +1035,7 @@ CONSTRUCTOR(LilyInterpreterValueListNode *,
             struct LilyInterpreterValueListNode *next)
 {
     LilyInterpreterValueListNode *self =
-      lily_malloc(sizeof(LilyInterpreterValueListNode));
+      VALUE_ALLOC(sizeof(LilyInterpreterValueListNode));
 
     self->value = value;
     self->next = next;
@@ -354,10 +1048,10 @@ DESTRUCTOR(LilyInterpreterValueListNode, LilyInterpreterValueListNode *self)
     LilyInterpreterValueListNode *current = self;
 
     while (current) {
-        LilyInterpreterValueListNode *next = self->next;
+        LilyInterpreterValueListNode *next = current->next;
 
-        FREE(LilyInterpreterValue, &self->value);
-        lily_free(current);
+        FREE(LilyInterpreterValue, &current->value);
+        VALUE_FREE(current, sizeof(LilyInterpreterValueListNode));
 
         current = next;
     }
@@ -369,9 +1063,10 @@ CONSTRUCTOR(LilyInterpreterValueList *,
             LilyInterpreterValueListNode *tail)
 {
     LilyInterpreterValueList *self =
-      lily_malloc(sizeof(LilyInterpreterValueList));
+      alloc__LilyInterpreterValueObject(sizeof(LilyInterpreterValueList));
 
-    self->ref_count = 0;
+    self->object =
+      NEW(LilyInterpreterValueObject, LILY_INTERPRETER_VALUE_KIND_LIST);
     self->head = head;
     self->tail = tail;
 
@@ -380,14 +1075,11 @@ CONSTRUCTOR(LilyInterpreterValueList *,
 
 DESTRUCTOR(LilyInterpreterValueList, LilyInterpreterValueList *self)
 {
-    if (self->ref_count > 0) {
-        --self->ref_count;
-        return;
+    if (self->object.ref_count > 0) {
+        return release__LilyInterpreterValueObject(&self->object);
     }
 
-    FREE(LilyInterpreterValueListNode, self->head);
-
-    lily_free(self);
+    free__LilyInterpreterValueObject(&self->object);
 }
 
 VARIANT_CONSTRUCTOR(LilyInterpreterValueResult *,
@@ -396,10 +1088,11 @@ VARIANT_CONSTRUCTOR(LilyInterpreterValueResult *,
                     LilyInterpreterValue ok)
 {
     LilyInterpreterValueResult *self =
-      lily_malloc(sizeof(LilyInterpreterValueResult));
+      alloc__LilyInterpreterValueObject(sizeof(LilyInterpreterValueResult));
 
+    self->object =
+      NEW(LilyInterpreterValueObject, LILY_INTERPRETER_VALUE_KIND_RESULT);
     self->kind = LILY_INTERPRETER_VALUE_RESULT_KIND_OK;
-    self->ref_count = 0;
     self->ok = ok;
 
     return self;
@@ -411,10 +1104,11 @@ VARIANT_CONSTRUCTOR(LilyInterpreterValueResult *,
                     LilyInterpreterValue err)
 {
     LilyInterpreterValueResult *self =
-      lily_malloc(sizeof(LilyInterpreterValueResult));
+      alloc__LilyInterpreterValueObject(sizeof(LilyInterpreterValueResult));
 
+    self->object =
+      NEW(LilyInterpreterValueObject, LILY_INTERPRETER_VALUE_KIND_RESULT);
     self->kind = LILY_INTERPRETER_VALUE_RESULT_KIND_ERR;
-    self->ref_count = 0;
     self->err = err;
 
     return self;
@@ -422,37 +1116,28 @@ VARIANT_CONSTRUCTOR(LilyInterpreterValueResult *,
 
 DESTRUCTOR(LilyInterpreterValueResult, LilyInterpreterValueResult *self)
 {
-    if (self->ref_count > 0) {
-        --self->ref_count;
-        return;
+    if (self->object.ref_count > 0) {
+        return release__LilyInterpreterValueObject(&self->object);
     }
 
-    switch (self->kind) {
-        case LILY_INTERPRETER_VALUE_RESULT_KIND_OK:
-            FREE(LilyInterpreterValue, &self->ok);
-            break;
-        case LILY_INTERPRETER_VALUE_RESULT_KIND_ERR:
-            FREE(LilyInterpreterValue, &self->err);
-            break;
-        default:
-            UNREACHABLE("unknown variant");
-    }
-
-    lily_free(self);
+    free__LilyInterpreterValueObject(&self->object);
 }
 
 CONSTRUCTOR(LilyInterpreterValueStr *,
             LilyInterpreterValueStr,
-            char *s,
+            const char *s,
             Usize len)
 {
     LilyInterpreterValueStr *self =
-      lily_malloc(sizeof(LilyInterpreterValueStr));
+      VALUE_ALLOC(sizeof(LilyInterpreterValueStr));
 
     self->ref_count = 0;
-    self->s = s;
+    self->s = VALUE_ALLOC(len + 1);
     self->len = len;
 
+    memcpy(self->s, s, len);
+    self->s[len] = '\0';
+
     return self;
 }
 
@@ -463,7 +1148,8 @@ DESTRUCTOR(LilyInterpreterValueStr, LilyInterpreterValueStr *self)
         return;
     }
 
-    lily_free(self);
+    VALUE_FREE(self->s, self->len + 1);
+    VALUE_FREE(self, sizeof(LilyInterpreterValueStr));
 }
 
 CONSTRUCTOR(LilyInterpreterValueStruct *,
@@ -471,10 +1157,13 @@ CONSTRUCTOR(LilyInterpreterValueStruct *,
             LilyInterpreterValue *values,
             Usize len)
 {
+    // NOTE: The struct is allocated with exactly the number of its fields.
     LilyInterpreterValueStruct *self =
-      lily_malloc(sizeof(LilyInterpreterValueStruct));
+      alloc__LilyInterpreterValueObject(sizeof(LilyInterpreterValueStruct) +
+                                        sizeof(LilyInterpreterValue) * len);
 
-    self->ref_count = 0;
+    self->object =
+      NEW(LilyInterpreterValueObject, LILY_INTERPRETER_VALUE_KIND_STRUCT);
     self->len = len;
 
     for (Usize i = 0; i < len; ++i) {
@@ -492,14 +1181,9 @@ get__LilyInterpreterValueStruct(LilyInterpreterValueStruct *self, Usize n)
 
 DESTRUCTOR(LilyInterpreterValueStruct, LilyInterpreterValueStruct *self)
 {
-    if (self->ref_count > 0) {
-        --self->ref_count;
-        return;
-    }
-
-    for (Usize i = 0; i < self->len; ++i) {
-        FREE(LilyInterpreterValue, &self->values[i]);
+    if (self->object.ref_count > 0) {
+        return release__LilyInterpreterValueObject(&self->object);
     }
 
-    lily_free(self);
+    free__LilyInterpreterValueObject(&self->object);
 }
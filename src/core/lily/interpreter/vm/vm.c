@@ -24,8 +24,11 @@
 
 #include <core/lily/interpreter/vm.h>
 #include <core/lily/interpreter/vm/runtime.h>
+#include <core/lily/interpreter/vm/slot.h>
 #include <core/lily/interpreter/vm/vm.h>
 
+#include <string.h>
+
 // Stack-based VM
 
 #if defined(CLANG_VERSION) || defined(GCC_VERSION)
@@ -105,6 +108,40 @@ run_inst__LilyInterpreterVM(LilyInterpreterVM *self);
 static void
 run_insts__LilyInterpreterVM(LilyInterpreterVM *self);
 
+static LilyInterpreterValue
+run_bytecode__LilyInterpreterVM(LilyInterpreterVM *self,
+                                const LilyInterpreterVMBytecodeFun *fun,
+                                LilyInterpreterValue *regs);
+
+static void
+run_bytecode_entry_point__LilyInterpreterVM(LilyInterpreterVM *self);
+
+/**
+ *
+ * @brief Link the calls and the jumps of the instruction to the function or
+ * the block they target.
+ */
+static void
+link_inst__LilyInterpreterVM(const LilyMirModule *module,
+                             OrderedHashMap *fun_insts,
+                             LilyMirInstruction *inst);
+
+/**
+ *
+ * @brief Link every call and jump of the module, so that the VM runs them
+ * without looking up the function or the block by name.
+ */
+static void
+link__LilyInterpreterVM(const LilyMirModule *module);
+
+/**
+ *
+ * @brief Get the block instruction of the current function targeted by a
+ * jump.
+ */
+static inline LilyMirInstruction *
+get_block_inst__LilyInterpreterVM(const LilyMirInstructionBlock *block);
+
 static threadlocal OrderedHashMap *current_fun_insts = NULL;
 static threadlocal LilyMirInstructionBlock *current_block = NULL;
 static threadlocal VecIter current_block_inst_iter;
@@ -112,20 +149,22 @@ static threadlocal LilyMirInstruction *current_block_inst = NULL;
 static threadlocal LilyInterpreterVMStack local_stack;
 static threadlocal LilyInterpreterVMStackBlockFrame *current_block_frame = NULL;
 static threadlocal LilyInterpreterVMStackFrame *current_frame = NULL;
+// The freed frames are kept in this pool to be reused by the next calls.
+static threadlocal LilyInterpreterVMStackFrame *frame_pool = NULL;
 
 CONSTRUCTOR(LilyInterpreterVMStackBlockFrame *,
             LilyInterpreterVMStackBlockFrame,
             char *name,
             Usize begin,
             Usize end,
-            Usize limit_id)
+            Usize limit_id,
+            Usize slots_len)
 {
     LilyInterpreterVMStackBlockFrame *self =
       lily_malloc(sizeof(LilyInterpreterVMStackBlockFrame));
 
     self->names = init__Vec(1, name);
-    self->variables = NEW(HashMap);
-    self->regs = NEW(HashMap);
+    self->slots = slots_len ? lily_calloc(slots_len, PTR_SIZE) : NULL;
     self->begin = begin;
     self->end = end;
     self->limit_id = limit_id;
@@ -149,87 +188,40 @@ add_name__LilyInterpreterVMStackBlockFrame(
 }
 
 void
-add_reg__LilyInterpreterVMStackBlockFrame(
-  const LilyInterpreterVMStackBlockFrame *self,
-  char *name,
-  LilyInterpreterValue *value)
-{
-#ifdef LILY_FULL_ASSERT_VM
-    LilyInterpreterValue *duplicate_value =
-      insert__HashMap(self->regs, name, value);
-    ASSERT(!duplicate_value);
-#else
-    insert__HashMap(self->regs, name, value);
-#endif
-}
-
-void
-add_variable__LilyInterpreterVMStackBlockFrame(
+add_slot__LilyInterpreterVMStackBlockFrame(
   const LilyInterpreterVMStackBlockFrame *self,
-  char *name,
+  Usize slot,
   LilyInterpreterValue *value)
 {
 #ifdef LILY_FULL_ASSERT_VM
-    LilyInterpreterValue *duplicate_value =
-      insert__HashMap(self->variables, name, value);
-    ASSERT(!duplicate_value);
-#else
-    insert__HashMap(self->variables, name, value);
+    ASSERT(!self->slots[slot]);
 #endif
-}
 
-LilyInterpreterValue *
-search_reg__LilyInterpreterVMStackBlockFrame(
-  const LilyInterpreterVMStackBlockFrame *self,
-  char *name)
-{
-    LilyInterpreterValue *reg_value = get__HashMap(self->regs, name);
-
-    if (reg_value) {
-        return ref__LilyInterpreterValue(reg_value);
-    }
-
-#ifdef LILY_FULL_ASSERT_VM
-    if (self->parent) {
-        return search_reg__LilyInterpreterVMStackBlockFrame(self->parent, name);
-    }
-
-    UNREACHABLE("the parent is NULL, the reg is not found");
-#else
-    // NOTE: Technically, the function cannot return NULL.
-    return self->parent
-             ? search_reg__LilyInterpreterVMStackBlockFrame(self->parent, name)
-             : NULL;
-#endif
+    self->slots[slot] = value;
 }
 
 LilyInterpreterValue *
-search_variable__LilyInterpreterVMStackBlockFrame(
+search_slot__LilyInterpreterVMStackBlockFrame(
   const LilyInterpreterVMStackBlockFrame *self,
-  char *name)
+  Usize slot)
 {
 #ifdef LILY_FULL_ASSERT_VM
     ASSERT(self);
 #endif
 
-    LilyInterpreterValue *var_value = get__HashMap(self->variables, name);
+    do {
+        LilyInterpreterValue *value = self->slots[slot];
 
-    if (var_value) {
-        return ref__LilyInterpreterValue(var_value);
-    }
+        if (value) {
+            return ref__LilyInterpreterValue(value);
+        }
+    } while ((self = self->parent));
 
 #ifdef LILY_FULL_ASSERT_VM
-    if (self->parent) {
-        return search_variable__LilyInterpreterVMStackBlockFrame(self->parent,
-                                                                 name);
-    }
-
-    UNREACHABLE("the parent is NULL, the variable is not found");
+    UNREACHABLE("the parent is NULL, the reg or the variable is not found");
 #else
     // NOTE: Technically, the function cannot return NULL.
-    return self->parent ? search_variable__LilyInterpreterVMStackBlockFrame(
-                            self->parent, name)
-                        : NULL;
+    return NULL;
 #endif
 }
 
@@ -237,8 +229,11 @@ DESTRUCTOR(LilyInterpreterVMStackBlockFrame,
            LilyInterpreterVMStackBlockFrame **self)
 {
     FREE(Vec, (*self)->names);
-    FREE(HashMap, (*self)->variables);
-    FREE(HashMap, (*self)->regs);
+
+    if ((*self)->slots) {
+        lily_free((*self)->slots);
+    }
+
     lily_free(*self);
 
     *self = NULL;
@@ -251,18 +246,50 @@ CONSTRUCTOR(LilyInterpreterVMStackFrame *,
             Usize params_len,
             Usize begin,
             Usize current_block_frame_limit_id,
-            Usize block_frames_len)
+            Usize block_frames_len,
+            Usize slots_len)
 {
-    LilyInterpreterVMStackFrame *self =
-      lily_malloc(sizeof(LilyInterpreterVMStackFrame));
+    LilyInterpreterVMStackFrame *self = frame_pool;
+
+    // NOTE: The limit id of the caller's block is also used as an index of
+    // the block frames of the new frame, so it must fit in them.
+    if (current_block_frame_limit_id >= block_frames_len) {
+        block_frames_len = current_block_frame_limit_id + 1;
+    }
+
+    if (self) {
+        frame_pool = self->next;
+
+        if (self->params_capacity < params_len) {
+            self = lily_realloc(self,
+                                sizeof(LilyInterpreterVMStackFrame) +
+                                  PTR_SIZE * params_len);
+            self->params_capacity = params_len;
+        }
+
+        if (self->block_frames_capacity < block_frames_len) {
+            lily_free(self->block_frames);
+
+            self->block_frames = lily_calloc(block_frames_len, PTR_SIZE);
+            self->block_frames_capacity = block_frames_len;
+        } else {
+            memset(self->block_frames, 0, PTR_SIZE * block_frames_len);
+        }
+    } else {
+        self = lily_malloc(sizeof(LilyInterpreterVMStackFrame) +
+                           PTR_SIZE * params_len);
+        self->params_capacity = params_len;
+        self->block_frames = lily_calloc(block_frames_len, PTR_SIZE);
+        self->block_frames_capacity = block_frames_len;
+    }
 
     self->name = name;
     self->params_len = params_len;
     self->begin = begin;
     self->end = 0;
     self->current_block_frame_limit_id = current_block_frame_limit_id;
-    self->block_frames = lily_calloc(block_frames_len, PTR_SIZE);
     self->block_frames_len = block_frames_len;
+    self->slots_len = slots_len;
     self->next = NULL;
 
     for (Usize i = 0; i < self->params_len; ++i) {
@@ -299,7 +326,8 @@ add_block_frame__LilyInterpreterVMStackFrame(LilyInterpreterVMStackFrame *self,
                        name,
                        begin,
                        0,
-                       current_block_frame_limit_id);
+                       current_block_frame_limit_id,
+                       self->slots_len);
     } else {
         // Add name to the already created block frame.
         add_name__LilyInterpreterVMStackBlockFrame(*current, name);
@@ -323,7 +351,8 @@ attach_stack_frame__LilyInterpreterVMStackFrame(
   Usize params_len,
   Usize begin,
   Usize current_block_frame_limit_id,
-  Usize block_frames_len)
+  Usize block_frames_len,
+  Usize slots_len)
 {
     self->end = begin;
     self->next = NEW(LilyInterpreterVMStackFrame,
@@ -332,7 +361,8 @@ attach_stack_frame__LilyInterpreterVMStackFrame(
                      params_len,
                      begin,
                      current_block_frame_limit_id,
-                     block_frames_len);
+                     block_frames_len,
+                     slots_len);
 
     return self->next;
 }
@@ -356,20 +386,38 @@ DESTRUCTOR(LilyInterpreterVMStackFrame, LilyInterpreterVMStackFrame **self)
         FREE(LilyInterpreterValue, &value);
     }
 
-    lily_free((*self)->block_frames);
-    lily_free(*self);
+    // Put the frame in the pool.
+    (*self)->next = frame_pool;
+    frame_pool = *self;
 
     *self = NULL;
 }
 
-CONSTRUCTOR(LilyInterpreterVMStack, LilyInterpreterVMStack, Usize max_capacity)
+void
+free_frame_pool__LilyInterpreterVMStackFrame()
 {
-    Usize mc = max_capacity == 0 ? DEFAULT_MAX_STACK_CAPACITY : max_capacity;
+    while (frame_pool) {
+        LilyInterpreterVMStackFrame *next = frame_pool->next;
 
-    return (LilyInterpreterVMStack){ .buffer = __alloc__$Alloc(mc, 0),
-                                     .current_frame = NULL,
-                                     .max_capacity = mc,
-                                     .len = 0 };
+        lily_free(frame_pool->block_frames);
+        lily_free(frame_pool);
+
+        frame_pool = next;
+    }
+}
+
+CONSTRUCTOR(LilyInterpreterVMStack, LilyInterpreterVMStack, Usize max_capacity)
+{
+    // NOTE: The max capacity is passed in bytes.
+    Usize mc = (max_capacity == 0 ? DEFAULT_MAX_STACK_CAPACITY : max_capacity) /
+               sizeof(LilyInterpreterValue);
+
+    return (LilyInterpreterVMStack){
+        .buffer = __alloc__$Alloc(mc * sizeof(LilyInterpreterValue), 0),
+        .current_frame = NULL,
+        .max_capacity = mc,
+        .len = 0
+    };
 }
 
 void
@@ -452,7 +500,93 @@ DESTRUCTOR(LilyInterpreterVMStack, LilyInterpreterVMStack *self)
         FREE(LilyInterpreterValue, &value);
     }
 
-    __free__$Alloc((void **)&self->buffer, self->max_capacity, 0);
+    __free__$Alloc((void **)&self->buffer,
+                   self->max_capacity * sizeof(LilyInterpreterValue),
+                   0);
+}
+
+void
+link_inst__LilyInterpreterVM(const LilyMirModule *module,
+                             OrderedHashMap *fun_insts,
+                             LilyMirInstruction *inst)
+{
+    if (!inst) {
+        return;
+    }
+
+    switch (inst->kind) {
+        case LILY_MIR_INSTRUCTION_KIND_CALL: {
+            LilyMirInstruction *fun =
+              get__OrderedHashMap(module->insts, (char *)inst->call.name);
+
+            // NOTE: A prototype is not linked, the call keeps the lookup by
+            // name.
+            if (fun && fun->kind == LILY_MIR_INSTRUCTION_KIND_FUN) {
+                inst->call.fun = fun;
+            }
+
+            break;
+        }
+        case LILY_MIR_INSTRUCTION_KIND_JMP:
+            inst->jmp->inst =
+              get__OrderedHashMap(fun_insts, (char *)inst->jmp->name);
+            break;
+        case LILY_MIR_INSTRUCTION_KIND_JMPCOND:
+            inst->jmpcond.then_block->inst = get__OrderedHashMap(
+              fun_insts, (char *)inst->jmpcond.then_block->name);
+            inst->jmpcond.else_block->inst = get__OrderedHashMap(
+              fun_insts, (char *)inst->jmpcond.else_block->name);
+            break;
+        case LILY_MIR_INSTRUCTION_KIND_NON_NIL:
+            return link_inst__LilyInterpreterVM(
+              module, fun_insts, inst->non_nil);
+        case LILY_MIR_INSTRUCTION_KIND_REG:
+            return link_inst__LilyInterpreterVM(
+              module, fun_insts, inst->reg.inst);
+        case LILY_MIR_INSTRUCTION_KIND_RET:
+            return link_inst__LilyInterpreterVM(module, fun_insts, inst->ret);
+        case LILY_MIR_INSTRUCTION_KIND_VAR:
+            return link_inst__LilyInterpreterVM(
+              module, fun_insts, inst->var.inst);
+        default:
+            break;
+    }
+}
+
+void
+link__LilyInterpreterVM(const LilyMirModule *module)
+{
+    OrderedHashMapIter iter = NEW(OrderedHashMapIter, module->insts);
+    LilyMirInstruction *inst = NULL;
+
+    while ((inst = next__OrderedHashMapIter(&iter))) {
+        if (inst->kind != LILY_MIR_INSTRUCTION_KIND_FUN) {
+            continue;
+        }
+
+        OrderedHashMapIter block_iter =
+          NEW(OrderedHashMapIter, inst->fun.insts);
+        LilyMirInstruction *block_inst = NULL;
+
+        while ((block_inst = next__OrderedHashMapIter(&block_iter))) {
+            ASSERT(block_inst->kind == LILY_MIR_INSTRUCTION_KIND_BLOCK);
+
+            for (Usize i = 0; i < block_inst->block.insts->len; ++i) {
+                link_inst__LilyInterpreterVM(
+                  module,
+                  inst->fun.insts,
+                  get__Vec(block_inst->block.insts, i));
+            }
+        }
+    }
+}
+
+LilyMirInstruction *
+get_block_inst__LilyInterpreterVM(const LilyMirInstructionBlock *block)
+{
+    return block->inst
+             ? block->inst
+             : get__OrderedHashMap(current_fun_insts, (char *)block->name);
 }
 
 CONSTRUCTOR(LilyInterpreterVM,
@@ -475,6 +609,12 @@ CONSTRUCTOR(LilyInterpreterVM,
     ASSERT(entry_point->kind == LILY_MIR_INSTRUCTION_KIND_FUN);
     ASSERT(entry_point->fun.insts->len >= 1);
 
+    resolve__LilyInterpreterVMSlot(module);
+    link__LilyInterpreterVM(module);
+
+    LilyInterpreterVMBytecodeModule *bytecode =
+      lower__LilyInterpreterVMBytecodeModule(module);
+
     VM_SET_CURRENT_FUN_INSTS(entry_point->fun.insts);
 
     {
@@ -509,12 +649,12 @@ CONSTRUCTOR(LilyInterpreterVM,
       &local_stack,
       NEW(LilyInterpreterVMStackFrame,
           entry_point->fun.name,
-          (LilyInterpreterValue *[MAX_FUN_PARAMS]){ argc_value_ref,
-                                                    argv_value_ref },
+          (LilyInterpreterValue *[]){ argc_value_ref, argv_value_ref },
           2,
           local_stack.len,
           current_block->limit->id,
-          entry_point->fun.insts->len));
+          entry_point->fun.block_count,
+          entry_point->fun.slots_len));
     add_block_frame__LilyInterpreterVMStackFrame(current_frame,
                                                  current_block->limit->id,
                                                  (char *)current_block->name,
@@ -528,6 +668,7 @@ CONSTRUCTOR(LilyInterpreterVM,
     return (LilyInterpreterVM){ .memory = memory,
                                 .module = module,
                                 .entry_point = entry_point,
+                                .bytecode = bytecode,
                                 .resources = resources,
                                 .check_overflow = check_overflow };
 }
@@ -601,8 +742,8 @@ push_value__LilyInterpreterVM(LilyInterpreterVM *self,
               *ref__LilyInterpreterValue(current_frame->params[val->param]));
         case LILY_MIR_INSTRUCTION_VAL_KIND_REG:
             return VM_PUSH(&local_stack,
-                           *search_reg__LilyInterpreterVMStackBlockFrame(
-                             current_block_frame, (char *)val->reg));
+                           *search_slot__LilyInterpreterVMStackBlockFrame(
+                             current_block_frame, val->slot));
         case LILY_MIR_INSTRUCTION_VAL_KIND_SLICE:
             TODO("push slice");
         case LILY_MIR_INSTRUCTION_VAL_KIND_STR:
@@ -659,8 +800,8 @@ push_value__LilyInterpreterVM(LilyInterpreterVM *self,
         case LILY_MIR_INSTRUCTION_VAL_KIND_VAR:
             // Bring and back to the front the var value.
             return VM_PUSH(&local_stack,
-                           *search_variable__LilyInterpreterVMStackBlockFrame(
-                             current_block_frame, (char *)val->var));
+                           *search_slot__LilyInterpreterVMStackBlockFrame(
+                             current_block_frame, val->slot));
         default:
             UNREACHABLE("unknown variant");
     }
@@ -1462,8 +1603,11 @@ run_inst__LilyInterpreterVM(LilyInterpreterVM *self)
         LilyInterpreterVMStackBlockFrame *last_current_block_frame =
           current_block_frame;
         // TODO: Manage function prototype.
-        LilyMirInstruction *fun_inst = get__OrderedHashMap(
-          self->module->insts, (char *)last_current_block_inst->call.name);
+        LilyMirInstruction *fun_inst =
+          last_current_block_inst->call.fun
+            ? last_current_block_inst->call.fun
+            : get__OrderedHashMap(self->module->insts,
+                                  (char *)last_current_block_inst->call.name);
         LilyInterpreterVMStackFrame *last_current_frame = current_frame;
 
 #ifdef LILY_FULL_ASSERT_VM
@@ -1512,7 +1656,8 @@ run_inst__LilyInterpreterVM(LilyInterpreterVM *self)
           params_len,
           stack->len,
           current_block->limit->id,
-          fun_inst->fun.insts->len));
+          fun_inst->fun.block_count,
+          fun_inst->fun.slots_len));
 
         add_block_frame__LilyInterpreterVMStackFrame(
           current_frame,
@@ -3707,8 +3852,8 @@ run_inst__LilyInterpreterVM(LilyInterpreterVM *self)
     VM_INST(LILY_MIR_INSTRUCTION_KIND_JMP)
     {
         LilyMirInstructionBlock *last_block = current_block;
-        LilyMirInstruction *new_current_block_inst = get__OrderedHashMap(
-          current_fun_insts, (char *)current_block_inst->jmp->name);
+        LilyMirInstruction *new_current_block_inst =
+          get_block_inst__LilyInterpreterVM(current_block_inst->jmp);
 
         VM_SET_CURRENT_BLOCK(&new_current_block_inst->block);
         VM_SET_CURRENT_BLOCK_INST_ITER(
@@ -3745,13 +3890,11 @@ run_inst__LilyInterpreterVM(LilyInterpreterVM *self)
 #endif
 
         if (cond.kind) {
-            new_current_block_inst = get__OrderedHashMap(
-              current_fun_insts,
-              (char *)current_block_inst->jmpcond.then_block->name);
+            new_current_block_inst = get_block_inst__LilyInterpreterVM(
+              current_block_inst->jmpcond.then_block);
         } else {
-            new_current_block_inst = get__OrderedHashMap(
-              current_fun_insts,
-              (char *)current_block_inst->jmpcond.else_block->name);
+            new_current_block_inst = get_block_inst__LilyInterpreterVM(
+              current_block_inst->jmpcond.else_block);
         }
 
         FREE(LilyInterpreterValue, &cond);
@@ -3828,7 +3971,7 @@ run_inst__LilyInterpreterVM(LilyInterpreterVM *self)
 
     VM_INST(LILY_MIR_INSTRUCTION_KIND_REG)
     {
-        char *reg_name = (char *)current_block_inst->reg.name;
+        Usize reg_slot = current_block_inst->reg.slot;
 
         SET_NEXT_LABEL(reg_finish);
 
@@ -3836,8 +3979,8 @@ run_inst__LilyInterpreterVM(LilyInterpreterVM *self)
         VM_GOTO_INST(current_block_inst);
 
     reg_finish: {
-        add_reg__LilyInterpreterVMStackBlockFrame(
-          current_block_frame, reg_name, VM_PEEK(stack));
+        add_slot__LilyInterpreterVMStackBlockFrame(
+          current_block_frame, reg_slot, VM_PEEK(stack));
         EAT_NEXT_LABEL();
     }
     }
@@ -4202,9 +4345,8 @@ run_inst__LilyInterpreterVM(LilyInterpreterVM *self)
 
         switch (current_block_inst->store.dest->kind) {
             case LILY_MIR_INSTRUCTION_VAL_KIND_VAR:
-                dest_value = search_variable__LilyInterpreterVMStackBlockFrame(
-                  current_block_frame,
-                  (char *)current_block_inst->store.dest->var);
+                dest_value = search_slot__LilyInterpreterVMStackBlockFrame(
+                  current_block_frame, current_block_inst->store.dest->slot);
                 break;
             default:
                 UNREACHABLE("expected a valid destination value, like var");
@@ -4366,14 +4508,14 @@ run_inst__LilyInterpreterVM(LilyInterpreterVM *self)
 
     VM_INST(LILY_MIR_INSTRUCTION_KIND_VAR)
     {
-        char *name = current_block_inst->var.name;
+        Usize slot = current_block_inst->var.slot;
 
         LilyInterpreterValue value =
           NEW(LilyInterpreterValue, LILY_INTERPRETER_VALUE_KIND_UNDEF);
 
         VM_PUSH(stack, value);
-        add_variable__LilyInterpreterVMStackBlockFrame(
-          current_block_frame, name, VM_PEEK(stack));
+        add_slot__LilyInterpreterVMStackBlockFrame(
+          current_block_frame, slot, VM_PEEK(stack));
 
         SET_NEXT_LABEL(var_finish);
 
@@ -4553,6 +4695,741 @@ run_inst__LilyInterpreterVM(LilyInterpreterVM *self)
     VM_END();
 }
 
+#define BYTECODE_RK(operand)                                              \
+    ((operand) & LILY_INTERPRETER_VM_BYTECODE_RK_CONST                    \
+       ? &fun->consts[(operand) & ~LILY_INTERPRETER_VM_BYTECODE_RK_CONST] \
+       : &regs[operand])
+
+// X(value_kind, field, type, ...)
+#define BYTECODE_INT_KINDS(X, ...)                                     \
+    X(LILY_INTERPRETER_VALUE_KIND_INT8, int8, Int8, __VA_ARGS__)       \
+    X(LILY_INTERPRETER_VALUE_KIND_INT16, int16, Int16, __VA_ARGS__)    \
+    X(LILY_INTERPRETER_VALUE_KIND_INT32, int32, Int32, __VA_ARGS__)    \
+    X(LILY_INTERPRETER_VALUE_KIND_INT64, int64, Int64, __VA_ARGS__)    \
+    X(LILY_INTERPRETER_VALUE_KIND_ISIZE, isize, Isize, __VA_ARGS__)    \
+    X(LILY_INTERPRETER_VALUE_KIND_UINT8, uint8, Uint8, __VA_ARGS__)    \
+    X(LILY_INTERPRETER_VALUE_KIND_UINT16, uint16, Uint16, __VA_ARGS__) \
+    X(LILY_INTERPRETER_VALUE_KIND_UINT32, uint32, Uint32, __VA_ARGS__) \
+    X(LILY_INTERPRETER_VALUE_KIND_UINT64, uint64, Uint64, __VA_ARGS__) \
+    X(LILY_INTERPRETER_VALUE_KIND_USIZE, usize, Usize, __VA_ARGS__)
+
+#define BYTECODE_BINARY_CASE(value_kind, field, type, op)                     \
+    case value_kind:                                                          \
+        regs[inst->x] =                                                       \
+          NEW_VARIANT(LilyInterpreterValue, field, lhs->field op rhs->field); \
+        break;
+
+#define BYTECODE_BINARY_OVERFLOW_CASE(value_kind, field, type, op, name) \
+    case value_kind:                                                     \
+        regs[inst->x] = NEW_VARIANT(                                     \
+          LilyInterpreterValue,                                          \
+          field,                                                         \
+          self->check_overflow                                           \
+            ? name##_with_overflow__##type(lhs->field, rhs->field)       \
+            : lhs->field op rhs->field);                                 \
+        break;
+
+#define BYTECODE_CMP_CASE(value_kind, field, type, op)                       \
+    case value_kind:                                                         \
+        regs[inst->x] = NEW(LilyInterpreterValue, lhs->field op rhs->field); \
+        break;
+
+#define BYTECODE_UNARY_CASE(value_kind, field, type, op)           \
+    case value_kind:                                               \
+        regs[inst->x] =                                            \
+          NEW_VARIANT(LilyInterpreterValue, field, op src->field); \
+        break;
+
+#define BYTECODE_BINARY_START()                             \
+    const LilyInterpreterValue *lhs = BYTECODE_RK(inst->y); \
+    const LilyInterpreterValue *rhs = BYTECODE_RK(inst->z);
+
+#ifdef LILY_FULL_ASSERT_VM
+#define BYTECODE_ASSERT_KIND(value_kind) \
+    ASSERT(lhs->kind == value_kind && rhs->kind == value_kind);
+#else
+#define BYTECODE_ASSERT_KIND(value_kind)
+#endif
+
+// Rewrite the generic instruction to its typed form (quickening), so the next
+// executions of this instruction don't dispatch on the kind of the operands.
+#define BYTECODE_QUICKEN()                                            \
+    inst->opcode = get_typed_opcode__LilyInterpreterVMBytecodeOpcode( \
+      inst->opcode, lhs->kind);
+
+// NOTE: The kind and the value of the register are written separately, so the
+// result doesn't need to be built in a temporary LilyInterpreterValue.
+#define BYTECODE_TYPED_INST(name, value_kind, field, result) \
+    BYTECODE_INST(name)                                      \
+    {                                                        \
+        BYTECODE_BINARY_START();                             \
+        BYTECODE_ASSERT_KIND(value_kind);                    \
+                                                             \
+        regs[inst->x].field = result;                        \
+        regs[inst->x].kind = value_kind;                     \
+                                                             \
+        BYTECODE_NEXT();                                     \
+    }
+
+#define BYTECODE_TYPED_CMP_INST(name, value_kind, field, op) \
+    BYTECODE_INST(name)                                      \
+    {                                                        \
+        BYTECODE_BINARY_START();                             \
+        BYTECODE_ASSERT_KIND(value_kind);                    \
+                                                             \
+        regs[inst->x].kind = lhs->field op rhs->field;       \
+                                                             \
+        BYTECODE_NEXT();                                     \
+    }
+
+#define BYTECODE_TYPED_OVERFLOW_INSTS(name, op, overflow_name)            \
+    BYTECODE_TYPED_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_##name##_F64, \
+                        LILY_INTERPRETER_VALUE_KIND_FLOAT,                \
+                        float_,                                           \
+                        lhs->float_ op rhs->float_)                       \
+    BYTECODE_TYPED_INST(                                                  \
+      LILY_INTERPRETER_VM_BYTECODE_OPCODE_##name##_I32,                   \
+      LILY_INTERPRETER_VALUE_KIND_INT32,                                  \
+      int32,                                                              \
+      self->check_overflow                                                \
+        ? overflow_name##_with_overflow__Int32(lhs->int32, rhs->int32)    \
+        : lhs->int32 op rhs->int32)                                       \
+    BYTECODE_TYPED_INST(                                                  \
+      LILY_INTERPRETER_VM_BYTECODE_OPCODE_##name##_I64,                   \
+      LILY_INTERPRETER_VALUE_KIND_INT64,                                  \
+      int64,                                                              \
+      self->check_overflow                                                \
+        ? overflow_name##_with_overflow__Int64(lhs->int64, rhs->int64)    \
+        : lhs->int64 op rhs->int64)
+
+// NOTE: The result of a comparison is stored in the kind of the register
+// (LILY_INTERPRETER_VALUE_KIND_FALSE or LILY_INTERPRETER_VALUE_KIND_TRUE).
+#define BYTECODE_TYPED_CMP_INSTS(name, op)                                    \
+    BYTECODE_TYPED_CMP_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_##name##_F64, \
+                            LILY_INTERPRETER_VALUE_KIND_FLOAT,                \
+                            float_,                                           \
+                            op)                                               \
+    BYTECODE_TYPED_CMP_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_##name##_I32, \
+                            LILY_INTERPRETER_VALUE_KIND_INT32,                \
+                            int32,                                            \
+                            op)                                               \
+    BYTECODE_TYPED_CMP_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_##name##_I64, \
+                            LILY_INTERPRETER_VALUE_KIND_INT64,                \
+                            int64,                                            \
+                            op)
+
+#ifdef LILY_USE_COMPUTED_GOTOS
+#define BYTECODE_START() BYTECODE_NEXT();
+#define BYTECODE_INST(name) label__##name:
+#define BYTECODE_NEXT()       \
+    inst = &fun->insts[pc++]; \
+    goto *opcode_lookup[inst->opcode];
+#define BYTECODE_END()
+#else
+#define BYTECODE_START()          \
+    for (;;) {                    \
+        inst = &fun->insts[pc++]; \
+        switch (inst->opcode) {
+#define BYTECODE_INST(name) case name:
+#define BYTECODE_NEXT() continue;
+#define BYTECODE_END()                          \
+    default:                                    \
+        UNREACHABLE("unknown bytecode opcode"); \
+        }                                       \
+        }
+#endif
+
+LilyInterpreterValue
+run_bytecode__LilyInterpreterVM(LilyInterpreterVM *self,
+                                const LilyInterpreterVMBytecodeFun *fun,
+                                LilyInterpreterValue *regs)
+{
+#ifdef LILY_USE_COMPUTED_GOTOS
+    static void *opcode_lookup[] = {
+#define BYTECODE_LABEL(name) [name] = &&label__##name
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_ADD),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_ADD_F64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_ADD_I32),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_ADD_I64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_BITAND),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_BITNOT),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_BITOR),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_CALL),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_DIV),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_DIV_F64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_DIV_I32),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_DIV_I64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_EQ),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_EQ_F64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_EQ_I32),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_EQ_I64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_GE),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_GE_F64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_GE_I32),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_GE_I64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_GT),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_GT_F64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_GT_I32),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_GT_I64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_JMP),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_JMPCOND),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_LE),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_LE_F64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_LE_I32),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_LE_I64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_LT),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_LT_F64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_LT_I32),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_LT_I64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_MOVE),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_MUL),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_MUL_F64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_MUL_I32),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_MUL_I64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_NE),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_NE_F64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_NE_I32),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_NE_I64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_NEG),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_NOT),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_REM),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_REM_F64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_REM_I32),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_REM_I64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_RET),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SHL),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SHR),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SUB),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SUB_F64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SUB_I32),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SUB_I64),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SYS_CALL),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_UNREACHABLE),
+        BYTECODE_LABEL(LILY_INTERPRETER_VM_BYTECODE_OPCODE_XOR),
+#undef BYTECODE_LABEL
+    };
+#endif
+
+    LilyInterpreterVMBytecodeInst *inst = NULL;
+    Usize pc = 0;
+
+    BYTECODE_START();
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_ADD)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_BINARY_OVERFLOW_CASE, +, add)
+            case LILY_INTERPRETER_VALUE_KIND_FLOAT:
+                regs[inst->x] = NEW_VARIANT(
+                  LilyInterpreterValue, float, lhs->float_ + rhs->float_);
+                break;
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint* or Float");
+        }
+
+        BYTECODE_QUICKEN();
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_BITAND)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_BINARY_CASE, &)
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint*");
+        }
+
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_BITNOT)
+    {
+        const LilyInterpreterValue *src = BYTECODE_RK(inst->y);
+
+        switch (src->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_UNARY_CASE, ~)
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint*");
+        }
+
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_BITOR)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_BINARY_CASE, |)
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint*");
+        }
+
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_CALL)
+    {
+        const LilyInterpreterVMBytecodeFun *callee =
+          get__Vec(self->bytecode->funs, inst->y);
+        Usize frame_begin = local_stack.len;
+
+        if (frame_begin + callee->regs_len > local_stack.max_capacity) {
+            RUNTIME_ERROR_STACK_OVERFLOW();
+        }
+
+        // NOTE: The registers of the callee are allocated on the stack, and
+        // the arguments are copied from the temporary registers of the caller.
+        LilyInterpreterValue *callee_regs = &local_stack.buffer[frame_begin];
+
+        memcpy(callee_regs,
+               &regs[inst->z],
+               sizeof(LilyInterpreterValue) * callee->params_len);
+
+        local_stack.len += callee->regs_len;
+        regs[inst->x] =
+          run_bytecode__LilyInterpreterVM(self, callee, callee_regs);
+        local_stack.len = frame_begin;
+
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_DIV)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_BINARY_OVERFLOW_CASE, /, div)
+            case LILY_INTERPRETER_VALUE_KIND_FLOAT:
+                regs[inst->x] = NEW_VARIANT(
+                  LilyInterpreterValue, float, lhs->float_ / rhs->float_);
+                break;
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint* or Float");
+        }
+
+        BYTECODE_QUICKEN();
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_EQ)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_CMP_CASE, ==)
+            case LILY_INTERPRETER_VALUE_KIND_FALSE:
+            case LILY_INTERPRETER_VALUE_KIND_TRUE:
+                regs[inst->x] =
+                  NEW(LilyInterpreterValue, lhs->kind == rhs->kind);
+                break;
+            case LILY_INTERPRETER_VALUE_KIND_FLOAT:
+                regs[inst->x] =
+                  NEW(LilyInterpreterValue, lhs->float_ == rhs->float_);
+                break;
+            default:
+                RUNTIME_ERROR_UNREACHABLE(
+                  "expected Int* or Uint* or Float or Bool");
+        }
+
+        BYTECODE_QUICKEN();
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_GE)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_CMP_CASE, >=)
+            case LILY_INTERPRETER_VALUE_KIND_FLOAT:
+                regs[inst->x] =
+                  NEW(LilyInterpreterValue, lhs->float_ >= rhs->float_);
+                break;
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint* or Float");
+        }
+
+        BYTECODE_QUICKEN();
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_GT)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_CMP_CASE, >)
+            case LILY_INTERPRETER_VALUE_KIND_FLOAT:
+                regs[inst->x] =
+                  NEW(LilyInterpreterValue, lhs->float_ > rhs->float_);
+                break;
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint* or Float");
+        }
+
+        BYTECODE_QUICKEN();
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_JMP)
+    {
+        pc = inst->y;
+
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_JMPCOND)
+    {
+        pc = BYTECODE_RK(inst->x)->kind == LILY_INTERPRETER_VALUE_KIND_TRUE
+               ? inst->y
+               : inst->z;
+
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_LE)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_CMP_CASE, <=)
+            case LILY_INTERPRETER_VALUE_KIND_FLOAT:
+                regs[inst->x] =
+                  NEW(LilyInterpreterValue, lhs->float_ <= rhs->float_);
+                break;
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint* or Float");
+        }
+
+        BYTECODE_QUICKEN();
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_LT)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_CMP_CASE, <)
+            case LILY_INTERPRETER_VALUE_KIND_FLOAT:
+                regs[inst->x] =
+                  NEW(LilyInterpreterValue, lhs->float_ < rhs->float_);
+                break;
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint* or Float");
+        }
+
+        BYTECODE_QUICKEN();
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_MOVE)
+    {
+        regs[inst->x] = *BYTECODE_RK(inst->y);
+
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_MUL)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_BINARY_OVERFLOW_CASE, *, mul)
+            case LILY_INTERPRETER_VALUE_KIND_FLOAT:
+                regs[inst->x] = NEW_VARIANT(
+                  LilyInterpreterValue, float, lhs->float_ * rhs->float_);
+                break;
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint* or Float");
+        }
+
+        BYTECODE_QUICKEN();
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_NE)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_CMP_CASE, !=)
+            case LILY_INTERPRETER_VALUE_KIND_FALSE:
+            case LILY_INTERPRETER_VALUE_KIND_TRUE:
+                regs[inst->x] =
+                  NEW(LilyInterpreterValue, lhs->kind != rhs->kind);
+                break;
+            case LILY_INTERPRETER_VALUE_KIND_FLOAT:
+                regs[inst->x] =
+                  NEW(LilyInterpreterValue, lhs->float_ != rhs->float_);
+                break;
+            default:
+                RUNTIME_ERROR_UNREACHABLE(
+                  "expected Int* or Uint* or Float or Bool");
+        }
+
+        BYTECODE_QUICKEN();
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_NEG)
+    {
+        const LilyInterpreterValue *src = BYTECODE_RK(inst->y);
+
+        switch (src->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_UNARY_CASE, -)
+            case LILY_INTERPRETER_VALUE_KIND_FLOAT:
+                regs[inst->x] =
+                  NEW_VARIANT(LilyInterpreterValue, float, -src->float_);
+                break;
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint* or Float");
+        }
+
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_NOT)
+    {
+        regs[inst->x] = NEW(LilyInterpreterValue,
+                            BYTECODE_RK(inst->y)->kind ==
+                              LILY_INTERPRETER_VALUE_KIND_FALSE);
+
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_REM)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_BINARY_CASE, %)
+            case LILY_INTERPRETER_VALUE_KIND_FLOAT:
+                regs[inst->x] =
+                  NEW_VARIANT(LilyInterpreterValue,
+                              float,
+                              mod__Float64(lhs->float_, rhs->float_));
+                break;
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint* or Float");
+        }
+
+        BYTECODE_QUICKEN();
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_RET)
+    {
+        return *BYTECODE_RK(inst->y);
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SHL)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_BINARY_CASE, <<)
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint*");
+        }
+
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SHR)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_BINARY_CASE, >>)
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint*");
+        }
+
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SUB)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_BINARY_CASE, -)
+            case LILY_INTERPRETER_VALUE_KIND_FLOAT:
+                regs[inst->x] = NEW_VARIANT(
+                  LilyInterpreterValue, float, lhs->float_ - rhs->float_);
+                break;
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint* or Float");
+        }
+
+        BYTECODE_QUICKEN();
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SYS_CALL)
+    {
+        LilyInterpreterValue *params = &regs[inst->z];
+
+        switch (inst->y) {
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_READ:
+                regs[inst->x] = read__LilyInterpreterVMRuntimeSys(
+                  params[0], params[1], params[2]);
+                break;
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_WRITE:
+                regs[inst->x] = write__LilyInterpreterVMRuntimeSys(
+                  params[0], params[1], params[2]);
+                break;
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_OPEN:
+                regs[inst->x] = open__LilyInterpreterVMRuntimeSys(
+                  params[0], params[1], params[2]);
+                break;
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_CLOSE:
+                regs[inst->x] = close__LilyInterpreterVMRuntimeSys(params[0]);
+                break;
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_MODE:
+                regs[inst->x] =
+                  stat_mode__LilyInterpreterVMRuntimeSys(params[0]);
+                break;
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_INO:
+                regs[inst->x] =
+                  stat_ino__LilyInterpreterVMRuntimeSys(params[0]);
+                break;
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_DEV:
+                regs[inst->x] =
+                  stat_dev__LilyInterpreterVMRuntimeSys(params[0]);
+                break;
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_NLINK:
+                regs[inst->x] =
+                  stat_nlink__LilyInterpreterVMRuntimeSys(params[0]);
+                break;
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_UID:
+                regs[inst->x] =
+                  stat_uid__LilyInterpreterVMRuntimeSys(params[0]);
+                break;
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_GID:
+                regs[inst->x] =
+                  stat_gid__LilyInterpreterVMRuntimeSys(params[0]);
+                break;
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_SIZE:
+                regs[inst->x] =
+                  stat_size__LilyInterpreterVMRuntimeSys(params[0]);
+                break;
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_ATIME:
+                regs[inst->x] =
+                  stat_atime__LilyInterpreterVMRuntimeSys(params[0]);
+                break;
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_MTIME:
+                regs[inst->x] =
+                  stat_mtime__LilyInterpreterVMRuntimeSys(params[0]);
+                break;
+            case LILY_INTERPRETER_VM_BYTECODE_SYS_CALL_STAT_CTIME:
+                regs[inst->x] =
+                  stat_ctime__LilyInterpreterVMRuntimeSys(params[0]);
+                break;
+            default:
+                UNREACHABLE("unknown sys call");
+        }
+
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_UNREACHABLE)
+    {
+        abort();
+    }
+
+    BYTECODE_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_XOR)
+    {
+        BYTECODE_BINARY_START();
+
+        switch (lhs->kind) {
+            BYTECODE_INT_KINDS(BYTECODE_BINARY_CASE, ^)
+            default:
+                RUNTIME_ERROR_UNREACHABLE("expected Int* or Uint*");
+        }
+
+        BYTECODE_NEXT();
+    }
+
+    BYTECODE_TYPED_OVERFLOW_INSTS(ADD, +, add)
+    BYTECODE_TYPED_OVERFLOW_INSTS(DIV, /, div)
+    BYTECODE_TYPED_OVERFLOW_INSTS(MUL, *, mul)
+
+    BYTECODE_TYPED_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_REM_F64,
+                        LILY_INTERPRETER_VALUE_KIND_FLOAT,
+                        float_,
+                        mod__Float64(lhs->float_, rhs->float_))
+    BYTECODE_TYPED_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_REM_I32,
+                        LILY_INTERPRETER_VALUE_KIND_INT32,
+                        int32,
+                        lhs->int32 % rhs->int32)
+    BYTECODE_TYPED_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_REM_I64,
+                        LILY_INTERPRETER_VALUE_KIND_INT64,
+                        int64,
+                        lhs->int64 % rhs->int64)
+
+    BYTECODE_TYPED_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SUB_F64,
+                        LILY_INTERPRETER_VALUE_KIND_FLOAT,
+                        float_,
+                        lhs->float_ - rhs->float_)
+    BYTECODE_TYPED_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SUB_I32,
+                        LILY_INTERPRETER_VALUE_KIND_INT32,
+                        int32,
+                        lhs->int32 - rhs->int32)
+    BYTECODE_TYPED_INST(LILY_INTERPRETER_VM_BYTECODE_OPCODE_SUB_I64,
+                        LILY_INTERPRETER_VALUE_KIND_INT64,
+                        int64,
+                        lhs->int64 - rhs->int64)
+
+    BYTECODE_TYPED_CMP_INSTS(EQ, ==)
+    BYTECODE_TYPED_CMP_INSTS(GE, >=)
+    BYTECODE_TYPED_CMP_INSTS(GT, >)
+    BYTECODE_TYPED_CMP_INSTS(LE, <=)
+    BYTECODE_TYPED_CMP_INSTS(LT, <)
+    BYTECODE_TYPED_CMP_INSTS(NE, !=)
+
+    BYTECODE_END();
+}
+
+void
+run_bytecode_entry_point__LilyInterpreterVM(LilyInterpreterVM *self)
+{
+    const LilyInterpreterVMBytecodeFun *entry_point =
+      self->bytecode->entry_point;
+    Usize frame_begin = local_stack.len;
+
+    ASSERT(entry_point->params_len <= current_frame->params_len);
+
+    if (frame_begin + entry_point->regs_len > local_stack.max_capacity) {
+        RUNTIME_ERROR_STACK_OVERFLOW();
+    }
+
+    LilyInterpreterValue *regs = &local_stack.buffer[frame_begin];
+
+    // NOTE: The params of the main function (argc and argv) are already pushed
+    // on the stack by the constructor of the VM.
+    for (Usize i = 0; i < entry_point->params_len; ++i) {
+        regs[i] = *current_frame->params[i];
+    }
+
+    local_stack.len += entry_point->regs_len;
+
+    LilyInterpreterValue ret_value =
+      run_bytecode__LilyInterpreterVM(self, entry_point, regs);
+
+    local_stack.len = frame_begin;
+
+    set_return__LilyInterpreterVMStackFrame(
+      current_frame,
+      NEW_VARIANT(LilyInterpreterVMStackFrameReturn, normal, ret_value));
+}
+
 void
 run_insts__LilyInterpreterVM(LilyInterpreterVM *self)
 {
@@ -4570,12 +5447,23 @@ void
 set_max_stack__LilyInterpreterVM(Usize max_stack)
 {
     local_stack.max_capacity =
-      max_stack == 0 ? DEFAULT_MAX_STACK_CAPACITY : max_stack;
+      (max_stack == 0 ? DEFAULT_MAX_STACK_CAPACITY : max_stack) /
+      sizeof(LilyInterpreterValue);
 }
 
 void
 run__LilyInterpreterVM(LilyInterpreterVM *self)
 {
+    // NOTE: The heap values are allocated in the memory of the VM until the VM
+    // is freed.
+    set_current__LilyInterpreterMemory(&self->memory);
+
+    if (self->bytecode) {
+        run_bytecode_entry_point__LilyInterpreterVM(self);
+
+        goto exit_vm;
+    }
+
     // TODO: Instead of call `run_inst__*`, execute all instructions and the VM
     // in one function.
 run_vm: {
@@ -4592,7 +5480,17 @@ exit_vm: {
 
 DESTRUCTOR(LilyInterpreterVM, const LilyInterpreterVM *self)
 {
+    if (self->bytecode) {
+        FREE(LilyInterpreterVMBytecodeModule, self->bytecode);
+    }
+
     FREE(LilyInterpreterVMResources, &self->resources);
     FREE(LilyInterpreterVMStackFrameReturn, &current_frame->return_);
     FREE(LilyInterpreterVMStackFrame, &current_frame);
+
+    free_frame_pool__LilyInterpreterVMStackFrame();
+    free_collector__LilyInterpreterValue();
+
+    set_current__LilyInterpreterMemory(NULL);
+    FREE(LilyInterpreterMemory, (LilyInterpreterMemory *)&self->memory);
 }
@@ -265,6 +265,7 @@ CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = kind;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
 
     return self;
 }
@@ -280,6 +281,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_ARRAY;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->array = array;
 
     return self;
@@ -296,6 +298,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_BYTES;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->bytes = bytes;
 
     return self;
@@ -312,6 +315,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_CONST;
     self->dt = NEW_VARIANT(LilyMirDt, ptr, dt);
     self->ref_count = 0;
+    self->slot = 0;
     self->const_ = const_;
 
     return self;
@@ -328,6 +332,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_CSTR;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->cstr = cstr;
 
     return self;
@@ -345,6 +350,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_EXCEPTION;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->exception[0] = ok;
     self->exception[1] = err;
 
@@ -362,6 +368,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_FLOAT;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->float_ = float_;
 
     return self;
@@ -378,6 +385,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_INT;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->int_ = int_;
 
     return self;
@@ -394,6 +402,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_LIST;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->list = list;
 
     return self;
@@ -410,6 +419,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_PARAM;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->param = param;
 
     return self;
@@ -426,6 +436,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_REG;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->reg = reg;
 
     return self;
@@ -442,6 +453,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_SLICE;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->slice = slice;
 
     return self;
@@ -458,6 +470,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_STR;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->str = str;
 
     return self;
@@ -474,6 +487,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_STRUCT;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->struct_ = struct_;
 
     return self;
@@ -490,6 +504,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_TRACE;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->trace = trace;
 
     return self;
@@ -506,6 +521,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_TUPLE;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->tuple = tuple;
 
     return self;
@@ -522,6 +538,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_UINT;
     self->dt = dt;
     self->ref_count = 0;
+    self->slot = 0;
     self->uint = uint;
 
     return self;
@@ -538,6 +555,7 @@ VARIANT_CONSTRUCTOR(LilyMirInstructionVal *,
     self->kind = LILY_MIR_INSTRUCTION_VAL_KIND_VAR;
     self->dt = NEW_VARIANT(LilyMirDt, ptr, dt);
     self->ref_count = 0;
+    self->slot = 0;
     self->var = var;
 
     return self;
@@ -1159,7 +1177,8 @@ CONSTRUCTOR(LilyMirInstructionFun,
         .virtual_variable_manager = NEW(LilyMirNameManager, "."),
         .scope = scope,
         .root_scope = scope,
-        .block_count = 1
+        .block_count = 1,
+        .slots_len = 0
     };
 }
 
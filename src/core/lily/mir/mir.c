@@ -147,16 +147,17 @@ LilyMirPopCurrent(LilyMirModule *Module)
 LilyMirScopeVar *
 LilyMirScopeGetVar(const LilyMirScope *Scope, String *name)
 {
-    for (Usize i = 0; i < Scope->vars->len; ++i) {
-        LilyMirScopeVar *var = get__Vec(Scope->vars, i);
+    // NOTE: The name is hashed once, then the scopes are searched by symbol.
+    Symbol symbol = lookup__Symbol(name->buffer);
 
-        if (!strcmp(var->name->buffer, name->buffer)) {
-            return var;
-        }
-    }
+    for (; Scope && symbol != SYMBOL_NONE; Scope = Scope->parent) {
+        for (Usize i = 0; i < Scope->vars->len; ++i) {
+            LilyMirScopeVar *var = get__Vec(Scope->vars, i);
 
-    if (Scope->parent) {
-        return LilyMirScopeGetVar(Scope->parent, name);
+            if (var->symbol == symbol) {
+                return var;
+            }
+        }
     }
 
     UNREACHABLE("the analysis has a bug!!");
@@ -58,6 +58,7 @@ CONSTRUCTOR(LilyMirScopeVar *,
     LilyMirScopeVar *self = lily_malloc(sizeof(LilyMirScopeVar));
 
     self->name = name;
+    self->symbol = intern__Symbol(name->buffer);
     self->data_type = data_type;
 
     return self;
@@ -46,7 +46,9 @@ CONSTRUCTOR(LilyPackageCompilerConfig,
             bool o2,
             bool o3,
             bool oz,
-            bool verbose)
+            bool verbose,
+            Usize jobs,
+            bool cache_stats)
 {
     enum Os os = -1;
     enum Arch arch = -1;
@@ -97,5 +99,7 @@ CONSTRUCTOR(LilyPackageCompilerConfig,
                                         .o2 = o2,
                                         .o3 = o3,
                                         .oz = oz,
-                                        .verbose = verbose };
+                                        .verbose = verbose,
+                                        .jobs = jobs,
+                                        .cache_stats = cache_stats };
 }
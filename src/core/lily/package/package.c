@@ -127,9 +127,10 @@ CONSTRUCTOR(LilyPackage *,
 
         // Push default operators contains in program resources.
         for (Usize i = 0; i < DEFAULT_OPERATORS_COUNT; ++i) {
-            push__Vec(self->operator_register.operators,
-                      ref__LilyCheckedOperator(
-                        self->program->resources.default_operators[i]));
+            push_operator__LilyCheckedOperatorRegister(
+              &self->operator_register,
+              ref__LilyCheckedOperator(
+                self->program->resources.default_operators[i]));
         }
     } else {
         self->parser = NEW(LilyParser, self, self, NULL);
@@ -0,0 +1,387 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/assert.h>
+#include <base/cpu.h>
+#include <base/new.h>
+
+#include <core/lily/package/package.h>
+#include <core/lily/package/scheduler.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ *
+ * @brief Add the task of the tree and the tasks of its children (recursively)
+ * to the scheduler.
+ * @param parent LilyPackageSchedulerTask*?
+ */
+static void
+add_tasks__LilyPackageScheduler(LilyPackageScheduler *self,
+                                LilyPackageDependencyTree *tree,
+                                LilyPackageSchedulerTask *parent);
+
+/**
+ *
+ * @brief Get the task of the tree.
+ */
+static LilyPackageSchedulerTask *
+get_task__LilyPackageScheduler(const LilyPackageScheduler *self,
+                               const LilyPackageDependencyTree *tree);
+
+/**
+ *
+ * @brief Link each task to the tasks of its dependencies.
+ */
+static void
+link_dependencies__LilyPackageScheduler(LilyPackageScheduler *self);
+
+/**
+ *
+ * @brief Push a ready task on the queue of the worker and wake up an idle
+ * worker.
+ * @note The mutex of the scheduler must be locked.
+ */
+static void
+push_ready__LilyPackageScheduler(LilyPackageScheduler *self,
+                                 LilyPackageSchedulerWorker *worker,
+                                 LilyPackageSchedulerTask *task);
+
+/**
+ *
+ * @brief Take a ready task from the queue of the worker, or steal one from the
+ * queue of another worker.
+ * @note A ready task must have been claimed before calling this function (see
+ * `ready_len`).
+ */
+static LilyPackageSchedulerTask *
+take_ready__LilyPackageSchedulerWorker(LilyPackageSchedulerWorker *self);
+
+/**
+ *
+ * @brief Run the ready tasks until all tasks are done.
+ * @param self LilyPackageSchedulerWorker*
+ */
+static void *
+run__LilyPackageSchedulerWorker(void *self);
+
+CONSTRUCTOR(LilyPackageSchedulerTask *,
+            LilyPackageSchedulerTask,
+            LilyPackageDependencyTree *tree)
+{
+    LilyPackageSchedulerTask *self =
+      lily_malloc(sizeof(LilyPackageSchedulerTask));
+
+    self->tree = tree;
+    self->successors = NEW(Vec);
+    self->pending = 0;
+
+    return self;
+}
+
+DESTRUCTOR(LilyPackageSchedulerTask, LilyPackageSchedulerTask *self)
+{
+    FREE(Vec, self->successors);
+    lily_free(self);
+}
+
+void
+add_tasks__LilyPackageScheduler(LilyPackageScheduler *self,
+                                LilyPackageDependencyTree *tree,
+                                LilyPackageSchedulerTask *parent)
+{
+    LilyPackageSchedulerTask *task = NEW(LilyPackageSchedulerTask, tree);
+
+    // The children of a tree are run after their parent.
+    if (parent) {
+        push__Vec(parent->successors, task);
+        ++task->pending;
+    }
+
+    push__Vec(self->tasks, task);
+
+    ASSERT(
+      !insert__HashMap(self->tasks_by_name, tree->package->name->buffer, task));
+
+    for (Usize i = 0; i < tree->children->len; ++i) {
+        add_tasks__LilyPackageScheduler(
+          self, get__Vec(tree->children, i), task);
+    }
+}
+
+LilyPackageSchedulerTask *
+get_task__LilyPackageScheduler(const LilyPackageScheduler *self,
+                               const LilyPackageDependencyTree *tree)
+{
+    LilyPackageSchedulerTask *task =
+      get__HashMap(self->tasks_by_name, tree->package->name->buffer);
+
+    if (task) {
+        ASSERT(task->tree == tree);
+
+        return task;
+    }
+
+    UNREACHABLE("the tree is not found in the scheduler");
+}
+
+void
+link_dependencies__LilyPackageScheduler(LilyPackageScheduler *self)
+{
+    for (Usize i = 0; i < self->tasks->len; ++i) {
+        LilyPackageSchedulerTask *task = get__Vec(self->tasks, i);
+
+        if (!task->tree->dependencies) {
+            continue;
+        }
+
+        for (Usize j = 0; j < task->tree->dependencies->len; ++j) {
+            LilyPackageSchedulerTask *dependency =
+              get_task__LilyPackageScheduler(
+                self, get__Vec(task->tree->dependencies, j));
+
+            push__Vec(dependency->successors, task);
+            ++task->pending;
+        }
+    }
+}
+
+CONSTRUCTOR(LilyPackageScheduler *,
+            LilyPackageScheduler,
+            const Vec *trees,
+            Usize jobs,
+            void (*run)(LilyPackageDependencyTree *tree))
+{
+    // NOTE: The scheduler is allocated on the heap, because the workers keep a
+    // reference to it, and the mutex and the condition variable must not be
+    // copied after their initialization.
+    LilyPackageScheduler *self = lily_malloc(sizeof(LilyPackageScheduler));
+
+    self->tasks = NEW(Vec);
+    self->tasks_by_name = NEW(HashMap);
+    self->workers = NULL;
+    self->workers_len = 0;
+    self->run = run;
+    self->ready_len = 0;
+    self->remaining_len = 0;
+
+    for (Usize i = 0; i < trees->len; ++i) {
+        add_tasks__LilyPackageScheduler(self, get__Vec(trees, i), NULL);
+    }
+
+    link_dependencies__LilyPackageScheduler(self);
+
+    self->remaining_len = self->tasks->len;
+
+    if (jobs == 0) {
+        jobs = get_cores_len__Cpu();
+    }
+
+    // NOTE: There's no reason to start more workers than tasks.
+    self->workers_len = jobs < self->tasks->len ? jobs : self->tasks->len;
+
+    if (self->workers_len > 0) {
+        self->workers =
+          lily_malloc(sizeof(LilyPackageSchedulerWorker) * self->workers_len);
+    }
+
+    for (Usize i = 0; i < self->workers_len; ++i) {
+        self->workers[i].scheduler = self;
+        self->workers[i].ready = NEW(Vec);
+        self->workers[i].id = i;
+
+        ASSERT(!pthread_mutex_init(&self->workers[i].ready_mutex, NULL));
+    }
+
+    ASSERT(!pthread_mutex_init(&self->mutex, NULL));
+    ASSERT(!pthread_cond_init(&self->cond, NULL));
+
+    return self;
+}
+
+void
+push_ready__LilyPackageScheduler(LilyPackageScheduler *self,
+                                 LilyPackageSchedulerWorker *worker,
+                                 LilyPackageSchedulerTask *task)
+{
+    pthread_mutex_lock(&worker->ready_mutex);
+    push__Vec(worker->ready, task);
+    pthread_mutex_unlock(&worker->ready_mutex);
+
+    ++self->ready_len;
+
+    pthread_cond_signal(&self->cond);
+}
+
+LilyPackageSchedulerTask *
+take_ready__LilyPackageSchedulerWorker(LilyPackageSchedulerWorker *self)
+{
+    LilyPackageScheduler *scheduler = self->scheduler;
+
+    // NOTE: The claimed task is necessarily in one of the queues, so this loop
+    // ends.
+    for (;;) {
+        // 1. Pop at the back of the queue of the worker.
+        pthread_mutex_lock(&self->ready_mutex);
+
+        LilyPackageSchedulerTask *task =
+          self->ready->len > 0 ? pop__Vec(self->ready) : NULL;
+
+        pthread_mutex_unlock(&self->ready_mutex);
+
+        if (task) {
+            return task;
+        }
+
+        // 2. Steal at the front of the queue of the other workers.
+        for (Usize i = 1; i < scheduler->workers_len; ++i) {
+            LilyPackageSchedulerWorker *victim =
+              &scheduler->workers[(self->id + i) % scheduler->workers_len];
+
+            pthread_mutex_lock(&victim->ready_mutex);
+
+            task =
+              victim->ready->len > 0 ? remove__Vec(victim->ready, 0) : NULL;
+
+            pthread_mutex_unlock(&victim->ready_mutex);
+
+            if (task) {
+                return task;
+            }
+        }
+    }
+}
+
+void *
+run__LilyPackageSchedulerWorker(void *self)
+{
+    LilyPackageSchedulerWorker *worker = self;
+    LilyPackageScheduler *scheduler = worker->scheduler;
+
+    for (;;) {
+        // 1. Wait and claim a ready task.
+        pthread_mutex_lock(&scheduler->mutex);
+
+        while (scheduler->ready_len == 0 && scheduler->remaining_len > 0) {
+            pthread_cond_wait(&scheduler->cond, &scheduler->mutex);
+        }
+
+        if (scheduler->remaining_len == 0) {
+            pthread_mutex_unlock(&scheduler->mutex);
+
+            return NULL;
+        }
+
+        --scheduler->ready_len;
+
+        pthread_mutex_unlock(&scheduler->mutex);
+
+        // 2. Run the task (without holding any lock).
+        LilyPackageSchedulerTask *task =
+          take_ready__LilyPackageSchedulerWorker(worker);
+
+        scheduler->run(task->tree);
+
+        // 3. Mark the task as done and push the tasks that become ready.
+        pthread_mutex_lock(&scheduler->mutex);
+
+        task->tree->is_done = true;
+
+        for (Usize i = 0; i < task->successors->len; ++i) {
+            LilyPackageSchedulerTask *successor =
+              get__Vec(task->successors, i);
+
+            if (--successor->pending == 0) {
+                push_ready__LilyPackageScheduler(scheduler, worker, successor);
+            }
+        }
+
+        if (--scheduler->remaining_len == 0) {
+            pthread_cond_broadcast(&scheduler->cond);
+        }
+
+        pthread_mutex_unlock(&scheduler->mutex);
+    }
+}
+
+void
+run__LilyPackageScheduler(LilyPackageScheduler *self)
+{
+    if (self->remaining_len == 0) {
+        return;
+    }
+
+    // 1. Push the tasks without predecessors, distributed on the workers.
+    pthread_mutex_lock(&self->mutex);
+
+    for (Usize i = 0, w = 0; i < self->tasks->len; ++i) {
+        LilyPackageSchedulerTask *task = get__Vec(self->tasks, i);
+
+        if (task->pending == 0) {
+            push_ready__LilyPackageScheduler(
+              self, &self->workers[w++ % self->workers_len], task);
+        }
+    }
+
+    ASSERT(self->ready_len > 0);
+
+    pthread_mutex_unlock(&self->mutex);
+
+    // 2. Start the workers.
+    for (Usize i = 0; i < self->workers_len; ++i) {
+        ASSERT(!pthread_create(&self->workers[i].thread,
+                               NULL,
+                               &run__LilyPackageSchedulerWorker,
+                               &self->workers[i]));
+    }
+
+    // 3. Wait the workers.
+    for (Usize i = 0; i < self->workers_len; ++i) {
+        pthread_join(self->workers[i].thread, NULL);
+    }
+}
+
+DESTRUCTOR(LilyPackageScheduler, LilyPackageScheduler *self)
+{
+    FREE_BUFFER_ITEMS(
+      self->tasks->buffer, self->tasks->len, LilyPackageSchedulerTask);
+    FREE(Vec, self->tasks);
+    FREE(HashMap, self->tasks_by_name);
+
+    for (Usize i = 0; i < self->workers_len; ++i) {
+        FREE(Vec, self->workers[i].ready);
+        pthread_mutex_destroy(&self->workers[i].ready_mutex);
+    }
+
+    if (self->workers) {
+        lily_free(self->workers);
+    }
+
+    pthread_mutex_destroy(&self->mutex);
+    pthread_cond_destroy(&self->cond);
+
+    lily_free(self);
+}
@@ -22,6 +22,7 @@
  * SOFTWARE.
  */
 
+#include <base/assert.h>
 #include <base/atof.h>
 #include <base/atoi.h>
 #include <base/print.h>
@@ -32,6 +33,7 @@
 #include <core/shared/diagnostic.h>
 
 #include <ctype.h>
+#include <pthread.h>
 #include <string.h>
 
 /*
@@ -98,6 +100,10 @@ Example:
 Output: no errors
  */
 
+/// @brief Build the perfect hash tables of keywords (called once).
+static void
+init_keywords__LilyScanner();
+
 /// @brief Get keyword from id.
 static enum LilyTokenKind
 get_keyword__LilyScanner(const String *id);
@@ -383,6 +389,12 @@ static const enum LilyTokenKind lily_at_keyword_ids[LILY_N_AT_KEYWORD] = {
     LILY_TOKEN_KIND_KEYWORD_AT_SYS,
 };
 
+// NOTE: These tables are built once from the sorted tables above (see
+// init_keywords__LilyScanner).
+static SearchPerfectHash lily_keywords_hash;
+static SearchPerfectHash lily_at_keywords_hash;
+static pthread_once_t lily_keywords_hash_once = PTHREAD_ONCE_INIT;
+
 #define IS_ZERO '0'
 
 #define IS_DIGIT_WITHOUT_ZERO \
@@ -789,11 +801,44 @@ static const enum LilyTokenKind lily_at_keyword_ids[LILY_N_AT_KEYWORD] = {
         }                                                                      \
     }
 
+void
+init_keywords__LilyScanner()
+{
+    lily_keywords_hash = NEW(SearchPerfectHash,
+                             lily_keywords,
+                             (const Int32 *)lily_keyword_ids,
+                             LILY_N_KEYWORD);
+    lily_at_keywords_hash = NEW(SearchPerfectHash,
+                                lily_at_keywords,
+                                (const Int32 *)lily_at_keyword_ids,
+                                LILY_N_AT_KEYWORD);
+
+    ASSERT(lily_keywords_hash.is_perfect);
+    ASSERT(lily_at_keywords_hash.is_perfect);
+}
+
+const SearchPerfectHash *
+get_keywords_hash__LilyScanner()
+{
+    pthread_once(&lily_keywords_hash_once, &init_keywords__LilyScanner);
+
+    return &lily_keywords_hash;
+}
+
+const SearchPerfectHash *
+get_at_keywords_hash__LilyScanner()
+{
+    pthread_once(&lily_keywords_hash_once, &init_keywords__LilyScanner);
+
+    return &lily_at_keywords_hash;
+}
+
 enum LilyTokenKind
 get_keyword__LilyScanner(const String *id)
 {
-    Int32 res = get_keyword__Scanner(
-      id, lily_keywords, (const Int32 *)lily_keyword_ids, LILY_N_KEYWORD);
+    pthread_once(&lily_keywords_hash_once, &init_keywords__LilyScanner);
+
+    Int32 res = get_keyword__Scanner(id, &lily_keywords_hash);
 
     if (res == -1) {
         return LILY_TOKEN_KIND_IDENTIFIER_NORMAL;
@@ -805,10 +850,9 @@ get_keyword__LilyScanner(const String *id)
 enum LilyTokenKind
 get_at_keyword__LilyScanner(const String *id)
 {
-    Int32 res = get_keyword__Scanner(id,
-                                     lily_at_keywords,
-                                     (const Int32 *)lily_at_keyword_ids,
-                                     LILY_N_AT_KEYWORD);
+    pthread_once(&lily_keywords_hash_once, &init_keywords__LilyScanner);
+
+    Int32 res = get_keyword__Scanner(id, &lily_at_keywords_hash);
 
     if (res == -1) {
         return LILY_TOKEN_KIND_IDENTIFIER_NORMAL;
@@ -1125,9 +1169,7 @@ get_character__LilyScanner(LilyScanner *self, char previous)
 void
 skip_comment_line__LilyScanner(LilyScanner *self)
 {
-    while (self->base.source.cursor.current != '\n') {
-        next_char__LilyScanner(self);
-    }
+    skip_line__Scanner(&self->base);
 }
 
 void
@@ -1140,9 +1182,11 @@ skip_comment_block__LilyScanner(LilyScanner *self)
                     self->base.source.cursor.column - 2,
                     self->base.source.cursor.position - 2); // 2 = `/*`
 
-    // Check if the comment block is closed. While the current character is not
-    // a `*` and the next character is not a `/`, we continue to scan the
-    // comment block.
+    // Skip the body of the comment block at once, then check if the comment
+    // block is closed. While the current character is not a `*` and the next
+    // character is not a `/`, we continue to scan the comment block.
+    skip_comment_block__Scanner(&self->base);
+
     while (self->base.source.cursor.current != '*' ||
            peek_char__LilyScanner(self, 1) != (char *)'/') {
         // Check if the comment block is not closed.
@@ -1200,7 +1244,7 @@ scan_identifier__LilyScanner(LilyScanner *self)
 {
     String *id = NEW(String);
 
-    scan_and_append_chars__LilyScanner(self, id, is_ident__LilyScanner);
+    scan_ident_chars__Scanner(&self->base, id, false);
     previous_char__LilyScanner(self);
 
     return id;
@@ -1315,6 +1359,15 @@ scan_string__LilyScanner(LilyScanner *self)
     // not a `"` or the next character is not a `"`, we continue to scan the
     // string literal.
     while (self->base.source.cursor.current != '\"') {
+        // Append the characters that don't need to be escaped at once.
+        if (self->base.source.cursor.current != '\\') {
+            scan_string_chars__Scanner(&self->base, res);
+
+            if (self->base.source.cursor.current == '\"') {
+                break;
+            }
+        }
+
         if (self->base.source.cursor.position >
             self->base.source.file->len - 2) {
             end__Location(&location_error,
@@ -2653,6 +2706,9 @@ get_token__LilyScanner(LilyScanner *self)
 void
 run__LilyScanner(LilyScanner *self, bool dump_scanner)
 {
+    MemoryArenaChain *previous_token_arena =
+      set_arena__LilyToken(&self->token_arena);
+
     if (self->base.source.file->len > 1) {
         while (!HAS_REACH_END(self)) {
             skip_space__LilyScanner(self);
@@ -2695,6 +2751,8 @@ run__LilyScanner(LilyScanner *self, bool dump_scanner)
                   LILY_TOKEN_KIND_EOF,
                   clone__Location(&self->base.location)));
 
+    set_arena__LilyToken(previous_token_arena);
+
 #ifndef DEBUG_SCANNER
     if (dump_scanner) {
         printf("====Scanner(%s)====\n", self->base.source.file->name);
@@ -2720,4 +2778,5 @@ DESTRUCTOR(LilyScanner, const LilyScanner *self)
 {
     FREE_BUFFER_ITEMS(self->tokens->buffer, self->tokens->len, LilyToken);
     FREE(Vec, self->tokens);
+    FREE(MemoryArenaChain, &self->token_arena);
 }
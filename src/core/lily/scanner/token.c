@@ -36,6 +36,16 @@
 #include <base/print.h>
 #endif
 
+// Allocate a LilyToken in the arena of the current thread, or with the
+// global allocator if no arena is set.
+static inline LilyToken *
+alloc__LilyToken();
+
+// Release the memory of the LilyToken, unless the token is allocated in an
+// arena.
+static inline void
+dealloc__LilyToken(LilyToken *self);
+
 // Free LilyToken type (LILY_TOKEN_KIND_COMMENT_DOC).
 static inline VARIANT_DESTRUCTOR(LilyToken, comment_doc, LilyToken *self);
 
@@ -112,12 +122,47 @@ IMPL_FOR_DEBUG(to_string, LilyTokenExpand, const LilyTokenExpand *self)
 }
 #endif
 
+// The arena in which the tokens are allocated (the arena is set by the
+// scanner, during the scan of a file).
+static threadlocal MemoryArenaChain *token_arena = NULL;
+
+MemoryArenaChain *
+set_arena__LilyToken(MemoryArenaChain *arena)
+{
+    MemoryArenaChain *previous_arena = token_arena;
+
+    token_arena = arena;
+
+    return previous_arena;
+}
+
+LilyToken *
+alloc__LilyToken()
+{
+    LilyToken *self = token_arena
+                        ? MEMORY_ARENA_CHAIN_ALLOC(LilyToken, token_arena, 1)
+                        : lily_malloc(sizeof(LilyToken));
+
+    self->is_in_arena = token_arena != NULL;
+
+    return self;
+}
+
+void
+dealloc__LilyToken(LilyToken *self)
+{
+    if (!self->is_in_arena) {
+        lily_free(self);
+    }
+}
+
 CONSTRUCTOR(LilyToken *, LilyToken, enum LilyTokenKind kind, Location location)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = kind;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
 
     return self;
 }
@@ -129,10 +174,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *comment_debug)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_COMMENT_DEBUG;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->comment_debug = comment_debug;
 
     return self;
@@ -145,10 +191,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *comment_doc)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_COMMENT_DOC;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->comment_doc = comment_doc;
 
     return self;
@@ -160,10 +207,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     LilyTokenExpand expand)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_EXPAND;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->expand = expand;
 
     return self;
@@ -175,10 +223,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *identifier_dollar)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_IDENTIFIER_DOLLAR;
     self->location = location;
+    self->symbol = intern__Symbol(identifier_dollar->buffer);
     self->identifier_dollar = identifier_dollar;
 
     return self;
@@ -190,10 +239,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *identifier_macro)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_IDENTIFIER_MACRO;
     self->location = location;
+    self->symbol = intern__Symbol(identifier_macro->buffer);
     self->identifier_macro = identifier_macro;
 
     return self;
@@ -205,10 +255,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *identifier_normal)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_IDENTIFIER_NORMAL;
     self->location = location;
+    self->symbol = intern__Symbol(identifier_normal->buffer);
     self->identifier_normal = identifier_normal;
 
     return self;
@@ -220,10 +271,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *identifier_operator)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_IDENTIFIER_OPERATOR;
     self->location = location;
+    self->symbol = intern__Symbol(identifier_operator->buffer);
     self->identifier_operator = identifier_operator;
 
     return self;
@@ -235,10 +287,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *identifier_string)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_IDENTIFIER_STRING;
     self->location = location;
+    self->symbol = intern__Symbol(identifier_string->buffer);
     self->identifier_string = identifier_string;
 
     return self;
@@ -250,10 +303,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Uint8 literal_byte)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_BYTE;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_byte = literal_byte;
 
     return self;
@@ -265,10 +319,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Uint8 *literal_bytes)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_BYTES;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_bytes = literal_bytes;
 
     return self;
@@ -280,10 +335,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     char literal_char)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_CHAR;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_char = literal_char;
 
     return self;
@@ -295,10 +351,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     char *literal_cstr)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_CSTR;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_cstr = literal_cstr;
 
     return self;
@@ -310,10 +367,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *literal_float)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_FLOAT;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_float = literal_float;
 
     return self;
@@ -325,10 +383,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *literal_int_2)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_INT_2;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_int_2 = literal_int_2;
 
     return self;
@@ -340,10 +399,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *literal_int_8)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_INT_8;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_int_8 = literal_int_8;
 
     return self;
@@ -355,10 +415,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *literal_int_10)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_INT_10;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_int_10 = literal_int_10;
 
     return self;
@@ -370,10 +431,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *literal_int_16)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_INT_16;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_int_16 = literal_int_16;
 
     return self;
@@ -385,10 +447,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     String *literal_str)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_STR;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_str = literal_str;
 
     return self;
@@ -400,10 +463,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Float32 literal_suffix_float32)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_FLOAT32;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_suffix_float32 = literal_suffix_float32;
 
     return self;
@@ -415,10 +479,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Float64 literal_suffix_float64)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_FLOAT64;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_suffix_float64 = literal_suffix_float64;
 
     return self;
@@ -430,10 +495,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Int16 literal_suffix_int16)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_INT16;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_suffix_int16 = literal_suffix_int16;
 
     return self;
@@ -445,10 +511,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Int32 literal_suffix_int32)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_INT32;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_suffix_int32 = literal_suffix_int32;
 
     return self;
@@ -460,10 +527,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Int64 literal_suffix_int64)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_INT64;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_suffix_int64 = literal_suffix_int64;
 
     return self;
@@ -475,10 +543,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Int8 literal_suffix_int8)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_INT8;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_suffix_int8 = literal_suffix_int8;
 
     return self;
@@ -490,10 +559,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Isize literal_suffix_isize)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_ISIZE;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_suffix_isize = literal_suffix_isize;
 
     return self;
@@ -505,10 +575,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Uint16 literal_suffix_uint16)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_UINT16;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_suffix_uint16 = literal_suffix_uint16;
 
     return self;
@@ -520,10 +591,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Uint32 literal_suffix_uint32)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_UINT32;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_suffix_uint32 = literal_suffix_uint32;
 
     return self;
@@ -535,10 +607,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Uint64 literal_suffix_uint64)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_UINT64;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_suffix_uint64 = literal_suffix_uint64;
 
     return self;
@@ -550,10 +623,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Uint8 literal_suffix_uint8)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_UINT8;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_suffix_uint8 = literal_suffix_uint8;
 
     return self;
@@ -565,10 +639,11 @@ VARIANT_CONSTRUCTOR(LilyToken *,
                     Location location,
                     Usize literal_suffix_usize)
 {
-    LilyToken *self = lily_malloc(sizeof(LilyToken));
+    LilyToken *self = alloc__LilyToken();
 
     self->kind = LILY_TOKEN_KIND_LITERAL_SUFFIX_USIZE;
     self->location = location;
+    self->symbol = SYMBOL_NONE;
     self->literal_suffix_usize = literal_suffix_usize;
 
     return self;
@@ -1697,90 +1772,90 @@ clone__LilyToken(const LilyToken *self)
 VARIANT_DESTRUCTOR(LilyToken, comment_doc, LilyToken *self)
 {
     FREE(String, self->comment_doc);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, identifier_dollar, LilyToken *self)
 {
     FREE(String, self->identifier_dollar);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, identifier_macro, LilyToken *self)
 {
     FREE(String, self->identifier_macro);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, identifier_operator, LilyToken *self)
 {
     FREE(String, self->identifier_operator);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, identifier_normal, LilyToken *self)
 {
     FREE(String, self->identifier_normal);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, identifier_string, LilyToken *self)
 {
     FREE(String, self->identifier_string);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_bytes, LilyToken *self)
 {
     lily_free(self->literal_bytes);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_cstr, LilyToken *self)
 {
     lily_free(self->literal_cstr);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_float, LilyToken *self)
 {
     FREE(String, self->literal_float);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_int_2, LilyToken *self)
 {
     FREE(String, self->literal_int_2);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_int_8, LilyToken *self)
 {
     FREE(String, self->literal_int_8);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_int_10, LilyToken *self)
 {
     FREE(String, self->literal_int_10);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_int_16, LilyToken *self)
 {
     FREE(String, self->literal_int_16);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, literal_str, LilyToken *self)
 {
     FREE(String, self->literal_str);
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 VARIANT_DESTRUCTOR(LilyToken, macro_expand, LilyToken *self)
 {
-    lily_free(self);
+    dealloc__LilyToken(self);
 }
 
 DESTRUCTOR(LilyToken, LilyToken *self)
@@ -1829,6 +1904,6 @@ DESTRUCTOR(LilyToken, LilyToken *self)
             FREE_VARIANT(LilyToken, literal_str, self);
             break;
         default:
-            lily_free(self);
+            dealloc__LilyToken(self);
     }
 }
@@ -27,7 +27,6 @@
 #include <base/format.h>
 #include <base/macros.h>
 #include <base/print.h>
-#include <base/str.h>
 
 #include <core/shared/diagnostic.h>
 
@@ -48,8 +47,9 @@ static inline CONSTRUCTOR(DiagnosticLevelUtil,
                           Vec *notes,
                           const Location *location);
 
-static String *
-to_string__DiagnosticLevelUtil(const DiagnosticLevelUtil *self);
+// Write DiagnosticLevelUtil in the buffer.
+static void
+write__DiagnosticLevelUtil(const DiagnosticLevelUtil *self, String *res);
 
 // Free DiagnosticLevelUtil type.
 static DESTRUCTOR(DiagnosticLevelUtil, const DiagnosticLevelUtil *self);
@@ -62,10 +62,11 @@ static inline CONSTRUCTOR(DiagnosticReferencingItem,
                           const DiagnosticDetail *detail,
                           const File *file);
 
-// Convert DiagnosticReferencingItem in String.
-static String *
-to_string__DiagnosticReferencingItem(const DiagnosticReferencingItem *self,
-                                     const DiagnosticLevel *level);
+// Write DiagnosticReferencingItem in the buffer.
+static void
+write__DiagnosticReferencingItem(const DiagnosticReferencingItem *self,
+                                 const DiagnosticLevel *level,
+                                 String *res);
 
 static DESTRUCTOR(DiagnosticReferencingItem, DiagnosticReferencingItem *self);
 
@@ -75,10 +76,11 @@ static inline CONSTRUCTOR(DiagnosticReferencing,
                           Vec *items,
                           const DiagnosticLevelUtil level_util);
 
-// Convert DiagnosticReferencing in String.
-static String *
-to_string__DiagnosticReferencing(const DiagnosticReferencing *self,
-                                 const DiagnosticLevel *level);
+// Write DiagnosticReferencing in the buffer.
+static void
+write__DiagnosticReferencing(const DiagnosticReferencing *self,
+                             const DiagnosticLevel *level,
+                             String *res);
 
 // Free DiagnosticReferencing type.
 static inline DESTRUCTOR(DiagnosticReferencing,
@@ -92,9 +94,11 @@ static inline CONSTRUCTOR(DiagnosticSimple,
 
 static DESTRUCTOR(DiagnosticSimple, const DiagnosticSimple *self);
 
-// Convert Simple in String.
-static String *
-to_string__Simple(const DiagnosticSimple *self, const DiagnosticLevel *level);
+// Write Simple in the buffer.
+static void
+write__Simple(const DiagnosticSimple *self,
+              const DiagnosticLevel *level,
+              String *res);
 
 // Construct DiagnosticLevelFormat type (DIAGNOSTIC_LEVEL_FORMAT_KIND_SIMPLE).
 static inline VARIANT_CONSTRUCTOR(DiagnosticLevelFormat,
@@ -109,10 +113,11 @@ static inline VARIANT_CONSTRUCTOR(DiagnosticLevelFormat,
                                   referencing,
                                   const DiagnosticReferencing referencing);
 
-// Convert DiagnosticLevelFormat in String.
-static String *
-to_string__DiagnosticLevelFormat(const DiagnosticLevelFormat *self,
-                                 const DiagnosticLevel *level);
+// Write DiagnosticLevelFormat in the buffer.
+static void
+write__DiagnosticLevelFormat(const DiagnosticLevelFormat *self,
+                             const DiagnosticLevel *level,
+                             String *res);
 
 // Free DiagnosticLevelFormat type (DIAGNOSTIC_LEVEL_FORMAT_KIND_SIMPLE).
 static VARIANT_DESTRUCTOR(DiagnosticLevelFormat,
@@ -131,83 +136,55 @@ static DESTRUCTOR(DiagnosticLevelFormat, const DiagnosticLevelFormat *self);
 static Usize
 calc_usize_length(Usize line);
 
-// Convert DiagnosticDetail in String.
-static String *
-to_string__DiagnosticDetail(const DiagnosticDetail *self,
-                            const DiagnosticLevel *level);
+// Get the line (without the newline character) containing the position.
+static const char *
+get_line__DiagnosticDetail(const DiagnosticDetail *self,
+                           Usize position,
+                           Usize *line_len);
 
-// Convert Diagnostic in String.
-static String *
-to_string__Diagnostic(const Diagnostic *self);
+// Write DiagnosticDetail in the buffer.
+static void
+write__DiagnosticDetail(const DiagnosticDetail *self,
+                        const DiagnosticLevel *level,
+                        String *res);
+
+// Write Diagnostic in the buffer.
+static void
+write__Diagnostic(const Diagnostic *self, String *res);
+
+// Write the string in the buffer as a JSON string.
+static void
+write_json_str__Diagnostic(const char *s, Usize len, String *res);
+
+// Write the Vec<String*>*? in the buffer as a JSON array.
+static void
+write_json_strings__Diagnostic(const char *key,
+                               const Vec *strings,
+                               String *res);
+
+// Write the level (name, code and message) of Diagnostic in the buffer as JSON
+// fields.
+static void
+write_json_level__Diagnostic(const Diagnostic *self, String *res);
+
+// Write Diagnostic in the buffer as a JSON object.
+static void
+write_json__Diagnostic(const Diagnostic *self, String *res);
+
+// Write Diagnostic in the current format, then write the buffer at once on
+// stderr.
+static void
+emit_base__Diagnostic(const Diagnostic *self);
+
+static enum DiagnosticFormat diagnostic_format = DIAGNOSTIC_FORMAT_HUMAN;
+
+// NOTE: This buffer is reused by all diagnostics emitted by the thread (the
+// diagnostics can be emitted by the threads of the package scheduler).
+static threadlocal String *diagnostic_buffer = NULL; // String*?
 
 // Free Diagnostic type.
 static inline DESTRUCTOR(Diagnostic, const Diagnostic *self);
 
-#define LINES(location, file)                                                  \
-    Usize start_position =                                                     \
-      location->start_position == file->len - 1                                \
-        ? location->start_position != 0 ? location->start_position - 1 : 0     \
-        : location->start_position;                                            \
-    Usize end_position = location->end_position;                               \
-                                                                               \
-    for (; start_position > 0 && file->content[start_position] != '\n';        \
-         --start_position)                                                     \
-        ;                                                                      \
-    for (;                                                                     \
-         end_position < file->len - 1 &&                                       \
-         (file->content[end_position] != '\n' && file->content[end_position]); \
-         ++end_position)                                                       \
-        ;                                                                      \
-                                                                               \
-    if (start_position + 1 != file->len - 1 && start_position != 0 &&          \
-        end_position != 0)                                                     \
-        ++start_position;                                                      \
-                                                                               \
-    Vec *lines = NULL;                                                         \
-                                                                               \
-    if (location->end_line - location->start_line == 0) {                      \
-        ASSERT(start_position <= end_position);                                \
-                                                                               \
-        if (start_position < end_position) {                                   \
-            char *slice =                                                      \
-              get_slice__Str(file->content, start_position, end_position);     \
-                                                                               \
-            lines = split__Str(slice, '\n');                                   \
-                                                                               \
-            lily_free(slice);                                                  \
-        } else {                                                               \
-            lines = NEW(Vec);                                                  \
-        }                                                                      \
-    } else {                                                                   \
-        String *slice = NEW(String);                                           \
-        Usize position = start_position;                                       \
-                                                                               \
-        for (Usize i = location->start_line; i < location->end_line; ++i) {    \
-            while (file->content[position] != '\n' &&                          \
-                   file->content[position]) {                                  \
-                push__String(slice, file->content[position++]);                \
-            }                                                                  \
-                                                                               \
-            ++position;                                                        \
-        }                                                                      \
-                                                                               \
-        while (position < end_position) {                                      \
-            push__String(slice, file->content[position++]);                    \
-        }                                                                      \
-                                                                               \
-        lines = split__Str(slice->buffer, '\n');                               \
-                                                                               \
-        FREE(String, slice);                                                   \
-    }                                                                          \
-                                                                               \
-    if (lines->len == 0) {                                                     \
-        char *empty_str = malloc(1);                                           \
-                                                                               \
-        empty_str[0] = '\0';                                                   \
-                                                                               \
-        push__Vec(lines, empty_str);                                           \
-    }
-
 DESTRUCTOR(DiagnosticLevel, const DiagnosticLevel *self)
 {
     switch (self->kind) {
@@ -227,11 +204,6 @@ DESTRUCTOR(DiagnosticLevel, const DiagnosticLevel *self)
 
 DESTRUCTOR(DiagnosticDetail, const DiagnosticDetail *self)
 {
-    for (Usize i = 0; i < self->lines->len; ++i)
-        lily_free(self->lines->buffer[i]);
-
-    FREE(Vec, self->lines);
-
     if (self->msg)
         FREE(String, self->msg);
 }
@@ -247,11 +219,9 @@ CONSTRUCTOR(DiagnosticLevelUtil,
                                   .location = location };
 }
 
-String *
-to_string__DiagnosticLevelUtil(const DiagnosticLevelUtil *self)
+void
+write__DiagnosticLevelUtil(const DiagnosticLevelUtil *self, String *res)
 {
-    String *res = NEW(String);
-
     if (self->helps) {
         for (Usize i = 0; i < self->helps->len; ++i) {
             char *s =
@@ -277,8 +247,6 @@ to_string__DiagnosticLevelUtil(const DiagnosticLevelUtil *self)
             PUSH_STR_AND_FREE(res, s);
         }
     }
-
-    return res;
 }
 
 DESTRUCTOR(DiagnosticLevelUtil, const DiagnosticLevelUtil *self)
@@ -301,24 +269,19 @@ CONSTRUCTOR(DiagnosticReferencingItem,
             const DiagnosticDetail *detail,
             const File *file)
 {
-    LINES(detail->location, file);
-
     return (DiagnosticReferencingItem){
         .msg = msg,
-        .detail = NEW(DiagnosticDetail, lines, detail_msg, detail->location)
+        .detail = NEW(DiagnosticDetail, file, detail_msg, detail->location)
     };
 }
 
-String *
-to_string__DiagnosticReferencingItem(const DiagnosticReferencingItem *self,
-                                     const DiagnosticLevel *level)
+void
+write__DiagnosticReferencingItem(const DiagnosticReferencingItem *self,
+                                 const DiagnosticLevel *level,
+                                 String *res)
 {
-    String *res = NEW(String);
-
     PUSH_STR_AND_FREE(res, format("{sa} {S}", BLUE("--------> "), self->msg));
-    APPEND_AND_FREE(res, to_string__DiagnosticDetail(&self->detail, level));
-
-    return res;
+    write__DiagnosticDetail(&self->detail, level, res);
 }
 
 DESTRUCTOR(DiagnosticReferencingItem, DiagnosticReferencingItem *self)
@@ -339,19 +302,14 @@ CONSTRUCTOR(DiagnosticReferencing,
     return (DiagnosticReferencing){ .items = items, .level_util = level_util };
 }
 
-String *
-to_string__DiagnosticReferencing(const DiagnosticReferencing *self,
-                                 const DiagnosticLevel *level)
+void
+write__DiagnosticReferencing(const DiagnosticReferencing *self,
+                             const DiagnosticLevel *level,
+                             String *res)
 {
-    String *res = NEW(String);
-
     for (Usize i = 0; i < self->items->len; ++i) {
-        APPEND_AND_FREE(
-          res,
-          to_string__DiagnosticReferencingItem(self->items->buffer[i], level));
+        write__DiagnosticReferencingItem(self->items->buffer[i], level, res);
     }
-
-    return res;
 }
 
 DESTRUCTOR(DiagnosticReferencing, const DiagnosticReferencing *self)
@@ -376,10 +334,12 @@ DESTRUCTOR(DiagnosticSimple, const DiagnosticSimple *self)
     FREE(DiagnosticLevelUtil, &self->level_util);
 }
 
-String *
-to_string__Simple(const DiagnosticSimple *self, const DiagnosticLevel *level)
+void
+write__Simple(const DiagnosticSimple *self,
+              const DiagnosticLevel *level,
+              String *res)
 {
-    return to_string__DiagnosticDetail(&self->detail, level);
+    write__DiagnosticDetail(&self->detail, level, res);
 }
 
 VARIANT_CONSTRUCTOR(DiagnosticLevelFormat,
@@ -401,39 +361,25 @@ VARIANT_CONSTRUCTOR(DiagnosticLevelFormat,
                                     .referencing = referencing };
 }
 
-String *
-to_string__DiagnosticLevelFormat(const DiagnosticLevelFormat *self,
-                                 const DiagnosticLevel *level)
+void
+write__DiagnosticLevelFormat(const DiagnosticLevelFormat *self,
+                             const DiagnosticLevel *level,
+                             String *res)
 {
-    String *res = NEW(String);
-
     switch (self->kind) {
-        case DIAGNOSTIC_LEVEL_FORMAT_KIND_SIMPLE: {
-            String *simple = to_string__Simple(&self->simple, level);
-            String *level_util =
-              to_string__DiagnosticLevelUtil(&self->simple.level_util);
-
-            APPEND_AND_FREE(res, simple);
-            APPEND_AND_FREE(res, level_util);
+        case DIAGNOSTIC_LEVEL_FORMAT_KIND_SIMPLE:
+            write__Simple(&self->simple, level, res);
+            write__DiagnosticLevelUtil(&self->simple.level_util, res);
 
             break;
-        }
-        case DIAGNOSTIC_LEVEL_FORMAT_KIND_REFERENCING: {
-            String *referencing =
-              to_string__DiagnosticReferencing(&self->referencing, level);
-            String *level_util =
-              to_string__DiagnosticLevelUtil(&self->referencing.level_util);
-
-            APPEND_AND_FREE(res, referencing);
-            APPEND_AND_FREE(res, level_util);
+        case DIAGNOSTIC_LEVEL_FORMAT_KIND_REFERENCING:
+            write__DiagnosticReferencing(&self->referencing, level, res);
+            write__DiagnosticLevelUtil(&self->referencing.level_util, res);
 
             break;
-        }
         default:
             UNREACHABLE("unknown variant");
     }
-
-    return res;
 }
 
 VARIANT_DESTRUCTOR(DiagnosticLevelFormat,
@@ -477,11 +423,36 @@ calc_usize_length(Usize line)
     return i;
 }
 
-String *
-to_string__DiagnosticDetail(const DiagnosticDetail *self,
-                            const DiagnosticLevel *level)
+const char *
+get_line__DiagnosticDetail(const DiagnosticDetail *self,
+                           Usize position,
+                           Usize *line_len)
+{
+    if (!self->file->content) {
+        *line_len = 0;
+
+        return "";
+    }
+
+    Usize line = get_line__File(self->file, position);
+    Usize line_start = get_line_start__File(self->file, line);
+
+    *line_len = get_line_end__File(self->file, line) - line_start;
+
+    return self->file->content + line_start;
+}
+
+void
+write__DiagnosticDetail(const DiagnosticDetail *self,
+                        const DiagnosticLevel *level,
+                        String *res)
 {
-    String *res = NEW(String);
+    // NOTE: The start position can be the position of the end of the file.
+    Usize start_position =
+      self->location->start_position + 1 == self->file->len &&
+          self->location->start_position != 0
+        ? self->location->start_position - 1
+        : self->location->start_position;
     Usize line_number_length = calc_usize_length(self->location->end_line);
 
     {
@@ -490,11 +461,13 @@ to_string__DiagnosticDetail(const DiagnosticDetail *self,
         PUSH_STR_AND_FREE(res, s);
     }
 
-    if (self->lines->len == 1) {
-        char *line = format("{s}", CAST(char *, get__Vec(self->lines, 0)));
+    if (self->location->end_line == self->location->start_line) {
+        Usize line_len = 0;
+        const char *line =
+          get_line__DiagnosticDetail(self, start_position, &line_len);
         Usize count_whitespace = 0;
 
-        for (Usize i = 0; line[i]; ++i) {
+        for (Usize i = 0; i < line_len; ++i) {
             if (isblank(line[i])) {
                 count_whitespace++;
             } else
@@ -508,11 +481,9 @@ to_string__DiagnosticDetail(const DiagnosticDetail *self,
             PUSH_STR_AND_FREE(res, s);
         }
 
-        {
-            char *s = format(" {s}\n", line);
-
-            PUSH_STR_AND_FREE(res, s);
-        }
+        push__String(res, ' ');
+        push_str_with_len__String(res, line, line_len);
+        push__String(res, '\n');
 
         {
             char *s = format(
@@ -585,15 +556,13 @@ to_string__DiagnosticDetail(const DiagnosticDetail *self,
         } else {
             push_str__String(res, "\n");
         }
-
-        lily_free(line);
     } else {
-        // TODO: diagnostic on one more line.
-        // printf("%s\n", CAST(char*, get__Vec(self->lines, 0)));
-        // printf("%s\n", CAST(char*, get__Vec(self->lines, 1)));
-        char *first_line =
-          format(" {s}", CAST(char *, get__Vec(self->lines, 0)));
-        char *last_line = format(" {s}", CAST(char *, last__Vec(self->lines)));
+        Usize first_line_len = 0;
+        const char *first_line =
+          get_line__DiagnosticDetail(self, start_position, &first_line_len);
+        Usize last_line_len = 0;
+        const char *last_line = get_line__DiagnosticDetail(
+          self, self->location->end_position, &last_line_len);
 
         {
             char *s = format("\x1b[34m{d}\x1b[0m{Sr}",
@@ -604,9 +573,11 @@ to_string__DiagnosticDetail(const DiagnosticDetail *self,
         }
 
         {
-            char *s = format("{sa} {s}", BLUE("|"), first_line);
+            char *s = format("{sa} ", BLUE("|"));
 
             PUSH_STR_AND_FREE(res, s);
+            push__String(res, ' ');
+            push_str_with_len__String(res, first_line, first_line_len);
         }
 
         {
@@ -661,7 +632,7 @@ to_string__DiagnosticDetail(const DiagnosticDetail *self,
             char *s = format("\x1b[34m{Sr}\x1b[0m {sa} \x1b[34m{Sr}\x1b[0m\n",
                              repeat__String("~", line_number_length),
                              BLUE("|"),
-                             repeat__String("_", strlen(first_line)));
+                             repeat__String("_", first_line_len + 1));
 
             PUSH_STR_AND_FREE(res, s);
         }
@@ -683,16 +654,14 @@ to_string__DiagnosticDetail(const DiagnosticDetail *self,
         }
 
         {
-            char *s = format(" {sa} {s}\n", BLUE("|"), last_line);
+            char *s = format(" {sa} ", BLUE("|"));
 
             PUSH_STR_AND_FREE(res, s);
+            push__String(res, ' ');
+            push_str_with_len__String(res, last_line, last_line_len);
+            push__String(res, '\n');
         }
-
-        lily_free(first_line);
-        lily_free(last_line);
     }
-
-    return res;
 }
 
 VARIANT_CONSTRUCTOR(Diagnostic,
@@ -705,15 +674,13 @@ VARIANT_CONSTRUCTOR(Diagnostic,
                     Vec *notes,
                     String *detail_msg)
 {
-    LINES(location, file);
-
     return (
       Diagnostic){ .kind = DIAGNOSTIC_KIND_SIMPLE_CC_ERROR,
                    .level_format = NEW_VARIANT(
                      DiagnosticLevelFormat,
                      simple,
                      NEW(DiagnosticSimple,
-                         NEW(DiagnosticDetail, lines, detail_msg, location),
+                         NEW(DiagnosticDetail, file, detail_msg, location),
                          NEW(DiagnosticLevelUtil, helps, notes, location))),
                    .file = file,
                    .location = location,
@@ -730,15 +697,13 @@ VARIANT_CONSTRUCTOR(Diagnostic,
                     Vec *notes,
                     String *detail_msg)
 {
-    LINES(location, file);
-
     return (
       Diagnostic){ .kind = DIAGNOSTIC_KIND_SIMPLE_CC_NOTE,
                    .level_format = NEW_VARIANT(
                      DiagnosticLevelFormat,
                      simple,
                      NEW(DiagnosticSimple,
-                         NEW(DiagnosticDetail, lines, detail_msg, location),
+                         NEW(DiagnosticDetail, file, detail_msg, location),
                          NEW(DiagnosticLevelUtil, helps, notes, location))),
                    .file = file,
                    .location = location,
@@ -755,15 +720,13 @@ VARIANT_CONSTRUCTOR(Diagnostic,
                     Vec *notes,
                     String *detail_msg)
 {
-    LINES(location, file);
-
     return (
       Diagnostic){ .kind = DIAGNOSTIC_KIND_SIMPLE_CC_WARNING,
                    .level_format = NEW_VARIANT(
                      DiagnosticLevelFormat,
                      simple,
                      NEW(DiagnosticSimple,
-                         NEW(DiagnosticDetail, lines, detail_msg, location),
+                         NEW(DiagnosticDetail, file, detail_msg, location),
                          NEW(DiagnosticLevelUtil, helps, notes, location))),
                    .file = file,
                    .location = location,
@@ -780,15 +743,13 @@ VARIANT_CONSTRUCTOR(Diagnostic,
                     Vec *notes,
                     String *detail_msg)
 {
-    LINES(location, file);
-
     return (
       Diagnostic){ .kind = DIAGNOSTIC_KIND_SIMPLE_CI_ERROR,
                    .level_format = NEW_VARIANT(
                      DiagnosticLevelFormat,
                      simple,
                      NEW(DiagnosticSimple,
-                         NEW(DiagnosticDetail, lines, detail_msg, location),
+                         NEW(DiagnosticDetail, file, detail_msg, location),
                          NEW(DiagnosticLevelUtil, helps, notes, location))),
                    .file = file,
                    .location = location,
@@ -805,15 +766,13 @@ VARIANT_CONSTRUCTOR(Diagnostic,
                     Vec *notes,
                     String *detail_msg)
 {
-    LINES(location, file);
-
     return (
       Diagnostic){ .kind = DIAGNOSTIC_KIND_SIMPLE_CI_NOTE,
                    .level_format = NEW_VARIANT(
                      DiagnosticLevelFormat,
                      simple,
                      NEW(DiagnosticSimple,
-                         NEW(DiagnosticDetail, lines, detail_msg, location),
+                         NEW(DiagnosticDetail, file, detail_msg, location),
                          NEW(DiagnosticLevelUtil, helps, notes, location))),
                    .file = file,
                    .location = location,
@@ -830,15 +789,13 @@ VARIANT_CONSTRUCTOR(Diagnostic,
                     Vec *notes,
                     String *detail_msg)
 {
-    LINES(location, file);
-
     return (
       Diagnostic){ .kind = DIAGNOSTIC_KIND_SIMPLE_CI_WARNING,
                    .level_format = NEW_VARIANT(
                      DiagnosticLevelFormat,
                      simple,
                      NEW(DiagnosticSimple,
-                         NEW(DiagnosticDetail, lines, detail_msg, location),
+                         NEW(DiagnosticDetail, file, detail_msg, location),
                          NEW(DiagnosticLevelUtil, helps, notes, location))),
                    .file = file,
                    .location = location,
@@ -855,15 +812,13 @@ VARIANT_CONSTRUCTOR(Diagnostic,
                     Vec *notes,
                     String *detail_msg)
 {
-    LINES(location, file);
-
     return (
       Diagnostic){ .kind = DIAGNOSTIC_KIND_SIMPLE_CPP_ERROR,
                    .level_format = NEW_VARIANT(
                      DiagnosticLevelFormat,
                      simple,
                      NEW(DiagnosticSimple,
-                         NEW(DiagnosticDetail, lines, detail_msg, location),
+                         NEW(DiagnosticDetail, file, detail_msg, location),
                          NEW(DiagnosticLevelUtil, helps, notes, location))),
                    .file = file,
                    .location = location,
@@ -880,15 +835,13 @@ VARIANT_CONSTRUCTOR(Diagnostic,
                     Vec *notes,
                     String *detail_msg)
 {
-    LINES(location, file);
-
     return (
       Diagnostic){ .kind = DIAGNOSTIC_KIND_SIMPLE_CPP_NOTE,
                    .level_format = NEW_VARIANT(
                      DiagnosticLevelFormat,
                      simple,
                      NEW(DiagnosticSimple,
-                         NEW(DiagnosticDetail, lines, detail_msg, location),
+                         NEW(DiagnosticDetail, file, detail_msg, location),
                          NEW(DiagnosticLevelUtil, helps, notes, location))),
                    .file = file,
                    .location = location,
@@ -905,15 +858,13 @@ VARIANT_CONSTRUCTOR(Diagnostic,
                     Vec *notes,
                     String *detail_msg)
 {
-    LINES(location, file);
-
     return (Diagnostic){
         .kind = DIAGNOSTIC_KIND_SIMPLE_CPP_WARNING,
         .level_format =
           NEW_VARIANT(DiagnosticLevelFormat,
                       simple,
                       NEW(DiagnosticSimple,
-                          NEW(DiagnosticDetail, lines, detail_msg, location),
+                          NEW(DiagnosticDetail, file, detail_msg, location),
                           NEW(DiagnosticLevelUtil, helps, notes, location))),
         .file = file,
         .location = location,
@@ -931,15 +882,13 @@ VARIANT_CONSTRUCTOR(Diagnostic,
                     Vec *notes,
                     String *detail_msg)
 {
-    LINES(location, file);
-
     return (
       Diagnostic){ .kind = DIAGNOSTIC_KIND_SIMPLE_LILY_ERROR,
                    .level_format = NEW_VARIANT(
                      DiagnosticLevelFormat,
                      simple,
                      NEW(DiagnosticSimple,
-                         NEW(DiagnosticDetail, lines, detail_msg, location),
+                         NEW(DiagnosticDetail, file, detail_msg, location),
                          NEW(DiagnosticLevelUtil, helps, notes, location))),
                    .file = file,
                    .location = location,
@@ -956,15 +905,13 @@ VARIANT_CONSTRUCTOR(Diagnostic,
                     Vec *notes,
                     String *detail_msg)
 {
-    LINES(location, file);
-
     return (
       Diagnostic){ .kind = DIAGNOSTIC_KIND_SIMPLE_LILY_NOTE,
                    .level_format = NEW_VARIANT(
                      DiagnosticLevelFormat,
                      simple,
                      NEW(DiagnosticSimple,
-                         NEW(DiagnosticDetail, lines, detail_msg, location),
+                         NEW(DiagnosticDetail, file, detail_msg, location),
                          NEW(DiagnosticLevelUtil, helps, notes, location))),
                    .file = file,
                    .location = location,
@@ -982,15 +929,13 @@ VARIANT_CONSTRUCTOR(Diagnostic,
                     String *detail_msg)
 {
 
-    LINES(location, file);
-
     return (Diagnostic){
         .kind = DIAGNOSTIC_KIND_SIMPLE_LILY_WARNING,
         .level_format =
           NEW_VARIANT(DiagnosticLevelFormat,
                       simple,
                       NEW(DiagnosticSimple,
-                          NEW(DiagnosticDetail, lines, detail_msg, location),
+                          NEW(DiagnosticDetail, file, detail_msg, location),
                           NEW(DiagnosticLevelUtil, helps, notes, location))),
         .file = file,
         .location = location,
@@ -1276,11 +1221,9 @@ VARIANT_CONSTRUCTOR(Diagnostic,
     };
 }
 
-String *
-to_string__Diagnostic(const Diagnostic *self)
+void
+write__Diagnostic(const Diagnostic *self, String *res)
 {
-    String *res = NEW(String);
-
     {
         char *s = format("{s}:{d}:{d}: ",
                          self->file->name,
@@ -1381,14 +1324,286 @@ to_string__Diagnostic(const Diagnostic *self)
 
     push__String(res, '\n');
 
+    write__DiagnosticLevelFormat(&self->level_format, &self->level, res);
+}
+
+void
+write_json_str__Diagnostic(const char *s, Usize len, String *res)
+{
+    push__String(res, '"');
+
+    for (Usize i = 0; i < len; ++i) {
+        switch (s[i]) {
+            case '"':
+                push_str__String(res, "\\\"");
+                break;
+            case '\\':
+                push_str__String(res, "\\\\");
+                break;
+            case '\n':
+                push_str__String(res, "\\n");
+                break;
+            case '\r':
+                push_str__String(res, "\\r");
+                break;
+            case '\t':
+                push_str__String(res, "\\t");
+                break;
+            default:
+                if ((unsigned char)s[i] < 0x20) {
+                    char escaped[7];
+
+                    snprintf(
+                      escaped, sizeof(escaped), "\\u%04x", (unsigned char)s[i]);
+                    push_str__String(res, escaped);
+                } else {
+                    push__String(res, s[i]);
+                }
+        }
+    }
+
+    push__String(res, '"');
+}
+
+void
+write_json_strings__Diagnostic(const char *key,
+                               const Vec *strings,
+                               String *res)
+{
+    push_str__String(res, ",\"");
+    push_str__String(res, (char *)key);
+    push_str__String(res, "\":[");
+
+    for (Usize i = 0; strings && i < strings->len; ++i) {
+        const String *string = get__Vec(strings, i);
+
+        if (i > 0) {
+            push__String(res, ',');
+        }
+
+        write_json_str__Diagnostic(string->buffer, string->len, res);
+    }
+
+    push__String(res, ']');
+}
+
+void
+write_json_level__Diagnostic(const Diagnostic *self, String *res)
+{
+    char *level = NULL;
+    char *code = NULL; // char*?
+    char *msg = NULL;
+    bool must_free_msg = false;
+
+    switch (self->level.kind) {
+        case DIAGNOSTIC_LEVEL_KIND_CC_ERROR:
+            level = "error";
+            code = to_code__CcError(&self->level.cc_error);
+            msg = to_msg__CcError(&self->level.cc_error);
+            must_free_msg =
+              self->level.cc_error.kind == CC_ERROR_KIND_UNEXPECTED_TOKEN;
+
+            break;
+        case DIAGNOSTIC_LEVEL_KIND_CC_NOTE:
+            level = "note";
+            msg = self->level.cc_note->buffer;
+
+            break;
+        case DIAGNOSTIC_LEVEL_KIND_CC_WARNING:
+            level = "warning";
+            code = to_code__CcWarning(&self->level.cc_warning);
+            msg = to_msg__CcWarning(&self->level.cc_warning);
+
+            break;
+        case DIAGNOSTIC_LEVEL_KIND_CI_ERROR:
+            level = "error";
+            code = to_code__CIError(&self->level.ci_error);
+            msg = to_msg__CIError(&self->level.ci_error);
+
+            break;
+        case DIAGNOSTIC_LEVEL_KIND_CI_NOTE:
+            level = "note";
+            msg = self->level.ci_note->buffer;
+
+            break;
+        case DIAGNOSTIC_LEVEL_KIND_CI_WARNING:
+            level = "warning";
+            code = to_code__CIWarning(&self->level.ci_warning);
+            msg = to_msg__CIWarning(&self->level.ci_warning);
+
+            break;
+        case DIAGNOSTIC_LEVEL_KIND_CPP_ERROR:
+            level = "error";
+            code = to_code__CppError(&self->level.cpp_error);
+            msg = to_msg__CppError(&self->level.cpp_error);
+            must_free_msg =
+              self->level.cpp_error.kind == CPP_ERROR_KIND_UNEXPECTED_TOKEN;
+
+            break;
+        case DIAGNOSTIC_LEVEL_KIND_CPP_NOTE:
+            level = "note";
+            msg = self->level.cpp_note->buffer;
+
+            break;
+        case DIAGNOSTIC_LEVEL_KIND_CPP_WARNING:
+            level = "warning";
+            code = to_code__CppWarning(&self->level.cpp_warning);
+            msg = to_msg__CppWarning(&self->level.cpp_warning);
+
+            break;
+        case DIAGNOSTIC_LEVEL_KIND_LILY_ERROR:
+            level = "error";
+            code = to_code__LilyError(&self->level.lily_error);
+            msg = to_msg__LilyError(&self->level.lily_error);
+            must_free_msg =
+              self->level.lily_error.kind == LILY_ERROR_KIND_UNEXPECTED_TOKEN;
+
+            break;
+        case DIAGNOSTIC_LEVEL_KIND_LILY_NOTE:
+            level = "note";
+            msg = self->level.lily_note->buffer;
+
+            break;
+        case DIAGNOSTIC_LEVEL_KIND_LILY_WARNING:
+            level = "warning";
+            code = to_code__LilyWarning(&self->level.lily_warning);
+            msg = to_msg__LilyWarning(&self->level.lily_warning);
+
+            break;
+        default:
+            UNREACHABLE("unknown variant");
+    }
+
+    push_str__String(res, ",\"level\":\"");
+    push_str__String(res, level);
+    push_str__String(res, "\",\"code\":");
+
+    if (code) {
+        write_json_str__Diagnostic(code, strlen(code), res);
+    } else {
+        push_str__String(res, "null");
+    }
+
+    push_str__String(res, ",\"message\":");
+    write_json_str__Diagnostic(msg, strlen(msg), res);
+
+    if (must_free_msg) {
+        lily_free(msg);
+    }
+}
+
+void
+write_json__Diagnostic(const Diagnostic *self, String *res)
+{
+    const DiagnosticLevelUtil *level_util = NULL;
+
     {
-        String *s =
-          to_string__DiagnosticLevelFormat(&self->level_format, &self->level);
+        push_str__String(res, "{\"file\":");
+        write_json_str__Diagnostic(
+          self->file->name ? self->file->name : "",
+          self->file->name ? strlen(self->file->name) : 0,
+          res);
+
+        char *s = format(",\"start_line\":{zu},\"start_column\":{zu},"
+                         "\"end_line\":{zu},\"end_column\":{zu}",
+                         self->location->start_line,
+                         self->location->start_column,
+                         self->location->end_line,
+                         self->location->end_column);
+
+        PUSH_STR_AND_FREE(res, s);
+    }
+
+    write_json_level__Diagnostic(self, res);
+
+    switch (self->level_format.kind) {
+        case DIAGNOSTIC_LEVEL_FORMAT_KIND_SIMPLE: {
+            const String *detail_msg = self->level_format.simple.detail.msg;
+
+            push_str__String(res, ",\"detail\":");
+
+            if (detail_msg) {
+                write_json_str__Diagnostic(
+                  detail_msg->buffer, detail_msg->len, res);
+            } else {
+                push_str__String(res, "null");
+            }
+
+            level_util = &self->level_format.simple.level_util;
+
+            break;
+        }
+        case DIAGNOSTIC_LEVEL_FORMAT_KIND_REFERENCING: {
+            const Vec *items = self->level_format.referencing.items;
+
+            push_str__String(res, ",\"references\":[");
+
+            for (Usize i = 0; i < items->len; ++i) {
+                const DiagnosticReferencingItem *item = get__Vec(items, i);
+
+                if (i > 0) {
+                    push__String(res, ',');
+                }
+
+                push_str__String(res, "{\"message\":");
+                write_json_str__Diagnostic(
+                  item->msg ? item->msg->buffer : "",
+                  item->msg ? item->msg->len : 0,
+                  res);
+
+                char *s = format(",\"start_line\":{zu},\"start_column\":{zu}",
+                                 item->detail.location->start_line,
+                                 item->detail.location->start_column);
+
+                PUSH_STR_AND_FREE(res, s);
+                push__String(res, '}');
+            }
+
+            push__String(res, ']');
 
-        APPEND_AND_FREE(res, s);
+            level_util = &self->level_format.referencing.level_util;
+
+            break;
+        }
+        default:
+            UNREACHABLE("unknown variant");
+    }
+
+    write_json_strings__Diagnostic("helps", level_util->helps, res);
+    write_json_strings__Diagnostic("notes", level_util->notes, res);
+
+    push__String(res, '}');
+}
+
+void
+emit_base__Diagnostic(const Diagnostic *self)
+{
+    if (!diagnostic_buffer) {
+        diagnostic_buffer = NEW(String);
     }
 
-    return res;
+    clear__String(diagnostic_buffer);
+
+    switch (diagnostic_format) {
+        case DIAGNOSTIC_FORMAT_HUMAN:
+            write__Diagnostic(self, diagnostic_buffer);
+            break;
+        case DIAGNOSTIC_FORMAT_JSON:
+            write_json__Diagnostic(self, diagnostic_buffer);
+            break;
+        default:
+            UNREACHABLE("unknown variant");
+    }
+
+    push__String(diagnostic_buffer, '\n');
+
+    fwrite(diagnostic_buffer->buffer, 1, diagnostic_buffer->len, stderr);
+}
+
+void
+set_format__Diagnostic(enum DiagnosticFormat format)
+{
+    diagnostic_format = format;
 }
 
 void
@@ -1429,7 +1644,7 @@ emit_warning__Diagnostic(Diagnostic self,
 
     *count_warning += 1;
 
-    EPRINTLN("{Sr}", to_string__Diagnostic(&self));
+    emit_base__Diagnostic(&self);
 
     FREE(Diagnostic, &self);
 }
@@ -1447,7 +1662,7 @@ emit_note__Diagnostic(Diagnostic self)
             UNREACHABLE("expected note diagnostic level");
     }
 
-    EPRINTLN("{Sr}", to_string__Diagnostic(&self));
+    emit_base__Diagnostic(&self);
 
     FREE(Diagnostic, &self);
 }
@@ -1466,7 +1681,7 @@ emit__Diagnostic(Diagnostic self, Usize *count_error)
             UNREACHABLE("expected error diagnostic level");
     }
 
-    EPRINTLN("{Sr}", to_string__Diagnostic(&self));
+    emit_base__Diagnostic(&self);
 
     FREE(Diagnostic, &self);
 }
@@ -0,0 +1,153 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/assert.h>
+
+#include <core/shared/file.h>
+
+/**
+ *
+ * @brief Get the length of the content (without the null character).
+ */
+static inline Usize
+get_content_len__File(const File *self);
+
+/**
+ *
+ * @brief Get the index of the line in `line_starts`, the line is clamped
+ * between the first and the last line of the file.
+ */
+static inline Usize
+get_line_index__File(const File *self, Usize line);
+
+Usize
+get_content_len__File(const File *self)
+{
+    return self->content && self->len > 0 ? self->len - 1 : 0;
+}
+
+Usize
+get_line_index__File(const File *self, Usize line)
+{
+    ASSERT(self->line_starts_len > 0);
+
+    if (line == 0) {
+        return 0;
+    } else if (line > self->line_starts_len) {
+        return self->line_starts_len - 1;
+    }
+
+    return line - 1;
+}
+
+CONSTRUCTOR(File, File, char *name, char *content)
+{
+    File self = { .name = name,
+                  .content = content,
+                  .len = get_size__File(name) + 1,
+                  .line_starts = NULL,
+                  .line_starts_len = 0 };
+    Usize content_len = get_content_len__File(&self);
+
+    if (!content) {
+        return self;
+    }
+
+    Usize lines_count = 1;
+
+    for (const char *current = content;
+         (current =
+            memchr(current, '\n', content_len - (current - content)));
+         ++current) {
+        ++lines_count;
+    }
+
+    self.line_starts = lily_malloc(sizeof(Usize) * lines_count);
+    self.line_starts[self.line_starts_len++] = 0;
+
+    for (Usize i = 0; i < content_len; ++i) {
+        if (content[i] == '\n') {
+            self.line_starts[self.line_starts_len++] = i + 1;
+        }
+    }
+
+    return self;
+}
+
+Usize
+get_line__File(const File *self, Usize position)
+{
+    if (self->line_starts_len == 0) {
+        return 1;
+    }
+
+    // Search the last line starting before (or at) the position.
+    Usize low = 0;
+    Usize high = self->line_starts_len;
+
+    while (high - low > 1) {
+        Usize middle = low + (high - low) / 2;
+
+        if (self->line_starts[middle] <= position) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low + 1;
+}
+
+Usize
+get_line_start__File(const File *self, Usize line)
+{
+    if (self->line_starts_len == 0) {
+        return 0;
+    }
+
+    return self->line_starts[get_line_index__File(self, line)];
+}
+
+Usize
+get_line_end__File(const File *self, Usize line)
+{
+    if (self->line_starts_len == 0) {
+        return 0;
+    }
+
+    Usize line_index = get_line_index__File(self, line);
+
+    return line_index + 1 < self->line_starts_len
+             ? self->line_starts[line_index + 1] - 1
+             : get_content_len__File(self);
+}
+
+DESTRUCTOR(File, const File *self)
+{
+    lily_free(self->content);
+
+    if (self->line_starts) {
+        lily_free(self->line_starts);
+    }
+}
@@ -23,37 +23,124 @@
  */
 
 #include <base/assert.h>
+#include <base/memscan.h>
 
 #include <core/shared/scanner.h>
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+/**
+ *
+ * @brief Get the current character.
+ */
+static inline const char *
+current__Scanner(const Scanner *self);
+
+/**
+ *
+ * @brief Get the number of characters from the current character to the last
+ * character where the cursor can move.
+ */
+static inline Usize
+remaining__Scanner(const Scanner *self);
+
+const char *
+current__Scanner(const Scanner *self)
+{
+    return self->source.file->content + self->source.cursor.position;
+}
+
+Usize
+remaining__Scanner(const Scanner *self)
+{
+    return self->source.cursor.position < self->source.file->len - 1
+             ? self->source.file->len - 1 - self->source.cursor.position
+             : 0;
+}
 
 void
 skip_space__Scanner(Scanner *self)
 {
-    while (isspace(self->source.cursor.current) &&
-           self->source.cursor.position < self->source.file->len - 1) {
-        next_char__Scanner(self);
-    }
+    advance__Source(&self->source,
+                    span_space__MemScan(
+                      current__Scanner(self), remaining__Scanner(self), true));
 }
 
 void
 skip_space_except_new_line__Scanner(Scanner *self)
 {
-    while (self->source.cursor.current != '\n' &&
-           isspace(self->source.cursor.current) &&
-           self->source.cursor.position < self->source.file->len - 1) {
-        next_char__Scanner(self);
-    }
+    advance__Source(&self->source,
+                    span_space__MemScan(
+                      current__Scanner(self), remaining__Scanner(self), false));
 }
 
 void
 jump__Scanner(Scanner *self, Usize n)
 {
-    while (n--) {
-        next_char__Scanner(self);
+    advance__Source(&self->source, n);
+}
+
+void
+skip_line__Scanner(Scanner *self)
+{
+    const char *current = current__Scanner(self);
+    const char *new_line = memchr(current, '\n', remaining__Scanner(self));
+
+    advance__Source(&self->source,
+                    new_line ? (Usize)(new_line - current)
+                             : remaining__Scanner(self));
+}
+
+void
+skip_comment_block__Scanner(Scanner *self)
+{
+    const char *current = current__Scanner(self);
+    // NOTE: The `/` of `*/` must also be before the last character.
+    Usize len = remaining__Scanner(self) > 0 ? remaining__Scanner(self) - 1 : 0;
+    Usize i = 0;
+
+    while (i < len) {
+        const char *star = memchr(current + i, '*', len - i);
+
+        if (!star) {
+            i = len;
+            break;
+        }
+
+        i = star - current;
+
+        if (current[i + 1] == '/') {
+            break;
+        }
+
+        ++i;
     }
+
+    advance__Source(&self->source, i);
+}
+
+void
+scan_ident_chars__Scanner(Scanner *self, String *res, bool with_dollar)
+{
+    const char *current = current__Scanner(self);
+    Usize n =
+      span_ident__MemScan(current, remaining__Scanner(self), with_dollar);
+
+    push_str_with_len__String(res, current, n);
+    advance__Source(&self->source, n);
+}
+
+void
+scan_string_chars__Scanner(Scanner *self, String *res)
+{
+    const char *current = current__Scanner(self);
+    Usize n =
+      find_any__MemScan(current, remaining__Scanner(self), '\"', '\\');
+
+    push_str_with_len__String(res, current, n);
+    advance__Source(&self->source, n);
 }
 
 void
@@ -26,6 +26,30 @@
 
 #include <string.h>
 
+/**
+ *
+ * @brief Hash the whole id (seeded FNV-1a with a final avalanche).
+ */
+static inline Uint64
+hash__SearchPerfectHash(Uint64 seed, const char *buffer, Usize len);
+
+/**
+ *
+ * @brief Get the slot index of the hash displaced by `displacement`.
+ */
+static inline Uint32
+index__SearchPerfectHash(Uint64 hash,
+                         Uint32 displacement,
+                         Uint32 capacity_mask);
+
+/**
+ *
+ * @brief Try to find a displacement for each bucket with the given seed.
+ * @return false if a bucket cannot be placed without collision.
+ */
+static bool
+try_fill__SearchPerfectHash(SearchPerfectHash *self, Uint64 seed);
+
 Int32
 get_id__Search(const String *id,
                const SizedStr ids_s[],
@@ -61,3 +85,190 @@ get_id__Search(const String *id,
 
     return -1;
 }
+
+Uint64
+hash__SearchPerfectHash(Uint64 seed, const char *buffer, Usize len)
+{
+    Uint64 hash = seed ^ 0xCBF29CE484222325;
+
+    for (Usize i = 0; i < len; ++i) {
+        hash = (hash ^ (Uint8)buffer[i]) * 0x100000001B3;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCD;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+Uint32
+index__SearchPerfectHash(Uint64 hash,
+                         Uint32 displacement,
+                         Uint32 capacity_mask)
+{
+    // NOTE: The step is odd, so that every displacement gives another slot
+    // when the capacity is a power of two.
+    Uint32 first = (Uint32)(hash >> 32);
+    Uint32 step = (Uint32)(hash >> 16) | 1;
+
+    return (first + displacement * step) & capacity_mask;
+}
+
+bool
+try_fill__SearchPerfectHash(SearchPerfectHash *self, Uint64 seed)
+{
+    Uint64 hashes[SEARCH_PERFECT_HASH_MAX_CAPACITY];
+    Uint8 bucket_lens[SEARCH_PERFECT_HASH_MAX_BUCKETS] = { 0 };
+    Uint8 order[SEARCH_PERFECT_HASH_MAX_BUCKETS];
+    Usize n_bucket = self->buckets_mask + 1;
+
+    memset(self->slots, 0, sizeof(self->slots));
+    memset(self->displacements, 0, sizeof(self->displacements));
+
+    for (Usize i = 0; i < self->ids_s_len; ++i) {
+        hashes[i] = hash__SearchPerfectHash(
+          seed, self->ids_s[i].buffer, self->ids_s[i].len);
+        ++bucket_lens[hashes[i] & self->buckets_mask];
+    }
+
+    // Place the largest buckets first, while most of the slots are free.
+    for (Usize i = 0; i < n_bucket; ++i) {
+        Usize j = i;
+
+        for (; j > 0 && bucket_lens[order[j - 1]] < bucket_lens[i]; --j) {
+            order[j] = order[j - 1];
+        }
+
+        order[j] = i;
+    }
+
+    for (Usize i = 0; i < n_bucket && bucket_lens[order[i]]; ++i) {
+        Uint8 bucket = order[i];
+        Uint32 displacement = 0;
+
+        for (; displacement <= self->capacity_mask; ++displacement) {
+            Usize placed = 0;
+
+            for (; placed < self->ids_s_len; ++placed) {
+                if ((hashes[placed] & self->buckets_mask) != bucket) {
+                    continue;
+                }
+
+                Uint32 index = index__SearchPerfectHash(
+                  hashes[placed], displacement, self->capacity_mask);
+
+                if (self->slots[index]) {
+                    break;
+                }
+
+                self->slots[index] = placed + 1;
+            }
+
+            if (placed == self->ids_s_len) {
+                break;
+            }
+
+            // Undo the ids of the bucket placed with this displacement.
+            for (Usize j = 0; j < placed; ++j) {
+                if ((hashes[j] & self->buckets_mask) == bucket) {
+                    self->slots[index__SearchPerfectHash(
+                      hashes[j], displacement, self->capacity_mask)] = 0;
+                }
+            }
+        }
+
+        if (displacement > self->capacity_mask) {
+            return false;
+        }
+
+        self->displacements[bucket] = displacement;
+    }
+
+    return true;
+}
+
+CONSTRUCTOR(SearchPerfectHash,
+            SearchPerfectHash,
+            const SizedStr ids_s[],
+            const Int32 ids[],
+            const Usize ids_s_len)
+{
+    SearchPerfectHash self = { .ids_s = ids_s,
+                               .ids = ids,
+                               .ids_s_len = ids_s_len,
+                               .seed = 0,
+                               .capacity_mask = 0,
+                               .buckets_mask = 0,
+                               .is_perfect = false };
+
+    if (ids_s_len == 0 || ids_s_len >= SEARCH_PERFECT_HASH_MAX_CAPACITY) {
+        return self;
+    }
+
+    Usize capacity = 1;
+    Usize n_bucket = 1;
+
+    while (capacity < ids_s_len) {
+        capacity <<= 1;
+    }
+
+    while (n_bucket * 4 < ids_s_len &&
+           n_bucket < SEARCH_PERFECT_HASH_MAX_BUCKETS) {
+        n_bucket <<= 1;
+    }
+
+    self.buckets_mask = n_bucket - 1;
+
+    // Start at the smallest power of two that holds every id, then double the
+    // capacity until every bucket is placed without any collision.
+    for (; capacity <= SEARCH_PERFECT_HASH_MAX_CAPACITY; capacity <<= 1) {
+        self.capacity_mask = capacity - 1;
+
+        for (Uint64 i = 0; i < SEARCH_PERFECT_HASH_MAX_SEED_TRIES; ++i) {
+            Uint64 seed = i * 0x9E3779B97F4A7C15;
+
+            if (try_fill__SearchPerfectHash(&self, seed)) {
+                self.seed = seed;
+                self.is_perfect = true;
+
+                return self;
+            }
+        }
+    }
+
+    self.capacity_mask = 0;
+    memset(self.slots, 0, sizeof(self.slots));
+    memset(self.displacements, 0, sizeof(self.displacements));
+
+    return self;
+}
+
+Int32
+get_id__SearchPerfectHash(const SearchPerfectHash *self, const String *id)
+{
+    if (!self->is_perfect) {
+        return get_id__Search(id, self->ids_s, self->ids, self->ids_s_len);
+    } else if (id->len == 0) {
+        return -1;
+    }
+
+    Uint64 hash = hash__SearchPerfectHash(self->seed, id->buffer, id->len);
+    Uint8 slot = self->slots[index__SearchPerfectHash(
+      hash,
+      self->displacements[hash & self->buckets_mask],
+      self->capacity_mask)];
+
+    if (slot) {
+        const SizedStr *current = &self->ids_s[slot - 1];
+
+        if (current->len == id->len &&
+            !memcmp(current->buffer, id->buffer, id->len)) {
+            return self->ids[slot - 1];
+        }
+    }
+
+    return -1;
+}
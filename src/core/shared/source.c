@@ -22,6 +22,8 @@
  * SOFTWARE.
  */
 
+#include <base/memscan.h>
+
 #include <core/shared/source.h>
 
 #include <string.h>
@@ -40,6 +42,39 @@ next_char__Source(Source *self)
     }
 }
 
+void
+advance__Source(Source *self, Usize n)
+{
+    Usize end = self->file->len - 1;
+
+    if (self->cursor.position + n > end) {
+        n = self->cursor.position < end ? end - self->cursor.position : 0;
+    }
+
+    if (n == 0) {
+        return;
+    }
+
+    const char *skipped = self->file->content + self->cursor.position;
+    Usize new_lines = count__MemScan(skipped, n, '\n');
+
+    if (new_lines > 0) {
+        Usize last_new_line = n - 1;
+
+        while (skipped[last_new_line] != '\n') {
+            --last_new_line;
+        }
+
+        self->cursor.line += new_lines;
+        self->cursor.column = n - last_new_line;
+    } else {
+        self->cursor.column += n;
+    }
+
+    self->cursor.position += n;
+    self->cursor.current = self->file->content[self->cursor.position];
+}
+
 void
 previous_char__Source(Source *self)
 {
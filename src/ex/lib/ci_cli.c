@@ -49,7 +49,9 @@ extern inline CONSTRUCTOR(CIConfigCompile,
                           enum CIStandard standard,
                           Vec *includes,
                           Vec *includes0,
-                          bool no_state_check);
+                          bool no_state_check,
+                          Usize jobs,
+                          bool json_diagnostics);
 
 extern inline DESTRUCTOR(CIConfigCompile, const CIConfigCompile *self);
 
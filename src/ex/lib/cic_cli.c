@@ -38,6 +38,8 @@ extern inline CONSTRUCTOR(CIcConfig,
                           enum CIStandard standard,
                           Vec *includes,
                           Vec *includes0,
-                          bool no_state_check);
+                          bool no_state_check,
+                          Usize jobs,
+                          bool json_diagnostics);
 
 #endif // LILY_EX_LIB_CIC_CLI_C
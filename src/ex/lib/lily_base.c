@@ -34,10 +34,13 @@
 #include <base/cli/value.h>
 #include <base/env.h>
 #include <base/file.h>
+#include <base/hash_ctrl.h>
 #include <base/hash_map.h>
+#include <base/job_runner.h>
 #include <base/linked_list.h>
 #include <base/memory/api.h>
 #include <base/memory/arena.h>
+#include <base/memory/arena_chain.h>
 #include <base/memory/page.h>
 #include <base/object/schema.h>
 #include <base/object/value/list.h>
@@ -70,6 +73,39 @@ open__File(const char *filename, const char *modes);
 extern inline Int32
 close__File(FILE *stream);
 
+// <base/hash_ctrl.h>
+extern inline Usize
+h1__HashCtrl(Usize hash);
+
+extern inline Int8
+h2__HashCtrl(Usize hash);
+
+extern inline HashCtrlMask
+match__HashCtrl(const Int8 *group, Int8 h2);
+
+extern inline HashCtrlMask
+match_empty__HashCtrl(const Int8 *group);
+
+extern inline HashCtrlMask
+match_empty_or_deleted__HashCtrl(const Int8 *group);
+
+extern inline HashCtrlMask
+match_full__HashCtrl(const Int8 *group);
+
+extern inline Usize
+next__HashCtrlMask(HashCtrlMask *self);
+
+extern inline void
+set__HashCtrl(Int8 *ctrls, Usize capacity, Usize index, Int8 ctrl);
+
+extern inline CONSTRUCTOR(HashCtrlProbe,
+                          HashCtrlProbe,
+                          Usize hash,
+                          Usize capacity);
+
+extern inline void
+next__HashCtrlProbe(HashCtrlProbe *self);
+
 // <base/hash_map.h>
 extern inline CONSTRUCTOR(HashMapPair, HashMapPair, char *key, void *value);
 
@@ -86,6 +122,10 @@ extern inline CONSTRUCTOR(HashMapIterPair,
 
 extern inline CONSTRUCTOR(HashMapIter, HashMapIter, HashMap *hash_map);
 
+// <base/job_runner.h>
+extern inline bool
+has_failed__Job(const Job *self);
+
 // <base/linked_list.h>
 extern inline DESTRUCTOR(LinkedListNode, LinkedListNode *self);
 
@@ -167,6 +207,9 @@ extern inline void *
 next__SizedArrayIter(SizedArrayIter *self);
 
 // <base/string.h>
+extern inline void
+clear__String(String *self);
+
 extern inline bool
 is_empty__String(const String *self);
 
@@ -252,6 +295,11 @@ extern inline CONSTRUCTOR(MemoryApi, MemoryApi);
 // <base/memory/arena.h>
 extern inline CONSTRUCTOR(MemoryArena, MemoryArena, Usize capacity);
 
+// <base/memory/arena_chain.h>
+extern inline CONSTRUCTOR(MemoryArenaChain,
+                          MemoryArenaChain,
+                          Usize arena_capacity);
+
 // <base/memory/page.h>
 extern inline CONSTRUCTOR(MemoryPage, MemoryPage);
 
@@ -98,7 +98,8 @@ extern inline CONSTRUCTOR(LilyConfigRun,
                           bool verbose,
                           Vec *args,
                           Usize max_stack,
-                          Usize max_heap);
+                          Usize max_heap,
+                          Usize jobs);
 
 // <cli/lily/config/test.h>
 extern inline CONSTRUCTOR(LilyConfigTest, LilyConfigTest, const char *filename);
@@ -547,7 +547,12 @@ is_source__CIFile(const char *filename);
 // <core/cc/ci/generator.h>
 extern inline CONSTRUCTOR(CIGeneratorContent, CIGeneratorContent);
 
-extern inline CONSTRUCTOR(CIGenerator, CIGenerator, const CIResultFile *file);
+extern inline CONSTRUCTOR(CIGeneratorGenCache, CIGeneratorGenCache);
+
+extern inline CONSTRUCTOR(CIGenerator,
+                          CIGenerator,
+                          const CIResultFile *file,
+                          CIGeneratorGenCache *gen_cache);
 
 // <core/cc/ci/project_config.h>
 extern inline CONSTRUCTOR(CIProjectConfigCompiler,
@@ -248,6 +248,9 @@ extern inline bool
 eq__LilyCheckedDataTypeLen(const LilyCheckedDataTypeLen *self,
                            const LilyCheckedDataTypeLen *other);
 
+extern inline bool
+may_eq_hash__LilyCheckedDataType(Uint64 self, Uint64 other);
+
 extern inline bool
 is_literal_data_type__LilyCheckedDataType(LilyCheckedDataType *self);
 
@@ -42,6 +42,9 @@ extern inline VARIANT_CONSTRUCTOR(LilyInterpreterMemory,
 
 extern inline CONSTRUCTOR(LilyInterpreterMemory, LilyInterpreterMemory);
 
+extern inline Usize
+get_size__LilyInterpreterMemory(const LilyInterpreterMemory *self);
+
 // <core/lily/interpreter/vm/value.h>
 extern inline VARIANT_CONSTRUCTOR(LilyInterpreterValue,
                                   LilyInterpreterValue,
@@ -157,6 +160,13 @@ extern inline CONSTRUCTOR(LilyInterpreterValue,
 extern inline LilyInterpreterValue *
 ref__LilyInterpreterValue(LilyInterpreterValue *self);
 
+extern inline CONSTRUCTOR(LilyInterpreterValueObject,
+                          LilyInterpreterValueObject,
+                          enum LilyInterpreterValueKind kind);
+
+extern inline void
+ref__LilyInterpreterValueObject(LilyInterpreterValueObject *self);
+
 extern inline LilyInterpreterValue
 get__LilyInterpreterValueDynamicArray(
   const LilyInterpreterValueDynamicArray *self,
@@ -61,7 +61,8 @@ extern inline CONSTRUCTOR(LilyPackageInterpreterConfig,
                           Vec *args,
                           bool verbose,
                           Usize max_heap,
-                          Usize max_stack);
+                          Usize max_stack,
+                          Usize jobs);
 
 extern inline LilyPackageInterpreterConfig
 default__LilyPackageInterpreterConfig();
@@ -104,15 +104,10 @@ extern inline VARIANT_CONSTRUCTOR(DiagnosticLevel,
 
 extern inline CONSTRUCTOR(DiagnosticDetail,
                           DiagnosticDetail,
-                          Vec *lines,
+                          const File *file,
                           String *msg,
                           const Location *location);
 
-// <core/shared/file.h>
-extern inline CONSTRUCTOR(File, File, char *name, char *content);
-
-extern inline DESTRUCTOR(File, const File *self);
-
 // <core/shared/location.h>
 extern inline CONSTRUCTOR(Location,
                           Location,
@@ -147,10 +142,7 @@ is_space_with_peeked_char__Scanner([[maybe_unused]] const Scanner *,
                                    const char *c);
 
 extern inline Int32
-get_keyword__Scanner(const String *id,
-                     const SizedStr keywords[],
-                     const Int32 keyword_ids[],
-                     const Usize keywords_len);
+get_keyword__Scanner(const String *id, const SearchPerfectHash *keywords);
 
 // <core/shared/source.h>
 extern inline CONSTRUCTOR(Source, Source, Cursor cursor, const File *file);
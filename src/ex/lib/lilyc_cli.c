@@ -64,7 +64,10 @@ extern inline CONSTRUCTOR(LilycConfig,
                           bool o3,
                           bool oz,
                           bool verbose,
-                          bool run);
+                          bool run,
+                          Usize jobs,
+                          bool cache_stats,
+                          bool skip_teardown);
 
 extern inline DESTRUCTOR(LilycConfig, const LilycConfig *self);
 
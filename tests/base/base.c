@@ -2,13 +2,19 @@
 #include "atof.c"
 #include "atoi.c"
 #include "buffer.c"
+#include "dir.c"
 #include "format.c"
 #include "hash_map.c"
 #include "hash_set.c"
+#include "interner.c"
 #include "itoa.c"
+#include "job_runner.c"
 #include "memory/arena.c"
+#include "memory/arena_chain.c"
 #include "memory/global.c"
 #include "memory/page.c"
+#include "memscan.c"
+#include "ordered_hash_map.c"
 #include "stack.c"
 #include "str.c"
 #include "string.c"
@@ -38,6 +44,11 @@ main()
               CALL_CASE(atoi_safe));
     ADD_SUITE(2, atof, CALL_CASE(atof__Float32), CALL_CASE(atof__Float64));
     ADD_SUITE(1, buffer, CALL_CASE(buffer_push));
+    ADD_SUITE(3,
+              dir,
+              CALL_CASE(dir_get_entries),
+              CALL_CASE(dir_get_entries_sub_dir),
+              CALL_CASE(dir_get_entries_missing));
     ADD_SUITE(9,
               format,
               CALL_CASE(format_s_specifier),
@@ -49,26 +60,58 @@ main()
               CALL_CASE(format_f_specifier),
               CALL_CASE(format_S_specifier),
               CALL_CASE(format_Sr_specifier));
-    ADD_SUITE(4,
+    ADD_SUITE(7,
               hash_map,
               CALL_CASE(hash_map_new),
               CALL_CASE(hash_map_get),
               CALL_CASE(hash_map_insert),
-              CALL_CASE(hash_map_remove));
+              CALL_CASE(hash_map_remove),
+              CALL_CASE(hash_map_insert_existing),
+              CALL_CASE(hash_map_grow),
+              CALL_CASE(hash_map_remove_and_insert));
     ADD_SUITE(2,
               hash_map_iter,
               CALL_CASE(hash_map_iter_next),
               CALL_CASE(hash_map_iter_next_pair));
     ADD_SUITE(1, hash_set, CALL_CASE(hash_set_new));
+    ADD_SUITE(3,
+              interner,
+              CALL_CASE(interner_intern),
+              CALL_CASE(interner_many),
+              CALL_CASE(interner_threads));
     ADD_SUITE(4,
               itoa,
               CALL_CASE(itoa_base_10),
               CALL_CASE(itoa_base_2),
               CALL_CASE(itoa_base_8),
               CALL_CASE(itoa_base_16));
+    ADD_SUITE(2,
+              job_runner,
+              CALL_CASE(job_runner_run),
+              CALL_CASE(job_runner_spawn_failure));
     ADD_SUITE(1, memory_arena, CALL_CASE(memory_arena_alloc));
-    ADD_SUITE(1, memory_global, CALL_CASE(memory_global_alloc));
+    ADD_SUITE(1, memory_arena_chain, CALL_CASE(memory_arena_chain_alloc));
+    ADD_SUITE(2,
+              memory_global,
+              CALL_CASE(memory_global_alloc),
+              CALL_CASE(memory_global_remote_free));
     ADD_SUITE(1, memory_page, CALL_CASE(memory_page_alloc));
+    ADD_SUITE(4,
+              memscan,
+              CALL_CASE(memscan_span_space),
+              CALL_CASE(memscan_span_ident),
+              CALL_CASE(memscan_find_any),
+              CALL_CASE(memscan_count));
+    ADD_SUITE(5,
+              ordered_hash_map,
+              CALL_CASE(ordered_hash_map_new),
+              CALL_CASE(ordered_hash_map_insert),
+              CALL_CASE(ordered_hash_map_get),
+              CALL_CASE(ordered_hash_map_remove),
+              CALL_CASE(ordered_hash_map_grow));
+    ADD_SUITE(1,
+              ordered_hash_map_iter,
+              CALL_CASE(ordered_hash_map_iter_order));
     ADD_SUITE(4,
               stack,
               CALL_CASE(stack_new),
@@ -81,10 +124,11 @@ main()
               CALL_CASE(str_get_slice),
               CALL_CASE(str_replace),
               CALL_CASE(str_count_c));
-    ADD_SUITE(12,
+    ADD_SUITE(13,
               string,
               CALL_CASE(string_new),
               CALL_CASE(string_clone),
+              CALL_CASE(string_clear),
               CALL_CASE(string_from),
               CALL_CASE(string_get_slice),
               CALL_CASE(string_split),
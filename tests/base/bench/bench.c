@@ -0,0 +1,28 @@
+#define _GNU_SOURCE
+
+#include "hash_map.c"
+#include "memory_global.c"
+
+#include <stdlib.h>
+
+int
+main(int argc, char **argv)
+{
+    Usize n = argc > 1 ? strtoull(argv[1], NULL, 10) : 0;
+
+    if (n > 0) {
+        bench_hash_map(n);
+        bench_ordered_hash_map(n);
+        bench_memory_global(n);
+
+        return 0;
+    }
+
+    bench_hash_map(100);
+    bench_hash_map(10000);
+    bench_hash_map(1000000);
+    bench_ordered_hash_map(10000);
+    bench_memory_global(1000000);
+
+    return 0;
+}
@@ -0,0 +1,314 @@
+#include <base/alloc.h>
+#include <base/hash/sip.h>
+#include <base/hash_map.h>
+#include <base/new.h>
+#include <base/ordered_hash_map.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Reference: the previous HashMap (separately allocated chained buckets,
+// SipHash recomputed on every lookup, duplicate check on every insert).
+typedef struct ChainedBucket
+{
+    char *key;
+    void *value;
+    struct ChainedBucket *next;
+} ChainedBucket;
+
+typedef struct ChainedHashMap
+{
+    ChainedBucket **buckets;
+    Usize len;
+    Usize capacity;
+} ChainedHashMap;
+
+static Usize
+index__ChainedHashMap(const ChainedHashMap *self, char *key)
+{
+    return hash_sip(key, strlen(key), SIP_K0, SIP_K1) % self->capacity;
+}
+
+static void *
+get__ChainedHashMap(const ChainedHashMap *self, char *key)
+{
+    if (!self->buckets) {
+        return NULL;
+    }
+
+    Usize index = index__ChainedHashMap(self, key);
+
+    for (ChainedBucket *current = self->buckets[index]; current;
+         current = current->next) {
+        if (!strcmp(current->key, key)) {
+            return current->value;
+        }
+    }
+
+    return NULL;
+}
+
+static void *
+insert__ChainedHashMap(ChainedHashMap *self, char *key, void *value)
+{
+    if (!self->buckets) {
+        self->capacity = 8;
+        self->buckets = lily_calloc(self->capacity, PTR_SIZE);
+    } else if (self->len + 1 > self->capacity) {
+        ChainedBucket **old_buckets = self->buckets;
+        Usize old_capacity = self->capacity;
+
+        self->capacity *= 2;
+        self->buckets = lily_calloc(self->capacity, PTR_SIZE);
+
+        for (Usize i = 0; i < old_capacity; ++i) {
+            ChainedBucket *current = old_buckets[i];
+
+            while (current) {
+                ChainedBucket *next = current->next;
+                Usize index = index__ChainedHashMap(self, current->key);
+
+                current->next = self->buckets[index];
+                self->buckets[index] = current;
+                current = next;
+            }
+        }
+
+        lily_free(old_buckets);
+    }
+
+    void *is_exist = get__ChainedHashMap(self, key);
+
+    if (is_exist) {
+        return is_exist;
+    }
+
+    Usize index = index__ChainedHashMap(self, key);
+    ChainedBucket *bucket = lily_malloc(sizeof(ChainedBucket));
+
+    bucket->key = key;
+    bucket->value = value;
+    bucket->next = self->buckets[index];
+    self->buckets[index] = bucket;
+    ++self->len;
+
+    return NULL;
+}
+
+static Usize
+iter__ChainedHashMap(const ChainedHashMap *self)
+{
+    Usize count = 0;
+
+    for (Usize i = 0; i < self->capacity; ++i) {
+        for (ChainedBucket *current = self->buckets[i]; current;
+             current = current->next) {
+            count += current->value != NULL;
+        }
+    }
+
+    return count;
+}
+
+static void
+free__ChainedHashMap(ChainedHashMap *self)
+{
+    for (Usize i = 0; i < self->capacity; ++i) {
+        ChainedBucket *current = self->buckets[i];
+
+        while (current) {
+            ChainedBucket *next = current->next;
+
+            lily_free(current);
+            current = next;
+        }
+    }
+
+    lily_free(self->buckets);
+}
+
+#define BENCH_MS(start) ((double)(clock() - (start)) * 1000 / CLOCKS_PER_SEC)
+
+#define BENCH_REPORT(name, chained, hash_map) \
+    printf("%-8s chained: %8.2f ms, open-addressing: %8.2f ms (x%.2f)\n", \
+           name,                                                          \
+           chained,                                                       \
+           hash_map,                                                      \
+           (chained) / ((hash_map) > 0 ? (hash_map) : 1e-3))
+
+/**
+ *
+ * @brief Compare insert, lookup (hit and miss) and iterate between the chained
+ * reference and HashMap on `n` keys.
+ */
+static void
+bench_hash_map(Usize n)
+{
+    char **keys = lily_malloc(sizeof(char *) * n);
+    char **missing_keys = lily_malloc(sizeof(char *) * n);
+
+    for (Usize i = 0; i < n; ++i) {
+        keys[i] = lily_malloc(24);
+        missing_keys[i] = lily_malloc(24);
+
+        snprintf(keys[i], 24, "identifier_%zu", i);
+        snprintf(missing_keys[i], 24, "missing_%zu", i);
+    }
+
+    ChainedHashMap chained = { .buckets = NULL, .len = 0, .capacity = 0 };
+    HashMap *hash_map = NEW(HashMap);
+    Usize found = 0;
+    double chained_ms, hash_map_ms;
+    clock_t start;
+
+    printf("--- %zu keys ---\n", n);
+
+    start = clock();
+
+    for (Usize i = 0; i < n; ++i) {
+        insert__ChainedHashMap(&chained, keys[i], keys[i]);
+    }
+
+    chained_ms = BENCH_MS(start);
+    start = clock();
+
+    for (Usize i = 0; i < n; ++i) {
+        insert__HashMap(hash_map, keys[i], keys[i]);
+    }
+
+    hash_map_ms = BENCH_MS(start);
+
+    BENCH_REPORT("insert", chained_ms, hash_map_ms);
+
+    start = clock();
+
+    for (Usize r = 0; r < 10; ++r) {
+        for (Usize i = 0; i < n; ++i) {
+            found += get__ChainedHashMap(&chained, keys[i]) != NULL;
+        }
+    }
+
+    chained_ms = BENCH_MS(start);
+    start = clock();
+
+    for (Usize r = 0; r < 10; ++r) {
+        for (Usize i = 0; i < n; ++i) {
+            found += get__HashMap(hash_map, keys[i]) != NULL;
+        }
+    }
+
+    hash_map_ms = BENCH_MS(start);
+
+    BENCH_REPORT("hit", chained_ms, hash_map_ms);
+
+    start = clock();
+
+    for (Usize r = 0; r < 10; ++r) {
+        for (Usize i = 0; i < n; ++i) {
+            found += get__ChainedHashMap(&chained, missing_keys[i]) != NULL;
+        }
+    }
+
+    chained_ms = BENCH_MS(start);
+    start = clock();
+
+    for (Usize r = 0; r < 10; ++r) {
+        for (Usize i = 0; i < n; ++i) {
+            found += get__HashMap(hash_map, missing_keys[i]) != NULL;
+        }
+    }
+
+    hash_map_ms = BENCH_MS(start);
+
+    BENCH_REPORT("miss", chained_ms, hash_map_ms);
+
+    start = clock();
+
+    for (Usize r = 0; r < 10; ++r) {
+        found += iter__ChainedHashMap(&chained);
+    }
+
+    chained_ms = BENCH_MS(start);
+    start = clock();
+
+    for (Usize r = 0; r < 10; ++r) {
+        HashMapIter iter = NEW(HashMapIter, hash_map);
+
+        while (next__HashMapIter(&iter)) {
+            ++found;
+        }
+    }
+
+    hash_map_ms = BENCH_MS(start);
+
+    BENCH_REPORT("iterate", chained_ms, hash_map_ms);
+
+    // Keep the results alive.
+    if (found != n * 40) {
+        printf("unexpected count: %zu\n", found);
+    }
+
+    free__ChainedHashMap(&chained);
+    FREE(HashMap, hash_map);
+
+    for (Usize i = 0; i < n; ++i) {
+        lily_free(keys[i]);
+        lily_free(missing_keys[i]);
+    }
+
+    lily_free(keys);
+    lily_free(missing_keys);
+}
+
+/**
+ *
+ * @brief Measure insert and in-order iterate of OrderedHashMap on `n` keys.
+ */
+static void
+bench_ordered_hash_map(Usize n)
+{
+    char **keys = lily_malloc(sizeof(char *) * n);
+
+    for (Usize i = 0; i < n; ++i) {
+        keys[i] = lily_malloc(24);
+
+        snprintf(keys[i], 24, "identifier_%zu", i);
+    }
+
+    OrderedHashMap *ordered_hash_map = NEW(OrderedHashMap);
+    Usize found = 0;
+    clock_t start = clock();
+
+    for (Usize i = 0; i < n; ++i) {
+        insert__OrderedHashMap(ordered_hash_map, keys[i], keys[i]);
+    }
+
+    double insert_ms = BENCH_MS(start);
+
+    start = clock();
+
+    for (Usize r = 0; r < 10; ++r) {
+        OrderedHashMapIter iter = NEW(OrderedHashMapIter, ordered_hash_map);
+
+        while (next__OrderedHashMapIter(&iter)) {
+            ++found;
+        }
+    }
+
+    double iter_ms = BENCH_MS(start);
+
+    printf("ordered  insert: %8.2f ms, iterate: %8.2f ms (%zu)\n",
+           insert_ms,
+           iter_ms,
+           found / 10);
+
+    FREE(OrderedHashMap, ordered_hash_map);
+
+    for (Usize i = 0; i < n; ++i) {
+        lily_free(keys[i]);
+    }
+
+    lily_free(keys);
+}
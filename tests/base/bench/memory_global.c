@@ -0,0 +1,112 @@
+#include <base/alloc.h>
+#include <base/memory/global.h>
+#include <base/new.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_MEMORY_GLOBAL_LIVE 64
+#define BENCH_MEMORY_GLOBAL_MAX_THREADS 64
+
+typedef struct BenchMemoryGlobalArgs
+{
+    Usize n;
+    bool use_global;
+    // Blocks left by the thread, freed by the next thread (remote frees).
+    void *blocks[BENCH_MEMORY_GLOBAL_LIVE];
+} BenchMemoryGlobalArgs;
+
+static double
+now_ms__BenchMemoryGlobal()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// Keep a window of live blocks of mixed sizes: each iteration frees the
+// oldest block and allocates a new one.
+static void *
+run__BenchMemoryGlobal(void *args)
+{
+    BenchMemoryGlobalArgs *self = args;
+    void *live[BENCH_MEMORY_GLOBAL_LIVE] = { 0 };
+
+    for (Usize i = 0; i < self->n; ++i) {
+        Usize slot = i % BENCH_MEMORY_GLOBAL_LIVE;
+        Usize size = 16 << (i % 8);
+
+        if (self->use_global) {
+            MEMORY_GLOBAL_FREE(live[slot]);
+            live[slot] = MEMORY_GLOBAL_ALLOC(char, size);
+        } else {
+            lily_free(live[slot]);
+            live[slot] = lily_malloc(size);
+        }
+
+        ((char *)live[slot])[0] = (char)i;
+    }
+
+    for (Usize i = 0; i < BENCH_MEMORY_GLOBAL_LIVE; ++i) {
+        self->blocks[i] = live[i];
+    }
+
+    return NULL;
+}
+
+static double
+run_threads__BenchMemoryGlobal(Usize n, Usize threads_len, bool use_global)
+{
+    static BenchMemoryGlobalArgs args[BENCH_MEMORY_GLOBAL_MAX_THREADS];
+    pthread_t threads[BENCH_MEMORY_GLOBAL_MAX_THREADS];
+    double start = now_ms__BenchMemoryGlobal();
+
+    for (Usize i = 0; i < threads_len; ++i) {
+        args[i].n = n;
+        args[i].use_global = use_global;
+
+        pthread_create(&threads[i], NULL, &run__BenchMemoryGlobal, &args[i]);
+    }
+
+    for (Usize i = 0; i < threads_len; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    // Free the blocks of each thread from this thread (remote frees).
+    for (Usize i = 0; i < threads_len; ++i) {
+        for (Usize j = 0; j < BENCH_MEMORY_GLOBAL_LIVE; ++j) {
+            if (use_global) {
+                MEMORY_GLOBAL_FREE(args[i].blocks[j]);
+            } else {
+                lily_free(args[i].blocks[j]);
+            }
+        }
+    }
+
+    return now_ms__BenchMemoryGlobal() - start;
+}
+
+static void
+bench_memory_global(Usize n)
+{
+    printf("--- %zu allocations per thread ---\n", n);
+
+    for (Usize threads_len = 1; threads_len <= BENCH_MEMORY_GLOBAL_MAX_THREADS;
+         threads_len *= 2) {
+        double malloc_ms =
+          run_threads__BenchMemoryGlobal(n, threads_len, false);
+        double global_ms = run_threads__BenchMemoryGlobal(n, threads_len, true);
+        double total = (double)n * threads_len / 1000.0;
+
+        printf("%2zu threads malloc: %8.2f Mops/s, global: %8.2f Mops/s "
+               "(x%.2f)\n",
+               threads_len,
+               total / malloc_ms,
+               total / global_ms,
+               malloc_ms / global_ms);
+    }
+}
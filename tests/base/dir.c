@@ -0,0 +1,75 @@
+#include <base/alloc.h>
+#include <base/dir.h>
+#include <base/new.h>
+#include <base/string.h>
+#include <base/test.h>
+#include <base/vec.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DIR_TEST_PATH "./tests/base/input/dir"
+
+/**
+ *
+ * @brief Check if the entries contain the name.
+ */
+static bool
+has_entry__DirTest(const Vec *entries, const char *name)
+{
+    for (Usize i = 0; i < entries->len; ++i) {
+        const String *entry = get__Vec(entries, i);
+
+        if (!strcmp(entry->buffer, name)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ *
+ * @brief Free the entries.
+ */
+static void
+free_entries__DirTest(Vec *entries)
+{
+    FREE_BUFFER_ITEMS(entries->buffer, entries->len, String);
+    FREE(Vec, entries);
+}
+
+SUITE(dir);
+
+CASE(dir_get_entries, {
+    Vec *entries = get_entries__Dir(DIR_TEST_PATH);
+
+    TEST_ASSERT(entries);
+
+    // The names are kept as is (files and folders), without `.` and `..`.
+    TEST_ASSERT_EQ(entries->len, 3);
+    TEST_ASSERT(has_entry__DirTest(entries, "a.txt"));
+    TEST_ASSERT(has_entry__DirTest(entries, "B.txt"));
+    TEST_ASSERT(has_entry__DirTest(entries, "sub"));
+    TEST_ASSERT(!has_entry__DirTest(entries, "."));
+    TEST_ASSERT(!has_entry__DirTest(entries, ".."));
+    TEST_ASSERT(!has_entry__DirTest(entries, "c.txt"));
+
+    free_entries__DirTest(entries);
+});
+
+CASE(dir_get_entries_sub_dir, {
+    Vec *entries = get_entries__Dir(DIR_TEST_PATH "/sub");
+
+    TEST_ASSERT(entries);
+    TEST_ASSERT_EQ(entries->len, 1);
+    TEST_ASSERT(has_entry__DirTest(entries, "c.txt"));
+
+    free_entries__DirTest(entries);
+});
+
+CASE(dir_get_entries_missing, {
+    TEST_ASSERT(!get_entries__Dir(DIR_TEST_PATH "/missing"));
+    TEST_ASSERT(!get_entries__Dir(DIR_TEST_PATH "/a.txt"));
+});
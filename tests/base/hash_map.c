@@ -64,6 +64,70 @@ CASE(hash_map_remove, {
     FREE(HashMap, hm);
 });
 
+CASE(hash_map_insert_existing, {
+    HashMap *hm = NEW(HashMap); // HashMap<char*>*
+
+    TEST_ASSERT(!insert__HashMap(hm, "1", "a"));
+    TEST_ASSERT(!strcmp(insert__HashMap(hm, "1", "b"), "a"));
+    TEST_ASSERT(!strcmp(get__HashMap(hm, "1"), "a"));
+    TEST_ASSERT(hm->len == 1);
+
+    FREE(HashMap, hm);
+});
+
+CASE(hash_map_grow, {
+    HashMap *hm = NEW(HashMap); // HashMap<char*>*
+    char keys[1000][8];
+
+    for (Usize i = 0; i < 1000; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "k%zu", i);
+
+        TEST_ASSERT(!insert__HashMap(hm, keys[i], keys[i]));
+    }
+
+    TEST_ASSERT(hm->len == 1000);
+
+    for (Usize i = 0; i < 1000; ++i) {
+        TEST_ASSERT(get__HashMap(hm, keys[i]) == keys[i]);
+    }
+
+    TEST_ASSERT(!get__HashMap(hm, "k1000"));
+
+    FREE(HashMap, hm);
+});
+
+CASE(hash_map_remove_and_insert, {
+    HashMap *hm = NEW(HashMap); // HashMap<char*>*
+    char keys[200][8];
+
+    for (Usize i = 0; i < 200; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "k%zu", i);
+
+        TEST_ASSERT(!insert__HashMap(hm, keys[i], keys[i]));
+    }
+
+    for (Usize i = 1; i < 200; i += 2) {
+        TEST_ASSERT(remove__HashMap(hm, keys[i]) == keys[i]);
+    }
+
+    TEST_ASSERT(hm->len == 100);
+
+    for (Usize i = 0; i < 200; ++i) {
+        TEST_ASSERT(i % 2 ? !get__HashMap(hm, keys[i])
+                          : get__HashMap(hm, keys[i]) == keys[i]);
+    }
+
+    for (Usize i = 1; i < 200; i += 2) {
+        TEST_ASSERT(!insert__HashMap(hm, keys[i], keys[i]));
+    }
+
+    for (Usize i = 0; i < 200; ++i) {
+        TEST_ASSERT(get__HashMap(hm, keys[i]) == keys[i]);
+    }
+
+    FREE(HashMap, hm);
+});
+
 SUITE(hash_map_iter);
 
 CASE(hash_map_iter_next, {
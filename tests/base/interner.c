@@ -0,0 +1,114 @@
+#include <base/interner.h>
+#include <base/new.h>
+#include <base/test.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+SUITE(interner);
+
+CASE(interner_intern, {
+    Interner *interner = NEW(Interner);
+    char a[] = "abc";
+    char a2[] = "abc";
+
+    Symbol sa = intern__Interner(interner, a);
+    Symbol sb = intern__Interner(interner, "def");
+
+    TEST_ASSERT(sa != SYMBOL_NONE);
+    TEST_ASSERT(sa != sb);
+    TEST_ASSERT(intern__Interner(interner, a2) == sa);
+    TEST_ASSERT(lookup__Interner(interner, "def") == sb);
+    TEST_ASSERT(lookup__Interner(interner, "ghi") == SYMBOL_NONE);
+    TEST_ASSERT(!strcmp(get__Interner(interner, sa), "abc"));
+    TEST_ASSERT(get__Interner(interner, sa) != a);
+
+    FREE(Interner, interner);
+});
+
+CASE(interner_many, {
+    Interner *interner = NEW(Interner);
+    char name[32];
+
+    for (Usize i = 0; i < 20000; ++i) {
+        snprintf(name, sizeof(name), "identifier_%zu", i);
+
+        TEST_ASSERT(intern__Interner(interner, name) == i + 1);
+    }
+
+    for (Usize i = 0; i < 20000; ++i) {
+        snprintf(name, sizeof(name), "identifier_%zu", i);
+
+        TEST_ASSERT(!strcmp(get__Interner(interner, i + 1), name));
+    }
+
+    FREE(Interner, interner);
+});
+
+#define INTERNER_TEST_THREADS_LEN 8
+#define INTERNER_TEST_NAMES_LEN 5000
+
+typedef struct InternerTestArgs
+{
+    Interner *interner;
+    Usize id;
+    Symbol symbols[INTERNER_TEST_NAMES_LEN];
+    bool is_valid;
+} InternerTestArgs;
+
+static void *
+intern_names__InternerTest(void *self)
+{
+    InternerTestArgs *args = self;
+    char name[32];
+
+    args->is_valid = true;
+
+    // All the threads intern the same names, in different orders, and look
+    // up the names interned by the other threads while the table grows.
+    for (Usize i = 0; i < INTERNER_TEST_NAMES_LEN; ++i) {
+        Usize n = (i + args->id * 613) % INTERNER_TEST_NAMES_LEN;
+
+        snprintf(name, sizeof(name), "name_%zu", n);
+
+        args->symbols[n] = intern__Interner(args->interner, name);
+
+        if (strcmp(get__Interner(args->interner, args->symbols[n]), name) ||
+            lookup__Interner(args->interner, name) != args->symbols[n]) {
+            args->is_valid = false;
+        }
+    }
+
+    return NULL;
+}
+
+CASE(interner_threads, {
+    Interner *interner = NEW(Interner);
+    pthread_t threads[INTERNER_TEST_THREADS_LEN];
+    static InternerTestArgs args[INTERNER_TEST_THREADS_LEN];
+
+    for (Usize i = 0; i < INTERNER_TEST_THREADS_LEN; ++i) {
+        args[i].interner = interner;
+        args[i].id = i;
+
+        pthread_create(
+          &threads[i], NULL, &intern_names__InternerTest, &args[i]);
+    }
+
+    for (Usize i = 0; i < INTERNER_TEST_THREADS_LEN; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    TEST_ASSERT(interner->len == INTERNER_TEST_NAMES_LEN);
+
+    for (Usize i = 0; i < INTERNER_TEST_THREADS_LEN; ++i) {
+        TEST_ASSERT(args[i].is_valid);
+
+        for (Usize j = 0; j < INTERNER_TEST_NAMES_LEN; ++j) {
+            TEST_ASSERT(args[i].symbols[j] == args[0].symbols[j]);
+        }
+    }
+
+    FREE(Interner, interner);
+});
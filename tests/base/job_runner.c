@@ -0,0 +1,48 @@
+#include <base/job_runner.h>
+#include <base/new.h>
+#include <base/str.h>
+#include <base/test.h>
+
+#include <string.h>
+
+SUITE(job_runner);
+
+CASE(job_runner_run, {
+    JobRunner runner = NEW(JobRunner, 2);
+
+    add__JobRunner(&runner, NEW(Job, split__Str("true", ' '), 0));
+    add__JobRunner(&runner, NEW(Job, split__Str("sh -c exit\t3", ' '), 0));
+    add__JobRunner(&runner, NEW(Job, split__Str("true", ' '), 1));
+    add__JobRunner(&runner,
+                   NEW(Job, split__Str("sh -c echo\terr\t>&2", ' '), 1));
+
+    TEST_ASSERT_EQ(run__JobRunner(&runner), 1);
+
+    Job *exit_3 = get__Vec(runner.jobs, 1);
+    Job *err = get__Vec(runner.jobs, 3);
+
+    TEST_ASSERT_EQ(exit_3->exit_status, 3);
+    TEST_ASSERT(has_failed__Job(exit_3));
+    TEST_ASSERT(!has_failed__Job(get__Vec(runner.jobs, 0)));
+    TEST_ASSERT(!has_failed__Job(get__Vec(runner.jobs, 2)));
+    TEST_ASSERT(!has_failed__Job(err));
+    TEST_ASSERT(strcmp(err->err->buffer, "err\n") == 0);
+
+    FREE(JobRunner, &runner);
+});
+
+CASE(job_runner_spawn_failure, {
+    JobRunner runner = NEW(JobRunner, 0);
+
+    add__JobRunner(&runner,
+                   NEW(Job, split__Str("lily_job_runner_not_found", ' '), 0));
+
+    TEST_ASSERT_EQ(run__JobRunner(&runner), 1);
+
+    Job *job = get__Vec(runner.jobs, 0);
+
+    TEST_ASSERT_EQ(job->exit_status, 127);
+    TEST_ASSERT(job->err->len > 0);
+
+    FREE(JobRunner, &runner);
+});
@@ -0,0 +1,41 @@
+#include <base/assert.h>
+#include <base/macros.h>
+#include <base/memory/arena_chain.h>
+#include <base/new.h>
+#include <base/test.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+SUITE(memory_arena_chain);
+
+CASE(memory_arena_chain_alloc, {
+    MemoryArenaChain chain = NEW(MemoryArenaChain, 64);
+    Usize *items[32];
+
+    for (Usize i = 0; i < 32; ++i) {
+        items[i] = MEMORY_ARENA_CHAIN_ALLOC(Usize, &chain, 1);
+        *items[i] = i;
+    }
+
+    for (Usize i = 0; i < 32; ++i) {
+        TEST_ASSERT_EQ(*items[i], i);
+        TEST_ASSERT_EQ((Uptr)items[i] % alignof(Usize), 0);
+    }
+
+    TEST_ASSERT_EQ(chain.arenas->len, 4);
+    TEST_ASSERT_EQ(get_total_size__MemoryArenaChain(&chain),
+                   32 * sizeof(Usize));
+
+    // A region bigger than the capacity of an arena gets its own arena.
+    char *big = MEMORY_ARENA_CHAIN_ALLOC(char, &chain, 256);
+
+    big[0] = 'a';
+    big[255] = 'b';
+
+    TEST_ASSERT_EQ(big[0], 'a');
+    TEST_ASSERT_EQ(big[255], 'b');
+    TEST_ASSERT_EQ(chain.arenas->len, 5);
+
+    FREE(MemoryArenaChain, &chain);
+});
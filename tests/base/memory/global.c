@@ -4,6 +4,7 @@
 #include <base/new.h>
 #include <base/test.h>
 
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -47,3 +48,47 @@ CASE(memory_global_alloc, {
 
     // print_stat__MemoryGlobal(&global);
 });
+
+#define MEMORY_GLOBAL_TEST_LEN 1000
+
+static void *
+alloc_blocks__MemoryGlobalTest(void *blocks)
+{
+    for (Usize i = 0; i < MEMORY_GLOBAL_TEST_LEN; ++i) {
+        Usize *block = MEMORY_GLOBAL_ALLOC(Usize, i % 100 + 1);
+
+        *block = i;
+        ((Usize **)blocks)[i] = block;
+    }
+
+    return NULL;
+}
+
+CASE(memory_global_remote_free, {
+    Usize *blocks[MEMORY_GLOBAL_TEST_LEN];
+    pthread_t thread;
+
+    // The blocks are allocated by another thread and freed by this thread.
+    pthread_create(&thread, NULL, &alloc_blocks__MemoryGlobalTest, blocks);
+    pthread_join(thread, NULL);
+
+    for (Usize i = 0; i < MEMORY_GLOBAL_TEST_LEN; ++i) {
+        TEST_ASSERT_EQ(*blocks[i], i);
+
+        MEMORY_GLOBAL_FREE(blocks[i]);
+    }
+
+    // The blocks freed are reused by a new thread.
+    pthread_create(&thread, NULL, &alloc_blocks__MemoryGlobalTest, blocks);
+    pthread_join(thread, NULL);
+
+    for (Usize i = 0; i < MEMORY_GLOBAL_TEST_LEN; ++i) {
+        TEST_ASSERT_EQ(*blocks[i], i);
+
+        blocks[i] = MEMORY_GLOBAL_RESIZE(Usize, blocks[i], i % 100 + 200);
+
+        TEST_ASSERT_EQ(*blocks[i], i);
+
+        MEMORY_GLOBAL_FREE(blocks[i]);
+    }
+});
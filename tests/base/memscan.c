@@ -0,0 +1,69 @@
+#include <base/memscan.h>
+#include <base/test.h>
+
+#include <string.h>
+
+SUITE(memscan);
+
+// NOTE: The runs are checked at every length up to 100 bytes, so that they end
+// in a SIMD block as well as in the scalar rest.
+CASE(memscan_span_space, {
+    char s[101];
+
+    for (Usize i = 0; i <= 100; ++i) {
+        for (Usize j = 0; j < i; ++j) {
+            s[j] = " \t\n\v\f\r"[j % 6];
+        }
+
+        s[i] = 'a';
+
+        TEST_ASSERT_EQ(span_space__MemScan(s, i + 1, true), i);
+        TEST_ASSERT_EQ(span_space__MemScan(s, i, true), i);
+        TEST_ASSERT_EQ(span_space__MemScan(s, i + 1, false), i > 2 ? 2 : i);
+    }
+});
+
+CASE(memscan_span_ident, {
+    const char *chars = "azAZ09_$";
+    char s[101];
+
+    for (Usize i = 0; i <= 100; ++i) {
+        for (Usize j = 0; j < i; ++j) {
+            s[j] = chars[j % 7];
+        }
+
+        s[i] = i % 2 ? '$' : '@';
+
+        TEST_ASSERT_EQ(span_ident__MemScan(s, i + 1, false), i);
+        TEST_ASSERT_EQ(span_ident__MemScan(s, i + 1, true), i + (i % 2));
+    }
+
+    TEST_ASSERT_EQ(span_ident__MemScan("[`{\x7f\xc3", 5, true), 0);
+});
+
+CASE(memscan_find_any, {
+    char s[101];
+
+    memset(s, 'a', sizeof(s));
+
+    for (Usize i = 0; i < 100; ++i) {
+        s[i] = i % 2 ? '"' : '\\';
+
+        TEST_ASSERT_EQ(find_any__MemScan(s, 101, '"', '\\'), i);
+        TEST_ASSERT_EQ(find_any__MemScan(s, i, '"', '\\'), i);
+
+        s[i] = 'a';
+    }
+});
+
+CASE(memscan_count, {
+    char s[100];
+
+    for (Usize i = 0; i < 100; ++i) {
+        s[i] = i % 3 ? 'a' : '\n';
+    }
+
+    for (Usize i = 0; i <= 100; ++i) {
+        TEST_ASSERT_EQ(count__MemScan(s, i, '\n'), (i + 2) / 3);
+    }
+});
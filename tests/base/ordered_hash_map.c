@@ -0,0 +1,139 @@
+#include <base/new.h>
+#include <base/ordered_hash_map.h>
+#include <base/test.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+SUITE(ordered_hash_map);
+
+CASE(ordered_hash_map_new, {
+    OrderedHashMap *hm = NEW(OrderedHashMap);
+
+    TEST_ASSERT(hm->len == 0);
+    TEST_ASSERT(!get__OrderedHashMap(hm, "1"));
+
+    FREE(OrderedHashMap, hm);
+});
+
+CASE(ordered_hash_map_insert, {
+    OrderedHashMap *hm = NEW(OrderedHashMap); // OrderedHashMap<char*>*
+
+    TEST_ASSERT(!insert__OrderedHashMap(hm, "1", "a"));
+    TEST_ASSERT(!insert__OrderedHashMap(hm, "2", "b"));
+    TEST_ASSERT(!insert__OrderedHashMap(hm, "3", "c"));
+    TEST_ASSERT(!strcmp(insert__OrderedHashMap(hm, "1", "d"), "a"));
+    TEST_ASSERT(hm->len == 3);
+
+    FREE(OrderedHashMap, hm);
+});
+
+CASE(ordered_hash_map_get, {
+    OrderedHashMap *hm = NEW(OrderedHashMap); // OrderedHashMap<char*>*
+
+    TEST_ASSERT(!insert__OrderedHashMap(hm, "1", "a"));
+    TEST_ASSERT(!insert__OrderedHashMap(hm, "2", "b"));
+    TEST_ASSERT(!insert__OrderedHashMap(hm, "3", "c"));
+
+    TEST_ASSERT(!strcmp(get__OrderedHashMap(hm, "1"), "a"));
+    TEST_ASSERT(!strcmp(get__OrderedHashMap(hm, "2"), "b"));
+    TEST_ASSERT(!strcmp(get__OrderedHashMap(hm, "3"), "c"));
+    TEST_ASSERT(!get__OrderedHashMap(hm, "4"));
+
+    TEST_ASSERT(*get_id__OrderedHashMap(hm, "1") == 0);
+    TEST_ASSERT(*get_id__OrderedHashMap(hm, "3") == 2);
+    TEST_ASSERT(!get_id__OrderedHashMap(hm, "4"));
+    TEST_ASSERT(!strcmp(get_from_id__OrderedHashMap(hm, 1), "b"));
+    TEST_ASSERT(!get_from_id__OrderedHashMap(hm, 3));
+    TEST_ASSERT(!strcmp(last__OrderedHashMap(hm), "c"));
+
+    FREE(OrderedHashMap, hm);
+});
+
+CASE(ordered_hash_map_remove, {
+    OrderedHashMap *hm = NEW(OrderedHashMap); // OrderedHashMap<char*>*
+
+    TEST_ASSERT(!remove__OrderedHashMap(hm, "1"));
+
+    TEST_ASSERT(!insert__OrderedHashMap(hm, "1", "a"));
+    TEST_ASSERT(!insert__OrderedHashMap(hm, "2", "b"));
+    TEST_ASSERT(!insert__OrderedHashMap(hm, "3", "c"));
+
+    TEST_ASSERT(!strcmp(remove__OrderedHashMap(hm, "2"), "b"));
+    TEST_ASSERT(!remove__OrderedHashMap(hm, "2"));
+    TEST_ASSERT(!remove__OrderedHashMap(hm, "4"));
+    TEST_ASSERT(hm->len == 2);
+
+    TEST_ASSERT(!get__OrderedHashMap(hm, "2"));
+    TEST_ASSERT(!strcmp(get__OrderedHashMap(hm, "3"), "c"));
+    TEST_ASSERT(*get_id__OrderedHashMap(hm, "3") == 1);
+
+    TEST_ASSERT(!insert__OrderedHashMap(hm, "2", "d"));
+    TEST_ASSERT(*get_id__OrderedHashMap(hm, "2") == 2);
+    TEST_ASSERT(!strcmp(last__OrderedHashMap(hm), "d"));
+
+    TEST_ASSERT(!strcmp(remove__OrderedHashMap(hm, "1"), "a"));
+    TEST_ASSERT(!strcmp(remove__OrderedHashMap(hm, "3"), "c"));
+    TEST_ASSERT(!strcmp(remove__OrderedHashMap(hm, "2"), "d"));
+    TEST_ASSERT(hm->len == 0);
+
+    FREE(OrderedHashMap, hm);
+});
+
+CASE(ordered_hash_map_grow, {
+    OrderedHashMap *hm = NEW(OrderedHashMap); // OrderedHashMap<char*>*
+    char keys[1000][8];
+
+    for (Usize i = 0; i < 1000; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "k%zu", i);
+
+        TEST_ASSERT(!insert__OrderedHashMap(hm, keys[i], keys[i]));
+    }
+
+    TEST_ASSERT(hm->len == 1000);
+
+    for (Usize i = 0; i < 1000; ++i) {
+        TEST_ASSERT(get__OrderedHashMap(hm, keys[i]) == keys[i]);
+        TEST_ASSERT(*get_id__OrderedHashMap(hm, keys[i]) == i);
+    }
+
+    TEST_ASSERT(!get__OrderedHashMap(hm, "k1000"));
+
+    FREE(OrderedHashMap, hm);
+});
+
+SUITE(ordered_hash_map_iter);
+
+CASE(ordered_hash_map_iter_order, {
+    OrderedHashMap *hm = NEW(OrderedHashMap); // OrderedHashMap<char*>*
+    char keys[200][8];
+
+    for (Usize i = 0; i < 200; ++i) {
+        // Insert in an order unrelated to the hash of the keys.
+        snprintf(keys[i], sizeof(keys[i]), "k%zu", (i * 37) % 200);
+
+        TEST_ASSERT(!insert__OrderedHashMap(hm, keys[i], keys[i]));
+    }
+
+    for (Usize i = 0; i < 200; i += 3) {
+        TEST_ASSERT(remove__OrderedHashMap(hm, keys[i]) == keys[i]);
+    }
+
+    OrderedHashMapIter iter = NEW(OrderedHashMapIter, hm);
+    OrderedHashMapIterPair pair;
+    Usize i = 1;
+
+    while (!ORD_HASH_MAP_ITER_PAIR_IS_NULL(
+      pair = next_pair__OrderedHashMapIter(&iter))) {
+        TEST_ASSERT(pair.key == keys[i]);
+        TEST_ASSERT(pair.value == keys[i]);
+
+        i += i % 3 == 2 ? 2 : 1;
+    }
+
+    TEST_ASSERT(i == 200);
+    TEST_ASSERT(!next__OrderedHashMapIter(&iter));
+
+    FREE(OrderedHashMap, hm);
+});
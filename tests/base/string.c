@@ -35,6 +35,23 @@ CASE(string_clone, {
     FREE(String, clone);
 });
 
+CASE(string_clear, {
+    String *s = from__String("Hello");
+    Usize capacity = s->capacity;
+
+    clear__String(s);
+
+    TEST_ASSERT(s->len == 0);
+    TEST_ASSERT(s->capacity == capacity);
+    TEST_ASSERT(!strcmp(s->buffer, ""));
+
+    push_str__String(s, "World");
+
+    TEST_ASSERT(!strcmp(s->buffer, "World"));
+
+    FREE(String, s);
+});
+
 CASE(string_from, {
     String *s = from__String("Hello");
 
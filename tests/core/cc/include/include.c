@@ -0,0 +1,15 @@
+#include "resolve.c"
+
+#include <base/test.h>
+
+int
+main()
+{
+    NEW_TEST("cc_include");
+    ADD_SUITE(3,
+              include_resolve,
+              CALL_CASE(include_resolve_found),
+              CALL_CASE(include_resolve_negative),
+              CALL_CASE(include_resolve_invalidation));
+    RUN_TEST();
+}
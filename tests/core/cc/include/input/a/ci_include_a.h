@@ -0,0 +1 @@
+#define CI_INCLUDE_A 1
@@ -0,0 +1 @@
+#define CI_INCLUDE_B 1
@@ -0,0 +1,115 @@
+#include <base/alloc.h>
+#include <base/dir.h>
+#include <base/file.h>
+#include <base/format.h>
+#include <base/new.h>
+#include <base/string.h>
+#include <base/test.h>
+
+#include <core/cc/ci/include.h>
+#include <core/cc/ci/result.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INCLUDE_TEST_COMPILER "cc"
+#define INCLUDE_TEST_INPUT "./tests/core/cc/include/input"
+
+/**
+ *
+ * @brief Resolve the included file from the folder of the tests.
+ * @return const String*? (&)
+ */
+static const String *
+resolve__IncludeTest(const char *include_path)
+{
+    String *include_path_s = from__String((char *)include_path);
+    String *including_dir = from__String("./tests/core/cc/include");
+    const String *res = resolve__CIInclude(include_path_s, including_dir);
+
+    FREE(String, include_path_s);
+    FREE(String, including_dir);
+
+    return res;
+}
+
+SUITE(include_resolve);
+
+CASE(include_resolve_found, {
+    String *compiler = from__String(INCLUDE_TEST_COMPILER);
+
+    init_include_dirs__CIInclude(compiler, INCLUDE_TEST_INPUT "/a");
+
+    const String *path = resolve__IncludeTest("ci_include_a.h");
+
+    TEST_ASSERT(path);
+    TEST_ASSERT(!strcmp(path->buffer, INCLUDE_TEST_INPUT "/a/ci_include_a.h"));
+
+    // The result of the resolution is cached.
+    TEST_ASSERT(resolve__IncludeTest("ci_include_a.h") == path);
+
+    // The name is compared regardless of the case in the content of the
+    // folder, but the file must still exist on the file system.
+    const String *upper_path = resolve__IncludeTest("CI_INCLUDE_A.h");
+
+    TEST_ASSERT(!upper_path || exists__File(upper_path->buffer));
+
+    destroy__CIInclude();
+    FREE(String, compiler);
+});
+
+CASE(include_resolve_negative, {
+    String *compiler = from__String(INCLUDE_TEST_COMPILER);
+    char *dir = get_output_path__CIResult("include_test");
+    char *new_file = format("{s}/ci_include_new.h", dir);
+
+    create_recursive_dir__Dir(dir,
+                              DIR_MODE_RWXU | DIR_MODE_RWXG | DIR_MODE_RWXO);
+    remove(new_file);
+
+    init_include_dirs__CIInclude(compiler, dir);
+
+    TEST_ASSERT(!resolve__IncludeTest("ci_include_new.h"));
+
+    // The file is created after the resolution, but the negative result is
+    // cached.
+    write_file__File(new_file, "", 0);
+
+    TEST_ASSERT(!resolve__IncludeTest("ci_include_new.h"));
+
+    remove(new_file);
+    destroy__CIInclude();
+    lily_free(new_file);
+    lily_free(dir);
+    FREE(String, compiler);
+});
+
+CASE(include_resolve_invalidation, {
+    String *compiler = from__String(INCLUDE_TEST_COMPILER);
+
+    init_include_dirs__CIInclude(compiler, INCLUDE_TEST_INPUT "/a");
+
+    TEST_ASSERT(!resolve__IncludeTest("ci_include_b.h"));
+
+    // The resolved includes are cleared, when an include directory is added.
+    add_include_dir__CIInclude(from__String(INCLUDE_TEST_INPUT "/b"));
+
+    const String *path = resolve__IncludeTest("ci_include_b.h");
+
+    TEST_ASSERT(path);
+    TEST_ASSERT(!strcmp(path->buffer, INCLUDE_TEST_INPUT "/b/ci_include_b.h"));
+
+    // The resolved includes are cleared, when an include directory is
+    // inserted.
+    insert_include_dir__CIInclude(from__String(INCLUDE_TEST_INPUT "/b/."), 0);
+
+    path = resolve__IncludeTest("ci_include_b.h");
+
+    TEST_ASSERT(path);
+    TEST_ASSERT(
+      !strcmp(path->buffer, INCLUDE_TEST_INPUT "/b/./ci_include_b.h"));
+
+    destroy__CIInclude();
+    FREE(String, compiler);
+});
@@ -0,0 +1,34 @@
+#ifndef TOKEN_CACHE_H
+#define TOKEN_CACHE_H
+
+#include <stddef.h>
+
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define NAME "token_cache"
+
+/* Comment */
+typedef struct Point
+{
+    int x;
+    unsigned long y;
+    float z;
+} Point;
+
+enum Color
+{
+    COLOR_RED = 0x1,
+    COLOR_GREEN = 02,
+    COLOR_BLUE = 'b',
+};
+
+#if defined(NAME) && MAX(1, 2) == 2
+static inline double
+length(const Point *p)
+{
+    return p->x * 1.5 + p->y;
+}
+#else
+#error "unexpected"
+#endif
+
+#endif // TOKEN_CACHE_H
@@ -0,0 +1,16 @@
+#include "keyword_hash.c"
+#include "token_cache.c"
+
+#include <base/test.h>
+
+int
+main()
+{
+    NEW_TEST("cc_scanner");
+    ADD_SIMPLE(keyword_hash);
+    ADD_SUITE(2,
+              token_cache,
+              CALL_CASE(token_cache_round_trip),
+              CALL_CASE(token_cache_missing_file));
+    RUN_TEST();
+}
@@ -0,0 +1,107 @@
+#include <base/file.h>
+#include <base/test.h>
+
+#include <core/cc/ci/scanner.h>
+#include <core/cc/ci/token_cache.h>
+
+#define FILE_TOKEN_CACHE "./tests/core/cc/scanner/input/token_cache.h"
+
+/**
+ *
+ * @brief Check that the both lists of tokens have the same kinds, locations
+ * and contents.
+ */
+static bool
+eq_tokens__TokenCacheTest(const CITokens *self, const CITokens *other)
+{
+    const CIToken *self_token = self->first;
+    const CIToken *other_token = other->first;
+
+    for (; self_token && other_token;
+         self_token = self_token->next, other_token = other_token->next) {
+        if (self_token->kind != other_token->kind ||
+            memcmp(&self_token->location,
+                   &other_token->location,
+                   sizeof(Location))) {
+            return false;
+        }
+    }
+
+    if (self_token || other_token) {
+        return false;
+    }
+
+    String *self_s = to_string__CITokens(self);
+    String *other_s = to_string__CITokens(other);
+    bool res = !strcmp(self_s->buffer, other_s->buffer);
+
+    FREE(String, self_s);
+    FREE(String, other_s);
+
+    return res;
+}
+
+/**
+ *
+ * @brief Build the configuration of the project used by the tests.
+ */
+static CIProjectConfig
+make_config__TokenCacheTest(enum CIStandard standard,
+                            enum CIProjectConfigCompilerKind compiler_kind)
+{
+    return (CIProjectConfig){ .standard = standard,
+                              .compiler = { .kind = compiler_kind } };
+}
+
+SUITE(token_cache);
+
+CASE(token_cache_round_trip, {
+    CIProjectConfig config = make_config__TokenCacheTest(
+      CI_STANDARD_11, CI_PROJECT_CONFIG_COMPILER_KIND_GCC);
+    File file = NEW(File, FILE_TOKEN_CACHE, read_file__File(FILE_TOKEN_CACHE));
+    Usize count_error = 0;
+    CIScanner scanner = NEW(CIScanner,
+                            NEW(Source, NEW(Cursor, file.content), &file),
+                            &count_error,
+                            &config);
+    CITokens loaded = NEW(CITokens);
+
+    run__CIScanner(&scanner, false);
+
+    TEST_ASSERT(!is_empty__CITokens(&scanner.tokens));
+
+    save__CITokenCache(&file, &config, &scanner.tokens);
+
+    TEST_ASSERT(load__CITokenCache(&file, &config, &loaded));
+    TEST_ASSERT(eq_tokens__TokenCacheTest(&scanner.tokens, &loaded));
+
+    FREE(CITokens, &loaded);
+
+    // The tokens depend on the standard and on the compiler.
+    config.standard = CI_STANDARD_23;
+
+    TEST_ASSERT(!load__CITokenCache(&file, &config, &loaded));
+
+    config.standard = CI_STANDARD_11;
+    config.compiler.kind = CI_PROJECT_CONFIG_COMPILER_KIND_CLANG;
+
+    TEST_ASSERT(!load__CITokenCache(&file, &config, &loaded));
+
+    FREE(CIScanner, &scanner);
+    FREE(File, &file);
+});
+
+CASE(token_cache_missing_file, {
+    CIProjectConfig config = make_config__TokenCacheTest(
+      CI_STANDARD_11, CI_PROJECT_CONFIG_COMPILER_KIND_GCC);
+    File file = NEW(File, FILE_TOKEN_CACHE, NULL);
+    CITokens tokens = NEW(CITokens);
+
+    file.name = "./tests/core/cc/scanner/input/missing.h";
+
+    // The last modification time of the file cannot be read, so the tokens
+    // are neither saved nor loaded.
+    save__CITokenCache(&file, &config, &tokens);
+
+    TEST_ASSERT(!load__CITokenCache(&file, &config, &tokens));
+});
@@ -0,0 +1,20 @@
+#include "data_type.c"
+#include "signature.c"
+
+#include <base/test.h>
+
+int
+main()
+{
+    NEW_TEST("analysis");
+    ADD_SUITE(3,
+              data_type_hash,
+              CALL_CASE(data_type_hash_eq),
+              CALL_CASE(data_type_hash_custom),
+              CALL_CASE(data_type_hash_generic));
+    ADD_SUITE(2,
+              signature_dedup,
+              CALL_CASE(signature_dedup_fun),
+              CALL_CASE(signature_dedup_operator));
+    RUN_TEST();
+}
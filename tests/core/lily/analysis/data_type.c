@@ -0,0 +1,85 @@
+#include "util.c"
+
+#include <base/test.h>
+
+#include <core/lily/analysis/checked/data_type.h>
+
+SUITE(data_type_hash);
+
+CASE(data_type_hash_eq, {
+    String *names[DATA_TYPE_TEST_NAMES_LEN];
+
+    init_names__DataTypeTest(names);
+
+    // If two data types are equal, their hashes must not reject them.
+    for (Usize i = 0; i < DATA_TYPE_TEST_LEN; ++i) {
+        for (Usize j = 0; j < DATA_TYPE_TEST_LEN; ++j) {
+            LilyCheckedDataType *self = make__DataTypeTest(i, names);
+            LilyCheckedDataType *other = make__DataTypeTest(j, names);
+            Uint64 self_hash = hash__LilyCheckedDataType(self);
+            Uint64 other_hash = hash__LilyCheckedDataType(other);
+
+            if (eq__LilyCheckedDataType(self, other)) {
+                TEST_ASSERT(
+                  may_eq_hash__LilyCheckedDataType(self_hash, other_hash));
+            }
+
+            FREE(LilyCheckedDataType, self);
+            FREE(LilyCheckedDataType, other);
+        }
+    }
+
+    free_names__DataTypeTest(names);
+});
+
+CASE(data_type_hash_custom, {
+    String *names[DATA_TYPE_TEST_NAMES_LEN];
+
+    init_names__DataTypeTest(names);
+
+    LilyCheckedDataType *a = make__DataTypeTest(5, names);
+    LilyCheckedDataType *a2 = make__DataTypeTest(6, names);
+    LilyCheckedDataType *b_ = make__DataTypeTest(7, names);
+    LilyCheckedDataType *a_enum = make__DataTypeTest(8, names);
+
+    // The hash depends on the global name, not on its buffer.
+    TEST_ASSERT(hash__LilyCheckedDataType(a));
+    TEST_ASSERT_EQ(hash__LilyCheckedDataType(a),
+                   hash__LilyCheckedDataType(a2));
+    TEST_ASSERT(hash__LilyCheckedDataType(a) !=
+                hash__LilyCheckedDataType(b_));
+    TEST_ASSERT(hash__LilyCheckedDataType(a) !=
+                hash__LilyCheckedDataType(a_enum));
+
+    FREE(LilyCheckedDataType, a);
+    FREE(LilyCheckedDataType, a2);
+    FREE(LilyCheckedDataType, b_);
+    FREE(LilyCheckedDataType, a_enum);
+    free_names__DataTypeTest(names);
+});
+
+CASE(data_type_hash_generic, {
+    String *names[DATA_TYPE_TEST_NAMES_LEN];
+
+    init_names__DataTypeTest(names);
+
+    // The generic and compiler generic data types (and the data types which
+    // contain them) can match other data types, so they have no hash.
+    for (Usize i = 9; i <= 13; ++i) {
+        LilyCheckedDataType *self = make__DataTypeTest(i, names);
+
+        TEST_ASSERT_EQ(hash__LilyCheckedDataType(self), 0);
+
+        FREE(LilyCheckedDataType, self);
+    }
+
+    LilyCheckedDataType *list = make__DataTypeTest(15, names);
+    LilyCheckedDataType *tuple = make__DataTypeTest(17, names);
+
+    TEST_ASSERT_EQ(hash__LilyCheckedDataType(list), 0);
+    TEST_ASSERT_EQ(hash__LilyCheckedDataType(tuple), 0);
+
+    FREE(LilyCheckedDataType, list);
+    FREE(LilyCheckedDataType, tuple);
+    free_names__DataTypeTest(names);
+});
@@ -0,0 +1,148 @@
+#include "util.c"
+
+#include <base/test.h>
+
+#include <core/lily/analysis/checked/operator_register.h>
+#include <core/lily/analysis/checked/signature.h>
+
+/**
+ *
+ * @brief Look for the signature without using the hashes (like before the
+ * hashes were stored in the signatures).
+ */
+static bool
+has_signature__SignatureTest(const Vec *signatures, const Vec *types)
+{
+    for (Usize i = 0; i < signatures->len; ++i) {
+        const LilyCheckedSignatureFun *signature = get__Vec(signatures, i);
+        bool is_match = true;
+
+        for (Usize j = 0; j < types->len && is_match; ++j) {
+            LilyCheckedDataType *types_dt = get__Vec(types, j);
+            LilyCheckedDataType *pushed_dt = get__Vec(signature->types, j);
+
+            is_match = eq__LilyCheckedDataType(types_dt, pushed_dt) &&
+                       types_dt->kind == pushed_dt->kind;
+        }
+
+        if (is_match) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ *
+ * @brief Look for the operator without using the hashes.
+ */
+static bool
+has_operator__SignatureTest(const LilyCheckedOperatorRegister *self,
+                            const char *name,
+                            const Vec *signature)
+{
+    for (Usize i = 0; i < self->operators->len; ++i) {
+        const LilyCheckedOperator *operator= get__Vec(self->operators, i);
+        bool is_match = !strcmp(operator->name->buffer, name) &&
+                        operator->signature->len == signature->len;
+
+        for (Usize j = 0; j < signature->len && is_match; ++j) {
+            is_match = eq__LilyCheckedDataType(
+              get__Vec(operator->signature, j), get__Vec(signature, j));
+        }
+
+        if (is_match) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+SUITE(signature_dedup);
+
+CASE(signature_dedup_fun, {
+    String *names[DATA_TYPE_TEST_NAMES_LEN];
+    Vec *signatures = NEW(Vec); // Vec<LilyCheckedSignatureFun*>*
+    Vec *params = NEW(Vec);     // Vec<LilyCheckedDataType*>*
+
+    init_names__DataTypeTest(names);
+
+    // Each data type is added twice, so every kind of duplicate is checked.
+    for (Usize i = 0; i < DATA_TYPE_TEST_LEN * 2; ++i) {
+        LilyCheckedDataType *param =
+          make__DataTypeTest(i % DATA_TYPE_TEST_LEN, names);
+        LilyCheckedDataType *return_data_type = make__DataTypeTest(0, names);
+        Vec *types = init__Vec(2, param, return_data_type);
+        bool expected = has_signature__SignatureTest(signatures, types);
+
+        TEST_ASSERT_EQ(add_signature__LilyCheckedSignatureFun(
+                         names[0], types, NULL, signatures),
+                       expected);
+
+        if (expected) {
+            FREE(LilyCheckedDataType, param);
+            FREE(LilyCheckedDataType, return_data_type);
+            FREE(Vec, types);
+        } else {
+            push__Vec(params, param);
+        }
+    }
+
+    FREE_BUFFER_ITEMS(
+      signatures->buffer, signatures->len, LilyCheckedSignatureFun);
+    FREE(Vec, signatures);
+    FREE_BUFFER_ITEMS(params->buffer, params->len, LilyCheckedDataType);
+    FREE(Vec, params);
+    free_names__DataTypeTest(names);
+});
+
+CASE(signature_dedup_operator, {
+    String *names[DATA_TYPE_TEST_NAMES_LEN];
+    String *name = from__String("+");
+    LilyCheckedOperatorRegister register_ = NEW(LilyCheckedOperatorRegister);
+    Vec *signatures = NEW(Vec); // Vec<Vec<LilyCheckedDataType*>*>*
+
+    init_names__DataTypeTest(names);
+
+    for (Usize i = 0; i < DATA_TYPE_TEST_LEN * 2; ++i) {
+        Vec *signature =
+          init__Vec(3,
+                    make__DataTypeTest(i % DATA_TYPE_TEST_LEN, names),
+                    make__DataTypeTest(i / 2 % DATA_TYPE_TEST_LEN, names),
+                    make__DataTypeTest(0, names));
+        bool expected =
+          has_operator__SignatureTest(&register_, name->buffer, signature);
+
+        TEST_ASSERT_EQ(search_operator__LilyCheckedOperatorRegister(
+                         &register_, name->buffer, signature) != NULL,
+                       expected);
+        LilyCheckedOperator *operator=
+          NEW(LilyCheckedOperator, name, signature, false);
+
+        TEST_ASSERT_EQ(
+          add_operator__LilyCheckedOperatorRegister(&register_, operator),
+          expected);
+
+        if (expected) {
+            FREE(LilyCheckedOperator, operator);
+        }
+
+        push__Vec(signatures, signature);
+    }
+
+    FREE(LilyCheckedOperatorRegister, &register_);
+
+    for (Usize i = 0; i < signatures->len; ++i) {
+        Vec *signature = get__Vec(signatures, i);
+
+        FREE_BUFFER_ITEMS(
+          signature->buffer, signature->len, LilyCheckedDataType);
+        FREE(Vec, signature);
+    }
+
+    FREE(Vec, signatures);
+    FREE(String, name);
+    free_names__DataTypeTest(names);
+});
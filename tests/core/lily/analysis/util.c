@@ -0,0 +1,174 @@
+#ifndef UTIL_C
+#define UTIL_C
+
+#include <base/new.h>
+#include <base/string.h>
+#include <base/vec.h>
+
+#include <core/lily/analysis/checked/data_type.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DATA_TYPE_TEST_LEN 19
+#define DATA_TYPE_TEST_NAMES_LEN 7
+
+static const Location location = { .filename = "test.lily",
+                                   .start_line = 1,
+                                   .end_line = 1,
+                                   .start_column = 1,
+                                   .end_column = 1,
+                                   .start_position = 0,
+                                   .end_position = 0 };
+
+/**
+ *
+ * @brief Build a custom data type.
+ */
+static LilyCheckedDataType *
+make_custom__DataTypeTest(String *name,
+                          enum LilyCheckedDataTypeCustomKind kind)
+{
+    return NEW_VARIANT(LilyCheckedDataType,
+                       custom,
+                       &location,
+                       NEW(LilyCheckedDataTypeCustom,
+                           0,
+                           (LilyCheckedAccessScope){ .id = 0 },
+                           name,
+                           name,
+                           NULL,
+                           kind,
+                           false));
+}
+
+/**
+ *
+ * @brief Build the nth data type of the test (a new data type is returned at
+ * each call, because eq__LilyCheckedDataType can update the data types).
+ * @param names [A, A (other buffer), B, T, U, @T, @U]
+ */
+static LilyCheckedDataType *
+make__DataTypeTest(Usize n, String *names[])
+{
+    switch (n) {
+        case 0:
+            return NEW(LilyCheckedDataType,
+                       LILY_CHECKED_DATA_TYPE_KIND_INT32,
+                       &location);
+        case 1:
+            return NEW(LilyCheckedDataType,
+                       LILY_CHECKED_DATA_TYPE_KIND_INT64,
+                       &location);
+        case 2:
+            return NEW_VARIANT(LilyCheckedDataType,
+                               mut,
+                               &location,
+                               make__DataTypeTest(0, names));
+        case 3:
+            return NEW_VARIANT(LilyCheckedDataType,
+                               ptr,
+                               &location,
+                               make__DataTypeTest(0, names));
+        case 4:
+            return NEW_VARIANT(LilyCheckedDataType,
+                               ptr,
+                               &location,
+                               make__DataTypeTest(1, names));
+        case 5:
+            return make_custom__DataTypeTest(
+              names[0], LILY_CHECKED_DATA_TYPE_CUSTOM_KIND_RECORD);
+        case 6:
+            return make_custom__DataTypeTest(
+              names[1], LILY_CHECKED_DATA_TYPE_CUSTOM_KIND_RECORD);
+        case 7:
+            return make_custom__DataTypeTest(
+              names[2], LILY_CHECKED_DATA_TYPE_CUSTOM_KIND_RECORD);
+        case 8:
+            return make_custom__DataTypeTest(
+              names[0], LILY_CHECKED_DATA_TYPE_CUSTOM_KIND_ENUM);
+        case 9:
+            return make_custom__DataTypeTest(
+              names[3], LILY_CHECKED_DATA_TYPE_CUSTOM_KIND_GENERIC);
+        case 10:
+            return make_custom__DataTypeTest(
+              names[4], LILY_CHECKED_DATA_TYPE_CUSTOM_KIND_GENERIC);
+        case 11:
+            return NEW_VARIANT(LilyCheckedDataType,
+                               compiler_generic,
+                               &location,
+                               NEW(LilyCheckedDataTypeCompilerGeneric,
+                                   names[5]));
+        case 12:
+            return NEW_VARIANT(LilyCheckedDataType,
+                               compiler_generic,
+                               &location,
+                               NEW(LilyCheckedDataTypeCompilerGeneric,
+                                   names[6]));
+        case 13:
+            return NEW_VARIANT(LilyCheckedDataType,
+                               ptr,
+                               &location,
+                               make__DataTypeTest(11, names));
+        case 14:
+            return NEW_VARIANT(LilyCheckedDataType,
+                               list,
+                               &location,
+                               make__DataTypeTest(5, names));
+        case 15:
+            return NEW_VARIANT(LilyCheckedDataType,
+                               list,
+                               &location,
+                               make__DataTypeTest(9, names));
+        case 16:
+            return NEW_VARIANT(LilyCheckedDataType,
+                               tuple,
+                               &location,
+                               init__Vec(2,
+                                         make__DataTypeTest(0, names),
+                                         make__DataTypeTest(6, names)));
+        case 17:
+            return NEW_VARIANT(LilyCheckedDataType,
+                               tuple,
+                               &location,
+                               init__Vec(2,
+                                         make__DataTypeTest(0, names),
+                                         make__DataTypeTest(10, names)));
+        case 18:
+            return NEW(LilyCheckedDataType,
+                       LILY_CHECKED_DATA_TYPE_KIND_UNKNOWN,
+                       &location);
+        default:
+            UNREACHABLE("unknown data type");
+    }
+}
+
+/**
+ *
+ * @brief Build the names used by make__DataTypeTest.
+ */
+static void
+init_names__DataTypeTest(String *names[])
+{
+    names[0] = from__String("A");
+    names[1] = from__String("A");
+    names[2] = from__String("B");
+    names[3] = from__String("T");
+    names[4] = from__String("U");
+    names[5] = from__String("@T");
+    names[6] = from__String("@U");
+}
+
+/**
+ *
+ * @brief Free the names used by make__DataTypeTest.
+ */
+static void
+free_names__DataTypeTest(String *names[])
+{
+    for (Usize i = 0; i < DATA_TYPE_TEST_NAMES_LEN; ++i) {
+        FREE(String, names[i]);
+    }
+}
+
+#endif // UTIL_C
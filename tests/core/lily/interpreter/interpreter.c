@@ -0,0 +1,22 @@
+#include "memory.c"
+#include "value.c"
+
+#include <base/test.h>
+
+int
+main()
+{
+    NEW_TEST("interpreter");
+    ADD_SUITE(3,
+              memory,
+              CALL_CASE(memory_slab_reuse),
+              CALL_CASE(memory_large_object),
+              CALL_CASE(memory_out_of_memory));
+    ADD_SUITE(4,
+              value,
+              CALL_CASE(value_collect_list_cycle),
+              CALL_CASE(value_collect_struct_cycle),
+              CALL_CASE(value_collect_live_cycle),
+              CALL_CASE(value_collect_deep_cycle));
+    RUN_TEST();
+}
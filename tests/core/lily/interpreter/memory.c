@@ -0,0 +1,140 @@
+#include <base/fork.h>
+#include <base/new.h>
+#include <base/test.h>
+
+#include <core/lily/interpreter/vm/memory.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#define MEMORY_SLAB_SIZE(block_size) \
+    ((block_size) * LILY_INTERPRETER_MEMORY_SLAB_BLOCKS_LEN)
+
+/**
+ *
+ * @brief Exceed the capacity of the memory (the process is expected to exit
+ * with an out of memory error).
+ */
+static void
+alloc_beyond_capacity__MemoryTest()
+{
+    LilyInterpreterMemory memory =
+      NEW_VARIANT(LilyInterpreterMemory, capacity, 1024);
+
+    // The error is not displayed in the output of the tests.
+    freopen("/dev/null", "w", stdout);
+
+    alloc__LilyInterpreterMemory(&memory, 512);
+    alloc__LilyInterpreterMemory(&memory, 512);
+    alloc__LilyInterpreterMemory(&memory, 1);
+
+    exit(TEST_PASS);
+}
+
+SUITE(memory);
+
+CASE(memory_slab_reuse, {
+    LilyInterpreterMemory memory = NEW(LilyInterpreterMemory);
+    void *first = alloc__LilyInterpreterMemory(&memory, 24);
+
+    // The size is rounded to the size class (32 bytes), and a slab of this
+    // size class is added.
+    TEST_ASSERT_EQ(memory.total_size, MEMORY_SLAB_SIZE(32));
+    TEST_ASSERT_EQ(get_size__LilyInterpreterMemory(&memory), 32);
+
+    free__LilyInterpreterMemory(&memory, first, 24);
+
+    TEST_ASSERT_EQ(get_size__LilyInterpreterMemory(&memory), 0);
+
+    // The freed block is reused by the next allocation of the size class.
+    TEST_ASSERT(alloc__LilyInterpreterMemory(&memory, 30) == first);
+
+    for (Usize i = 1; i < LILY_INTERPRETER_MEMORY_SLAB_BLOCKS_LEN; ++i) {
+        alloc__LilyInterpreterMemory(&memory, 32);
+    }
+
+    TEST_ASSERT_EQ(memory.total_size, MEMORY_SLAB_SIZE(32));
+    TEST_ASSERT_EQ(memory.total_size_free, 0);
+
+    // The slab is full.
+    alloc__LilyInterpreterMemory(&memory, 32);
+
+    TEST_ASSERT_EQ(memory.total_size, MEMORY_SLAB_SIZE(32) * 2);
+
+    // The resize stays in the block, if the size class is the same.
+    void *mem = alloc__LilyInterpreterMemory(&memory, 100);
+
+    TEST_ASSERT(resize__LilyInterpreterMemory(&memory, mem, 100, 128) == mem);
+    TEST_ASSERT_EQ(memory.alloc_count,
+                   LILY_INTERPRETER_MEMORY_SLAB_BLOCKS_LEN + 3);
+    TEST_ASSERT_EQ(memory.free_count, 1);
+
+    FREE(LilyInterpreterMemory, &memory);
+});
+
+CASE(memory_large_object, {
+    LilyInterpreterMemory memory = NEW(LilyInterpreterMemory);
+    char *large = alloc__LilyInterpreterMemory(&memory, 1000);
+
+    // The large objects are not taken from a slab.
+    TEST_ASSERT(memory.larges);
+    TEST_ASSERT(!memory.slabs);
+    TEST_ASSERT_EQ(memory.total_size, 1000);
+    TEST_ASSERT_EQ(get_size__LilyInterpreterMemory(&memory), 1000);
+
+    memset(large, 'a', 1000);
+
+    large = resize__LilyInterpreterMemory(&memory, large, 1000, 3000);
+
+    TEST_ASSERT_EQ(memory.total_size, 3000);
+
+    for (Usize i = 0; i < 1000; ++i) {
+        TEST_ASSERT_EQ(large[i], 'a');
+    }
+
+    // The content is kept, when a large object is shrunk to a small object.
+    large = resize__LilyInterpreterMemory(&memory, large, 3000, 64);
+
+    TEST_ASSERT(!memory.larges);
+    TEST_ASSERT_EQ(get_size__LilyInterpreterMemory(&memory), 64);
+    TEST_ASSERT_EQ(memory.peak_size, 4000);
+
+    for (Usize i = 0; i < 64; ++i) {
+        TEST_ASSERT_EQ(large[i], 'a');
+    }
+
+    free__LilyInterpreterMemory(&memory, large, 64);
+
+    TEST_ASSERT_EQ(get_size__LilyInterpreterMemory(&memory), 0);
+
+    FREE(LilyInterpreterMemory, &memory);
+});
+
+CASE(memory_out_of_memory, {
+    LilyInterpreterMemory memory =
+      NEW_VARIANT(LilyInterpreterMemory, capacity, 1024);
+
+    // The capacity can be reached.
+    void *first = alloc__LilyInterpreterMemory(&memory, 512);
+    void *second = alloc__LilyInterpreterMemory(&memory, 512);
+
+    TEST_ASSERT_EQ(get_size__LilyInterpreterMemory(&memory), 1024);
+    TEST_ASSERT_EQ(memory.peak_size, 1024);
+
+    free__LilyInterpreterMemory(&memory, first, 512);
+    free__LilyInterpreterMemory(&memory, second, 512);
+    FREE(LilyInterpreterMemory, &memory);
+
+    // The capacity cannot be exceeded.
+    int exit_status = -1;
+    int kill_signal = -1;
+    int stop_signal = -1;
+
+    use__Fork(run__Fork(),
+              &alloc_beyond_capacity__MemoryTest,
+              &exit_status,
+              &kill_signal,
+              &stop_signal);
+
+    TEST_ASSERT_EQ(exit_status, 1);
+});
@@ -0,0 +1,159 @@
+#include <base/new.h>
+#include <base/test.h>
+
+#include <core/lily/interpreter/vm/memory.h>
+#include <core/lily/interpreter/vm/value.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#define VALUE_DEEP_CYCLE_LEN 200000
+
+/**
+ *
+ * @brief Build a list whose only node references the list itself.
+ * @return Return the value owning the list.
+ */
+static LilyInterpreterValue
+build_cyclic_list__ValueTest()
+{
+    LilyInterpreterValueList *list = NEW(LilyInterpreterValueList, NULL, NULL);
+    LilyInterpreterValueListNode *node =
+      NEW(LilyInterpreterValueListNode,
+          NEW_VARIANT(
+            LilyInterpreterValue, list, ref__LilyInterpreterValueList(list)),
+          NULL);
+
+    list->head = node;
+    list->tail = node;
+
+    return NEW_VARIANT(LilyInterpreterValue, list, list);
+}
+
+/**
+ *
+ * @brief Build a chain of `len` structs (plus one), where the innermost struct
+ * references the outermost one.
+ * @return Return the value owning the outermost struct.
+ */
+static LilyInterpreterValue
+build_cyclic_struct__ValueTest(Usize len)
+{
+    LilyInterpreterValue fields[2];
+
+    fields[0] = NEW_VARIANT(LilyInterpreterValue, int32, 0);
+    fields[1] = NEW_VARIANT(
+      LilyInterpreterValue, str, NEW(LilyInterpreterValueStr, "cycle", 5));
+
+    LilyInterpreterValueStruct *inner =
+      NEW(LilyInterpreterValueStruct, fields, 2);
+    LilyInterpreterValueStruct *outer = inner;
+
+    for (Usize i = 0; i < len; ++i) {
+        fields[0] = NEW_VARIANT(LilyInterpreterValue, struct, outer);
+        outer = NEW(LilyInterpreterValueStruct, fields, 1);
+    }
+
+    inner->values[0] = NEW_VARIANT(
+      LilyInterpreterValue, struct, ref__LilyInterpreterValueStruct(outer));
+
+    return NEW_VARIANT(LilyInterpreterValue, struct, outer);
+}
+
+SUITE(value);
+
+CASE(value_collect_list_cycle, {
+    LilyInterpreterMemory memory = NEW(LilyInterpreterMemory);
+    LilyInterpreterMemory *previous =
+      set_current__LilyInterpreterMemory(&memory);
+    LilyInterpreterValue list = build_cyclic_list__ValueTest();
+
+    // The list is buffered as a possible root, when the owner is freed.
+    FREE(LilyInterpreterValue, &list);
+
+    TEST_ASSERT(get_size__LilyInterpreterMemory(&memory) > 0);
+
+    collect_cycles__LilyInterpreterValue();
+
+    TEST_ASSERT_EQ(get_collector_stats__LilyInterpreterValue()->collections, 1);
+    TEST_ASSERT_EQ(get_collector_stats__LilyInterpreterValue()->cycles, 1);
+    TEST_ASSERT_EQ(get_collector_stats__LilyInterpreterValue()->objects_freed,
+                   1);
+    TEST_ASSERT_EQ(get_size__LilyInterpreterMemory(&memory), 0);
+
+    free_collector__LilyInterpreterValue();
+    set_current__LilyInterpreterMemory(previous);
+    FREE(LilyInterpreterMemory, &memory);
+});
+
+CASE(value_collect_struct_cycle, {
+    LilyInterpreterMemory memory = NEW(LilyInterpreterMemory);
+    LilyInterpreterMemory *previous =
+      set_current__LilyInterpreterMemory(&memory);
+    LilyInterpreterValue struct_ = build_cyclic_struct__ValueTest(1);
+
+    FREE(LilyInterpreterValue, &struct_);
+    collect_cycles__LilyInterpreterValue();
+
+    // The two structs are freed, and the Str outside of the cycle is released.
+    TEST_ASSERT_EQ(get_collector_stats__LilyInterpreterValue()->cycles, 1);
+    TEST_ASSERT_EQ(get_collector_stats__LilyInterpreterValue()->objects_freed,
+                   2);
+    TEST_ASSERT_EQ(get_size__LilyInterpreterMemory(&memory), 0);
+
+    free_collector__LilyInterpreterValue();
+    set_current__LilyInterpreterMemory(previous);
+    FREE(LilyInterpreterMemory, &memory);
+});
+
+CASE(value_collect_live_cycle, {
+    LilyInterpreterMemory memory = NEW(LilyInterpreterMemory);
+    LilyInterpreterMemory *previous =
+      set_current__LilyInterpreterMemory(&memory);
+    LilyInterpreterValue list = build_cyclic_list__ValueTest();
+    LilyInterpreterValue other = NEW_VARIANT(
+      LilyInterpreterValue, list, ref__LilyInterpreterValueList(list.list));
+
+    // The list is still referenced by `list`.
+    FREE(LilyInterpreterValue, &other);
+    collect_cycles__LilyInterpreterValue();
+
+    TEST_ASSERT_EQ(get_collector_stats__LilyInterpreterValue()->cycles, 0);
+    TEST_ASSERT_EQ(get_collector_stats__LilyInterpreterValue()->objects_freed,
+                   0);
+    TEST_ASSERT(list.list->object.color == LILY_INTERPRETER_VALUE_COLOR_BLACK);
+    TEST_ASSERT(get_size__LilyInterpreterMemory(&memory) > 0);
+
+    FREE(LilyInterpreterValue, &list);
+    collect_cycles__LilyInterpreterValue();
+
+    TEST_ASSERT_EQ(get_collector_stats__LilyInterpreterValue()->cycles, 1);
+    TEST_ASSERT_EQ(get_collector_stats__LilyInterpreterValue()->objects_freed,
+                   1);
+    TEST_ASSERT_EQ(get_size__LilyInterpreterMemory(&memory), 0);
+
+    free_collector__LilyInterpreterValue();
+    set_current__LilyInterpreterMemory(previous);
+    FREE(LilyInterpreterMemory, &memory);
+});
+
+CASE(value_collect_deep_cycle, {
+    LilyInterpreterMemory memory = NEW(LilyInterpreterMemory);
+    LilyInterpreterMemory *previous =
+      set_current__LilyInterpreterMemory(&memory);
+    // NOTE: The cycle is too deep to be traversed recursively.
+    LilyInterpreterValue struct_ =
+      build_cyclic_struct__ValueTest(VALUE_DEEP_CYCLE_LEN);
+
+    FREE(LilyInterpreterValue, &struct_);
+    collect_cycles__LilyInterpreterValue();
+
+    TEST_ASSERT_EQ(get_collector_stats__LilyInterpreterValue()->cycles, 1);
+    TEST_ASSERT_EQ(get_collector_stats__LilyInterpreterValue()->objects_freed,
+                   VALUE_DEEP_CYCLE_LEN + 1);
+    TEST_ASSERT_EQ(get_size__LilyInterpreterMemory(&memory), 0);
+
+    free_collector__LilyInterpreterValue();
+    set_current__LilyInterpreterMemory(previous);
+    FREE(LilyInterpreterMemory, &memory);
+});
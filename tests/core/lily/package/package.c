@@ -0,0 +1,11 @@
+#include "scheduler.c"
+
+#include <base/test.h>
+
+int
+main()
+{
+    NEW_TEST("package");
+    ADD_SUITE(1, scheduler, CALL_CASE(scheduler_diamond));
+    RUN_TEST();
+}
@@ -0,0 +1,114 @@
+#include <base/alloc.h>
+#include <base/new.h>
+#include <base/test.h>
+
+#include <core/lily/package/dependency_tree.h>
+#include <core/lily/package/package.h>
+#include <core/lily/package/scheduler.h>
+
+#include <stdatomic.h>
+#include <unistd.h>
+
+#define SCHEDULER_TEST_PACKAGE_LEN 4
+#define SCHEDULER_TEST_RUN_LEN 50
+
+static atomic_size_t scheduler_test_counter = 0;
+static Usize scheduler_test_orders[SCHEDULER_TEST_PACKAGE_LEN];
+static atomic_bool scheduler_test_is_valid = true;
+static char *scheduler_test_names[SCHEDULER_TEST_PACKAGE_LEN] = { "a",
+                                                                 "b",
+                                                                 "c",
+                                                                 "d" };
+
+static void
+run__SchedulerTest(LilyPackageDependencyTree *tree)
+{
+    // All the dependencies must be done before the package is run.
+    if (tree->dependencies) {
+        for (Usize i = 0; i < tree->dependencies->len; ++i) {
+            LilyPackageDependencyTree *dependency =
+              get__Vec(tree->dependencies, i);
+
+            if (!dependency->is_done) {
+                scheduler_test_is_valid = false;
+            }
+        }
+    }
+
+    // NOTE: The package c is slower, so d would be run before c is done if
+    // its dependency on c was ignored.
+    usleep(tree->package->name->buffer[0] == 'c' ? 2000 : 100);
+
+    scheduler_test_orders[tree->package->name->buffer[0] - 'a'] =
+      atomic_fetch_add(&scheduler_test_counter, 1);
+}
+
+static LilyPackage *
+new_package__SchedulerTest(char *name)
+{
+    LilyPackage *package = lily_malloc(sizeof(LilyPackage));
+
+    package->name = from__String(name);
+
+    return package;
+}
+
+static void
+free_package__SchedulerTest(LilyPackage *package)
+{
+    FREE(String, package->name);
+    lily_free(package);
+}
+
+SUITE(scheduler);
+
+// a -> b -> d
+//   -> c ---^
+CASE(scheduler_diamond, {
+    for (Usize n = 0; n < SCHEDULER_TEST_RUN_LEN; ++n) {
+        LilyPackage *packages[SCHEDULER_TEST_PACKAGE_LEN];
+
+        for (Usize i = 0; i < SCHEDULER_TEST_PACKAGE_LEN; ++i) {
+            packages[i] = new_package__SchedulerTest(scheduler_test_names[i]);
+        }
+
+        LilyPackageDependencyTree *tree_a =
+          NEW(LilyPackageDependencyTree, packages[0], NULL);
+        LilyPackageDependencyTree *tree_b =
+          NEW(LilyPackageDependencyTree, packages[1], init__Vec(1, tree_a));
+        LilyPackageDependencyTree *tree_c =
+          NEW(LilyPackageDependencyTree, packages[2], init__Vec(1, tree_a));
+        LilyPackageDependencyTree *tree_d = NEW(
+          LilyPackageDependencyTree, packages[3], init__Vec(2, tree_b, tree_c));
+
+        push__Vec(tree_a->children, tree_b);
+        push__Vec(tree_a->children, tree_c);
+        push__Vec(tree_b->children, tree_d);
+
+        Vec *trees = init__Vec(1, tree_a);
+        LilyPackageScheduler *scheduler =
+          NEW(LilyPackageScheduler, trees, 4, &run__SchedulerTest);
+
+        TEST_ASSERT_EQ(scheduler->workers_len, 4);
+
+        atomic_store(&scheduler_test_counter, 0);
+        run__LilyPackageScheduler(scheduler);
+
+        TEST_ASSERT(atomic_load(&scheduler_test_is_valid));
+        TEST_ASSERT_EQ(atomic_load(&scheduler_test_counter), 4);
+        TEST_ASSERT(scheduler_test_orders[0] < scheduler_test_orders[1]);
+        TEST_ASSERT(scheduler_test_orders[0] < scheduler_test_orders[2]);
+        TEST_ASSERT(scheduler_test_orders[1] < scheduler_test_orders[3]);
+        TEST_ASSERT(scheduler_test_orders[2] < scheduler_test_orders[3]);
+        TEST_ASSERT(tree_a->is_done && tree_b->is_done && tree_c->is_done &&
+                    tree_d->is_done);
+
+        FREE(LilyPackageScheduler, scheduler);
+        FREE(Vec, trees);
+        FREE(LilyPackageDependencyTree, tree_a);
+
+        for (Usize i = 0; i < SCHEDULER_TEST_PACKAGE_LEN; ++i) {
+            free_package__SchedulerTest(packages[i]);
+        }
+    }
+});
@@ -0,0 +1,151 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022-2026 ArthurPV
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <base/alloc.h>
+#include <base/format.h>
+#include <base/new.h>
+#include <base/string.h>
+
+#include <core/lily/scanner/scanner.h>
+#include <core/shared/search.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MS(start) ((double)(clock() - (start)) * 1000 / CLOCKS_PER_SEC)
+
+/**
+ *
+ * @brief Compare get_id__Search and SearchPerfectHash on a mix of keywords and
+ * identifiers.
+ */
+static void
+bench_keyword(Usize n)
+{
+    static const char *words[] = { "while", "value",  "return", "result",
+                                   "fun",   "func",   "x",      "match",
+                                   "self",  "selfie", "type",   "typed" };
+    const Usize words_len = sizeof(words) / sizeof(*words);
+    String *strings[sizeof(words) / sizeof(*words)];
+    // NOTE: Use the table of keywords of the scanner, so that the lookup is
+    // measured on the real ids.
+    const SearchPerfectHash *hash = get_keywords_hash__LilyScanner();
+
+    for (Usize i = 0; i < words_len; ++i) {
+        strings[i] = from__String((char *)words[i]);
+    }
+
+    Int64 linear_sum = 0, hash_sum = 0;
+    clock_t start = clock();
+
+    for (Usize i = 0; i < n; ++i) {
+        linear_sum += get_id__Search(
+          strings[i % words_len], hash->ids_s, hash->ids, hash->ids_s_len);
+    }
+
+    double linear_ms = BENCH_MS(start);
+
+    start = clock();
+
+    for (Usize i = 0; i < n; ++i) {
+        hash_sum += get_id__SearchPerfectHash(hash, strings[i % words_len]);
+    }
+
+    double hash_ms = BENCH_MS(start);
+
+    printf("keyword  linear: %8.2f ms, perfect hash: %8.2f ms (x%.2f)\n",
+           linear_ms,
+           hash_ms,
+           linear_ms / (hash_ms > 0 ? hash_ms : 1e-3));
+
+    if (linear_sum != hash_sum) {
+        printf("unexpected sum: %lld != %lld\n",
+               (long long)linear_sum,
+               (long long)hash_sum);
+    }
+
+    for (Usize i = 0; i < words_len; ++i) {
+        FREE(String, strings[i]);
+    }
+}
+
+/**
+ *
+ * @brief Scan a generated source of `n` functions and report the throughput
+ * in tokens per second.
+ */
+static void
+bench_scanner(Usize n)
+{
+    String *content = NEW(String);
+
+    for (Usize i = 0; i < n; ++i) {
+        char *line = format("/* Add `x` and `y`, then multiply `y` by a "
+                            "constant. */\n"
+                            "fun add_{zu}(x Int32, y Int32) Int32 =\n"
+                            "    // Compute the result.\n"
+                            "    val result := x + y * {zu};\n"
+                            "    if result > 10 do\n"
+                            "        return result;\n"
+                            "    end\n"
+                            "    return \"value\" and not true;\n"
+                            "end\n\n",
+                            i,
+                            i);
+
+        push_str__String(content, line);
+        lily_free(line);
+    }
+
+    // NOTE: Like read_file__File, end the content with an extra new line.
+    push__String(content, '\n');
+
+    // NOTE: NEW(File, ...) takes the length from the file on disk.
+    Usize bytes = content->len;
+    File file = { .name = "bench.lily",
+                  .content = content->buffer,
+                  .len = content->len };
+    Usize count_error = 0;
+    LilyScanner scanner = NEW(
+      LilyScanner, NEW(Source, NEW(Cursor, file.content), &file), &count_error);
+    clock_t start = clock();
+
+    run__LilyScanner(&scanner, false);
+
+    double ms = BENCH_MS(start);
+    Usize tokens = scanner.tokens->len;
+
+    printf("scanner  %zu tokens, %zu bytes: %8.2f ms (%.0f tokens/s, %.2f "
+           "MB/s)\n",
+           tokens,
+           bytes,
+           ms,
+           tokens / (ms > 0 ? ms / 1000 : 1e-6),
+           bytes / (ms > 0 ? ms * 1000 : 1e-3));
+
+    FREE(LilyScanner, &scanner);
+    FREE(File, &file);
+    lily_free(content);
+}
@@ -0,0 +1,51 @@
+#include "util.c"
+
+#include <base/test.h>
+
+#include <core/shared/search.h>
+
+/**
+ *
+ * @brief Check that every id of the table is found by the perfect hash (and
+ * that the non-ids are not found).
+ */
+static bool
+check_keyword_hash(const SearchPerfectHash *hash)
+{
+    static const char *non_ids[] = { "",       "x",      "funn", "selfie",
+                                     "Fun",    "fu",     "@",    "@lenn",
+                                     "while_", "zzzzzz", "a b",  "end\n" };
+
+    if (!hash->is_perfect) {
+        return false;
+    }
+
+    for (Usize i = 0; i < hash->ids_s_len; ++i) {
+        String *id = from__String((char *)hash->ids_s[i].buffer);
+        Int32 res = get_id__SearchPerfectHash(hash, id);
+
+        FREE(String, id);
+
+        if (res != hash->ids[i]) {
+            return false;
+        }
+    }
+
+    for (Usize i = 0; i < sizeof(non_ids) / sizeof(*non_ids); ++i) {
+        String *id = from__String((char *)non_ids[i]);
+        Int32 res = get_id__SearchPerfectHash(hash, id);
+
+        FREE(String, id);
+
+        if (res != -1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+SIMPLE(keyword_hash, {
+    TEST_ASSERT(check_keyword_hash(get_keywords_hash__LilyScanner()));
+    TEST_ASSERT(check_keyword_hash(get_at_keywords_hash__LilyScanner()));
+});
@@ -5,6 +5,7 @@
 #include "identifier_normal.c"
 #include "identifier_operator.c"
 #include "keyword.c"
+#include "keyword_hash.c"
 #include "literal.c"
 #include "literal_byte.c"
 #include "literal_bytes.c"
@@ -44,6 +45,7 @@ main()
     ADD_SIMPLE(identifier_normal);
     ADD_SIMPLE(identifier_operator);
     ADD_SIMPLE(keyword);
+    ADD_SIMPLE(keyword_hash);
     ADD_SIMPLE(separator);
     ADD_SIMPLE(operator);
     ADD_SUITE(21,
@@ -0,0 +1,129 @@
+#include <base/file.h>
+#include <base/new.h>
+#include <base/string.h>
+#include <base/test.h>
+#include <base/vec.h>
+
+#include <core/shared/diagnostic.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#define FILE_DIAGNOSTIC "./tests/core/shared/input/lines.txt"
+#define DIAGNOSTIC_OUTPUT "./tests/core/shared/input/output.jsonl"
+#define DIAGNOSTIC_JSON                                                      \
+    "{\"file\":\"" FILE_DIAGNOSTIC "\",\"start_line\":2,\"start_column\":1," \
+    "\"end_line\":2,\"end_column\":2,\"level\":\"error\",\"code\":\"0019\"," \
+    "\"message\":\"invalid octal literal\",\"detail\":\"add a digit\","      \
+    "\"helps\":[\"e.g. \\\"0o22\\\"\\n\\t0o56\"],\"notes\":[]}"
+#define DIAGNOSTIC_THREADS_LEN 4
+#define DIAGNOSTIC_THREAD_EMITS_LEN 1000
+
+/**
+ *
+ * @brief Emit the diagnostic used by the tests.
+ */
+static void
+emit__DiagnosticTest(const File *file, Usize *count_error)
+{
+    Location location = NEW(Location, FILE_DIAGNOSTIC, 2, 2, 1, 2, 3, 4);
+
+    emit__Diagnostic(
+      NEW_VARIANT(Diagnostic,
+                  simple_lily_error,
+                  file,
+                  &location,
+                  NEW(LilyError, LILY_ERROR_KIND_INVALID_OCTAL_LITERAL),
+                  init__Vec(1, from__String("e.g. \"0o22\"\n\t0o56")),
+                  NULL,
+                  from__String("add a digit")),
+      count_error);
+}
+
+/**
+ *
+ * @brief Check that each line of the output is the JSON object of the
+ * diagnostic.
+ * @return Return the number of lines, or -1 if a line is not expected.
+ */
+static Isize
+check_output__DiagnosticTest()
+{
+    fflush(stderr);
+
+    char *output = read_file__File(DIAGNOSTIC_OUTPUT);
+    const Usize expected_len = strlen(DIAGNOSTIC_JSON);
+    Isize lines_count = 0;
+
+    for (char *line = output; *line; ++lines_count) {
+        char *line_end = strchr(line, '\n');
+
+        if (!line_end || (Usize)(line_end - line) != expected_len ||
+            strncmp(line, DIAGNOSTIC_JSON, expected_len)) {
+            lines_count = -1;
+
+            break;
+        }
+
+        line = line_end + 1;
+    }
+
+    lily_free(output);
+    remove(DIAGNOSTIC_OUTPUT);
+
+    return lines_count;
+}
+
+static void *
+emit_thread__DiagnosticTest(void *file)
+{
+    Usize count_error = 0;
+
+    for (Usize i = 0; i < DIAGNOSTIC_THREAD_EMITS_LEN; ++i) {
+        emit__DiagnosticTest(file, &count_error);
+    }
+
+    return NULL;
+}
+
+SUITE(diagnostic_json);
+
+CASE(diagnostic_json_lines, {
+    File file = NEW(File, FILE_DIAGNOSTIC, read_file__File(FILE_DIAGNOSTIC));
+    Usize count_error = 0;
+
+    set_format__Diagnostic(DIAGNOSTIC_FORMAT_JSON);
+    TEST_ASSERT(freopen(DIAGNOSTIC_OUTPUT, "w", stderr));
+
+    emit__DiagnosticTest(&file, &count_error);
+    emit__DiagnosticTest(&file, &count_error);
+
+    // Each diagnostic is written on one line (the strings are escaped).
+    TEST_ASSERT_EQ(count_error, 2);
+    TEST_ASSERT_EQ(check_output__DiagnosticTest(), 2);
+
+    FREE(File, &file);
+});
+
+CASE(diagnostic_json_threads, {
+    File file = NEW(File, FILE_DIAGNOSTIC, read_file__File(FILE_DIAGNOSTIC));
+    pthread_t threads[DIAGNOSTIC_THREADS_LEN];
+
+    set_format__Diagnostic(DIAGNOSTIC_FORMAT_JSON);
+    TEST_ASSERT(freopen(DIAGNOSTIC_OUTPUT, "w", stderr));
+
+    for (Usize i = 0; i < DIAGNOSTIC_THREADS_LEN; ++i) {
+        pthread_create(&threads[i], NULL, &emit_thread__DiagnosticTest, &file);
+    }
+
+    for (Usize i = 0; i < DIAGNOSTIC_THREADS_LEN; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    // The diagnostics emitted by the threads are never interleaved.
+    TEST_ASSERT_EQ(check_output__DiagnosticTest(),
+                   DIAGNOSTIC_THREADS_LEN * DIAGNOSTIC_THREAD_EMITS_LEN);
+
+    FREE(File, &file);
+});
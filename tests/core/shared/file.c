@@ -0,0 +1,98 @@
+#include <base/file.h>
+#include <base/new.h>
+#include <base/test.h>
+
+#include <core/shared/file.h>
+
+#define FILE_LINES "./tests/core/shared/input/lines.txt"
+#define FILE_EMPTY "./tests/core/shared/input/empty.txt"
+#define FILE_MANY_LINES "./tests/core/shared/input/many_lines.txt"
+
+SUITE(file_lines);
+
+CASE(file_get_line, {
+    // ab\ncd\n\nef (the last line has no newline character)
+    File file = NEW(File, FILE_LINES, read_file__File(FILE_LINES));
+
+    TEST_ASSERT_EQ(file.line_starts_len, 4);
+
+    TEST_ASSERT_EQ(get_line__File(&file, 0), 1);
+    TEST_ASSERT_EQ(get_line__File(&file, 2), 1);
+    TEST_ASSERT_EQ(get_line__File(&file, 3), 2);
+    TEST_ASSERT_EQ(get_line__File(&file, 5), 2);
+    TEST_ASSERT_EQ(get_line__File(&file, 6), 3);
+    TEST_ASSERT_EQ(get_line__File(&file, 7), 4);
+    TEST_ASSERT_EQ(get_line__File(&file, 8), 4);
+    TEST_ASSERT_EQ(get_line__File(&file, 100), 4);
+
+    FREE(File, &file);
+});
+
+CASE(file_get_line_bounds, {
+    File file = NEW(File, FILE_LINES, read_file__File(FILE_LINES));
+
+    TEST_ASSERT_EQ(get_line_start__File(&file, 1), 0);
+    TEST_ASSERT_EQ(get_line_end__File(&file, 1), 2);
+    TEST_ASSERT_EQ(get_line_start__File(&file, 2), 3);
+    TEST_ASSERT_EQ(get_line_end__File(&file, 2), 5);
+
+    // Empty line.
+    TEST_ASSERT_EQ(get_line_start__File(&file, 3), 6);
+    TEST_ASSERT_EQ(get_line_end__File(&file, 3), 6);
+
+    // The last line ends at the end of the content.
+    TEST_ASSERT_EQ(get_line_start__File(&file, 4), 7);
+    TEST_ASSERT_EQ(get_line_end__File(&file, 4), 9);
+
+    // The line is clamped between the first and the last line.
+    TEST_ASSERT_EQ(get_line_start__File(&file, 0), 0);
+    TEST_ASSERT_EQ(get_line_start__File(&file, 10), 7);
+    TEST_ASSERT_EQ(get_line_end__File(&file, 10), 9);
+
+    FREE(File, &file);
+});
+
+CASE(file_get_line_empty, {
+    File file = NEW(File, FILE_EMPTY, read_file__File(FILE_EMPTY));
+
+    TEST_ASSERT_EQ(file.line_starts_len, 1);
+    TEST_ASSERT_EQ(get_line__File(&file, 0), 1);
+    TEST_ASSERT_EQ(get_line_start__File(&file, 1), 0);
+    TEST_ASSERT_EQ(get_line_end__File(&file, 1), 0);
+
+    FREE(File, &file);
+
+    // Without content, the lines are not indexed.
+    File no_content = NEW(File, FILE_EMPTY, NULL);
+
+    TEST_ASSERT_EQ(no_content.line_starts_len, 0);
+    TEST_ASSERT_EQ(get_line__File(&no_content, 0), 1);
+    TEST_ASSERT_EQ(get_line_start__File(&no_content, 1), 0);
+    TEST_ASSERT_EQ(get_line_end__File(&no_content, 1), 0);
+});
+
+CASE(file_get_line_many, {
+    File file = NEW(File, FILE_MANY_LINES, read_file__File(FILE_MANY_LINES));
+    Usize line = 1;
+    Usize line_start = 0;
+
+    // Compare the binary search with a linear scan of the content.
+    for (Usize i = 0; i < file.len - 1; ++i) {
+        TEST_ASSERT_EQ(get_line__File(&file, i), line);
+        TEST_ASSERT_EQ(get_line_start__File(&file, line), line_start);
+
+        if (file.content[i] == '\n') {
+            TEST_ASSERT_EQ(get_line_end__File(&file, line), i);
+
+            ++line;
+            line_start = i + 1;
+        }
+    }
+
+    // The file ends with a newline character, so the last line is empty.
+    TEST_ASSERT_EQ(file.line_starts_len, line);
+    TEST_ASSERT_EQ(get_line_start__File(&file, line), file.len - 1);
+    TEST_ASSERT_EQ(get_line_end__File(&file, line), file.len - 1);
+
+    FREE(File, &file);
+});
@@ -0,0 +1,21 @@
+#include "diagnostic.c"
+#include "file.c"
+
+#include <base/test.h>
+
+int
+main()
+{
+    NEW_TEST("core_shared");
+    ADD_SUITE(4,
+              file_lines,
+              CALL_CASE(file_get_line),
+              CALL_CASE(file_get_line_bounds),
+              CALL_CASE(file_get_line_empty),
+              CALL_CASE(file_get_line_many));
+    ADD_SUITE(2,
+              diagnostic_json,
+              CALL_CASE(diagnostic_json_lines),
+              CALL_CASE(diagnostic_json_threads));
+    RUN_TEST();
+}